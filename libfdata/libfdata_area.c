@@ -1043,22 +1043,24 @@ int libfdata_area_get_element_value_at_offset(
 	}
 	element_index = (int) ( element_value_offset / internal_area->element_data_size );
 
+	/* The cache entry index is calculated once and reused after the element data was read
+	 */
+	if( internal_area->calculate_cache_entry_index == NULL )
+	{
+		cache_entry_index = element_index % number_of_cache_entries;
+	}
+	else
+	{
+		cache_entry_index = internal_area->calculate_cache_entry_index(
+		                     element_index,
+		                     element_data_file_index,
+		                     element_data_offset,
+		                     internal_area->element_data_size,
+		                     element_data_flags,
+		                     number_of_cache_entries );
+	}
 	if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
 	{
-		if( internal_area->calculate_cache_entry_index == NULL )
-		{
-			cache_entry_index = element_index % number_of_cache_entries;
-		}
-		else
-		{
-			cache_entry_index = internal_area->calculate_cache_entry_index(
-			                     element_index,
-			                     element_data_file_index,
-			                     element_data_offset,
-			                     internal_area->element_data_size,
-			                     element_data_flags,
-			                     number_of_cache_entries );
-		}
 		if( libfcache_cache_get_value_by_index(
 		     cache,
 		     cache_entry_index,
@@ -1160,20 +1162,6 @@ int libfdata_area_get_element_value_at_offset(
 
 			return( -1 );
 		}
-		if( internal_area->calculate_cache_entry_index == NULL )
-		{
-			cache_entry_index = element_index % number_of_cache_entries;
-		}
-		else
-		{
-			cache_entry_index = internal_area->calculate_cache_entry_index(
-			                     element_index,
-			                     element_data_file_index,
-			                     element_data_offset,
-			                     internal_area->element_data_size,
-			                     element_data_flags,
-			                     number_of_cache_entries );
-		}
 		if( libfcache_cache_get_value_by_index(
 		     cache,
 		     cache_entry_index,
@@ -24,11 +24,15 @@
 #include <types.h>
 
 #include "libfdata_btree.h"
+#include "libfdata_btree_key_value_filter.h"
+#include "libfdata_btree_key_value_index.h"
+#include "libfdata_btree_leaf_count_table.h"
 #include "libfdata_btree_node.h"
 #include "libfdata_btree_range.h"
 #include "libfdata_definitions.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libcnotify.h"
+#include "libfdata_libcthreads.h"
 #include "libfdata_libfcache.h"
 #include "libfdata_types.h"
 #include "libfdata_unused.h"
@@ -145,6 +149,34 @@ int libfdata_btree_initialize(
 
 		goto on_error;
 	}
+	if( libfdata_btree_leaf_count_table_initialize(
+	     &( internal_tree->leaf_count_table ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create leaf count table.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( internal_tree->cache_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	if( libfcache_date_time_get_timestamp(
 	     &( internal_tree->timestamp ),
 	     error ) != 1 )
@@ -174,6 +206,20 @@ int libfdata_btree_initialize(
 on_error:
 	if( internal_tree != NULL )
 	{
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+		if( internal_tree->cache_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_tree->cache_mutex ),
+			 NULL );
+		}
+#endif
+		if( internal_tree->leaf_count_table != NULL )
+		{
+			libfdata_btree_leaf_count_table_free(
+			 &( internal_tree->leaf_count_table ),
+			 NULL );
+		}
 		if( internal_tree->root_node_data_range != NULL )
 		{
 			libfdata_btree_range_free(
@@ -226,6 +272,50 @@ int libfdata_btree_free(
 
 			result = -1;
 		}
+		if( libfdata_btree_leaf_count_table_free(
+		     &( internal_tree->leaf_count_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free leaf count table.",
+			 function );
+
+			result = -1;
+		}
+		if( internal_tree->key_value_index != NULL )
+		{
+			if( libfdata_btree_key_value_index_free(
+			     &( internal_tree->key_value_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free key value index.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( internal_tree->cache_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free cache mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		if( ( internal_tree->flags & LIBFDATA_DATA_HANDLE_FLAG_MANAGED ) != 0 )
 		{
 			if( internal_tree->data_handle != NULL )
@@ -428,6 +518,53 @@ int libfdata_btree_clone(
 
 		goto on_error;
 	}
+	if( libfdata_btree_leaf_count_table_initialize(
+	     &( internal_destination_tree->leaf_count_table ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination leaf count table.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( internal_destination_tree->cache_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( internal_source_tree->key_value_index != NULL )
+	{
+		if( libfdata_btree_key_value_index_initialize(
+		     &( internal_destination_tree->key_value_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination key value index.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	internal_destination_tree->maximum_number_of_threads = internal_source_tree->maximum_number_of_threads;
+	internal_destination_tree->key_value_hash_function   = internal_source_tree->key_value_hash_function;
+
 	if( libfcache_date_time_get_timestamp(
 	     &( internal_destination_tree->timestamp ),
 	     error ) != 1 )
@@ -448,6 +585,26 @@ int libfdata_btree_clone(
 on_error:
 	if( internal_destination_tree != NULL )
 	{
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+		if( internal_destination_tree->cache_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_destination_tree->cache_mutex ),
+			 NULL );
+		}
+#endif
+		if( internal_destination_tree->key_value_index != NULL )
+		{
+			libfdata_btree_key_value_index_free(
+			 &( internal_destination_tree->key_value_index ),
+			 NULL );
+		}
+		if( internal_destination_tree->leaf_count_table != NULL )
+		{
+			libfdata_btree_leaf_count_table_free(
+			 &( internal_destination_tree->leaf_count_table ),
+			 NULL );
+		}
 		if( internal_destination_tree->root_node_data_range != NULL )
 		{
 			libfdata_btree_range_free(
@@ -467,30 +624,22 @@ on_error:
 	return( -1 );
 }
 
-/* Cache entry functions
- */
-
-/* Calculated the node cache entry index
+/* Sets the maximum number of threads used to read sub trees
+ * A value of 0 or 1 reads the sub trees on the calling thread
+ *
+ * If more than 1 thread is used the read node function is called from
+ * multiple threads at the same time and must be safe to do so
+ * The value is ignored if multi-thread support is not available
+ *
  * Returns 1 if successful or -1 on error
  */
-int libfdata_btree_calculate_node_cache_entry_index(
+int libfdata_btree_set_maximum_number_of_threads(
      libfdata_btree_t *tree,
-     libfcache_cache_t *cache,
-     int level LIBFDATA_ATTRIBUTE_UNUSED,
-     int node_data_file_index LIBFDATA_ATTRIBUTE_UNUSED,
-     off64_t node_data_offset,
-     size64_t node_data_size LIBFDATA_ATTRIBUTE_UNUSED,
-     uint32_t node_data_flags LIBFDATA_ATTRIBUTE_UNUSED,
-     int *cache_entry_index,
+     int maximum_number_of_threads,
      libcerror_error_t **error )
 {
-	static char *function       = "libfdata_btree_calculate_node_cache_entry_index";
-	int number_of_cache_entries = 0;
-
-	LIBFDATA_UNREFERENCED_PARAMETER( level );
-	LIBFDATA_UNREFERENCED_PARAMETER( node_data_file_index );
-	LIBFDATA_UNREFERENCED_PARAMETER( node_data_size );
-	LIBFDATA_UNREFERENCED_PARAMETER( node_data_flags );
+	libfdata_internal_btree_t *internal_tree = NULL;
+	static char *function                    = "libfdata_btree_set_maximum_number_of_threads";
 
 	if( tree == NULL )
 	{
@@ -503,85 +652,148 @@ int libfdata_btree_calculate_node_cache_entry_index(
 
 		return( -1 );
 	}
-	if( cache_entry_index == NULL )
+	internal_tree = (libfdata_internal_btree_t *) tree;
+
+	if( maximum_number_of_threads < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid cache entry index.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of threads value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfcache_cache_get_number_of_entries(
-	     cache,
-	     &number_of_cache_entries,
-	     error ) != 1 )
+	internal_tree->maximum_number_of_threads = maximum_number_of_threads;
+
+	return( 1 );
+}
+
+/* Sets the key value hash function
+ * The key value hash function is used to build a key value filter for every
+ * leaf node that is read, which allows to reject key values that are not
+ * in a leaf node without comparing them to its leaf values
+ *
+ * Key values that compare as equal must have the same hash, including the
+ * key values passed to the functions that retrieve a leaf value by key
+ * The function should be set before the tree is read, since the key value
+ * filters are only built when a leaf node is read
+ * Set the function to NULL to disable the key value filters
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_set_key_value_hash_function(
+     libfdata_btree_t *tree,
+     int (*key_value_hash_function)(
+            intptr_t *key_value,
+            uint32_t *key_value_hash,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	libfdata_internal_btree_t *internal_tree = NULL;
+	static char *function                    = "libfdata_btree_set_key_value_hash_function";
+
+	if( tree == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of cache entries.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_cache_entries <= 0 )
+	internal_tree = (libfdata_internal_btree_t *) tree;
+
+	internal_tree->key_value_hash_function = key_value_hash_function;
+
+	if( internal_tree->key_value_index != NULL )
+	{
+		if( libfdata_btree_key_value_index_empty(
+		     internal_tree->key_value_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to empty key value index.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Enables the key value index
+ * The key value index maps the hashes of the key values to leaf values, so that
+ * exact matches can be retrieved without comparing the key values of the branch nodes
+ * The index is filled as the leaf values are mapped, when leaf nodes are read
+ * or leaf values are retrieved by index, and requires a key value hash function
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_enable_key_value_index(
+     libfdata_btree_t *tree,
+     libcerror_error_t **error )
+{
+	libfdata_internal_btree_t *internal_tree = NULL;
+	static char *function                    = "libfdata_btree_enable_key_value_index";
+
+	if( tree == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid number of cache entries value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
 		 function );
 
 		return( -1 );
 	}
-/* TODO improve cache entry index calculation */
-	if( number_of_cache_entries <= 4 )
-	{
-		*cache_entry_index = node_data_offset % number_of_cache_entries;
-	}
-	else if( level == 0 )
-	{
-		*cache_entry_index = 0;
-	}
-	else
-	{
-		*cache_entry_index = 1;
+	internal_tree = (libfdata_internal_btree_t *) tree;
 
-		/* Use 3/4 of the cache for the nodes
-		 */
-		number_of_cache_entries = ( ( number_of_cache_entries - 1 ) / 4 ) * 3;
+	if( internal_tree->key_value_index == NULL )
+	{
+		if( libfdata_btree_key_value_index_initialize(
+		     &( internal_tree->key_value_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create key value index.",
+			 function );
 
-		*cache_entry_index += node_data_offset % number_of_cache_entries;
+			return( -1 );
+		}
 	}
 	return( 1 );
 }
 
-/* Calculated the leaf value cache entry index
+/* Builds the key value index
+ * Enables the key value index if necessary and inserts the key values of all
+ * leaf values. A key value that is not in a complete index is not in the tree.
  * Returns 1 if successful or -1 on error
  */
-int libfdata_btree_calculate_leaf_value_cache_entry_index(
+int libfdata_btree_build_key_value_index(
      libfdata_btree_t *tree,
+     intptr_t *file_io_handle,
      libfcache_cache_t *cache,
-     int leaf_value_index LIBFDATA_ATTRIBUTE_UNUSED,
-     int leaf_value_data_file_index LIBFDATA_ATTRIBUTE_UNUSED,
-     off64_t leaf_value_data_offset,
-     size64_t leaf_value_data_size LIBFDATA_ATTRIBUTE_UNUSED,
-     uint32_t leaf_value_data_flags LIBFDATA_ATTRIBUTE_UNUSED,
-     int *cache_entry_index,
+     uint8_t read_flags,
      libcerror_error_t **error )
 {
-	static char *function       = "libfdata_btree_calculate_leaf_value_cache_entry_index";
-	int number_of_cache_entries = 0;
-
-	LIBFDATA_UNREFERENCED_PARAMETER( leaf_value_index );
-	LIBFDATA_UNREFERENCED_PARAMETER( leaf_value_data_file_index );
-	LIBFDATA_UNREFERENCED_PARAMETER( leaf_value_data_size );
-	LIBFDATA_UNREFERENCED_PARAMETER( leaf_value_data_flags );
+	libfdata_btree_node_t *leaf_node              = NULL;
+	libfdata_btree_range_t *leaf_value_data_range = NULL;
+	libfdata_internal_btree_t *internal_tree      = NULL;
+	static char *function                         = "libfdata_btree_build_key_value_index";
+	int leaf_value_index                          = 0;
+	int node_leaf_value_index                     = 0;
+	int number_of_leaf_values                     = 0;
+	int number_of_node_leaf_values                = 0;
 
 	if( tree == NULL )
 	{
@@ -594,36 +806,322 @@ int libfdata_btree_calculate_leaf_value_cache_entry_index(
 
 		return( -1 );
 	}
-	if( cache_entry_index == NULL )
+	internal_tree = (libfdata_internal_btree_t *) tree;
+
+	if( internal_tree->key_value_hash_function == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid cache entry index.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid tree - missing key value hash function.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfcache_cache_get_number_of_entries(
-	     cache,
-	     &number_of_cache_entries,
+	if( libfdata_btree_enable_key_value_index(
+	     tree,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of cache entries.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to enable key value index.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_cache_entries <= 0 )
+	if( internal_tree->key_value_index->is_complete != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		return( 1 );
+	}
+	if( libfdata_btree_get_number_of_leaf_values(
+	     tree,
+	     file_io_handle,
+	     cache,
+	     &number_of_leaf_values,
+	     read_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of leaf values.",
+		 function );
+
+		return( -1 );
+	}
+	/* The leaf values are inserted per leaf node, so that every leaf node
+	 * only needs to be looked up once
+	 */
+	while( leaf_value_index < number_of_leaf_values )
+	{
+		if( libfdata_btree_get_leaf_node_by_index(
+		     internal_tree,
+		     file_io_handle,
+		     cache,
+		     internal_tree->root_node_data_range,
+		     0,
+		     leaf_value_index,
+		     &leaf_node,
+		     &node_leaf_value_index,
+		     read_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve leaf node of leaf value: %d.",
+			 function,
+			 leaf_value_index );
+
+			return( -1 );
+		}
+		if( libfdata_btree_node_get_number_of_leaf_values(
+		     leaf_node,
+		     &number_of_node_leaf_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of leaf values.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( node_leaf_value_index < 0 )
+		 || ( node_leaf_value_index >= number_of_node_leaf_values ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid node leaf value index value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		while( ( node_leaf_value_index < number_of_node_leaf_values )
+		    && ( leaf_value_index < number_of_leaf_values ) )
+		{
+			if( libfdata_btree_node_get_leaf_value_data_range_by_index(
+			     leaf_node,
+			     node_leaf_value_index,
+			     &leaf_value_data_range,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve leaf value: %d data range.",
+				 function,
+				 node_leaf_value_index );
+
+				return( -1 );
+			}
+			if( leaf_value_data_range == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing leaf value: %d data range.",
+				 function,
+				 node_leaf_value_index );
+
+				return( -1 );
+			}
+			leaf_value_data_range->mapped_first_leaf_value_index = leaf_value_index;
+			leaf_value_data_range->mapped_last_leaf_value_index  = -1;
+			leaf_value_data_range->mapped_number_of_leaf_values  = 1;
+
+			if( libfdata_btree_insert_key_value_in_index(
+			     internal_tree,
+			     leaf_value_data_range,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert key value of leaf value: %d in index.",
+				 function,
+				 leaf_value_index );
+
+				return( -1 );
+			}
+			node_leaf_value_index++;
+			leaf_value_index++;
+		}
+	}
+	internal_tree->key_value_index->is_complete = 1;
+
+	return( 1 );
+}
+
+/* Cache entry functions
+ */
+
+/* Calculated the node cache entry index
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_calculate_node_cache_entry_index(
+     libfdata_btree_t *tree,
+     libfcache_cache_t *cache,
+     int level LIBFDATA_ATTRIBUTE_UNUSED,
+     int node_data_file_index LIBFDATA_ATTRIBUTE_UNUSED,
+     off64_t node_data_offset,
+     size64_t node_data_size LIBFDATA_ATTRIBUTE_UNUSED,
+     uint32_t node_data_flags LIBFDATA_ATTRIBUTE_UNUSED,
+     int *cache_entry_index,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfdata_btree_calculate_node_cache_entry_index";
+	int number_of_cache_entries = 0;
+
+	LIBFDATA_UNREFERENCED_PARAMETER( level );
+	LIBFDATA_UNREFERENCED_PARAMETER( node_data_file_index );
+	LIBFDATA_UNREFERENCED_PARAMETER( node_data_size );
+	LIBFDATA_UNREFERENCED_PARAMETER( node_data_flags );
+
+	if( tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( cache_entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache entry index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cache entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+/* TODO improve cache entry index calculation */
+	if( number_of_cache_entries <= 4 )
+	{
+		*cache_entry_index = node_data_offset % number_of_cache_entries;
+	}
+	else if( level == 0 )
+	{
+		*cache_entry_index = 0;
+	}
+	else
+	{
+		*cache_entry_index = 1;
+
+		/* Use 3/4 of the cache for the nodes
+		 */
+		number_of_cache_entries = ( ( number_of_cache_entries - 1 ) / 4 ) * 3;
+
+		*cache_entry_index += node_data_offset % number_of_cache_entries;
+	}
+	return( 1 );
+}
+
+/* Calculated the leaf value cache entry index
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_calculate_leaf_value_cache_entry_index(
+     libfdata_btree_t *tree,
+     libfcache_cache_t *cache,
+     int leaf_value_index LIBFDATA_ATTRIBUTE_UNUSED,
+     int leaf_value_data_file_index LIBFDATA_ATTRIBUTE_UNUSED,
+     off64_t leaf_value_data_offset,
+     size64_t leaf_value_data_size LIBFDATA_ATTRIBUTE_UNUSED,
+     uint32_t leaf_value_data_flags LIBFDATA_ATTRIBUTE_UNUSED,
+     int *cache_entry_index,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfdata_btree_calculate_leaf_value_cache_entry_index";
+	int number_of_cache_entries = 0;
+
+	LIBFDATA_UNREFERENCED_PARAMETER( leaf_value_index );
+	LIBFDATA_UNREFERENCED_PARAMETER( leaf_value_data_file_index );
+	LIBFDATA_UNREFERENCED_PARAMETER( leaf_value_data_size );
+	LIBFDATA_UNREFERENCED_PARAMETER( leaf_value_data_flags );
+
+	if( tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( cache_entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache entry index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
 		 "%s: invalid number of cache entries value out of bounds.",
 		 function );
@@ -780,21 +1278,50 @@ int libfdata_btree_set_root_node(
 
 		return( -1 );
 	}
-	if( libfcache_date_time_get_timestamp(
-	     &( internal_tree->timestamp ),
+	if( libfdata_btree_leaf_count_table_empty(
+	     internal_tree->leaf_count_table,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve cache timestamp.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to empty leaf count table.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-}
+	if( internal_tree->key_value_index != NULL )
+	{
+		if( libfdata_btree_key_value_index_empty(
+		     internal_tree->key_value_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to empty key value index.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libfcache_date_time_get_timestamp(
+	     &( internal_tree->timestamp ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
 
 /* Leaf value functions
  */
@@ -1081,18 +1608,13 @@ int libfdata_btree_read_node(
      uint8_t read_flags,
      libcerror_error_t **error )
 {
-	libfcache_cache_value_t *cache_value = NULL;
-	intptr_t *key_value                  = NULL;
-	static char *function                = "libfdata_btree_read_node";
-	off64_t cache_value_offset           = 0;
-	off64_t node_data_offset             = 0;
-	size64_t node_data_size              = 0;
-	time_t cache_value_timestamp         = 0;
-	uint32_t node_data_flags             = 0;
-	int cache_entry_index                = -1;
-	int cache_value_file_index           = -1;
-	int node_data_file_index             = -1;
-	int result                           = 0;
+	intptr_t *key_value      = NULL;
+	static char *function    = "libfdata_btree_read_node";
+	off64_t node_data_offset = 0;
+	size64_t node_data_size  = 0;
+	uint32_t node_data_flags = 0;
+	int node_data_file_index = -1;
+	int result               = 0;
 
 	if( internal_tree == NULL )
 	{
@@ -1151,6 +1673,33 @@ int libfdata_btree_read_node(
 	}
 	*node = NULL;
 
+	if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
+	{
+		result = libfdata_btree_get_node_from_cache(
+		          internal_tree,
+		          cache,
+		          node_data_range,
+		          level,
+		          node,
+		          read_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve node from cache.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			return( 1 );
+		}
+	}
 	if( libfdata_btree_range_get(
 	     node_data_range,
 	     &node_data_file_index,
@@ -1169,189 +1718,245 @@ int libfdata_btree_read_node(
 
 		goto on_error;
 	}
-	if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
 	{
-		if( internal_tree->calculate_node_cache_entry_index(
-		     (libfdata_btree_t *) internal_tree,
+		libcnotify_printf(
+		 "%s: reading node at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIu64 "\n",
+		 function,
+		 node_data_offset,
+		 node_data_offset,
+		 node_data_size );
+	}
+#endif
+	if( libfdata_btree_node_initialize(
+	     node,
+	     level,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create node at level: %d.",
+		 function,
+		 level );
+
+		goto on_error;
+	}
+	if( internal_tree->read_node(
+	     internal_tree->data_handle,
+	     file_io_handle,
+	     *node,
+	     node_data_file_index,
+	     node_data_offset,
+	     node_data_size,
+	     node_data_flags,
+	     key_value,
+	     read_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read node at offset: %" PRIi64 ".",
+		 function,
+		 node_data_offset );
+
+		goto on_error;
+	}
+	if( libfdata_btree_build_key_value_filter(
+	     internal_tree,
+	     node_data_range,
+	     *node,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build key value filter.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( read_flags & LIBFDATA_READ_FLAG_NO_CACHE ) == 0 )
+	{
+		if( libfdata_btree_set_node_in_cache(
+		     internal_tree,
 		     cache,
+		     node_data_range,
 		     level,
-		     node_data_file_index,
-		     node_data_offset,
-		     node_data_size,
-		     node_data_flags,
-		     &cache_entry_index,
+		     *node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to calculate cache entry index.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set node in cache.",
 			 function );
 
 			goto on_error;
 		}
-		if( libfcache_cache_get_value_by_index(
-		     cache,
-		     cache_entry_index,
-		     &cache_value,
+	}
+	return( 1 );
+
+on_error:
+	if( *node != NULL )
+	{
+		libfdata_btree_node_free(
+		 node,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the node identified by the data range from the cache
+ * If the LIBFDATA_READ_FLAG_NO_CACHE flag is set the node is removed from
+ * the cache and the caller takes over management of the node
+ * Returns 1 if successful, 0 if the node is not cached or -1 on error
+ */
+int libfdata_btree_get_node_from_cache(
+     libfdata_internal_btree_t *internal_tree,
+     libfcache_cache_t *cache,
+     libfdata_btree_range_t *node_data_range,
+     int level,
+     libfdata_btree_node_t **node,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value = NULL;
+	intptr_t *key_value                  = NULL;
+	static char *function                = "libfdata_btree_get_node_from_cache";
+	off64_t cache_value_offset           = 0;
+	off64_t node_data_offset             = 0;
+	size64_t node_data_size              = 0;
+	time_t cache_value_timestamp         = 0;
+	uint32_t node_data_flags             = 0;
+	int cache_entry_index                = -1;
+	int cache_value_file_index           = -1;
+	int node_data_file_index             = -1;
+	int result                           = 0;
+
+	if( internal_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_btree_range_get(
+	     node_data_range,
+	     &node_data_file_index,
+	     &node_data_offset,
+	     &node_data_size,
+	     &node_data_flags,
+	     &key_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve node data range values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_tree->calculate_node_cache_entry_index(
+	     (libfdata_btree_t *) internal_tree,
+	     cache,
+	     level,
+	     node_data_file_index,
+	     node_data_offset,
+	     node_data_size,
+	     node_data_flags,
+	     &cache_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate cache entry index.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_tree->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfcache_cache_get_value_by_index(
+	     cache,
+	     cache_entry_index,
+	     &cache_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache entry: %d from cache.",
+		 function,
+		 cache_entry_index );
+
+		result = -1;
+	}
+	else if( cache_value != NULL )
+	{
+		if( libfcache_cache_value_get_identifier(
+		     cache_value,
+		     &cache_value_file_index,
+		     &cache_value_offset,
+		     &cache_value_timestamp,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve cache entry: %d from cache.",
-			 function,
-			 cache_entry_index );
+			 "%s: unable to retrieve cache value identifier.",
+			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( cache_value != NULL )
+		else if( ( node_data_file_index == cache_value_file_index )
+		      && ( node_data_offset == cache_value_offset )
+		      && ( internal_tree->timestamp == cache_value_timestamp ) )
 		{
-			if( libfcache_cache_value_get_identifier(
-			     cache_value,
-			     &cache_value_file_index,
-			     &cache_value_offset,
-			     &cache_value_timestamp,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve cache value identifier.",
-				 function );
-
-				goto on_error;
-			}
-		}
-		if( ( node_data_file_index == cache_value_file_index )
-		 && ( node_data_offset == cache_value_offset )
-		 && ( internal_tree->timestamp == cache_value_timestamp ) )
-		{
-			result = 1;
-		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			if( result == 0 )
-			{
-				libcnotify_printf(
-				 "%s: cache: 0x%08" PRIjx " miss (entry: %d, want: %" PRIi64 ", got: %" PRIi64 ")\n",
-				 function,
-				 (intptr_t) cache,
-				 cache_entry_index,
-				 node_data_offset,
-				 cache_value_offset );
-			}
-			else
-			{
-				libcnotify_printf(
-				 "%s: cache: 0x%08" PRIjx " hit (entry: %d)\n",
-				 function,
-				 (intptr_t) cache,
-				 cache_entry_index );
-			}
-		}
-#endif
-	}
-	if( result == 0 )
-	{
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: reading node at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIu64 "\n",
-			 function,
-			 node_data_offset,
-			 node_data_offset,
-			 node_data_size );
-		}
-#endif
-		if( libfdata_btree_node_initialize(
-		     node,
-		     level,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create node at level: %d.",
-			 function,
-			 level );
-
-			goto on_error;
-		}
-		if( internal_tree->read_node(
-		     internal_tree->data_handle,
-		     file_io_handle,
-		     *node,
-		     node_data_file_index,
-		     node_data_offset,
-		     node_data_size,
-		     node_data_flags,
-		     key_value,
-		     read_flags,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read node at offset: %" PRIi64 ".",
-			 function,
-			 node_data_offset );
-
-			goto on_error;
-		}
-		if( ( read_flags & LIBFDATA_READ_FLAG_NO_CACHE ) == 0 )
-		{
-			if( internal_tree->calculate_node_cache_entry_index(
-			     (libfdata_btree_t *) internal_tree,
-			     cache,
-			     level,
-			     node_data_file_index,
-			     node_data_offset,
-			     node_data_size,
-			     node_data_flags,
-			     &cache_entry_index,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to calculate cache entry index.",
-				 function );
-
-				goto on_error;
-			}
-			if( libfcache_cache_set_value_by_index(
-			     cache,
-			     cache_entry_index,
-			     node_data_file_index,
-			     node_data_offset,
-			     internal_tree->timestamp,
-			     (intptr_t *) *node,
-			     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_btree_node_free,
-			     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set node in cache entry: %d.",
-				 function,
-				 cache_entry_index );
-
-				goto on_error;
-			}
+			result = 1;
 		}
 	}
-	else
+	if( result == 1 )
 	{
 		if( libfcache_cache_value_get_value(
 		     cache_value,
@@ -1367,9 +1972,9 @@ int libfdata_btree_read_node(
 
 			*node = NULL;
 
-			goto on_error;
+			result = -1;
 		}
-		if( ( read_flags & LIBFDATA_READ_FLAG_NO_CACHE ) != 0 )
+		else if( ( read_flags & LIBFDATA_READ_FLAG_NO_CACHE ) != 0 )
 		{
 			/* Remove the node from the cache
 			 */
@@ -1386,52 +1991,71 @@ int libfdata_btree_read_node(
 
 				*node = NULL;
 
-				goto on_error;
+				result = -1;
 			}
 		}
 	}
-	return( 1 );
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_tree->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
 
-on_error:
-	if( *node != NULL )
+		return( -1 );
+	}
+#endif
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
 	{
-		libfdata_btree_node_free(
-		 node,
-		 NULL );
+		if( result == 0 )
+		{
+			libcnotify_printf(
+			 "%s: cache: 0x%08" PRIjx " miss (entry: %d, want: %" PRIi64 ", got: %" PRIi64 ")\n",
+			 function,
+			 (intptr_t) cache,
+			 cache_entry_index,
+			 node_data_offset,
+			 cache_value_offset );
+		}
+		else if( result == 1 )
+		{
+			libcnotify_printf(
+			 "%s: cache: 0x%08" PRIjx " hit (entry: %d)\n",
+			 function,
+			 (intptr_t) cache,
+			 cache_entry_index );
+		}
 	}
-	return( -1 );
+#endif
+	return( result );
 }
 
-/* Reads the sub tree
+/* Sets a node in the cache
+ * The cache takes over management of the node
  * Returns 1 if successful or -1 on error
  */
-int libfdata_btree_read_sub_tree(
+int libfdata_btree_set_node_in_cache(
      libfdata_internal_btree_t *internal_tree,
-     intptr_t *file_io_handle,
      libfcache_cache_t *cache,
      libfdata_btree_range_t *node_data_range,
      int level,
-     int mapped_first_leaf_value_index,
-     libfdata_btree_node_t **node,
-     uint8_t read_flags,
+     libfdata_btree_node_t *node,
      libcerror_error_t **error )
 {
-	libfdata_btree_range_t *leaf_value_data_range = NULL;
-	libfdata_btree_range_t *sub_node_data_range   = NULL;
-	libfdata_btree_node_t *sub_node               = NULL;
-	intptr_t *key_value                           = NULL;
-	static char *function                         = "libfdata_btree_read_sub_tree";
-	off64_t node_data_offset                      = 0;
-	size64_t node_data_size                       = 0;
-	uint32_t node_data_flags                      = 0;
-	int branch_number_of_leaf_values              = 0;
-	int cache_entry_index                         = -1;
-	int leaf_value_index                          = 0;
-	int node_data_file_index                      = -1;
-	int number_of_leaf_values                     = 0;
-	int number_of_sub_nodes                       = 0;
-	int result                                    = 0;
-	int sub_node_index                            = 0;
+	intptr_t *key_value      = NULL;
+	static char *function    = "libfdata_btree_set_node_in_cache";
+	off64_t node_data_offset = 0;
+	size64_t node_data_size  = 0;
+	uint32_t node_data_flags = 0;
+	int cache_entry_index    = -1;
+	int node_data_file_index = -1;
+	int result               = 1;
 
 	if( internal_tree == NULL )
 	{
@@ -1444,30 +2068,17 @@ int libfdata_btree_read_sub_tree(
 
 		return( -1 );
 	}
-	if( level < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid level value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
 	if( node == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing node.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
 		 function );
 
 		return( -1 );
 	}
-	/* Note that the node data range can be cached out later in the function.
-	 */
 	if( libfdata_btree_range_get(
 	     node_data_range,
 	     &node_data_file_index,
@@ -1481,270 +2092,1899 @@ int libfdata_btree_read_sub_tree(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve data range from tree node.",
+		 "%s: unable to retrieve node data range values.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	/* Make sure to not have the node cached here to prevent it from
-	 * being freed during recursing the sub tree.
-	 */
-	if( libfdata_btree_read_node(
-	     internal_tree,
-	     file_io_handle,
+	if( internal_tree->calculate_node_cache_entry_index(
+	     (libfdata_btree_t *) internal_tree,
 	     cache,
-	     node_data_range,
 	     level,
-	     node,
-	     read_flags | LIBFDATA_READ_FLAG_NO_CACHE,
+	     node_data_file_index,
+	     node_data_offset,
+	     node_data_size,
+	     node_data_flags,
+	     &cache_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate cache entry index.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_tree->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfcache_cache_set_value_by_index(
+	     cache,
+	     cache_entry_index,
+	     node_data_file_index,
+	     node_data_offset,
+	     internal_tree->timestamp,
+	     (intptr_t *) node,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_btree_node_free,
+	     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set node in cache entry: %d.",
+		 function,
+		 cache_entry_index );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_tree->cache_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read node.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets a branch node in the cache unless its cache entry holds the leaf node
+ * The cache takes over management of the branch node if set
+ * Returns 1 if successful, 0 if the branch node was not set or -1 on error
+ */
+int libfdata_btree_set_branch_node_in_cache(
+     libfdata_internal_btree_t *internal_tree,
+     libfcache_cache_t *cache,
+     libfdata_btree_range_t *node_data_range,
+     int level,
+     libfdata_btree_node_t *node,
+     libfdata_btree_node_t *leaf_node,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value = NULL;
+	intptr_t *cache_value_node           = NULL;
+	intptr_t *key_value                  = NULL;
+	static char *function                = "libfdata_btree_set_branch_node_in_cache";
+	off64_t node_data_offset             = 0;
+	size64_t node_data_size              = 0;
+	uint32_t node_data_flags             = 0;
+	int cache_entry_index                = -1;
+	int node_data_file_index             = -1;
+	int result                           = 1;
+
+	if( internal_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_btree_range_get(
+	     node_data_range,
+	     &node_data_file_index,
+	     &node_data_offset,
+	     &node_data_size,
+	     &node_data_flags,
+	     &key_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve node data range values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_tree->calculate_node_cache_entry_index(
+	     (libfdata_btree_t *) internal_tree,
+	     cache,
+	     level,
+	     node_data_file_index,
+	     node_data_offset,
+	     node_data_size,
+	     node_data_flags,
+	     &cache_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate cache entry index.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_tree->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfcache_cache_get_value_by_index(
+	     cache,
+	     cache_entry_index,
+	     &cache_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache entry: %d from cache.",
+		 function,
+		 cache_entry_index );
+
+		result = -1;
+	}
+	else if( cache_value != NULL )
+	{
+		if( libfcache_cache_value_get_value(
+		     cache_value,
+		     &cache_value_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve node value from cache.",
+			 function );
+
+			result = -1;
+		}
+		else if( ( leaf_node != NULL )
+		      && ( cache_value_node == (intptr_t *) leaf_node ) )
+		{
+			/* Replacing the cache value would free the leaf node
+			 */
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libfcache_cache_set_value_by_index(
+		     cache,
+		     cache_entry_index,
+		     node_data_file_index,
+		     node_data_offset,
+		     internal_tree->timestamp,
+		     (intptr_t *) node,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_btree_node_free,
+		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set node in cache entry: %d.",
+			 function,
+			 cache_entry_index );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_tree->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of leaf values of the sub tree of a node from the leaf count table
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfdata_btree_get_leaf_count(
+     libfdata_internal_btree_t *internal_tree,
+     libfdata_btree_range_t *node_data_range,
+     int *number_of_leaf_values,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_btree_get_leaf_count";
+	int result            = 0;
+
+	if( internal_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_data_range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node data range.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_tree->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libfdata_btree_leaf_count_table_get_number_of_leaf_values(
+	          internal_tree->leaf_count_table,
+	          node_data_range->file_index,
+	          node_data_range->offset,
+	          number_of_leaf_values,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of leaf values from leaf count table.",
+		 function );
+	}
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_tree->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the number of leaf values of the sub tree of a node in the leaf count table
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_set_leaf_count(
+     libfdata_internal_btree_t *internal_tree,
+     libfdata_btree_range_t *node_data_range,
+     int number_of_leaf_values,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_btree_set_leaf_count";
+	int result            = 1;
+
+	if( internal_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_data_range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node data range.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_tree->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfdata_btree_leaf_count_table_set_number_of_leaf_values(
+	     internal_tree->leaf_count_table,
+	     node_data_range->file_index,
+	     node_data_range->offset,
+	     number_of_leaf_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of leaf values in leaf count table.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_tree->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Builds the key value filter of a leaf node
+ * The key value filter is stored in the node data range, so that it remains
+ * available after the leaf node has been removed from the cache
+ * Returns 1 if successful, 0 if no key value filter was built or -1 on error
+ */
+int libfdata_btree_build_key_value_filter(
+     libfdata_internal_btree_t *internal_tree,
+     libfdata_btree_range_t *node_data_range,
+     libfdata_btree_node_t *node,
+     libcerror_error_t **error )
+{
+	libfdata_btree_key_value_filter_t *key_value_filter = NULL;
+	libfdata_btree_range_t *leaf_value_data_range       = NULL;
+	static char *function                               = "libfdata_btree_build_key_value_filter";
+	uint32_t key_value_hash                             = 0;
+	int leaf_value_index                                = 0;
+	int number_of_leaf_values                           = 0;
+	int result                                          = 0;
+
+	if( internal_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_data_range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node data range.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_tree->key_value_hash_function == NULL )
+	 || ( node_data_range->key_value_filter != NULL ) )
+	{
+		return( 0 );
+	}
+	result = libfdata_btree_node_is_leaf(
+	          node,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if node is a leaf node.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libfdata_btree_node_get_number_of_leaf_values(
+	     node,
+	     &number_of_leaf_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of leaf values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_btree_key_value_filter_initialize(
+	     &key_value_filter,
+	     number_of_leaf_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create key value filter.",
+		 function );
+
+		goto on_error;
+	}
+	for( leaf_value_index = 0;
+	     leaf_value_index < number_of_leaf_values;
+	     leaf_value_index++ )
+	{
+		if( libfdata_btree_node_get_leaf_value_data_range_by_index(
+		     node,
+		     leaf_value_index,
+		     &leaf_value_data_range,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve leaf value: %d data range.",
+			 function,
+			 leaf_value_index );
+
+			goto on_error;
+		}
+		if( leaf_value_data_range == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing leaf value: %d data range.",
+			 function,
+			 leaf_value_index );
+
+			goto on_error;
+		}
+		/* A leaf value without a key value cannot be represented in the filter
+		 */
+		if( leaf_value_data_range->key_value == NULL )
+		{
+			libfdata_btree_key_value_filter_free(
+			 &key_value_filter,
+			 NULL );
+
+			return( 0 );
+		}
+		if( internal_tree->key_value_hash_function(
+		     leaf_value_data_range->key_value,
+		     &key_value_hash,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve hash of leaf value: %d key value.",
+			 function,
+			 leaf_value_index );
+
+			goto on_error;
+		}
+		if( libfdata_btree_key_value_filter_insert(
+		     key_value_filter,
+		     key_value_hash,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert leaf value: %d key value hash into key value filter.",
+			 function,
+			 leaf_value_index );
+
+			goto on_error;
+		}
+	}
+	node_data_range->key_value_filter = key_value_filter;
+
+	return( 1 );
+
+on_error:
+	if( key_value_filter != NULL )
+	{
+		libfdata_btree_key_value_filter_free(
+		 &key_value_filter,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Determines if the leaf node identified by the data range can contain a specific key value
+ * The key value filter of the node data range is used if available
+ * Returns 1 if the leaf node can contain the key value, 0 if not or -1 on error
+ */
+int libfdata_btree_leaf_node_can_contain_key_value(
+     libfdata_internal_btree_t *internal_tree,
+     libfdata_btree_range_t *node_data_range,
+     intptr_t *key_value,
+     libcerror_error_t **error )
+{
+	static char *function   = "libfdata_btree_leaf_node_can_contain_key_value";
+	uint32_t key_value_hash = 0;
+	int result              = 0;
+
+	if( internal_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_data_range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node data range.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_tree->key_value_hash_function == NULL )
+	 || ( node_data_range->key_value_filter == NULL )
+	 || ( key_value == NULL ) )
+	{
+		return( 1 );
+	}
+	if( internal_tree->key_value_hash_function(
+	     key_value,
+	     &key_value_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve hash of key value.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfdata_btree_key_value_filter_contains(
+	          node_data_range->key_value_filter,
+	          key_value_hash,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if key value filter contains key value hash.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Inserts the key value of a mapped leaf value in the key value index
+ * Does nothing if the key value index is not enabled
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_insert_key_value_in_index(
+     libfdata_internal_btree_t *internal_tree,
+     libfdata_btree_range_t *leaf_value_data_range,
+     libcerror_error_t **error )
+{
+	static char *function   = "libfdata_btree_insert_key_value_in_index";
+	uint32_t key_value_hash = 0;
+
+	if( internal_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( leaf_value_data_range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid leaf value data range.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_tree->key_value_index == NULL )
+	 || ( internal_tree->key_value_hash_function == NULL )
+	 || ( leaf_value_data_range->key_value == NULL ) )
+	{
+		return( 1 );
+	}
+	if( internal_tree->key_value_hash_function(
+	     leaf_value_data_range->key_value,
+	     &key_value_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve hash of key value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_btree_key_value_index_insert(
+	     internal_tree->key_value_index,
+	     key_value_hash,
+	     leaf_value_data_range->mapped_first_leaf_value_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert key value hash in index.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the data range of the leaf value with a specific key value from the key value index
+ * The leaf values with a matching key value hash are retrieved by index and their
+ * key values compared, to rule out hash collisions
+ * Returns 1 if successful, 0 if not found or -1 on error
+ */
+int libfdata_btree_get_leaf_value_data_range_from_key_value_index(
+     libfdata_internal_btree_t *internal_tree,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     intptr_t *key_value,
+     int (*key_value_compare_function)(
+            intptr_t *first_key_value,
+            intptr_t *second_key_value,
+            libcerror_error_t **error ),
+     libfdata_btree_range_t **leaf_value_data_range,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfdata_btree_node_t *leaf_node = NULL;
+	static char *function            = "libfdata_btree_get_leaf_value_data_range_from_key_value_index";
+	uint32_t key_value_hash          = 0;
+	int entry_index                  = -1;
+	int leaf_value_index             = 0;
+	int node_leaf_value_index        = 0;
+	int result                       = 0;
+
+	if( internal_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_value_compare_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key value compare function.",
+		 function );
+
+		return( -1 );
+	}
+	if( leaf_value_data_range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid leaf value data range.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_tree->key_value_index == NULL )
+	 || ( internal_tree->key_value_hash_function == NULL )
+	 || ( key_value == NULL ) )
+	{
+		return( 0 );
+	}
+	if( internal_tree->key_value_hash_function(
+	     key_value,
+	     &key_value_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve hash of key value.",
+		 function );
+
+		return( -1 );
+	}
+	/* Retrieving the leaf nodes by index does not insert key values in the index
+	 * so the entry index remains valid
+	 */
+	do
+	{
+		result = libfdata_btree_key_value_index_get_next_leaf_value_index(
+		          internal_tree->key_value_index,
+		          key_value_hash,
+		          &entry_index,
+		          &leaf_value_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve leaf value index from key value index.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libfdata_btree_get_leaf_node_by_index(
+		     internal_tree,
+		     file_io_handle,
+		     cache,
+		     internal_tree->root_node_data_range,
+		     0,
+		     leaf_value_index,
+		     &leaf_node,
+		     &node_leaf_value_index,
+		     read_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve leaf node of leaf value: %d.",
+			 function,
+			 leaf_value_index );
+
+			return( -1 );
+		}
+		if( libfdata_btree_node_get_leaf_value_data_range_by_index(
+		     leaf_node,
+		     node_leaf_value_index,
+		     leaf_value_data_range,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve leaf value: %d data range.",
+			 function,
+			 node_leaf_value_index );
+
+			return( -1 );
+		}
+		if( *leaf_value_data_range == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing leaf value: %d data range.",
+			 function,
+			 node_leaf_value_index );
+
+			return( -1 );
+		}
+		result = key_value_compare_function(
+		          key_value,
+		          ( *leaf_value_data_range )->key_value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to compare key value with leaf value: %d key value.",
+			 function,
+			 leaf_value_index );
+
+			return( -1 );
+		}
+		else if( result == LIBFDATA_COMPARE_EQUAL )
+		{
+			( *leaf_value_data_range )->mapped_first_leaf_value_index = leaf_value_index;
+			( *leaf_value_data_range )->mapped_last_leaf_value_index  = -1;
+			( *leaf_value_data_range )->mapped_number_of_leaf_values  = 1;
+
+			return( 1 );
+		}
+	}
+	while( result != 0 );
+
+	*leaf_value_data_range = NULL;
+
+	return( 0 );
+}
+
+/* Reads the sub tree
+ * Maps the leaf values of the sub tree starting at the mapped first leaf value index
+ * The sub nodes of a branch node are not read if the number of leaf values in
+ * their sub trees has been determined before
+ *
+ * If the tree has a maximum number of threads larger than 1 the sub trees of
+ * the sub nodes are read in parallel
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_read_sub_tree(
+     libfdata_internal_btree_t *internal_tree,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     libfdata_btree_range_t *node_data_range,
+     int level,
+     int mapped_first_leaf_value_index,
+     libfdata_btree_node_t **node,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfdata_btree_range_t *leaf_value_data_range = NULL;
+	libfdata_btree_range_t *sub_node_data_range   = NULL;
+	libfdata_internal_btree_node_t *internal_node = NULL;
+	static char *function                         = "libfdata_btree_read_sub_tree";
+	int branch_number_of_leaf_values              = 0;
+	int leaf_value_index                          = 0;
+	int number_of_leaf_values                     = 0;
+	int number_of_sub_nodes                       = 0;
+	int result                                    = 0;
+	int sub_node_index                            = 0;
+
+	if( internal_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( level < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid level value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing node.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure to not have the node cached here to prevent it from
+	 * being freed during reading the sub trees.
+	 */
+	if( libfdata_btree_read_node(
+	     internal_tree,
+	     file_io_handle,
+	     cache,
+	     node_data_range,
+	     level,
+	     node,
+	     read_flags | LIBFDATA_READ_FLAG_NO_CACHE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read node.",
+		 function );
+
+		goto on_error;
+	}
+	if( *node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing node.",
+		 function );
+
+		goto on_error;
+	}
+	internal_node = (libfdata_internal_btree_node_t *) *node;
+
+	if( ( internal_node->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
+	{
+		result = libfdata_btree_node_is_leaf(
+			  *node,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if node is a leaf node.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( libfdata_btree_node_get_number_of_leaf_values(
+			     *node,
+			     &number_of_leaf_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of leaf values.",
+				 function );
+
+				goto on_error;
+			}
+			for( leaf_value_index = 0;
+			     leaf_value_index < number_of_leaf_values;
+			     leaf_value_index++ )
+			{
+				if( libfdata_btree_node_get_leaf_value_data_range_by_index(
+				     *node,
+				     leaf_value_index,
+				     &leaf_value_data_range,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve leaf value: %d data range.",
+					 function,
+					 leaf_value_index );
+
+					goto on_error;
+				}
+				if( leaf_value_data_range == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing leaf value: %d data range.",
+					 function,
+					 leaf_value_index );
+
+					goto on_error;
+				}
+				leaf_value_data_range->mapped_first_leaf_value_index = mapped_first_leaf_value_index;
+				leaf_value_data_range->mapped_last_leaf_value_index  = -1;
+				leaf_value_data_range->mapped_number_of_leaf_values  = 1;
+
+				if( libfdata_btree_insert_key_value_in_index(
+				     internal_tree,
+				     leaf_value_data_range,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to insert key value of leaf value: %d in index.",
+					 function,
+					 leaf_value_index );
+
+					goto on_error;
+				}
+				mapped_first_leaf_value_index++;
+			}
+			branch_number_of_leaf_values = number_of_leaf_values;
+		}
+		else
+		{
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+			if( internal_tree->maximum_number_of_threads > 1 )
+			{
+				if( libfdata_btree_read_sub_trees_parallel(
+				     internal_tree,
+				     file_io_handle,
+				     cache,
+				     *node,
+				     level,
+				     read_flags,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read sub trees.",
+					 function );
+
+					goto on_error;
+				}
+			}
+#endif
+			/* The sub nodes are mapped in order, which makes the mapped leaf value
+			 * indexes independent of the order in which the sub trees were read
+			 */
+			if( libfdata_btree_map_sub_nodes(
+			     internal_tree,
+			     file_io_handle,
+			     cache,
+			     *node,
+			     level,
+			     -1,
+			     read_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to map sub nodes.",
+				 function );
+
+				goto on_error;
+			}
+			if( libfdata_btree_node_get_number_of_sub_nodes(
+			     *node,
+			     &number_of_sub_nodes,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of sub nodes.",
+				 function );
+
+				goto on_error;
+			}
+			for( sub_node_index = 0;
+			     sub_node_index < number_of_sub_nodes;
+			     sub_node_index++ )
+			{
+				if( libfdata_btree_node_get_sub_node_data_range_by_index(
+				     *node,
+				     sub_node_index,
+				     &sub_node_data_range,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve sub node: %d data range.",
+					 function,
+					 sub_node_index );
+
+					goto on_error;
+				}
+				if( sub_node_data_range == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing sub node: %d data range.",
+					 function,
+					 sub_node_index );
+
+					goto on_error;
+				}
+				number_of_leaf_values = internal_node->sub_node_leaf_value_offsets[ sub_node_index + 1 ]
+				                      - internal_node->sub_node_leaf_value_offsets[ sub_node_index ];
+
+				sub_node_data_range->mapped_first_leaf_value_index = mapped_first_leaf_value_index;
+				mapped_first_leaf_value_index                     += number_of_leaf_values;
+				sub_node_data_range->mapped_last_leaf_value_index  = mapped_first_leaf_value_index - 1;
+				sub_node_data_range->mapped_number_of_leaf_values  = number_of_leaf_values;
+				branch_number_of_leaf_values                      += number_of_leaf_values;
+			}
+		}
+		internal_node->branch_number_of_leaf_values = branch_number_of_leaf_values;
+		internal_node->flags                       &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
+	}
+	if( libfdata_btree_set_node_in_cache(
+	     internal_tree,
+	     cache,
+	     node_data_range,
+	     level,
+	     *node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set node in cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *node != NULL )
+	{
+		libfdata_btree_node_free(
+		 node,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the number of leaf values in the sub tree of a specific node
+ * The number of leaf values is stored in the leaf count table, so that
+ * the sub tree only needs to be counted once
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_get_sub_tree_number_of_leaf_values(
+     libfdata_internal_btree_t *internal_tree,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     libfdata_btree_range_t *node_data_range,
+     int level,
+     int *number_of_leaf_values,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfdata_btree_node_t *node    = NULL;
+	static char *function          = "libfdata_btree_get_sub_tree_number_of_leaf_values";
+	int number_of_mapped_sub_nodes = 0;
+	int result                     = 0;
+
+	if( internal_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_data_range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node data range.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_leaf_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of leaf values.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfdata_btree_get_leaf_count(
+	          internal_tree,
+	          node_data_range,
+	          number_of_leaf_values,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of leaf values from leaf count table.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+	/* Make sure to not have the node cached here to prevent it from
+	 * being freed during mapping the sub nodes.
+	 */
+	if( libfdata_btree_read_node(
+	     internal_tree,
+	     file_io_handle,
+	     cache,
+	     node_data_range,
+	     level,
+	     &node,
+	     read_flags | LIBFDATA_READ_FLAG_NO_CACHE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read node.",
+		 function );
+
+		goto on_error;
+	}
+	result = libfdata_btree_node_is_leaf(
+		  node,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if node is a leaf node.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libfdata_btree_node_get_number_of_leaf_values(
+		     node,
+		     number_of_leaf_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of leaf values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( libfdata_btree_map_sub_nodes(
+		     internal_tree,
+		     file_io_handle,
+		     cache,
+		     node,
+		     level,
+		     -1,
+		     read_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to map sub nodes.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfdata_btree_node_get_number_of_mapped_sub_nodes(
+		     node,
+		     &number_of_mapped_sub_nodes,
+		     number_of_leaf_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of mapped sub nodes.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfdata_btree_set_node_in_cache(
+	     internal_tree,
+	     cache,
+	     node_data_range,
+	     level,
+	     node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set node in cache.",
+		 function );
+
+		goto on_error;
+	}
+	node = NULL;
+
+	if( libfdata_btree_set_leaf_count(
+	     internal_tree,
+	     node_data_range,
+	     *number_of_leaf_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of leaf values in leaf count table.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( node != NULL )
+	{
+		libfdata_btree_node_free(
+		 &node,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Maps the number of leaf values of the sub nodes of a branch node
+ * The sub nodes are mapped up to and including the sub node that contains
+ * the leaf value index, or all sub nodes if the leaf value index is -1
+ * The leaf value index is relative to the first leaf value of the node
+ *
+ * Make sure the node is not cached, since the node can otherwise be
+ * freed while reading the sub nodes
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_map_sub_nodes(
+     libfdata_internal_btree_t *internal_tree,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     libfdata_btree_node_t *node,
+     int level,
+     int leaf_value_index,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfdata_btree_range_t *sub_node_data_range = NULL;
+	static char *function                       = "libfdata_btree_map_sub_nodes";
+	int number_of_leaf_values                   = 0;
+	int number_of_mapped_leaf_values            = 0;
+	int number_of_mapped_sub_nodes              = 0;
+	int number_of_sub_nodes                     = 0;
+
+	if( level < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid level value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( leaf_value_index < -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid leaf value index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_btree_node_get_number_of_sub_nodes(
+	     node,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_btree_node_get_number_of_mapped_sub_nodes(
+	     node,
+	     &number_of_mapped_sub_nodes,
+	     &number_of_mapped_leaf_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of mapped sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	while( number_of_mapped_sub_nodes < number_of_sub_nodes )
+	{
+		if( ( leaf_value_index != -1 )
+		 && ( leaf_value_index < number_of_mapped_leaf_values ) )
+		{
+			break;
+		}
+		if( libfdata_btree_node_get_sub_node_data_range_by_index(
+		     node,
+		     number_of_mapped_sub_nodes,
+		     &sub_node_data_range,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub node: %d data range.",
+			 function,
+			 number_of_mapped_sub_nodes );
+
+			return( -1 );
+		}
+		if( libfdata_btree_get_sub_tree_number_of_leaf_values(
+		     internal_tree,
+		     file_io_handle,
+		     cache,
+		     sub_node_data_range,
+		     level + 1,
+		     &number_of_leaf_values,
+		     read_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of leaf values of sub node: %d sub tree.",
+			 function,
+			 number_of_mapped_sub_nodes );
+
+			return( -1 );
+		}
+		if( libfdata_btree_node_append_mapped_sub_node(
+		     node,
+		     number_of_leaf_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to map sub node: %d.",
+			 function,
+			 number_of_mapped_sub_nodes );
+
+			return( -1 );
+		}
+		number_of_mapped_sub_nodes   += 1;
+		number_of_mapped_leaf_values += number_of_leaf_values;
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+
+/* Reads the sub tree of a sub node on a worker thread
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_read_sub_trees_callback(
+     libfdata_btree_range_t *sub_node_data_range,
+     libfdata_btree_read_sub_trees_arguments_t *arguments )
+{
+	libcerror_error_t *error  = NULL;
+	static char *function     = "libfdata_btree_read_sub_trees_callback";
+	int number_of_leaf_values = 0;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	if( libfdata_btree_get_sub_tree_number_of_leaf_values(
+	     arguments->internal_tree,
+	     arguments->file_io_handle,
+	     arguments->cache,
+	     sub_node_data_range,
+	     arguments->level,
+	     &number_of_leaf_values,
+	     arguments->read_flags,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub tree.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( libcthreads_mutex_grab(
+	     arguments->internal_tree->cache_mutex,
+	     NULL ) == 1 )
+	{
+		arguments->number_of_failed_sub_trees += 1;
+
+		libcthreads_mutex_release(
+		 arguments->internal_tree->cache_mutex,
+		 NULL );
+	}
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Reads the sub trees of the sub nodes of a branch node in parallel
+ * The sub trees of which the number of leaf values has not been determined
+ * are distributed over a pool of worker threads, that store the number of
+ * leaf values in the leaf count table
+ *
+ * Make sure the node is not cached, since the node can otherwise be
+ * freed while reading the sub trees
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_read_sub_trees_parallel(
+     libfdata_internal_btree_t *internal_tree,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     libfdata_btree_node_t *node,
+     int level,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfdata_btree_read_sub_trees_arguments_t arguments;
+
+	libcthreads_thread_pool_t *thread_pool      = NULL;
+	libfdata_btree_range_t *sub_node_data_range = NULL;
+	static char *function                       = "libfdata_btree_read_sub_trees_parallel";
+	int number_of_leaf_values                   = 0;
+	int number_of_sub_nodes                     = 0;
+	int number_of_threads                       = 0;
+	int number_of_unread_sub_trees              = 0;
+	int pass                                    = 0;
+	int result                                  = 0;
+	int sub_node_index                          = 0;
+
+	if( internal_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( *node == NULL )
+	if( libfdata_btree_node_get_number_of_sub_nodes(
+	     node,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing node.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( ( ( (libfdata_internal_btree_node_t *) *node )->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
+	/* The first pass determines the number of unread sub trees
+	 * the second pass pushes the unread sub trees onto the thread pool
+	 */
+	for( pass = 0;
+	     pass < 2;
+	     pass++ )
 	{
-		result = libfdata_btree_node_is_leaf(
-			  *node,
-			  error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine if node is a leaf node.",
-			 function,
-			 sub_node_index );
-
-			goto on_error;
-		}
-		else if( result != 0 )
+		for( sub_node_index = 0;
+		     sub_node_index < number_of_sub_nodes;
+		     sub_node_index++ )
 		{
-			if( libfdata_btree_node_get_number_of_leaf_values(
-			     *node,
-			     &number_of_leaf_values,
+			if( libfdata_btree_node_get_sub_node_data_range_by_index(
+			     node,
+			     sub_node_index,
+			     &sub_node_data_range,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve number of leaf values.",
-				 function );
+				 "%s: unable to retrieve sub node: %d data range.",
+				 function,
+				 sub_node_index );
 
 				goto on_error;
 			}
-			for( leaf_value_index = 0;
-			     leaf_value_index < number_of_leaf_values;
-			     leaf_value_index++ )
-			{
-				if( libfdata_btree_node_get_leaf_value_data_range_by_index(
-				     *node,
-				     leaf_value_index,
-				     &leaf_value_data_range,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve leaf value: %d data range.",
-					 function,
-					 leaf_value_index );
-
-					goto on_error;
-				}
-				if( leaf_value_data_range == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing leaf value: %d data range.",
-					 function,
-					 leaf_value_index );
-
-					goto on_error;
-				}
-				leaf_value_data_range->mapped_first_leaf_value_index = mapped_first_leaf_value_index;
-				leaf_value_data_range->mapped_last_leaf_value_index  = -1;
-				leaf_value_data_range->mapped_number_of_leaf_values  = 1;
-
-				mapped_first_leaf_value_index++;
-			}
-			branch_number_of_leaf_values = number_of_leaf_values;
+			result = libfdata_btree_get_leaf_count(
+			          internal_tree,
+			          sub_node_data_range,
+			          &number_of_leaf_values,
+			          error );
 
-/* TODO*/
-			level++;
-		}
-		else
-		{
-			if( libfdata_btree_node_get_number_of_sub_nodes(
-			     *node,
-			     &number_of_sub_nodes,
-			     error ) != 1 )
+			if( result == -1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve number of sub nodes.",
-				 function );
+				 "%s: unable to retrieve number of leaf values of sub node: %d.",
+				 function,
+				 sub_node_index );
 
 				goto on_error;
 			}
-			level++;
-
-			for( sub_node_index = 0;
-			     sub_node_index < number_of_sub_nodes;
-			     sub_node_index++ )
+			else if( result != 0 )
 			{
-				if( libfdata_btree_node_get_sub_node_data_range_by_index(
-				     *node,
-				     sub_node_index,
-				     &sub_node_data_range,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve sub node: %d data range.",
-					 function,
-					 sub_node_index );
-
-					goto on_error;
-				}
-				if( sub_node_data_range == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing sub node: %d data range.",
-					 function,
-					 sub_node_index );
+				continue;
+			}
+			if( pass == 0 )
+			{
+				number_of_unread_sub_trees++;
+			}
+			else if( libcthreads_thread_pool_push(
+			          thread_pool,
+			          (intptr_t *) sub_node_data_range,
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push sub node: %d onto thread pool.",
+				 function,
+				 sub_node_index );
 
-					goto on_error;
-				}
-				if( libfdata_btree_read_sub_tree(
-				     internal_tree,
-				     file_io_handle,
-				     cache,
-				     sub_node_data_range,
-				     level,
-				     mapped_first_leaf_value_index,
-				     &sub_node,
-				     read_flags,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read sub node: %d sub tree.",
-					 function,
-					 sub_node_index );
+				goto on_error;
+			}
+		}
+		if( pass != 0 )
+		{
+			break;
+		}
+		/* Only use a thread pool if there are multiple sub trees to read
+		 */
+		if( number_of_unread_sub_trees < 2 )
+		{
+			return( 1 );
+		}
+		number_of_threads = internal_tree->maximum_number_of_threads;
 
-					goto on_error;
-				}
-				if( libfdata_btree_node_get_number_of_leaf_values_in_branch(
-				     sub_node,
-				     &number_of_leaf_values,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve number of leaf values in branch.",
-					 function );
+		if( number_of_threads > number_of_unread_sub_trees )
+		{
+			number_of_threads = number_of_unread_sub_trees;
+		}
+		arguments.internal_tree              = internal_tree;
+		arguments.file_io_handle             = file_io_handle;
+		arguments.cache                      = cache;
+		arguments.level                      = level + 1;
+		arguments.read_flags                 = read_flags;
+		arguments.number_of_failed_sub_trees = 0;
+
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     number_of_threads,
+		     number_of_unread_sub_trees,
+		     (int (*)(intptr_t *, void *)) &libfdata_btree_read_sub_trees_callback,
+		     (void *) &arguments,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
 
-					goto on_error;
-				}
-				sub_node_data_range->mapped_first_leaf_value_index = mapped_first_leaf_value_index;
-				mapped_first_leaf_value_index                     += number_of_leaf_values;
-				sub_node_data_range->mapped_last_leaf_value_index  = mapped_first_leaf_value_index - 1;
-				sub_node_data_range->mapped_number_of_leaf_values  = number_of_leaf_values;
-				branch_number_of_leaf_values                      += number_of_leaf_values;
-			}
+			goto on_error;
 		}
-		( (libfdata_internal_btree_node_t *) *node )->branch_number_of_leaf_values = branch_number_of_leaf_values;
-		( (libfdata_internal_btree_node_t *) *node )->flags                       &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
 	}
-	if( internal_tree->calculate_node_cache_entry_index(
-	     (libfdata_btree_t *) internal_tree,
-	     cache,
-	     level,
-	     node_data_file_index,
-	     node_data_offset,
-	     node_data_size,
-	     node_data_flags,
-	     &cache_entry_index,
+	if( libcthreads_thread_pool_join(
+	     &thread_pool,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to calculate cache entry index.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join thread pool.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfcache_cache_set_value_by_index(
-	     cache,
-	     cache_entry_index,
-	     node_data_file_index,
-	     node_data_offset,
-	     internal_tree->timestamp,
-	     (intptr_t *) *node,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_btree_node_free,
-	     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
-	     error ) != 1 )
+	if( arguments.number_of_failed_sub_trees != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set node in cache entry: %d.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read %d sub trees.",
 		 function,
-		 cache_entry_index );
+		 arguments.number_of_failed_sub_trees );
 
-		goto on_error;
+		return( -1 );
 	}
 	return( 1 );
 
 on_error:
-	if( *node != NULL )
+	if( thread_pool != NULL )
 	{
-		libfdata_btree_node_free(
-		 node,
+		libcthreads_thread_pool_join(
+		 &thread_pool,
 		 NULL );
 	}
 	return( -1 );
 }
 
+#endif /* defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT ) */
+
 /* Retrieves a leaf node the contains a specific leaf value index
+ * The node leaf value index is set to the index of the leaf value in the leaf node
+ *
+ * Only the sub nodes on the path to the leaf value are read, the number of
+ * leaf values of the preceding sub trees is determined once and then looked up
+ * with a binary search
+ *
+ * The nodes on the path are taken out of the cache while their sub nodes are
+ * read, so that the sub node data ranges they own cannot be freed by the cache
+ * in the meantime
+ *
  * Returns 1 if successful or -1 on error
  */
 int libfdata_btree_get_leaf_node_by_index(
@@ -1755,12 +3995,16 @@ int libfdata_btree_get_leaf_node_by_index(
      int level,
      int leaf_value_index,
      libfdata_btree_node_t **node,
+     int *node_leaf_value_index,
      uint8_t read_flags,
      libcerror_error_t **error )
 {
+	libfdata_btree_node_t *leaf_node            = NULL;
 	libfdata_btree_range_t *sub_node_data_range = NULL;
 	static char *function                       = "libfdata_btree_get_leaf_node_by_index";
+	int number_of_leaf_values                   = 0;
 	int result                                  = 0;
+	int sub_node_leaf_value_index               = 0;
 
 	if( internal_tree == NULL )
 	{
@@ -1817,33 +4061,38 @@ int libfdata_btree_get_leaf_node_by_index(
 
 		return( -1 );
 	}
-	if( libfdata_btree_read_sub_tree(
-	     internal_tree,
-	     file_io_handle,
-	     cache,
-	     node_data_range,
-	     level,
-	     node_data_range->mapped_first_leaf_value_index,
-	     node,
-	     read_flags,
-	     error ) != 1 )
+	if( node_leaf_value_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read node sub tree.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node leaf value index.",
 		 function );
 
 		return( -1 );
 	}
-	if( *node == NULL )
+	/* The nodes on the path are kept in the cache
+	 */
+	read_flags &= ~( LIBFDATA_READ_FLAG_NO_CACHE );
+
+	*node = NULL;
+
+	if( libfdata_btree_read_node(
+	     internal_tree,
+	     file_io_handle,
+	     cache,
+	     node_data_range,
+	     level,
+	     node,
+	     read_flags | LIBFDATA_READ_FLAG_NO_CACHE,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing node.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read node.",
 		 function );
 
 		return( -1 );
@@ -1861,38 +4110,115 @@ int libfdata_btree_get_leaf_node_by_index(
 		 "%s: unable to determine if node is a leaf node.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	else if( result != 0 )
 	{
+		if( libfdata_btree_node_get_number_of_leaf_values(
+		     *node,
+		     &number_of_leaf_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of leaf values.",
+			 function );
+
+			goto on_error;
+		}
+		if( leaf_value_index >= number_of_leaf_values )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid leaf value index value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		/* The node data range is owned by the parent node, which is
+		 * not in the cache at this point
+		 */
+		if( libfdata_btree_set_node_in_cache(
+		     internal_tree,
+		     cache,
+		     node_data_range,
+		     level,
+		     *node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set node in cache.",
+			 function );
+
+			goto on_error;
+		}
+		*node_leaf_value_index = leaf_value_index;
+
 		return( 1 );
 	}
-	if( libfdata_btree_node_get_sub_node_data_range_by_mapped_index(
-	     *node,
-	     leaf_value_index,
-	     &sub_node_data_range,
-	     error ) != 1 )
+	result = libfdata_btree_node_get_sub_node_data_range_by_leaf_value_index(
+	          *node,
+	          leaf_value_index,
+	          &sub_node_leaf_value_index,
+	          &sub_node_data_range,
+	          error );
+
+	if( result == 0 )
+	{
+		if( libfdata_btree_map_sub_nodes(
+		     internal_tree,
+		     file_io_handle,
+		     cache,
+		     *node,
+		     level,
+		     leaf_value_index,
+		     read_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to map sub nodes.",
+			 function );
+
+			goto on_error;
+		}
+		result = libfdata_btree_node_get_sub_node_data_range_by_leaf_value_index(
+		          *node,
+		          leaf_value_index,
+		          &sub_node_leaf_value_index,
+		          &sub_node_data_range,
+		          error );
+	}
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve sub node data range for leaf value: %d..",
+		 "%s: unable to retrieve sub node data range for leaf value: %d.",
 		 function,
 		 leaf_value_index );
 
-		return( -1 );
+		goto on_error;
 	}
-	*node = NULL;
-
 	if( libfdata_btree_get_leaf_node_by_index(
 	     internal_tree,
 	     file_io_handle,
 	     cache,
 	     sub_node_data_range,
 	     level + 1,
-	     leaf_value_index,
-	     node,
+	     sub_node_leaf_value_index,
+	     &leaf_node,
+	     node_leaf_value_index,
 	     read_flags,
 	     error ) != 1 )
 	{
@@ -1904,12 +4230,63 @@ int libfdata_btree_get_leaf_node_by_index(
 		 function,
 		 leaf_value_index );
 
-		return( -1 );
+		goto on_error;
+	}
+	result = libfdata_btree_set_branch_node_in_cache(
+	          internal_tree,
+	          cache,
+	          node_data_range,
+	          level,
+	          *node,
+	          leaf_node,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set node in cache.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libfdata_btree_node_free(
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free node.",
+			 function );
+
+			goto on_error;
+		}
 	}
+	*node = leaf_node;
+
 	return( 1 );
+
+on_error:
+	if( *node != NULL )
+	{
+		libfdata_btree_node_free(
+		 node,
+		 NULL );
+	}
+	return( -1 );
 }
 
 /* Retrieves a leaf node for a specific key value
+ * If leaf_node_can_contain_key_value is not NULL it is set to 0 if the key value
+ * filter of the leaf node rules out the key value or 1 otherwise. The filter is
+ * checked before the node is read, since the node data range is owned by the
+ * parent node, which can be evicted from the cache when the node is read
  *
  * Uses the key_value_compare_function to determine the similarity of the key values
  * The key_value_compare_function should return LIBFDATA_COMPARE_LESS,
@@ -1932,6 +4309,7 @@ int libfdata_btree_get_leaf_node_by_key(
             libcerror_error_t **error ),
      int *node_index,
      libfdata_btree_node_t **node,
+     int *leaf_node_can_contain_key_value,
      uint8_t read_flags,
      libcerror_error_t **error )
 {
@@ -2006,6 +4384,29 @@ int libfdata_btree_get_leaf_node_by_key(
 
 		return( -1 );
 	}
+	if( leaf_node_can_contain_key_value != NULL )
+	{
+		/* Only the data range of a leaf node has a key value filter
+		 */
+		result = libfdata_btree_leaf_node_can_contain_key_value(
+		          internal_tree,
+		          node_data_range,
+		          key_value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if node can contain key value.",
+			 function );
+
+			return( -1 );
+		}
+		*leaf_node_can_contain_key_value = result;
+	}
 	if( libfdata_btree_read_sub_tree(
 	     internal_tree,
 	     file_io_handle,
@@ -2098,6 +4499,7 @@ int libfdata_btree_get_leaf_node_by_key(
 		  key_value_compare_function,
 		  node_index,
 		  node,
+		  leaf_node_can_contain_key_value,
 		  read_flags,
 		  error );
 
@@ -2221,6 +4623,7 @@ int libfdata_btree_get_next_leaf_node_by_key(
 		          key_value_compare_function,
 		          &branch_node_index,
 		          &branch_node,
+		          NULL,
 		          read_flags,
 		          error );
 
@@ -2286,6 +4689,31 @@ int libfdata_btree_get_next_leaf_node_by_key(
 
 				return( -1 );
 			}
+			/* The sub node does not need to be read if it is a leaf node
+			 * of which the key value filter rules out the key value
+			 */
+			result = libfdata_btree_leaf_node_can_contain_key_value(
+			          internal_tree,
+			          sub_node_data_range,
+			          key_value,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if next sub node: %d can contain key value.",
+				 function,
+				 node_index );
+
+				return( -1 );
+			}
+			else if( result == 0 )
+			{
+				return( 0 );
+			}
 			result = libfdata_btree_get_leaf_node_by_key(
 			          internal_tree,
 			          file_io_handle,
@@ -2297,6 +4725,7 @@ int libfdata_btree_get_next_leaf_node_by_key(
 			          key_value_compare_function,
 			          next_node_index,
 			          next_node,
+			          NULL,
 			          read_flags,
 			          error );
 
@@ -2427,6 +4856,7 @@ int libfdata_btree_get_previous_leaf_node_by_key(
 		          key_value_compare_function,
 		          &branch_node_index,
 		          &branch_node,
+		          NULL,
 		          read_flags,
 		          error );
 
@@ -2492,6 +4922,31 @@ int libfdata_btree_get_previous_leaf_node_by_key(
 
 				return( -1 );
 			}
+			/* The sub node does not need to be read if it is a leaf node
+			 * of which the key value filter rules out the key value
+			 */
+			result = libfdata_btree_leaf_node_can_contain_key_value(
+			          internal_tree,
+			          sub_node_data_range,
+			          key_value,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if previous sub node: %d can contain key value.",
+				 function,
+				 node_index );
+
+				return( -1 );
+			}
+			else if( result == 0 )
+			{
+				return( 0 );
+			}
 			result = libfdata_btree_get_leaf_node_by_key(
 			          internal_tree,
 			          file_io_handle,
@@ -2503,6 +4958,7 @@ int libfdata_btree_get_previous_leaf_node_by_key(
 			          key_value_compare_function,
 			          previous_node_index,
 			          previous_node,
+			          NULL,
 			          read_flags,
 			          error );
 
@@ -2595,7 +5051,7 @@ int libfdata_btree_get_number_of_leaf_values(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of leaf values in branch.",
+		 "%s: unable to retrieve number of leaf values in root node branch.",
 		 function );
 
 		return( -1 );
@@ -2619,6 +5075,7 @@ int libfdata_btree_get_leaf_value_by_index(
 	libfdata_btree_range_t *leaf_value_data_range = NULL;
 	libfdata_internal_btree_t *internal_tree      = NULL;
 	static char *function                         = "libfdata_btree_get_leaf_value_by_index";
+	int node_leaf_value_index                     = 0;
 
 	if( tree == NULL )
 	{
@@ -2652,6 +5109,7 @@ int libfdata_btree_get_leaf_value_by_index(
 	     0,
 	     leaf_value_index,
 	     &node,
+	     &node_leaf_value_index,
 	     read_flags,
 	     error ) != 1 )
 	{
@@ -2664,9 +5122,9 @@ int libfdata_btree_get_leaf_value_by_index(
 
 		return( -1 );
 	}
-	if( libfdata_btree_node_get_leaf_value_data_range_by_mapped_index(
+	if( libfdata_btree_node_get_leaf_value_data_range_by_index(
 	     node,
-	     leaf_value_index,
+	     node_leaf_value_index,
 	     &leaf_value_data_range,
 	     error ) != 1 )
 	{
@@ -2679,6 +5137,36 @@ int libfdata_btree_get_leaf_value_by_index(
 
 		return( -1 );
 	}
+	if( leaf_value_data_range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing leaf value data range.",
+		 function );
+
+		return( -1 );
+	}
+	leaf_value_data_range->mapped_first_leaf_value_index = leaf_value_index;
+	leaf_value_data_range->mapped_last_leaf_value_index  = -1;
+	leaf_value_data_range->mapped_number_of_leaf_values  = 1;
+
+	if( libfdata_btree_insert_key_value_in_index(
+	     internal_tree,
+	     leaf_value_data_range,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert key value of leaf value: %d in index.",
+		 function,
+		 leaf_value_index );
+
+		return( -1 );
+	}
 	if( libfdata_btree_read_leaf_value(
 	     internal_tree,
 	     file_io_handle,
@@ -2730,6 +5218,7 @@ int libfdata_btree_set_leaf_value_by_index(
 	uint32_t leaf_value_data_flags                = 0;
 	int cache_entry_index                         = -1;
 	int leaf_value_data_file_index                = -1;
+	int node_leaf_value_index                     = 0;
 
 	LIBFDATA_UNREFERENCED_PARAMETER( file_io_handle )
 
@@ -2765,6 +5254,7 @@ int libfdata_btree_set_leaf_value_by_index(
 	     0,
 	     leaf_value_index,
 	     &node,
+	     &node_leaf_value_index,
 	     0,
 	     error ) != 1 )
 	{
@@ -2777,9 +5267,9 @@ int libfdata_btree_set_leaf_value_by_index(
 
 		return( -1 );
 	}
-	if( libfdata_btree_node_get_leaf_value_data_range_by_mapped_index(
+	if( libfdata_btree_node_get_leaf_value_data_range_by_index(
 	     node,
-	     leaf_value_index,
+	     node_leaf_value_index,
 	     &leaf_value_data_range,
 	     error ) != 1 )
 	{
@@ -2881,6 +5371,7 @@ int libfdata_btree_get_leaf_value_by_key(
 	libfdata_btree_range_t *leaf_value_data_range = NULL;
 	libfdata_internal_btree_t *internal_tree      = NULL;
 	static char *function                         = "libfdata_btree_get_leaf_value_by_key";
+	int leaf_node_can_contain_key_value           = 1;
 	int leaf_node_index                           = 0;
 	int leaf_node_level                           = 0;
 	int node_index                                = 0;
@@ -2921,6 +5412,59 @@ int libfdata_btree_get_leaf_value_by_key(
 
 		return( -1 );
 	}
+	if( ( internal_tree->key_value_index != NULL )
+	 && ( key_value_compare_function != NULL ) )
+	{
+		result = libfdata_btree_get_leaf_value_data_range_from_key_value_index(
+		          internal_tree,
+		          file_io_handle,
+		          cache,
+		          key_value,
+		          key_value_compare_function,
+		          &leaf_value_data_range,
+		          read_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve leaf value data range from key value index.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( libfdata_btree_read_leaf_value(
+			     internal_tree,
+			     file_io_handle,
+			     cache,
+			     leaf_value_data_range,
+			     value,
+			     read_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read leaf value.",
+				 function );
+
+				return( -1 );
+			}
+			return( 1 );
+		}
+		/* A key value that is not in a complete index is not in the tree
+		 */
+		if( internal_tree->key_value_index->is_complete != 0 )
+		{
+			return( 0 );
+		}
+	}
 	result = libfdata_btree_get_leaf_node_by_key(
 	          internal_tree,
 	          file_io_handle,
@@ -2932,6 +5476,7 @@ int libfdata_btree_get_leaf_value_by_key(
 	          key_value_compare_function,
 	          &node_index,
 	          &leaf_node,
+	          &leaf_node_can_contain_key_value,
 	          read_flags,
 	          error );
 
@@ -2964,23 +5509,31 @@ int libfdata_btree_get_leaf_value_by_key(
 
 		return( -1 );
 	}
-	result = libfdata_btree_node_get_leaf_value_data_range_by_key(
-	          leaf_node,
-	          key_value,
-	          key_value_compare_function,
-	          &leaf_value_data_range,
-	          error );
+	/* The leaf values do not need to be compared if the key value filter
+	 * of the leaf node rules out the key value
+	 */
+	result = leaf_node_can_contain_key_value;
 
-	if( result == -1 )
+	if( result != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve leaf value data range.",
-		 function );
+		result = libfdata_btree_node_get_leaf_value_data_range_by_key(
+		          leaf_node,
+		          key_value,
+		          key_value_compare_function,
+		          &leaf_value_data_range,
+		          error );
 
-		return( -1 );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve leaf value data range.",
+			 function );
+
+			return( -1 );
+		}
 	}
 	if( ( result == 0 )
 	 && ( ( search_flags & LIBFDATA_BTREE_SEARCH_FLAG_SCAN_PREVIOUS_NODE ) != 0 ) )
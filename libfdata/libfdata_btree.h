@@ -25,10 +25,13 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfdata_btree_key_value_index.h"
+#include "libfdata_btree_leaf_count_table.h"
 #include "libfdata_btree_node.h"
 #include "libfdata_btree_range.h"
 #include "libfdata_extern.h"
 #include "libfdata_libcerror.h"
+#include "libfdata_libcthreads.h"
 #include "libfdata_libfcache.h"
 #include "libfdata_types.h"
 
@@ -52,6 +55,33 @@ struct libfdata_internal_btree
 	 */
 	uint8_t flags;
 
+	/* The leaf count table
+	 * contains the number of leaf values of the sub trees that have been counted
+	 */
+	libfdata_btree_leaf_count_table_t *leaf_count_table;
+
+	/* The maximum number of threads used to read sub trees
+	 */
+	int maximum_number_of_threads;
+
+	/* The key value hash function
+	 */
+	int (*key_value_hash_function)(
+	       intptr_t *key_value,
+	       uint32_t *key_value_hash,
+	       libcerror_error_t **error );
+
+	/* The key value index
+	 * maps key value hashes to leaf value indexes, NULL if not enabled
+	 */
+	libfdata_btree_key_value_index_t *key_value_index;
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	/* The mutex used to serialize access to the cache and leaf count table
+	 */
+	libcthreads_mutex_t *cache_mutex;
+#endif
+
 	/* The calculate node cache entry index value
 	 */
 	int (*calculate_node_cache_entry_index)(
@@ -126,6 +156,39 @@ struct libfdata_internal_btree
 	       libcerror_error_t **error );
 };
 
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+
+typedef struct libfdata_btree_read_sub_trees_arguments libfdata_btree_read_sub_trees_arguments_t;
+
+struct libfdata_btree_read_sub_trees_arguments
+{
+	/* The tree
+	 */
+	libfdata_internal_btree_t *internal_tree;
+
+	/* The file IO handle
+	 */
+	intptr_t *file_io_handle;
+
+	/* The cache
+	 */
+	libfcache_cache_t *cache;
+
+	/* The level of the sub nodes
+	 */
+	int level;
+
+	/* The read flags
+	 */
+	uint8_t read_flags;
+
+	/* The number of sub trees that could not be read
+	 */
+	int number_of_failed_sub_trees;
+};
+
+#endif /* defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT ) */
+
 LIBFDATA_EXTERN \
 int libfdata_btree_initialize(
      libfdata_btree_t **tree,
@@ -175,6 +238,34 @@ int libfdata_btree_clone(
      libfdata_btree_t *source_tree,
      libcerror_error_t **error );
 
+LIBFDATA_EXTERN \
+int libfdata_btree_set_maximum_number_of_threads(
+     libfdata_btree_t *tree,
+     int maximum_number_of_threads,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_btree_set_key_value_hash_function(
+     libfdata_btree_t *tree,
+     int (*key_value_hash_function)(
+            intptr_t *key_value,
+            uint32_t *key_value_hash,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_btree_enable_key_value_index(
+     libfdata_btree_t *tree,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_btree_build_key_value_index(
+     libfdata_btree_t *tree,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
 /* Cache entry functions
  */
 int libfdata_btree_calculate_node_cache_entry_index(
@@ -240,6 +331,74 @@ int libfdata_btree_read_node(
      uint8_t read_flags,
      libcerror_error_t **error );
 
+int libfdata_btree_get_node_from_cache(
+     libfdata_internal_btree_t *internal_tree,
+     libfcache_cache_t *cache,
+     libfdata_btree_range_t *node_data_range,
+     int level,
+     libfdata_btree_node_t **node,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
+int libfdata_btree_set_node_in_cache(
+     libfdata_internal_btree_t *internal_tree,
+     libfcache_cache_t *cache,
+     libfdata_btree_range_t *node_data_range,
+     int level,
+     libfdata_btree_node_t *node,
+     libcerror_error_t **error );
+
+int libfdata_btree_set_branch_node_in_cache(
+     libfdata_internal_btree_t *internal_tree,
+     libfcache_cache_t *cache,
+     libfdata_btree_range_t *node_data_range,
+     int level,
+     libfdata_btree_node_t *node,
+     libfdata_btree_node_t *leaf_node,
+     libcerror_error_t **error );
+
+int libfdata_btree_get_leaf_count(
+     libfdata_internal_btree_t *internal_tree,
+     libfdata_btree_range_t *node_data_range,
+     int *number_of_leaf_values,
+     libcerror_error_t **error );
+
+int libfdata_btree_set_leaf_count(
+     libfdata_internal_btree_t *internal_tree,
+     libfdata_btree_range_t *node_data_range,
+     int number_of_leaf_values,
+     libcerror_error_t **error );
+
+int libfdata_btree_build_key_value_filter(
+     libfdata_internal_btree_t *internal_tree,
+     libfdata_btree_range_t *node_data_range,
+     libfdata_btree_node_t *node,
+     libcerror_error_t **error );
+
+int libfdata_btree_leaf_node_can_contain_key_value(
+     libfdata_internal_btree_t *internal_tree,
+     libfdata_btree_range_t *node_data_range,
+     intptr_t *key_value,
+     libcerror_error_t **error );
+
+int libfdata_btree_insert_key_value_in_index(
+     libfdata_internal_btree_t *internal_tree,
+     libfdata_btree_range_t *leaf_value_data_range,
+     libcerror_error_t **error );
+
+int libfdata_btree_get_leaf_value_data_range_from_key_value_index(
+     libfdata_internal_btree_t *internal_tree,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     intptr_t *key_value,
+     int (*key_value_compare_function)(
+            intptr_t *first_key_value,
+            intptr_t *second_key_value,
+            libcerror_error_t **error ),
+     libfdata_btree_range_t **leaf_value_data_range,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
 int libfdata_btree_read_sub_tree(
      libfdata_internal_btree_t *internal_tree,
      intptr_t *file_io_handle,
@@ -251,6 +410,43 @@ int libfdata_btree_read_sub_tree(
      uint8_t read_flags,
      libcerror_error_t **error );
 
+int libfdata_btree_get_sub_tree_number_of_leaf_values(
+     libfdata_internal_btree_t *internal_tree,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     libfdata_btree_range_t *node_data_range,
+     int level,
+     int *number_of_leaf_values,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
+int libfdata_btree_map_sub_nodes(
+     libfdata_internal_btree_t *internal_tree,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     libfdata_btree_node_t *node,
+     int level,
+     int leaf_value_index,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+
+int libfdata_btree_read_sub_trees_callback(
+     libfdata_btree_range_t *sub_node_data_range,
+     libfdata_btree_read_sub_trees_arguments_t *arguments );
+
+int libfdata_btree_read_sub_trees_parallel(
+     libfdata_internal_btree_t *internal_tree,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     libfdata_btree_node_t *node,
+     int level,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT ) */
+
 int libfdata_btree_get_leaf_node_by_index(
      libfdata_internal_btree_t *internal_tree,
      intptr_t *file_io_handle,
@@ -259,6 +455,7 @@ int libfdata_btree_get_leaf_node_by_index(
      int level,
      int leaf_value_index,
      libfdata_btree_node_t **node,
+     int *node_leaf_value_index,
      uint8_t read_flags,
      libcerror_error_t **error );
 
@@ -276,6 +473,7 @@ int libfdata_btree_get_leaf_node_by_key(
             libcerror_error_t **error ),
      int *node_index,
      libfdata_btree_node_t **node,
+     int *leaf_node_can_contain_key_value,
      uint8_t read_flags,
      libcerror_error_t **error );
 
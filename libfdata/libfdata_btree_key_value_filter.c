@@ -0,0 +1,326 @@
+/*
+ * The balanced tree key value filter functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfdata_btree_key_value_filter.h"
+#include "libfdata_libcerror.h"
+
+/* The number of bits per key value
+ * 10 bits per key value result in a false positive rate of about 1%
+ */
+#define LIBFDATA_BTREE_KEY_VALUE_FILTER_NUMBER_OF_BITS_PER_KEY_VALUE	10
+
+/* The number of bits set per key value
+ */
+#define LIBFDATA_BTREE_KEY_VALUE_FILTER_NUMBER_OF_PROBES		7
+
+/* The minimum number of bits
+ */
+#define LIBFDATA_BTREE_KEY_VALUE_FILTER_MINIMUM_NUMBER_OF_BITS		64
+
+/* Calculates the increment of a key value hash, used to derive the probes
+ */
+#define libfdata_btree_key_value_filter_calculate_increment( key_value_hash ) \
+	( ( ( key_value_hash ) >> 17 ) | ( ( key_value_hash ) << 15 ) )
+
+/* Creates a key value filter
+ * Make sure the value filter is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_key_value_filter_initialize(
+     libfdata_btree_key_value_filter_t **filter,
+     int number_of_key_values,
+     libcerror_error_t **error )
+{
+	static char *function   = "libfdata_btree_key_value_filter_initialize";
+	size_t bits_size        = 0;
+	uint32_t number_of_bits = 0;
+
+	if( filter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filter.",
+		 function );
+
+		return( -1 );
+	}
+	if( *filter != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid filter value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_key_values < 0 )
+	 || ( number_of_key_values > ( INT_MAX / LIBFDATA_BTREE_KEY_VALUE_FILTER_NUMBER_OF_BITS_PER_KEY_VALUE ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of key values value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_bits = (uint32_t) number_of_key_values * LIBFDATA_BTREE_KEY_VALUE_FILTER_NUMBER_OF_BITS_PER_KEY_VALUE;
+
+	if( number_of_bits < LIBFDATA_BTREE_KEY_VALUE_FILTER_MINIMUM_NUMBER_OF_BITS )
+	{
+		number_of_bits = LIBFDATA_BTREE_KEY_VALUE_FILTER_MINIMUM_NUMBER_OF_BITS;
+	}
+	bits_size = ( (size_t) number_of_bits + 7 ) / 8;
+
+	*filter = memory_allocate_structure(
+	           libfdata_btree_key_value_filter_t );
+
+	if( *filter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filter.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *filter,
+	     0,
+	     sizeof( libfdata_btree_key_value_filter_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear filter.",
+		 function );
+
+		memory_free(
+		 *filter );
+
+		*filter = NULL;
+
+		return( -1 );
+	}
+	( *filter )->bits = (uint8_t *) memory_allocate(
+	                                 bits_size );
+
+	if( ( *filter )->bits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create bits.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *filter )->bits,
+	     0,
+	     bits_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear bits.",
+		 function );
+
+		goto on_error;
+	}
+	( *filter )->number_of_bits = number_of_bits;
+
+	return( 1 );
+
+on_error:
+	if( *filter != NULL )
+	{
+		if( ( *filter )->bits != NULL )
+		{
+			memory_free(
+			 ( *filter )->bits );
+		}
+		memory_free(
+		 *filter );
+
+		*filter = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a key value filter
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_key_value_filter_free(
+     libfdata_btree_key_value_filter_t **filter,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_btree_key_value_filter_free";
+
+	if( filter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filter.",
+		 function );
+
+		return( -1 );
+	}
+	if( *filter != NULL )
+	{
+		if( ( *filter )->bits != NULL )
+		{
+			memory_free(
+			 ( *filter )->bits );
+		}
+		memory_free(
+		 *filter );
+
+		*filter = NULL;
+	}
+	return( 1 );
+}
+
+/* Inserts a key value hash into the key value filter
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_key_value_filter_insert(
+     libfdata_btree_key_value_filter_t *filter,
+     uint32_t key_value_hash,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_btree_key_value_filter_insert";
+	uint32_t bit_index    = 0;
+	uint32_t increment    = 0;
+	int probe_index       = 0;
+
+	if( filter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filter.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filter->bits == NULL )
+	 || ( filter->number_of_bits == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid filter - missing bits.",
+		 function );
+
+		return( -1 );
+	}
+	increment = libfdata_btree_key_value_filter_calculate_increment(
+	             key_value_hash );
+
+	for( probe_index = 0;
+	     probe_index < LIBFDATA_BTREE_KEY_VALUE_FILTER_NUMBER_OF_PROBES;
+	     probe_index++ )
+	{
+		bit_index = key_value_hash % filter->number_of_bits;
+
+		filter->bits[ bit_index / 8 ] |= (uint8_t) ( 1 << ( bit_index % 8 ) );
+
+		key_value_hash += increment;
+	}
+	return( 1 );
+}
+
+/* Determines if the key value filter contains a key value hash
+ * The filter can report a key value hash that was not inserted, but never
+ * fails to report a key value hash that was inserted
+ * Returns 1 if the filter possibly contains the key value hash, 0 if not or -1 on error
+ */
+int libfdata_btree_key_value_filter_contains(
+     libfdata_btree_key_value_filter_t *filter,
+     uint32_t key_value_hash,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_btree_key_value_filter_contains";
+	uint32_t bit_index    = 0;
+	uint32_t increment    = 0;
+	int probe_index       = 0;
+
+	if( filter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filter.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filter->bits == NULL )
+	 || ( filter->number_of_bits == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid filter - missing bits.",
+		 function );
+
+		return( -1 );
+	}
+	increment = libfdata_btree_key_value_filter_calculate_increment(
+	             key_value_hash );
+
+	for( probe_index = 0;
+	     probe_index < LIBFDATA_BTREE_KEY_VALUE_FILTER_NUMBER_OF_PROBES;
+	     probe_index++ )
+	{
+		bit_index = key_value_hash % filter->number_of_bits;
+
+		if( ( filter->bits[ bit_index / 8 ] & (uint8_t) ( 1 << ( bit_index % 8 ) ) ) == 0 )
+		{
+			return( 0 );
+		}
+		key_value_hash += increment;
+	}
+	return( 1 );
+}
+
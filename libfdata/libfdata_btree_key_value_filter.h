@@ -0,0 +1,75 @@
+/*
+ * The balanced tree key value filter functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _LIBFDATA_BTREE_KEY_VALUE_FILTER_H )
+#define _LIBFDATA_BTREE_KEY_VALUE_FILTER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfdata_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfdata_btree_key_value_filter libfdata_btree_key_value_filter_t;
+
+/* The key value filter is a Bloom filter of the hashes of the key values
+ * of the leaf values of a leaf node
+ */
+struct libfdata_btree_key_value_filter
+{
+	/* The bits
+	 */
+	uint8_t *bits;
+
+	/* The number of bits
+	 */
+	uint32_t number_of_bits;
+};
+
+int libfdata_btree_key_value_filter_initialize(
+     libfdata_btree_key_value_filter_t **filter,
+     int number_of_key_values,
+     libcerror_error_t **error );
+
+int libfdata_btree_key_value_filter_free(
+     libfdata_btree_key_value_filter_t **filter,
+     libcerror_error_t **error );
+
+int libfdata_btree_key_value_filter_insert(
+     libfdata_btree_key_value_filter_t *filter,
+     uint32_t key_value_hash,
+     libcerror_error_t **error );
+
+int libfdata_btree_key_value_filter_contains(
+     libfdata_btree_key_value_filter_t *filter,
+     uint32_t key_value_hash,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFDATA_BTREE_KEY_VALUE_FILTER_H ) */
+
@@ -0,0 +1,458 @@
+/*
+ * The balanced tree key value index functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfdata_btree_key_value_index.h"
+#include "libfdata_libcerror.h"
+
+/* The initial number of allocated entries, must be a power of 2
+ */
+#define LIBFDATA_BTREE_KEY_VALUE_INDEX_INITIAL_NUMBER_OF_ENTRIES	64
+
+/* Calculates the entry index of a key value hash
+ * The upper bits of the key value hash are folded into the lower bits before mixing
+ */
+#define libfdata_btree_key_value_index_calculate_entry_index( key_value_hash, number_of_allocated_entries ) \
+	(int) ( ( ( (uint32_t) ( key_value_hash ) ^ ( (uint32_t) ( key_value_hash ) >> 16 ) ) * 0x9e3779b1UL ) & (uint32_t) ( ( number_of_allocated_entries ) - 1 ) )
+
+/* Creates a key value index
+ * Make sure the value index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_key_value_index_initialize(
+     libfdata_btree_key_value_index_t **index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_btree_key_value_index_initialize";
+
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*index = memory_allocate_structure(
+	          libfdata_btree_key_value_index_t );
+
+	if( *index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *index,
+	     0,
+	     sizeof( libfdata_btree_key_value_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *index != NULL )
+	{
+		memory_free(
+		 *index );
+
+		*index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a key value index
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_key_value_index_free(
+     libfdata_btree_key_value_index_t **index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_btree_key_value_index_free";
+
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index != NULL )
+	{
+		if( ( *index )->entries != NULL )
+		{
+			memory_free(
+			 ( *index )->entries );
+		}
+		memory_free(
+		 *index );
+
+		*index = NULL;
+	}
+	return( 1 );
+}
+
+/* Empties a key value index
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_key_value_index_empty(
+     libfdata_btree_key_value_index_t *index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_btree_key_value_index_empty";
+
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	if( index->entries != NULL )
+	{
+		memory_free(
+		 index->entries );
+
+		index->entries = NULL;
+	}
+	index->number_of_allocated_entries = 0;
+	index->number_of_entries           = 0;
+	index->is_complete                 = 0;
+
+	return( 1 );
+}
+
+/* Resizes the entries of a key value index
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_key_value_index_resize(
+     libfdata_btree_key_value_index_t *index,
+     int number_of_allocated_entries,
+     libcerror_error_t **error )
+{
+	libfdata_btree_key_value_index_entry_t *entries = NULL;
+	static char *function                           = "libfdata_btree_key_value_index_resize";
+	int entry_index                                 = 0;
+	int old_entry_index                             = 0;
+
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_allocated_entries <= index->number_of_entries )
+	 || ( (size_t) number_of_allocated_entries > ( (size_t) SSIZE_MAX / sizeof( libfdata_btree_key_value_index_entry_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of allocated entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entries = (libfdata_btree_key_value_index_entry_t *) memory_allocate(
+	                                                      sizeof( libfdata_btree_key_value_index_entry_t ) * number_of_allocated_entries );
+
+	if( entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_allocated_entries;
+	     entry_index++ )
+	{
+		entries[ entry_index ].leaf_value_index = -1;
+	}
+	for( old_entry_index = 0;
+	     old_entry_index < index->number_of_allocated_entries;
+	     old_entry_index++ )
+	{
+		if( index->entries[ old_entry_index ].leaf_value_index == -1 )
+		{
+			continue;
+		}
+		entry_index = libfdata_btree_key_value_index_calculate_entry_index(
+		               index->entries[ old_entry_index ].key_value_hash,
+		               number_of_allocated_entries );
+
+		while( entries[ entry_index ].leaf_value_index != -1 )
+		{
+			entry_index = ( entry_index + 1 ) & ( number_of_allocated_entries - 1 );
+		}
+		entries[ entry_index ] = index->entries[ old_entry_index ];
+	}
+	if( index->entries != NULL )
+	{
+		memory_free(
+		 index->entries );
+	}
+	index->entries                     = entries;
+	index->number_of_allocated_entries = number_of_allocated_entries;
+
+	return( 1 );
+}
+
+/* Inserts the key value hash of a specific leaf value
+ * Multiple leaf values can have the same key value hash, a leaf value
+ * that was already inserted is not inserted again
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_key_value_index_insert(
+     libfdata_btree_key_value_index_t *index,
+     uint32_t key_value_hash,
+     int leaf_value_index,
+     libcerror_error_t **error )
+{
+	static char *function           = "libfdata_btree_key_value_index_insert";
+	int entry_index                 = 0;
+	int number_of_allocated_entries = 0;
+
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	if( leaf_value_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid leaf value index value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( index->number_of_entries > 0 )
+	{
+		entry_index = libfdata_btree_key_value_index_calculate_entry_index(
+		               key_value_hash,
+		               index->number_of_allocated_entries );
+
+		while( index->entries[ entry_index ].leaf_value_index != -1 )
+		{
+			if( ( index->entries[ entry_index ].key_value_hash == key_value_hash )
+			 && ( index->entries[ entry_index ].leaf_value_index == leaf_value_index ) )
+			{
+				return( 1 );
+			}
+			entry_index = ( entry_index + 1 ) & ( index->number_of_allocated_entries - 1 );
+		}
+	}
+	/* Keep the load factor of the index below 3/4
+	 */
+	if( ( index->number_of_entries + 1 ) > ( ( index->number_of_allocated_entries / 4 ) * 3 ) )
+	{
+		if( index->number_of_allocated_entries == 0 )
+		{
+			number_of_allocated_entries = LIBFDATA_BTREE_KEY_VALUE_INDEX_INITIAL_NUMBER_OF_ENTRIES;
+		}
+		else if( index->number_of_allocated_entries > ( INT_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid index - number of allocated entries value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		else
+		{
+			number_of_allocated_entries = index->number_of_allocated_entries * 2;
+		}
+		if( libfdata_btree_key_value_index_resize(
+		     index,
+		     number_of_allocated_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize index.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	entry_index = libfdata_btree_key_value_index_calculate_entry_index(
+	               key_value_hash,
+	               index->number_of_allocated_entries );
+
+	while( index->entries[ entry_index ].leaf_value_index != -1 )
+	{
+		entry_index = ( entry_index + 1 ) & ( index->number_of_allocated_entries - 1 );
+	}
+	index->entries[ entry_index ].key_value_hash   = key_value_hash;
+	index->entries[ entry_index ].leaf_value_index = leaf_value_index;
+
+	index->number_of_entries += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the next leaf value index with a specific key value hash
+ * The entry index is used to continue the search and should be -1 for the first call
+ * Returns 1 if successful, 0 if no such leaf value index or -1 on error
+ */
+int libfdata_btree_key_value_index_get_next_leaf_value_index(
+     libfdata_btree_key_value_index_t *index,
+     uint32_t key_value_hash,
+     int *entry_index,
+     int *leaf_value_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_btree_key_value_index_get_next_leaf_value_index";
+	int safe_entry_index  = 0;
+
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	if( leaf_value_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid leaf value index.",
+		 function );
+
+		return( -1 );
+	}
+	if( index->number_of_entries == 0 )
+	{
+		return( 0 );
+	}
+	if( *entry_index < 0 )
+	{
+		safe_entry_index = libfdata_btree_key_value_index_calculate_entry_index(
+		                    key_value_hash,
+		                    index->number_of_allocated_entries );
+	}
+	else if( *entry_index < index->number_of_allocated_entries )
+	{
+		safe_entry_index = ( *entry_index + 1 ) & ( index->number_of_allocated_entries - 1 );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( index->entries[ safe_entry_index ].leaf_value_index != -1 )
+	{
+		if( index->entries[ safe_entry_index ].key_value_hash == key_value_hash )
+		{
+			*entry_index      = safe_entry_index;
+			*leaf_value_index = index->entries[ safe_entry_index ].leaf_value_index;
+
+			return( 1 );
+		}
+		safe_entry_index = ( safe_entry_index + 1 ) & ( index->number_of_allocated_entries - 1 );
+	}
+	return( 0 );
+}
+
@@ -0,0 +1,105 @@
+/*
+ * The balanced tree key value index functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFDATA_BTREE_KEY_VALUE_INDEX_H )
+#define _LIBFDATA_BTREE_KEY_VALUE_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfdata_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfdata_btree_key_value_index_entry libfdata_btree_key_value_index_entry_t;
+
+struct libfdata_btree_key_value_index_entry
+{
+	/* The key value hash
+	 */
+	uint32_t key_value_hash;
+
+	/* The (mapped) leaf value index
+	 * -1 if the entry is not used
+	 */
+	int leaf_value_index;
+};
+
+typedef struct libfdata_btree_key_value_index libfdata_btree_key_value_index_t;
+
+struct libfdata_btree_key_value_index
+{
+	/* The entries
+	 */
+	libfdata_btree_key_value_index_entry_t *entries;
+
+	/* The number of allocated entries
+	 * this value is 0 or a power of 2
+	 */
+	int number_of_allocated_entries;
+
+	/* The number of used entries
+	 */
+	int number_of_entries;
+
+	/* Value to indicate the index contains the key values of all leaf values
+	 */
+	uint8_t is_complete;
+};
+
+int libfdata_btree_key_value_index_initialize(
+     libfdata_btree_key_value_index_t **index,
+     libcerror_error_t **error );
+
+int libfdata_btree_key_value_index_free(
+     libfdata_btree_key_value_index_t **index,
+     libcerror_error_t **error );
+
+int libfdata_btree_key_value_index_empty(
+     libfdata_btree_key_value_index_t *index,
+     libcerror_error_t **error );
+
+int libfdata_btree_key_value_index_resize(
+     libfdata_btree_key_value_index_t *index,
+     int number_of_allocated_entries,
+     libcerror_error_t **error );
+
+int libfdata_btree_key_value_index_insert(
+     libfdata_btree_key_value_index_t *index,
+     uint32_t key_value_hash,
+     int leaf_value_index,
+     libcerror_error_t **error );
+
+int libfdata_btree_key_value_index_get_next_leaf_value_index(
+     libfdata_btree_key_value_index_t *index,
+     uint32_t key_value_hash,
+     int *entry_index,
+     int *leaf_value_index,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFDATA_BTREE_KEY_VALUE_INDEX_H ) */
+
@@ -0,0 +1,438 @@
+/*
+ * The balanced tree leaf count table functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfdata_btree_leaf_count_table.h"
+#include "libfdata_libcerror.h"
+
+/* The initial number of allocated entries, must be a power of 2
+ */
+#define LIBFDATA_BTREE_LEAF_COUNT_TABLE_INITIAL_NUMBER_OF_ENTRIES	64
+
+/* Calculates the hash of a node data file index and offset
+ */
+#define libfdata_btree_leaf_count_table_calculate_hash( node_data_file_index, node_data_offset ) \
+	( ( (uint32_t) ( node_data_offset ) ^ (uint32_t) ( (uint64_t) ( node_data_offset ) >> 32 ) ^ (uint32_t) ( node_data_file_index ) ) * 0x9e3779b1UL )
+
+/* Creates a leaf count table
+ * Make sure the value table is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_leaf_count_table_initialize(
+     libfdata_btree_leaf_count_table_t **table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_btree_leaf_count_table_initialize";
+
+	if( table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*table = memory_allocate_structure(
+	          libfdata_btree_leaf_count_table_t );
+
+	if( *table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *table,
+	     0,
+	     sizeof( libfdata_btree_leaf_count_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear table.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *table != NULL )
+	{
+		memory_free(
+		 *table );
+
+		*table = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a leaf count table
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_leaf_count_table_free(
+     libfdata_btree_leaf_count_table_t **table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_btree_leaf_count_table_free";
+
+	if( table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *table != NULL )
+	{
+		if( ( *table )->entries != NULL )
+		{
+			memory_free(
+			 ( *table )->entries );
+		}
+		memory_free(
+		 *table );
+
+		*table = NULL;
+	}
+	return( 1 );
+}
+
+/* Empties a leaf count table
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_leaf_count_table_empty(
+     libfdata_btree_leaf_count_table_t *table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_btree_leaf_count_table_empty";
+
+	if( table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table.",
+		 function );
+
+		return( -1 );
+	}
+	if( table->entries != NULL )
+	{
+		memory_free(
+		 table->entries );
+
+		table->entries = NULL;
+	}
+	table->number_of_allocated_entries = 0;
+	table->number_of_entries           = 0;
+
+	return( 1 );
+}
+
+/* Resizes the entries of a leaf count table
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_leaf_count_table_resize(
+     libfdata_btree_leaf_count_table_t *table,
+     int number_of_allocated_entries,
+     libcerror_error_t **error )
+{
+	libfdata_btree_leaf_count_table_entry_t *entries = NULL;
+	static char *function                            = "libfdata_btree_leaf_count_table_resize";
+	uint32_t hash                                    = 0;
+	int entry_index                                  = 0;
+	int old_entry_index                              = 0;
+
+	if( table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_allocated_entries <= table->number_of_entries )
+	 || ( (size_t) number_of_allocated_entries > ( (size_t) SSIZE_MAX / sizeof( libfdata_btree_leaf_count_table_entry_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of allocated entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entries = (libfdata_btree_leaf_count_table_entry_t *) memory_allocate(
+	                                                       sizeof( libfdata_btree_leaf_count_table_entry_t ) * number_of_allocated_entries );
+
+	if( entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_allocated_entries;
+	     entry_index++ )
+	{
+		entries[ entry_index ].node_data_file_index = -1;
+	}
+	for( old_entry_index = 0;
+	     old_entry_index < table->number_of_allocated_entries;
+	     old_entry_index++ )
+	{
+		if( table->entries[ old_entry_index ].node_data_file_index == -1 )
+		{
+			continue;
+		}
+		hash = libfdata_btree_leaf_count_table_calculate_hash(
+		        table->entries[ old_entry_index ].node_data_file_index,
+		        table->entries[ old_entry_index ].node_data_offset );
+
+		entry_index = (int) ( hash & (uint32_t) ( number_of_allocated_entries - 1 ) );
+
+		while( entries[ entry_index ].node_data_file_index != -1 )
+		{
+			entry_index = ( entry_index + 1 ) & ( number_of_allocated_entries - 1 );
+		}
+		entries[ entry_index ] = table->entries[ old_entry_index ];
+	}
+	if( table->entries != NULL )
+	{
+		memory_free(
+		 table->entries );
+	}
+	table->entries                     = entries;
+	table->number_of_allocated_entries = number_of_allocated_entries;
+
+	return( 1 );
+}
+
+/* Retrieves the number of leaf values of the sub tree of a specific node
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfdata_btree_leaf_count_table_get_number_of_leaf_values(
+     libfdata_btree_leaf_count_table_t *table,
+     int node_data_file_index,
+     off64_t node_data_offset,
+     int *number_of_leaf_values,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_btree_leaf_count_table_get_number_of_leaf_values";
+	uint32_t hash         = 0;
+	int entry_index       = 0;
+
+	if( table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_leaf_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of leaf values.",
+		 function );
+
+		return( -1 );
+	}
+	if( table->number_of_entries == 0 )
+	{
+		return( 0 );
+	}
+	hash = libfdata_btree_leaf_count_table_calculate_hash(
+	        node_data_file_index,
+	        node_data_offset );
+
+	entry_index = (int) ( hash & (uint32_t) ( table->number_of_allocated_entries - 1 ) );
+
+	while( table->entries[ entry_index ].node_data_file_index != -1 )
+	{
+		if( ( table->entries[ entry_index ].node_data_file_index == node_data_file_index )
+		 && ( table->entries[ entry_index ].node_data_offset == node_data_offset ) )
+		{
+			*number_of_leaf_values = table->entries[ entry_index ].number_of_leaf_values;
+
+			return( 1 );
+		}
+		entry_index = ( entry_index + 1 ) & ( table->number_of_allocated_entries - 1 );
+	}
+	return( 0 );
+}
+
+/* Sets the number of leaf values of the sub tree of a specific node
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_leaf_count_table_set_number_of_leaf_values(
+     libfdata_btree_leaf_count_table_t *table,
+     int node_data_file_index,
+     off64_t node_data_offset,
+     int number_of_leaf_values,
+     libcerror_error_t **error )
+{
+	static char *function           = "libfdata_btree_leaf_count_table_set_number_of_leaf_values";
+	uint32_t hash                   = 0;
+	int entry_index                 = 0;
+	int number_of_allocated_entries = 0;
+
+	if( table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_data_file_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid node data file index value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_leaf_values < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of leaf values value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	/* Keep the load factor of the table below 3/4
+	 */
+	if( ( table->number_of_entries + 1 ) > ( ( table->number_of_allocated_entries / 4 ) * 3 ) )
+	{
+		if( table->number_of_allocated_entries == 0 )
+		{
+			number_of_allocated_entries = LIBFDATA_BTREE_LEAF_COUNT_TABLE_INITIAL_NUMBER_OF_ENTRIES;
+		}
+		else if( table->number_of_allocated_entries > ( INT_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid table - number of allocated entries value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		else
+		{
+			number_of_allocated_entries = table->number_of_allocated_entries * 2;
+		}
+		if( libfdata_btree_leaf_count_table_resize(
+		     table,
+		     number_of_allocated_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize table.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	hash = libfdata_btree_leaf_count_table_calculate_hash(
+	        node_data_file_index,
+	        node_data_offset );
+
+	entry_index = (int) ( hash & (uint32_t) ( table->number_of_allocated_entries - 1 ) );
+
+	while( table->entries[ entry_index ].node_data_file_index != -1 )
+	{
+		if( ( table->entries[ entry_index ].node_data_file_index == node_data_file_index )
+		 && ( table->entries[ entry_index ].node_data_offset == node_data_offset ) )
+		{
+			table->entries[ entry_index ].number_of_leaf_values = number_of_leaf_values;
+
+			return( 1 );
+		}
+		entry_index = ( entry_index + 1 ) & ( table->number_of_allocated_entries - 1 );
+	}
+	table->entries[ entry_index ].node_data_offset      = node_data_offset;
+	table->entries[ entry_index ].node_data_file_index  = node_data_file_index;
+	table->entries[ entry_index ].number_of_leaf_values = number_of_leaf_values;
+
+	table->number_of_entries += 1;
+
+	return( 1 );
+}
+
@@ -0,0 +1,106 @@
+/*
+ * The balanced tree leaf count table functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFDATA_BTREE_LEAF_COUNT_TABLE_H )
+#define _LIBFDATA_BTREE_LEAF_COUNT_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfdata_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfdata_btree_leaf_count_table_entry libfdata_btree_leaf_count_table_entry_t;
+
+struct libfdata_btree_leaf_count_table_entry
+{
+	/* The node data offset
+	 */
+	off64_t node_data_offset;
+
+	/* The node data file index
+	 * -1 if the entry is not used
+	 */
+	int node_data_file_index;
+
+	/* The number of leaf values in the sub tree of the node
+	 */
+	int number_of_leaf_values;
+};
+
+typedef struct libfdata_btree_leaf_count_table libfdata_btree_leaf_count_table_t;
+
+struct libfdata_btree_leaf_count_table
+{
+	/* The entries
+	 */
+	libfdata_btree_leaf_count_table_entry_t *entries;
+
+	/* The number of allocated entries
+	 * this value is 0 or a power of 2
+	 */
+	int number_of_allocated_entries;
+
+	/* The number of used entries
+	 */
+	int number_of_entries;
+};
+
+int libfdata_btree_leaf_count_table_initialize(
+     libfdata_btree_leaf_count_table_t **table,
+     libcerror_error_t **error );
+
+int libfdata_btree_leaf_count_table_free(
+     libfdata_btree_leaf_count_table_t **table,
+     libcerror_error_t **error );
+
+int libfdata_btree_leaf_count_table_empty(
+     libfdata_btree_leaf_count_table_t *table,
+     libcerror_error_t **error );
+
+int libfdata_btree_leaf_count_table_resize(
+     libfdata_btree_leaf_count_table_t *table,
+     int number_of_allocated_entries,
+     libcerror_error_t **error );
+
+int libfdata_btree_leaf_count_table_get_number_of_leaf_values(
+     libfdata_btree_leaf_count_table_t *table,
+     int node_data_file_index,
+     off64_t node_data_offset,
+     int *number_of_leaf_values,
+     libcerror_error_t **error );
+
+int libfdata_btree_leaf_count_table_set_number_of_leaf_values(
+     libfdata_btree_leaf_count_table_t *table,
+     int node_data_file_index,
+     off64_t node_data_offset,
+     int number_of_leaf_values,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFDATA_BTREE_LEAF_COUNT_TABLE_H ) */
+
@@ -26,11 +26,14 @@
 #include "libfdata_btree_node.h"
 #include "libfdata_btree_range.h"
 #include "libfdata_definitions.h"
-#include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libcnotify.h"
 #include "libfdata_types.h"
 
+/* The initial number of allocated ranges
+ */
+#define LIBFDATA_BTREE_NODE_INITIAL_NUMBER_OF_ALLOCATED_RANGES	16
+
 /* Creates a node
  * Make sure the value node is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -132,6 +135,7 @@ int libfdata_btree_node_free(
 {
 	libfdata_internal_btree_node_t *internal_tree_node = NULL;
 	static char *function                              = "libfdata_btree_node_free";
+	int range_index                                    = 0;
 	int result                                         = 1;
 
 	if( node == NULL )
@@ -150,39 +154,34 @@ int libfdata_btree_node_free(
 		internal_tree_node = (libfdata_internal_btree_node_t *) *node;
 		*node              = NULL;
 
-		if( internal_tree_node->sub_node_ranges_array != NULL )
+		if( internal_tree_node->ranges != NULL )
 		{
-			if( libcdata_array_free(
-			     &( internal_tree_node->sub_node_ranges_array ),
-			     (int (*)(intptr_t **, libcerror_error_t **error)) &libfdata_btree_range_free,
-			     error ) != 1 )
+			for( range_index = 0;
+			     range_index < internal_tree_node->number_of_ranges;
+			     range_index++ )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free the sub node ranges array.",
-				 function );
-
-				result = -1;
+				if( libfdata_btree_range_clear(
+				     &( internal_tree_node->ranges[ range_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to clear range: %d.",
+					 function,
+					 range_index );
+
+					result = -1;
+				}
 			}
+			memory_free(
+			 internal_tree_node->ranges );
 		}
-		if( internal_tree_node->leaf_value_ranges_array != NULL )
+		if( internal_tree_node->sub_node_leaf_value_offsets != NULL )
 		{
-			if( libcdata_array_free(
-			     &( internal_tree_node->leaf_value_ranges_array ),
-			     (int (*)(intptr_t **, libcerror_error_t **error)) &libfdata_btree_range_free,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free the leaf value ranges array.",
-				 function );
-
-				result = -1;
-			}
+			memory_free(
+			 internal_tree_node->sub_node_leaf_value_offsets );
 		}
 		memory_free(
 		 internal_tree_node );
@@ -190,6 +189,182 @@ int libfdata_btree_node_free(
 	return( result );
 }
 
+/* Retrieves a specific range
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_node_get_range_by_index(
+     libfdata_internal_btree_node_t *internal_tree_node,
+     int range_index,
+     libfdata_btree_range_t **range,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_btree_node_get_range_by_index";
+
+	if( internal_tree_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_index < 0 )
+	 || ( range_index >= internal_tree_node->number_of_ranges ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range.",
+		 function );
+
+		return( -1 );
+	}
+	*range = &( internal_tree_node->ranges[ range_index ] );
+
+	return( 1 );
+}
+
+/* Appends an empty range
+ * The ranges are stored in a single contiguous array that is resized when
+ * necessary, hence a range is only valid until the next range is appended
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_node_append_range(
+     libfdata_internal_btree_node_t *internal_tree_node,
+     int *range_index,
+     libfdata_btree_range_t **range,
+     libcerror_error_t **error )
+{
+	static char *function          = "libfdata_btree_node_append_range";
+	void *reallocation             = NULL;
+	int number_of_allocated_ranges = 0;
+
+	if( internal_tree_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range index.",
+		 function );
+
+		return( -1 );
+	}
+	if( range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_tree_node->number_of_ranges >= internal_tree_node->number_of_allocated_ranges )
+	{
+		if( internal_tree_node->number_of_allocated_ranges == 0 )
+		{
+			number_of_allocated_ranges = LIBFDATA_BTREE_NODE_INITIAL_NUMBER_OF_ALLOCATED_RANGES;
+		}
+		else if( internal_tree_node->number_of_allocated_ranges > ( INT_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated ranges value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		else
+		{
+			number_of_allocated_ranges = internal_tree_node->number_of_allocated_ranges * 2;
+		}
+		if( (size_t) number_of_allocated_ranges > ( (size_t) SSIZE_MAX / sizeof( libfdata_btree_range_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated ranges value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                internal_tree_node->ranges,
+		                sizeof( libfdata_btree_range_t ) * number_of_allocated_ranges );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize ranges.",
+			 function );
+
+			return( -1 );
+		}
+		internal_tree_node->ranges                     = (libfdata_btree_range_t *) reallocation;
+		internal_tree_node->number_of_allocated_ranges = number_of_allocated_ranges;
+	}
+	*range = &( internal_tree_node->ranges[ internal_tree_node->number_of_ranges ] );
+
+	if( memory_set(
+	     *range,
+	     0,
+	     sizeof( libfdata_btree_range_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear range.",
+		 function );
+
+		*range = NULL;
+
+		return( -1 );
+	}
+	( *range )->file_index = -1;
+	( *range )->offset     = (off64_t) -1;
+
+	*range_index = internal_tree_node->number_of_ranges;
+
+	internal_tree_node->number_of_ranges += 1;
+
+	return( 1 );
+}
+
 /* Node functions
  */
 
@@ -350,7 +525,7 @@ int libfdata_btree_node_get_number_of_sub_nodes(
 	}
 	internal_tree_node = (libfdata_internal_btree_node_t *) node;
 
-	if( internal_tree_node->sub_node_ranges_array == NULL )
+	if( ( internal_tree_node->flags & LIBFDATA_BTREE_NODE_FLAG_IS_BRANCH ) == 0 )
 	{
 		if( number_of_sub_nodes == NULL )
 		{
@@ -367,20 +542,7 @@ int libfdata_btree_node_get_number_of_sub_nodes(
 	}
 	else
 	{
-		if( libcdata_array_get_number_of_entries(
-		     internal_tree_node->sub_node_ranges_array,
-		     number_of_sub_nodes,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of entries from sub node ranges array.",
-			 function );
-
-			return( -1 );
-		}
+		*number_of_sub_nodes = internal_tree_node->number_of_ranges;
 	}
 	return( 1 );
 }
@@ -410,28 +572,28 @@ int libfdata_btree_node_get_sub_node_data_range_by_index(
 	}
 	internal_tree_node = (libfdata_internal_btree_node_t *) node;
 
-	if( internal_tree_node->sub_node_ranges_array == NULL )
+	if( ( internal_tree_node->flags & LIBFDATA_BTREE_NODE_FLAG_IS_BRANCH ) == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid node - missing sub node ranges array.",
+		 "%s: invalid node - missing sub node ranges.",
 		 function );
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     internal_tree_node->sub_node_ranges_array,
+	if( libfdata_btree_node_get_range_by_index(
+	     internal_tree_node,
 	     sub_node_index,
-	     (intptr_t **) sub_node_data_range,
+	     sub_node_data_range,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from sub node ranges array.",
+		 "%s: unable to retrieve sub node range: %d.",
 		 function,
 		 sub_node_index );
 
@@ -467,13 +629,13 @@ int libfdata_btree_node_get_sub_node_data_range_by_mapped_index(
 	}
 	internal_tree_node = (libfdata_internal_btree_node_t *) node;
 
-	if( internal_tree_node->sub_node_ranges_array == NULL )
+	if( ( internal_tree_node->flags & LIBFDATA_BTREE_NODE_FLAG_IS_BRANCH ) == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid node - missing sub node ranges array.",
+		 "%s: invalid node - missing sub node ranges.",
 		 function );
 
 		return( -1 );
@@ -498,52 +660,13 @@ int libfdata_btree_node_get_sub_node_data_range_by_mapped_index(
 		 mapped_index );
 	}
 #endif
-	if( libcdata_array_get_number_of_entries(
-	     internal_tree_node->sub_node_ranges_array,
-	     &number_of_sub_nodes,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from sub node ranges array.",
-		 function );
+	number_of_sub_nodes = internal_tree_node->number_of_ranges;
 
-		return( -1 );
-	}
 	for( sub_node_index = 0;
 	     sub_node_index < number_of_sub_nodes;
 	     sub_node_index++ )
 	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_tree_node->sub_node_ranges_array,
-		     sub_node_index,
-		     (intptr_t **) sub_node_data_range,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from sub node ranges array.",
-			 function,
-			 sub_node_index );
-
-			return( -1 );
-		}
-		if( *sub_node_data_range == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing sub node: %d data range.",
-			 function,
-			 sub_node_index );
-
-			return( -1 );
-		}
+		*sub_node_data_range = &( internal_tree_node->ranges[ sub_node_index ] );
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
@@ -613,13 +736,13 @@ int libfdata_btree_node_get_sub_node_data_range_by_key(
 	}
 	internal_tree_node = (libfdata_internal_btree_node_t *) node;
 
-	if( internal_tree_node->sub_node_ranges_array == NULL )
+	if( ( internal_tree_node->flags & LIBFDATA_BTREE_NODE_FLAG_IS_BRANCH ) == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid node - missing sub node ranges array.",
+		 "%s: invalid node - missing sub node ranges.",
 		 function );
 
 		return( -1 );
@@ -646,52 +769,13 @@ int libfdata_btree_node_get_sub_node_data_range_by_key(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_number_of_entries(
-	     internal_tree_node->sub_node_ranges_array,
-	     &number_of_sub_nodes,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from sub node ranges array.",
-		 function );
+	number_of_sub_nodes = internal_tree_node->number_of_ranges;
 
-		return( -1 );
-	}
 	for( search_node_index = 0;
 	     search_node_index < number_of_sub_nodes;
 	     search_node_index++ )
 	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_tree_node->sub_node_ranges_array,
-		     search_node_index,
-		     (intptr_t **) sub_node_data_range,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from sub node ranges array.",
-			 function,
-			 search_node_index );
-
-			return( -1 );
-		}
-		if( *sub_node_data_range == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing sub node: %d data range.",
-			 function,
-			 search_node_index );
-
-			return( -1 );
-		}
+		*sub_node_data_range = &( internal_tree_node->ranges[ search_node_index ] );
 		if( key_value_compare_function == NULL )
 		{
 			if( key_value == ( *sub_node_data_range )->key_value )
@@ -839,7 +923,7 @@ int libfdata_btree_node_set_sub_node_by_index(
 	}
 	internal_tree_node = (libfdata_internal_btree_node_t *) node;
 
-	if( internal_tree_node->sub_node_ranges_array == NULL )
+	if( ( internal_tree_node->flags & LIBFDATA_BTREE_NODE_FLAG_IS_BRANCH ) == 0 )
 	{
 		libcerror_error_set(
 		 error,
@@ -850,17 +934,17 @@ int libfdata_btree_node_set_sub_node_by_index(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     internal_tree_node->sub_node_ranges_array,
+	if( libfdata_btree_node_get_range_by_index(
+	     internal_tree_node,
 	     sub_node_index,
-	     (intptr_t **) &data_range,
+	     &data_range,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from sub node ranges array.",
+		 "%s: unable to retrieve sub node range: %d.",
 		 function,
 		 sub_node_index );
 
@@ -935,35 +1019,20 @@ int libfdata_btree_node_append_sub_node(
 
 		return( -1 );
 	}
-	if( internal_tree_node->sub_node_ranges_array == NULL )
-	{
-		if( libcdata_array_initialize(
-		     &( internal_tree_node->sub_node_ranges_array ),
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create sub node ranges array.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	if( libfdata_btree_range_initialize(
+	if( libfdata_btree_node_append_range(
+	     internal_tree_node,
+	     sub_node_index,
 	     &data_range,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create data range.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append sub node range.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( libfdata_btree_range_set(
 	     data_range,
@@ -983,35 +1052,15 @@ int libfdata_btree_node_append_sub_node(
 		 "%s: unable to set data range.",
 		 function );
 
-		goto on_error;
-	}
-	if( libcdata_array_append_entry(
-	     internal_tree_node->sub_node_ranges_array,
-	     sub_node_index,
-	     (intptr_t *) data_range,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append data range to sub node ranges array.",
-		 function );
+		/* The appended range does not contain values that need to be freed
+		 */
+		internal_tree_node->number_of_ranges -= 1;
 
-		goto on_error;
+		return( -1 );
 	}
 	internal_tree_node->flags |= LIBFDATA_BTREE_NODE_FLAG_IS_BRANCH;
 
 	return( 1 );
-
-on_error:
-	if( data_range != NULL )
-	{
-		libfdata_btree_range_free(
-		 &data_range,
-		 NULL );
-	}
-	return( -1 );
 }
 
 /* Branch leaf values functions
@@ -1057,6 +1106,283 @@ int libfdata_btree_node_get_number_of_leaf_values_in_branch(
 	return( 1 );
 }
 
+/* Retrieves the number of mapped sub nodes and the number of leaf values in them
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_node_get_number_of_mapped_sub_nodes(
+     libfdata_btree_node_t *node,
+     int *number_of_mapped_sub_nodes,
+     int *number_of_mapped_leaf_values,
+     libcerror_error_t **error )
+{
+	libfdata_internal_btree_node_t *internal_tree_node = NULL;
+	static char *function                              = "libfdata_btree_node_get_number_of_mapped_sub_nodes";
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_btree_node_t *) node;
+
+	if( number_of_mapped_sub_nodes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of mapped sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_mapped_leaf_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of mapped leaf values.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_mapped_sub_nodes = internal_tree_node->number_of_mapped_sub_nodes;
+
+	if( internal_tree_node->sub_node_leaf_value_offsets == NULL )
+	{
+		*number_of_mapped_leaf_values = 0;
+	}
+	else
+	{
+		*number_of_mapped_leaf_values = internal_tree_node->sub_node_leaf_value_offsets[ internal_tree_node->number_of_mapped_sub_nodes ];
+	}
+	return( 1 );
+}
+
+/* Maps the number of leaf values of the next unmapped sub node
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_node_append_mapped_sub_node(
+     libfdata_btree_node_t *node,
+     int number_of_leaf_values,
+     libcerror_error_t **error )
+{
+	libfdata_internal_btree_node_t *internal_tree_node = NULL;
+	static char *function                              = "libfdata_btree_node_append_mapped_sub_node";
+	void *reallocation                                 = NULL;
+	int number_of_mapped_leaf_values                   = 0;
+	int number_of_sub_nodes                            = 0;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_btree_node_t *) node;
+
+	if( number_of_leaf_values < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of leaf values value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_sub_nodes = internal_tree_node->number_of_ranges;
+	if( internal_tree_node->number_of_mapped_sub_nodes >= number_of_sub_nodes )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid node - all sub nodes are mapped.",
+		 function );
+
+		return( -1 );
+	}
+	/* The sub node leaf value offsets contains one more entry
+	 * than the number of sub nodes
+	 */
+	if( internal_tree_node->number_of_allocated_sub_node_leaf_value_offsets <= number_of_sub_nodes )
+	{
+		if( (size_t) number_of_sub_nodes >= ( (size_t) SSIZE_MAX / sizeof( int ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of sub nodes value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                internal_tree_node->sub_node_leaf_value_offsets,
+		                sizeof( int ) * ( number_of_sub_nodes + 1 ) );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize sub node leaf value offsets.",
+			 function );
+
+			return( -1 );
+		}
+		if( internal_tree_node->sub_node_leaf_value_offsets == NULL )
+		{
+			( (int *) reallocation )[ 0 ] = 0;
+		}
+		internal_tree_node->sub_node_leaf_value_offsets                     = (int *) reallocation;
+		internal_tree_node->number_of_allocated_sub_node_leaf_value_offsets = number_of_sub_nodes + 1;
+	}
+	number_of_mapped_leaf_values = internal_tree_node->sub_node_leaf_value_offsets[ internal_tree_node->number_of_mapped_sub_nodes ];
+
+	if( number_of_leaf_values > ( INT_MAX - number_of_mapped_leaf_values ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of leaf values value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node->number_of_mapped_sub_nodes += 1;
+
+	internal_tree_node->sub_node_leaf_value_offsets[ internal_tree_node->number_of_mapped_sub_nodes ] = number_of_mapped_leaf_values + number_of_leaf_values;
+
+	return( 1 );
+}
+
+/* Retrieves the sub node data range that contains a specific leaf value
+ * The leaf value index is relative to the first leaf value of the node
+ * Only mapped sub nodes are searched, using a binary search
+ * Returns 1 if successful, 0 if the leaf value is not within the mapped sub nodes or -1 on error
+ */
+int libfdata_btree_node_get_sub_node_data_range_by_leaf_value_index(
+     libfdata_btree_node_t *node,
+     int leaf_value_index,
+     int *sub_node_leaf_value_index,
+     libfdata_btree_range_t **sub_node_data_range,
+     libcerror_error_t **error )
+{
+	libfdata_internal_btree_node_t *internal_tree_node = NULL;
+	static char *function                              = "libfdata_btree_node_get_sub_node_data_range_by_leaf_value_index";
+	int first_sub_node_index                           = 0;
+	int last_sub_node_index                            = 0;
+	int sub_node_index                                 = 0;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_btree_node_t *) node;
+
+	if( leaf_value_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid leaf value index value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_node_leaf_value_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node leaf value index.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_node_data_range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node data range.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_tree_node->sub_node_leaf_value_offsets == NULL )
+	 || ( leaf_value_index >= internal_tree_node->sub_node_leaf_value_offsets[ internal_tree_node->number_of_mapped_sub_nodes ] ) )
+	{
+		return( 0 );
+	}
+	/* Find the last sub node of which the first leaf value is less than
+	 * or equal to the leaf value index, this skips sub nodes without leaf values
+	 */
+	first_sub_node_index = 0;
+	last_sub_node_index  = internal_tree_node->number_of_mapped_sub_nodes - 1;
+
+	while( first_sub_node_index < last_sub_node_index )
+	{
+		sub_node_index = first_sub_node_index + ( ( last_sub_node_index - first_sub_node_index + 1 ) / 2 );
+
+		if( internal_tree_node->sub_node_leaf_value_offsets[ sub_node_index ] <= leaf_value_index )
+		{
+			first_sub_node_index = sub_node_index;
+		}
+		else
+		{
+			last_sub_node_index = sub_node_index - 1;
+		}
+	}
+	if( libfdata_btree_node_get_range_by_index(
+	     internal_tree_node,
+	     first_sub_node_index,
+	     sub_node_data_range,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub node range: %d.",
+		 function,
+		 first_sub_node_index );
+
+		return( -1 );
+	}
+	*sub_node_leaf_value_index = leaf_value_index - internal_tree_node->sub_node_leaf_value_offsets[ first_sub_node_index ];
+
+	return( 1 );
+}
+
 /* Leaf value data range functions
  */
 
@@ -1084,7 +1410,7 @@ int libfdata_btree_node_get_number_of_leaf_values(
 	}
 	internal_tree_node = (libfdata_internal_btree_node_t *) node;
 
-	if( internal_tree_node->leaf_value_ranges_array == NULL )
+	if( ( internal_tree_node->flags & LIBFDATA_BTREE_NODE_FLAG_IS_LEAF ) == 0 )
 	{
 		if( number_of_leaf_values == NULL )
 		{
@@ -1101,20 +1427,7 @@ int libfdata_btree_node_get_number_of_leaf_values(
 	}
 	else
 	{
-		if( libcdata_array_get_number_of_entries(
-		     internal_tree_node->leaf_value_ranges_array,
-		     number_of_leaf_values,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of entries from leaf value ranges array.",
-			 function );
-
-			return( -1 );
-		}
+		*number_of_leaf_values = internal_tree_node->number_of_ranges;
 	}
 	return( 1 );
 }
@@ -1144,28 +1457,28 @@ int libfdata_btree_node_get_leaf_value_data_range_by_index(
 	}
 	internal_tree_node = (libfdata_internal_btree_node_t *) node;
 
-	if( internal_tree_node->leaf_value_ranges_array == NULL )
+	if( ( internal_tree_node->flags & LIBFDATA_BTREE_NODE_FLAG_IS_LEAF ) == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid node - missing leaf value ranges array.",
+		 "%s: invalid node - missing leaf value ranges.",
 		 function );
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     internal_tree_node->leaf_value_ranges_array,
+	if( libfdata_btree_node_get_range_by_index(
+	     internal_tree_node,
 	     leaf_value_index,
-	     (intptr_t **) leaf_value_data_range,
+	     leaf_value_data_range,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from leaf value ranges array.",
+		 "%s: unable to retrieve leaf value range: %d.",
 		 function,
 		 leaf_value_index );
 
@@ -1201,13 +1514,13 @@ int libfdata_btree_node_get_leaf_value_data_range_by_mapped_index(
 	}
 	internal_tree_node = (libfdata_internal_btree_node_t *) node;
 
-	if( internal_tree_node->leaf_value_ranges_array == NULL )
+	if( ( internal_tree_node->flags & LIBFDATA_BTREE_NODE_FLAG_IS_LEAF ) == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid node - missing leaf value ranges array.",
+		 "%s: invalid node - missing leaf value ranges.",
 		 function );
 
 		return( -1 );
@@ -1232,52 +1545,13 @@ int libfdata_btree_node_get_leaf_value_data_range_by_mapped_index(
 		 mapped_index );
 	}
 #endif
-	if( libcdata_array_get_number_of_entries(
-	     internal_tree_node->leaf_value_ranges_array,
-	     &number_of_leaf_values,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from leaf value ranges array.",
-		 function );
+	number_of_leaf_values = internal_tree_node->number_of_ranges;
 
-		return( -1 );
-	}
 	for( leaf_value_index = 0;
 	     leaf_value_index < number_of_leaf_values;
 	     leaf_value_index++ )
 	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_tree_node->leaf_value_ranges_array,
-		     leaf_value_index,
-		     (intptr_t **) leaf_value_data_range,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from leaf value ranges array.",
-			 function,
-			 leaf_value_index );
-
-			return( -1 );
-		}
-		if( *leaf_value_data_range == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing leaf value: %d data range.",
-			 function,
-			 leaf_value_index );
-
-			return( -1 );
-		}
+		*leaf_value_data_range = &( internal_tree_node->ranges[ leaf_value_index ] );
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
@@ -1344,13 +1618,13 @@ int libfdata_btree_node_get_leaf_value_data_range_by_key(
 	}
 	internal_tree_node = (libfdata_internal_btree_node_t *) node;
 
-	if( internal_tree_node->leaf_value_ranges_array == NULL )
+	if( ( internal_tree_node->flags & LIBFDATA_BTREE_NODE_FLAG_IS_LEAF ) == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid node - missing leaf value ranges array.",
+		 "%s: invalid node - missing leaf value ranges.",
 		 function );
 
 		return( -1 );
@@ -1366,52 +1640,13 @@ int libfdata_btree_node_get_leaf_value_data_range_by_key(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_number_of_entries(
-	     internal_tree_node->leaf_value_ranges_array,
-	     &number_of_leaf_values,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from leaf value ranges array.",
-		 function );
+	number_of_leaf_values = internal_tree_node->number_of_ranges;
 
-		return( -1 );
-	}
 	for( leaf_value_index = 0;
 	     leaf_value_index < number_of_leaf_values;
 	     leaf_value_index++ )
 	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_tree_node->leaf_value_ranges_array,
-		     leaf_value_index,
-		     (intptr_t **) leaf_value_data_range,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from leaf value ranges array.",
-			 function,
-			 leaf_value_index );
-
-			return( -1 );
-		}
-		if( *leaf_value_data_range == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing leaf value: %d data range.",
-			 function,
-			 leaf_value_index );
-
-			return( -1 );
-		}
+		*leaf_value_data_range = &( internal_tree_node->ranges[ leaf_value_index ] );
 		if( key_value_compare_function == NULL )
 		{
 			if( key_value == ( *leaf_value_data_range )->key_value )
@@ -1611,7 +1846,7 @@ int libfdata_btree_node_set_leaf_value_by_index(
 	}
 	internal_tree_node = (libfdata_internal_btree_node_t *) node;
 
-	if( internal_tree_node->leaf_value_ranges_array == NULL )
+	if( ( internal_tree_node->flags & LIBFDATA_BTREE_NODE_FLAG_IS_LEAF ) == 0 )
 	{
 		libcerror_error_set(
 		 error,
@@ -1622,17 +1857,17 @@ int libfdata_btree_node_set_leaf_value_by_index(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     internal_tree_node->leaf_value_ranges_array,
+	if( libfdata_btree_node_get_range_by_index(
+	     internal_tree_node,
 	     leaf_value_index,
-	     (intptr_t **) &data_range,
+	     &data_range,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from leaf value ranges array.",
+		 "%s: unable to retrieve leaf value range: %d.",
 		 function,
 		 leaf_value_index );
 
@@ -1707,35 +1942,20 @@ int libfdata_btree_node_append_leaf_value(
 
 		return( -1 );
 	}
-	if( internal_tree_node->leaf_value_ranges_array == NULL )
-	{
-		if( libcdata_array_initialize(
-		     &( internal_tree_node->leaf_value_ranges_array ),
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create leaf value ranges array.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	if( libfdata_btree_range_initialize(
+	if( libfdata_btree_node_append_range(
+	     internal_tree_node,
+	     leaf_value_index,
 	     &data_range,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create data range.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append leaf value range.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( libfdata_btree_range_set(
 	     data_range,
@@ -1755,34 +1975,14 @@ int libfdata_btree_node_append_leaf_value(
 		 "%s: unable to set data range.",
 		 function );
 
-		goto on_error;
-	}
-	if( libcdata_array_append_entry(
-	     internal_tree_node->leaf_value_ranges_array,
-	     leaf_value_index,
-	     (intptr_t *) data_range,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append data range to leaf value ranges array.",
-		 function );
+		/* The appended range does not contain values that need to be freed
+		 */
+		internal_tree_node->number_of_ranges -= 1;
 
-		goto on_error;
+		return( -1 );
 	}
 	internal_tree_node->flags |= LIBFDATA_BTREE_NODE_FLAG_IS_LEAF;
 
 	return( 1 );
-
-on_error:
-	if( data_range != NULL )
-	{
-		libfdata_btree_range_free(
-		 &data_range,
-		 NULL );
-	}
-	return( -1 );
 }
 
@@ -27,7 +27,6 @@
 
 #include "libfdata_btree_range.h"
 #include "libfdata_extern.h"
-#include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_types.h"
 
@@ -43,17 +42,37 @@ struct libfdata_internal_btree_node
 	 */
 	int level;
 
-	/* The sub node (data) ranges array
+	/* The (data) ranges
+	 * contains the sub node ranges of a branch node or
+	 * the leaf value ranges of a leaf node
 	 */
-	libcdata_array_t *sub_node_ranges_array;
+	libfdata_btree_range_t *ranges;
+
+	/* The number of ranges
+	 */
+	int number_of_ranges;
+
+	/* The number of allocated ranges
+	 */
+	int number_of_allocated_ranges;
 
 	/* The number of leaf values in the branch
 	 */
 	int branch_number_of_leaf_values;
 
-	/* The leaf value (data) ranges array
+	/* The number of sub nodes of which the number of leaf values is mapped
+	 */
+	int number_of_mapped_sub_nodes;
+
+	/* The sub node leaf value offsets
+	 * contains the index of the first leaf value of every mapped sub node
+	 * relative to the node, followed by the number of mapped leaf values
 	 */
-	libcdata_array_t *leaf_value_ranges_array;
+	int *sub_node_leaf_value_offsets;
+
+	/* The number of allocated sub node leaf value offsets
+	 */
+	int number_of_allocated_sub_node_leaf_value_offsets;
 
 	/* The flags
 	 */
@@ -69,6 +88,18 @@ int libfdata_btree_node_free(
      libfdata_btree_node_t **node,
      libcerror_error_t **error );
 
+int libfdata_btree_node_get_range_by_index(
+     libfdata_internal_btree_node_t *internal_tree_node,
+     int range_index,
+     libfdata_btree_range_t **range,
+     libcerror_error_t **error );
+
+int libfdata_btree_node_append_range(
+     libfdata_internal_btree_node_t *internal_tree_node,
+     int *range_index,
+     libfdata_btree_range_t **range,
+     libcerror_error_t **error );
+
 /* Node functions
  */
 
@@ -174,6 +205,24 @@ int libfdata_btree_node_get_number_of_leaf_values_in_branch(
      int *number_of_leaf_values,
      libcerror_error_t **error );
 
+int libfdata_btree_node_get_number_of_mapped_sub_nodes(
+     libfdata_btree_node_t *node,
+     int *number_of_mapped_sub_nodes,
+     int *number_of_mapped_leaf_values,
+     libcerror_error_t **error );
+
+int libfdata_btree_node_append_mapped_sub_node(
+     libfdata_btree_node_t *node,
+     int number_of_leaf_values,
+     libcerror_error_t **error );
+
+int libfdata_btree_node_get_sub_node_data_range_by_leaf_value_index(
+     libfdata_btree_node_t *node,
+     int leaf_value_index,
+     int *sub_node_leaf_value_index,
+     libfdata_btree_range_t **sub_node_data_range,
+     libcerror_error_t **error );
+
 /* Leaf value data range functions
  */
 
@@ -23,6 +23,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfdata_btree_key_value_filter.h"
 #include "libfdata_btree_range.h"
 #include "libfdata_definitions.h"
 #include "libfdata_libcerror.h"
@@ -128,35 +129,18 @@ int libfdata_btree_range_free(
 	}
 	if( *range != NULL )
 	{
-		if( ( *range )->key_value != NULL )
+		if( libfdata_btree_range_clear(
+		     *range,
+		     error ) != 1 )
 		{
-			if( ( ( *range )->key_value_flags & LIBFDATA_KEY_VALUE_FLAG_MANAGED ) != 0 )
-			{
-				if( ( *range )->free_key_value == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: invalid tree range - missing free key value function.",
-					 function );
-
-					result = -1;
-				}
-				else if( ( *range )->free_key_value(
-					  &( ( *range )->key_value ),
-					  error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-					 "%s: unable to free key value.",
-					 function );
-
-					result = -1;
-				}
-			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear tree range.",
+			 function );
+
+			result = -1;
 		}
 		memory_free(
 		 *range );
@@ -166,6 +150,79 @@ int libfdata_btree_range_free(
 	return( result );
 }
 
+/* Clears a tree range
+ * Frees the values of the range but not the range itself, which allows
+ * to use ranges that are stored in an array
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_btree_range_clear(
+     libfdata_btree_range_t *range,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_btree_range_clear";
+	int result            = 1;
+
+	if( range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree range.",
+		 function );
+
+		return( -1 );
+	}
+	if( range->key_value != NULL )
+	{
+		if( ( range->key_value_flags & LIBFDATA_KEY_VALUE_FLAG_MANAGED ) != 0 )
+		{
+			if( range->free_key_value == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: invalid tree range - missing free key value function.",
+				 function );
+
+				result = -1;
+			}
+			else if( range->free_key_value(
+				  &( range->key_value ),
+				  error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free key value.",
+				 function );
+
+				result = -1;
+			}
+		}
+		range->key_value = NULL;
+	}
+	if( range->key_value_filter != NULL )
+	{
+		if( libfdata_btree_key_value_filter_free(
+		     &( range->key_value_filter ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free key value filter.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
 /* Clones (duplicates) the range
  * Returns 1 if successful or -1 on error
  */
@@ -232,7 +289,8 @@ int libfdata_btree_range_clone(
 
 		goto on_error;
 	}
-	( *destination_range )->key_value = NULL;
+	( *destination_range )->key_value        = NULL;
+	( *destination_range )->key_value_filter = NULL;
 
 	return( 1 );
 
@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfdata_btree_key_value_filter.h"
 #include "libfdata_extern.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_types.h"
@@ -78,6 +79,12 @@ struct libfdata_btree_range
 	/* The mapped number of leaf values
 	 */
 	int mapped_number_of_leaf_values;
+
+	/* The key value filter
+	 * contains the key values of the leaf values of a leaf node
+	 * NULL if the node was not read or is not a leaf node
+	 */
+	libfdata_btree_key_value_filter_t *key_value_filter;
 };
 
 int libfdata_btree_range_initialize(
@@ -88,6 +95,10 @@ int libfdata_btree_range_free(
      libfdata_btree_range_t **range,
      libcerror_error_t **error );
 
+int libfdata_btree_range_clear(
+     libfdata_btree_range_t *range,
+     libcerror_error_t **error );
+
 int libfdata_btree_range_clone(
      libfdata_btree_range_t **destination_range,
      libfdata_btree_range_t *source_range,
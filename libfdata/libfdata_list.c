@@ -23,18 +23,31 @@
 #include <memory.h>
 #include <types.h>
 
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
 #include "libfdata_definitions.h"
-#include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libcnotify.h"
+#include "libfdata_libcthreads.h"
 #include "libfdata_libfcache.h"
 #include "libfdata_list.h"
 #include "libfdata_list_element.h"
-#include "libfdata_mapped_range.h"
-#include "libfdata_range.h"
 #include "libfdata_types.h"
 #include "libfdata_unused.h"
 
+#define LIBFDATA_LIST_INITIAL_NUMBER_OF_ALLOCATED_ENTRIES	16
+
+/* The number of chunks per thread in which the elements are processed
+ * by libfdata_list_parallel_for_each
+ */
+#define LIBFDATA_LIST_FOR_EACH_NUMBER_OF_CHUNKS_PER_THREAD	4
+
+/* The minimum number of elements of a chunk
+ */
+#define LIBFDATA_LIST_FOR_EACH_MINIMUM_CHUNK_SIZE		16
+
 /* Creates a list
  * Make sure the value list is referencing, is set to NULL
  *
@@ -146,30 +159,15 @@ int libfdata_list_initialize(
 
 		return( -1 );
 	}
-	if( libcdata_array_initialize(
-	     &( internal_list->elements_array ),
-	     0,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create elements array.",
-		 function );
-
-		goto on_error;
-	}
-	if( libcdata_array_initialize(
-	     &( internal_list->mapped_ranges_array ),
-	     0,
+	if( libfcache_date_time_get_timestamp(
+	     &( internal_list->timestamp ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create mapped ranges array.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache timestamp.",
 		 function );
 
 		goto on_error;
@@ -188,13 +186,6 @@ int libfdata_list_initialize(
 on_error:
 	if( internal_list != NULL )
 	{
-		if( internal_list->elements_array != NULL )
-		{
-			libcdata_array_free(
-			 &( internal_list->elements_array ),
-			 NULL,
-			 NULL );
-		}
 		memory_free(
 		 internal_list );
 	}
@@ -210,6 +201,7 @@ int libfdata_list_free(
 {
 	libfdata_internal_list_t *internal_list = NULL;
 	static char *function                   = "libfdata_list_free";
+	int element_index                       = 0;
 	int result                              = 1;
 
 	if( list == NULL )
@@ -228,33 +220,47 @@ int libfdata_list_free(
 		internal_list = (libfdata_internal_list_t *) *list;
 		*list         = NULL;
 
-		if( libcdata_array_free(
-		     &( internal_list->elements_array ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_list_element_free,
+		if( libfdata_list_free_entries_pages(
+		     internal_list,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free the elements array.",
+			 "%s: unable to free entries pages.",
 			 function );
 
 			result = -1;
 		}
-		if( libcdata_array_free(
-		     &( internal_list->mapped_ranges_array ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
-		     error ) != 1 )
+		if( internal_list->elements != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free the mapped ranges array.",
-			 function );
+			for( element_index = 0;
+			     element_index < internal_list->number_of_allocated_elements;
+			     element_index++ )
+			{
+				if( libfdata_list_element_free(
+				     &( internal_list->elements[ element_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free list element: %d.",
+					 function,
+					 element_index );
 
-			result = -1;
+					result = -1;
+				}
+			}
+			memory_free(
+			 internal_list->elements );
+		}
+		if( internal_list->entries != NULL )
+		{
+			memory_free(
+			 internal_list->entries );
 		}
 		if( ( internal_list->flags & LIBFDATA_DATA_HANDLE_FLAG_MANAGED ) != 0 )
 		{
@@ -404,42 +410,53 @@ int libfdata_list_clone(
 			goto on_error;
 		}
 	}
-	if( libcdata_array_clone(
-	     &( internal_destination_list->elements_array ),
-	     internal_source_list->elements_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_list_element_free,
-	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libfdata_list_element_clone,
-	     error ) != 1 )
+	if( internal_source_list->get_element_range != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination elements array.",
-		 function );
-
-		goto on_error;
+		/* The resolved entries of a lazy list are not cloned
+		 * but resolved again on demand
+		 */
+		internal_destination_list->get_element_range = internal_source_list->get_element_range;
+		internal_destination_list->number_of_entries = internal_source_list->number_of_entries;
 	}
-	if( libcdata_array_clone(
-	     &( internal_destination_list->mapped_ranges_array ),
-	     internal_source_list->mapped_ranges_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
-	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libfdata_mapped_range_clone,
-	     error ) != 1 )
+	else if( internal_source_list->number_of_entries > 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination mapped ranges array.",
-		 function );
+		if( libfdata_list_resize_entries(
+		     internal_destination_list,
+		     internal_source_list->number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize destination entries.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
+		if( memory_copy(
+		     internal_destination_list->entries,
+		     internal_source_list->entries,
+		     sizeof( libfdata_list_entry_t ) * internal_source_list->number_of_entries ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy entries.",
+			 function );
+
+			goto on_error;
+		}
 	}
+	internal_destination_list->mapped_offset      = internal_source_list->mapped_offset;
+	internal_destination_list->size               = internal_source_list->size;
+	internal_destination_list->timestamp          = internal_source_list->timestamp;
 	internal_destination_list->flags              = internal_source_list->flags | LIBFDATA_DATA_HANDLE_FLAG_MANAGED;
 	internal_destination_list->free_data_handle   = internal_source_list->free_data_handle;
 	internal_destination_list->clone_data_handle  = internal_source_list->clone_data_handle;
 	internal_destination_list->read_element_data  = internal_source_list->read_element_data;
+	internal_destination_list->read_elements_data = internal_source_list->read_elements_data;
 	internal_destination_list->write_element_data = internal_source_list->write_element_data;
 
 	*destination_list = (libfdata_list_t *) internal_destination_list;
@@ -449,12 +466,10 @@ int libfdata_list_clone(
 on_error:
 	if( internal_destination_list != NULL )
 	{
-		if( internal_destination_list->elements_array != NULL )
+		if( internal_destination_list->entries != NULL )
 		{
-			libcdata_array_free(
-			 &( internal_destination_list->elements_array ),
-			 (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_list_element_free,
-			 NULL );
+			memory_free(
+			 internal_destination_list->entries );
 		}
 		if( ( internal_destination_list->data_handle != NULL )
 		 && ( internal_source_list->free_data_handle != NULL ) )
@@ -497,18 +512,32 @@ int libfdata_list_set_calculate_mapped_ranges_flag(
 	return( 1 );
 }
 
-/* List elements functions
- */
-
-/* Empties the list
+/* Sets the read elements data function
+ * The function reads the data of a number of consecutive elements, which is
+ * stored contiguously in a single file, and sets their values in the cache
+ * It is used to prefetch adjacent element values with a single read,
+ * without it every element is read on its own
  * Returns 1 if successful or -1 on error
  */
-int libfdata_list_empty(
+int libfdata_list_set_read_elements_data_function(
      libfdata_list_t *list,
+     int (*read_elements_data)(
+            intptr_t *data_handle,
+            intptr_t *file_io_handle,
+            libfdata_list_t *list,
+            libfcache_cache_t *cache,
+            int first_element_index,
+            int number_of_elements,
+            int elements_data_file_index,
+            off64_t elements_data_offset,
+            size64_t elements_data_size,
+            uint32_t elements_data_flags,
+            uint8_t read_flags,
+            libcerror_error_t **error ),
      libcerror_error_t **error )
 {
 	libfdata_internal_list_t *internal_list = NULL;
-	static char *function                   = "libfdata_list_empty";
+	static char *function                   = "libfdata_list_set_read_elements_data_function";
 
 	if( list == NULL )
 	{
@@ -523,49 +552,36 @@ int libfdata_list_empty(
 	}
 	internal_list = (libfdata_internal_list_t *) list;
 
-	if( libcdata_array_empty(
-	     internal_list->elements_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_list_element_free,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to empty elements array.",
-		 function );
-
-		return( -1 );
-	}
-	if( libcdata_array_empty(
-	     internal_list->mapped_ranges_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty mapped ranges array.",
-		 function );
-
-		return( -1 );
-	}
-	internal_list->size = 0;
+	internal_list->read_elements_data = read_elements_data;
 
 	return( 1 );
 }
 
-/* Resizes the list
+/* Sets the get element range function
+ * This makes the list lazy, the list contains number_of_elements elements of which
+ * the data range is resolved by the get element range function when first accessed
+ * The get element range function should set mapped_size to the element size
+ * if the element has no distinct mapped size
+ * Modifying the layout of a lazy list, for example by appending or reversing,
+ * or retrieving elements by offset resolves all the elements
  * Returns 1 if successful or -1 on error
  */
-int libfdata_list_resize(
+int libfdata_list_set_element_range_function(
      libfdata_list_t *list,
      int number_of_elements,
+     int (*get_element_range)(
+            intptr_t *data_handle,
+            int element_index,
+            int *element_file_index,
+            off64_t *element_offset,
+            size64_t *element_size,
+            uint32_t *element_flags,
+            size64_t *mapped_size,
+            libcerror_error_t **error ),
      libcerror_error_t **error )
 {
 	libfdata_internal_list_t *internal_list = NULL;
-	static char *function                   = "libfdata_list_resize";
+	static char *function                   = "libfdata_list_set_element_range_function";
 
 	if( list == NULL )
 	{
@@ -580,55 +596,63 @@ int libfdata_list_resize(
 	}
 	internal_list = (libfdata_internal_list_t *) list;
 
-	if( libcdata_array_resize(
-	     internal_list->elements_array,
-	     number_of_elements,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_list_element_free,
-	     error ) != 1 )
+	if( ( internal_list->number_of_entries != 0 )
+	 || ( internal_list->get_element_range != NULL ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to resize elements array.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid list - elements already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( libcdata_array_resize(
-	     internal_list->mapped_ranges_array,
-	     number_of_elements,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
-	     error ) != 1 )
+	if( number_of_elements < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to resize mapped ranges array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of elements value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	internal_list->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+	if( get_element_range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid get element range function.",
+		 function );
+
+		return( -1 );
+	}
+	internal_list->get_element_range = get_element_range;
+	internal_list->number_of_entries = number_of_elements;
+	internal_list->size              = 0;
+	internal_list->flags            |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
 
 	return( 1 );
 }
 
-/* Reverses the order of the elements
+/* Frees the entries pages of a lazy list
+ * This also frees the list elements (handles) of the entries pages
  * Returns 1 if successful or -1 on error
  */
-int libfdata_list_reverse(
-     libfdata_list_t *list,
+int libfdata_list_free_entries_pages(
+     libfdata_internal_list_t *internal_list,
      libcerror_error_t **error )
 {
-	libfdata_internal_list_t *internal_list = NULL;
-	libfdata_list_element_t *list_element   = NULL;
-	static char *function                   = "libfdata_list_reverse";
-	int element_index                       = 0;
-	int number_of_elements                  = 0;
+	libfdata_list_entries_page_t *entries_page = NULL;
+	static char *function                      = "libfdata_list_free_entries_pages";
+	int entry_index                            = 0;
+	int page_index                             = 0;
+	int result                                 = 1;
 
-	if( list == NULL )
+	if( internal_list == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -639,88 +663,203 @@ int libfdata_list_reverse(
 
 		return( -1 );
 	}
-	internal_list = (libfdata_internal_list_t *) list;
+	if( internal_list->entries_pages == NULL )
+	{
+		return( 1 );
+	}
+	for( page_index = 0;
+	     page_index < internal_list->number_of_entries_pages;
+	     page_index++ )
+	{
+		entries_page = internal_list->entries_pages[ page_index ];
 
-	if( libcdata_array_reverse(
-	     internal_list->elements_array,
-	     error ) != 1 )
+		if( entries_page == NULL )
+		{
+			continue;
+		}
+		for( entry_index = 0;
+		     entry_index < LIBFDATA_LIST_ENTRIES_PAGE_SIZE;
+		     entry_index++ )
+		{
+			if( libfdata_list_element_free(
+			     &( entries_page->elements[ entry_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free list element: %d.",
+				 function,
+				 ( page_index * LIBFDATA_LIST_ENTRIES_PAGE_SIZE ) + entry_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 entries_page );
+	}
+	memory_free(
+	 internal_list->entries_pages );
+
+	internal_list->entries_pages           = NULL;
+	internal_list->number_of_entries_pages = 0;
+
+	return( result );
+}
+
+/* Retrieves the entries page of a specific element of a lazy list
+ * The entries page is created on demand
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_get_entries_page(
+     libfdata_internal_list_t *internal_list,
+     int element_index,
+     libfdata_list_entries_page_t **entries_page,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfdata_list_get_entries_page";
+	size_t entries_pages_size   = 0;
+	int number_of_entries_pages = 0;
+	int page_index              = 0;
+
+	if( internal_list == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to reverse elements array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
 		 function );
 
 		return( -1 );
 	}
-	if( libcdata_array_get_number_of_entries(
-	     internal_list->elements_array,
-	     &number_of_elements,
-	     error ) != 1 )
+	if( ( element_index < 0 )
+	 || ( element_index >= internal_list->number_of_entries ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of elements from elements array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element index value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	for( element_index = 0;
-	     element_index < number_of_elements;
-	     element_index++ )
+	if( entries_page == NULL )
 	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_list->elements_array,
-		     element_index,
-		     (intptr_t **) &list_element,
-		     error ) != 1 )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entries page.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_list->entries_pages == NULL )
+	{
+		number_of_entries_pages = ( internal_list->number_of_entries / LIBFDATA_LIST_ENTRIES_PAGE_SIZE ) + 1;
+
+		entries_pages_size = sizeof( libfdata_list_entries_page_t * ) * number_of_entries_pages;
+
+		internal_list->entries_pages = (libfdata_list_entries_page_t **) memory_allocate(
+		                                                                  entries_pages_size );
+
+		if( internal_list->entries_pages == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from elements array.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entries pages.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     internal_list->entries_pages,
+		     0,
+		     entries_pages_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entries pages.",
+			 function );
+
+			memory_free(
+			 internal_list->entries_pages );
+
+			internal_list->entries_pages = NULL;
+
+			return( -1 );
+		}
+		internal_list->number_of_entries_pages = number_of_entries_pages;
+	}
+	page_index = element_index / LIBFDATA_LIST_ENTRIES_PAGE_SIZE;
+
+	if( internal_list->entries_pages[ page_index ] == NULL )
+	{
+		internal_list->entries_pages[ page_index ] = memory_allocate_structure(
+		                                              libfdata_list_entries_page_t );
+
+		if( internal_list->entries_pages[ page_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entries page: %d.",
 			 function,
-			 element_index );
+			 page_index );
 
 			return( -1 );
 		}
-		if( libfdata_list_element_set_element_index(
-		     list_element,
-		     element_index,
-		     error ) != 1 )
+		if( memory_set(
+		     internal_list->entries_pages[ page_index ],
+		     0,
+		     sizeof( libfdata_list_entries_page_t ) ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set list element: %d index.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entries page: %d.",
 			 function,
-			 element_index );
+			 page_index );
+
+			memory_free(
+			 internal_list->entries_pages[ page_index ] );
+
+			internal_list->entries_pages[ page_index ] = NULL;
 
 			return( -1 );
 		}
 	}
-	internal_list->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+	*entries_page = internal_list->entries_pages[ page_index ];
 
 	return( 1 );
 }
 
-/* Retrieves the number of elements of the list
+/* Resolves an entry of a lazy list using the get element range function
  * Returns 1 if successful or -1 on error
  */
-int libfdata_list_get_number_of_elements(
-     libfdata_list_t *list,
-     int *number_of_elements,
+int libfdata_list_resolve_entry(
+     libfdata_internal_list_t *internal_list,
+     int element_index,
+     libfdata_list_entry_t *entry,
      libcerror_error_t **error )
 {
-	libfdata_internal_list_t *internal_list = NULL;
-	static char *function                   = "libfdata_list_get_number_of_elements";
+	static char *function  = "libfdata_list_resolve_entry";
+	size64_t element_size  = 0;
+	size64_t mapped_size   = 0;
+	off64_t element_offset = 0;
+	uint32_t element_flags = 0;
+	int element_file_index = 0;
 
-	if( list == NULL )
+	if( internal_list == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -731,88 +870,93 @@ int libfdata_list_get_number_of_elements(
 
 		return( -1 );
 	}
-	internal_list = (libfdata_internal_list_t *) list;
-
-	if( libcdata_array_get_number_of_entries(
-	     internal_list->elements_array,
-	     number_of_elements,
-	     error ) != 1 )
+	if( internal_list->get_element_range == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of elements from elements array.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid list - missing get element range function.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-}
-
-/* Retrieves a specific list element
- * Returns 1 if successful or -1 on error
- */
-int libfdata_list_get_list_element_by_index(
-     libfdata_list_t *list,
-     int element_index,
-     libfdata_list_element_t **element,
-     libcerror_error_t **error )
-{
-	libfdata_internal_list_t *internal_list = NULL;
-	static char *function                   = "libfdata_list_get_list_element_by_index";
-
-	if( list == NULL )
+	if( entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid list.",
+		 "%s: invalid entry.",
 		 function );
 
 		return( -1 );
 	}
-	internal_list = (libfdata_internal_list_t *) list;
-
-	if( libcdata_array_get_entry_by_index(
-	     internal_list->elements_array,
+	if( internal_list->get_element_range(
+	     internal_list->data_handle,
 	     element_index,
-	     (intptr_t **) element,
+	     &element_file_index,
+	     &element_offset,
+	     &element_size,
+	     &element_flags,
+	     &mapped_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from elements array.",
+		 "%s: unable to retrieve data range of element: %d.",
 		 function,
 		 element_index );
 
 		return( -1 );
 	}
-	internal_list->current_element_index = element_index;
+	if( libfdata_list_set_entry_data_range(
+	     internal_list,
+	     entry,
+	     element_file_index,
+	     element_offset,
+	     element_size,
+	     element_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set data range of element: %d.",
+		 function,
+		 element_index );
 
+		return( -1 );
+	}
+	if( mapped_size != element_size )
+	{
+		entry->mapped_size = mapped_size;
+		entry->flags      |= LIBFDATA_LIST_ELEMENT_FLAG_HAS_MAPPED_SIZE;
+	}
 	return( 1 );
 }
 
-/* Retrieves the data range of a specific element
+/* Resolves all the entries of a lazy list and stores them in the entries
+ * After this the list is no longer lazy
+ * On error the list remains lazy, the list elements are only moved once all
+ * the entries have been resolved and a lazy list does not use the entries
  * Returns 1 if successful or -1 on error
  */
-int libfdata_list_get_element_by_index(
-     libfdata_list_t *list,
-     int element_index,
-     int *element_file_index,
-     off64_t *element_offset,
-     size64_t *element_size,
-     uint32_t *element_flags,
+int libfdata_list_materialize_entries(
+     libfdata_internal_list_t *internal_list,
      libcerror_error_t **error )
 {
-	libfdata_internal_list_t *internal_list = NULL;
-	libfdata_list_element_t *list_element   = NULL;
-	static char *function                   = "libfdata_list_get_element_by_index";
+	libfdata_list_entries_page_t *entries_page = NULL;
+	static char *function                      = "libfdata_list_materialize_entries";
+	int element_index                          = 0;
+	int entry_index                            = 0;
+	int number_of_entries                      = 0;
+	int page_index                             = 0;
 
-	if( list == NULL )
+	if( internal_list == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -823,76 +967,144 @@ int libfdata_list_get_element_by_index(
 
 		return( -1 );
 	}
-	internal_list = (libfdata_internal_list_t *) list;
+	if( internal_list->get_element_range == NULL )
+	{
+		return( 1 );
+	}
+	number_of_entries = internal_list->number_of_entries;
 
-	if( libcdata_array_get_entry_by_index(
-	     internal_list->elements_array,
-	     element_index,
-	     (intptr_t **) &list_element,
+	/* The entries of a lazy list are not stored in the entries array
+	 */
+	internal_list->number_of_entries = 0;
+
+	if( libfdata_list_resize_entries(
+	     internal_list,
+	     number_of_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from elements array.",
-		 function,
-		 element_index );
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize entries.",
+		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( libfdata_list_element_get_data_range(
-	     list_element,
-	     element_file_index,
-	     element_offset,
-	     element_size,
-	     element_flags,
+	for( element_index = 0;
+	     element_index < number_of_entries;
+	     element_index++ )
+	{
+		page_index  = element_index / LIBFDATA_LIST_ENTRIES_PAGE_SIZE;
+		entry_index = element_index % LIBFDATA_LIST_ENTRIES_PAGE_SIZE;
+
+		entries_page = NULL;
+
+		if( internal_list->entries_pages != NULL )
+		{
+			entries_page = internal_list->entries_pages[ page_index ];
+		}
+		if( ( entries_page != NULL )
+		 && ( ( entries_page->entries[ entry_index ].flags & LIBFDATA_LIST_ELEMENT_FLAG_IS_SET ) != 0 ) )
+		{
+			internal_list->entries[ element_index ] = entries_page->entries[ entry_index ];
+		}
+		else if( libfdata_list_resolve_entry(
+		          internal_list,
+		          element_index,
+		          &( internal_list->entries[ element_index ] ),
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to resolve entry: %d.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		if( ( entries_page != NULL )
+		 && ( entries_page->elements[ entry_index ] != NULL ) )
+		{
+			if( libfdata_list_create_elements(
+			     internal_list,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create elements.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	/* Move the list elements (handles) from the entries pages to the elements
+	 */
+	if( ( internal_list->elements != NULL )
+	 && ( internal_list->entries_pages != NULL ) )
+	{
+		for( element_index = 0;
+		     element_index < number_of_entries;
+		     element_index++ )
+		{
+			page_index  = element_index / LIBFDATA_LIST_ENTRIES_PAGE_SIZE;
+			entry_index = element_index % LIBFDATA_LIST_ENTRIES_PAGE_SIZE;
+
+			entries_page = internal_list->entries_pages[ page_index ];
+
+			if( entries_page != NULL )
+			{
+				internal_list->elements[ element_index ] = entries_page->elements[ entry_index ];
+				entries_page->elements[ entry_index ]    = NULL;
+			}
+		}
+	}
+	internal_list->get_element_range = NULL;
+	internal_list->flags            |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+
+	if( libfdata_list_free_entries_pages(
+	     internal_list,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve data range from list element: %d.",
-		 function,
-		 element_index );
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free entries pages.",
+		 function );
 
 		return( -1 );
 	}
-	internal_list->current_element_index = element_index;
-
 	return( 1 );
+
+on_error:
+	internal_list->number_of_entries = number_of_entries;
+
+	return( -1 );
 }
 
-/* Sets the data range of a specific element
+/* Resizes the entries
+ * The entries are stored in a single contiguous array that is grown geometrically,
+ * hence a reference to an entry is only valid until the entries are resized
+ * New entries are not set and list elements of removed entries are freed
  * Returns 1 if successful or -1 on error
  */
-int libfdata_list_set_element_by_index(
-     libfdata_list_t *list,
-     int element_index,
-     int element_file_index,
-     off64_t element_offset,
-     size64_t element_size,
-     uint32_t element_flags,
+int libfdata_list_resize_entries(
+     libfdata_internal_list_t *internal_list,
+     int number_of_entries,
      libcerror_error_t **error )
 {
-	libfdata_internal_list_t *internal_list = NULL;
-	libfdata_list_element_t *list_element   = NULL;
-	libfdata_mapped_range_t *mapped_range   = NULL;
-	static char *function                   = "libfdata_list_set_element_by_index";
-	off64_t previous_element_offset         = 0;
-	size64_t mapped_size                    = 0;
-	size64_t previous_element_size          = 0;
-	uint32_t previous_element_flags         = 0;
-	int previous_element_file_index         = 0;
-	int result                              = 0;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	off64_t mapped_range_offset             = 0;
-	size64_t mapped_range_size              = 0;
-#endif
+	static char *function           = "libfdata_list_resize_entries";
+	void *reallocation              = NULL;
+	int element_index               = 0;
+	int number_of_allocated_entries = 0;
 
-	if( list == NULL )
+	if( internal_list == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -903,96 +1115,132 @@ int libfdata_list_set_element_by_index(
 
 		return( -1 );
 	}
-	internal_list = (libfdata_internal_list_t *) list;
-
-	if( libcdata_array_get_entry_by_index(
-	     internal_list->elements_array,
-	     element_index,
-	     (intptr_t **) &list_element,
-	     error ) != 1 )
+	if( number_of_entries < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from elements array.",
-		 function,
-		 element_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of entries value less than zero.",
+		 function );
 
 		return( -1 );
 	}
-	if( list_element == NULL )
+	if( number_of_entries > internal_list->number_of_allocated_entries )
 	{
-		if( libfdata_list_element_initialize(
-		     &list_element,
-		     list,
-		     element_index,
-		     error ) != 1 )
+		number_of_allocated_entries = internal_list->number_of_allocated_entries;
+
+		if( number_of_allocated_entries == 0 )
+		{
+			number_of_allocated_entries = LIBFDATA_LIST_INITIAL_NUMBER_OF_ALLOCATED_ENTRIES;
+		}
+		while( number_of_allocated_entries < number_of_entries )
+		{
+			if( number_of_allocated_entries > ( INT_MAX / 2 ) )
+			{
+				number_of_allocated_entries = number_of_entries;
+
+				break;
+			}
+			number_of_allocated_entries *= 2;
+		}
+		if( (size_t) number_of_allocated_entries > ( (size_t) SSIZE_MAX / sizeof( libfdata_list_entry_t ) ) )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create list element.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated entries value exceeds maximum.",
 			 function );
 
 			return( -1 );
 		}
-		if( libcdata_array_set_entry_by_index(
-		     internal_list->elements_array,
-		     element_index,
-		     (intptr_t *) list_element,
-		     error ) != 1 )
+		reallocation = memory_reallocate(
+		                internal_list->entries,
+		                sizeof( libfdata_list_entry_t ) * number_of_allocated_entries );
+
+		if( reallocation == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set entry: %d in elements array.",
-			 function,
-			 element_index );
-
-			libfdata_list_element_free(
-			 &list_element,
-			 NULL );
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize entries.",
+			 function );
 
 			return( -1 );
 		}
+		internal_list->entries                     = (libfdata_list_entry_t *) reallocation;
+		internal_list->number_of_allocated_entries = number_of_allocated_entries;
 	}
-	else
+	if( ( internal_list->elements != NULL )
+	 && ( internal_list->number_of_allocated_elements < internal_list->number_of_allocated_entries ) )
 	{
-		result = libfdata_list_element_get_mapped_size(
-		          list_element,
-		          &mapped_size,
-		          error );
+		reallocation = memory_reallocate(
+		                internal_list->elements,
+		                sizeof( libfdata_list_element_t * ) * internal_list->number_of_allocated_entries );
 
-		if( result == -1 )
+		if( reallocation == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve mapped size of list element: %d.",
-			 function,
-			 element_index );
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize elements.",
+			 function );
 
 			return( -1 );
 		}
-		else if( result == 0 )
+		internal_list->elements = (libfdata_list_element_t **) reallocation;
+
+		if( memory_set(
+		     &( internal_list->elements[ internal_list->number_of_allocated_elements ] ),
+		     0,
+		     sizeof( libfdata_list_element_t * ) * ( internal_list->number_of_allocated_entries - internal_list->number_of_allocated_elements ) ) == NULL )
 		{
-			if( libfdata_list_element_get_data_range(
-			     list_element,
-			     &previous_element_file_index,
-			     &previous_element_offset,
-			     &previous_element_size,
-			     &previous_element_flags,
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear elements.",
+			 function );
+
+			return( -1 );
+		}
+		internal_list->number_of_allocated_elements = internal_list->number_of_allocated_entries;
+	}
+	if( number_of_entries > internal_list->number_of_entries )
+	{
+		if( memory_set(
+		     &( internal_list->entries[ internal_list->number_of_entries ] ),
+		     0,
+		     sizeof( libfdata_list_entry_t ) * ( number_of_entries - internal_list->number_of_entries ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entries.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( internal_list->elements != NULL )
+	{
+		for( element_index = number_of_entries;
+		     element_index < internal_list->number_of_entries;
+		     element_index++ )
+		{
+			if( libfdata_list_element_free(
+			     &( internal_list->elements[ element_index ] ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve data range of list element: %d.",
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free list element: %d.",
 				 function,
 				 element_index );
 
@@ -1000,158 +1248,124 @@ int libfdata_list_set_element_by_index(
 			}
 		}
 	}
-	if( libfdata_list_element_set_data_range(
-	     list_element,
-	     element_file_index,
-	     element_offset,
-	     element_size,
-	     element_flags,
-	     error ) != 1 )
+	internal_list->number_of_entries = number_of_entries;
+
+	return( 1 );
+}
+
+/* Retrieves a specific entry
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_get_entry_by_index(
+     libfdata_internal_list_t *internal_list,
+     int element_index,
+     libfdata_list_entry_t **entry,
+     libcerror_error_t **error )
+{
+	libfdata_list_entries_page_t *entries_page = NULL;
+	libfdata_list_entry_t *list_entry          = NULL;
+	static char *function                      = "libfdata_list_get_entry_by_index";
+
+	if( internal_list == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set data range of list element: %d.",
-		 function,
-		 element_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
 
 		return( -1 );
 	}
-	/* Make sure the list has a mapped range entry for every element
-	 */
-	if( libcdata_array_get_entry_by_index(
-	     internal_list->mapped_ranges_array,
-	     element_index,
-	     (intptr_t **) &mapped_range,
-	     error ) != 1 )
+	if( ( element_index < 0 )
+	 || ( element_index >= internal_list->number_of_entries ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from mapped ranges array.",
-		 function,
-		 element_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
 
 		return( -1 );
 	}
-	if( mapped_range == NULL )
+	if( internal_list->get_element_range != NULL )
 	{
-		if( libfdata_mapped_range_initialize(
-		     &mapped_range,
+		if( libfdata_list_get_entries_page(
+		     internal_list,
+		     element_index,
+		     &entries_page,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create mapped range.",
-			 function );
-
-			return( -1 );
-		}
-		if( libcdata_array_set_entry_by_index(
-		     internal_list->mapped_ranges_array,
-		     element_index,
-		     (intptr_t *) mapped_range,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set entry: %d in mapped ranges array.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entries page of element: %d.",
 			 function,
 			 element_index );
 
-			libfdata_mapped_range_free(
-			 &mapped_range,
-			 NULL );
-
 			return( -1 );
 		}
-		internal_list->size  += element_size;
-		internal_list->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
-	}
-	/* If the size of the element is mapped or if the element size did not change
-	 * there is no need to recalculate the mapped range
-	 */
-	else if( ( mapped_size == 0 )
-	      && ( previous_element_size != element_size ) )
-	{
-		internal_list->size  -= previous_element_size;
-		internal_list->size  += element_size;
-		internal_list->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: element: %03d\tfile index: %03d offset: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
-		 function,
-		 element_index,
-		 element_file_index,
-		 element_offset,
-		 element_offset + element_size,
-		 element_size );
+		list_entry = &( entries_page->entries[ element_index % LIBFDATA_LIST_ENTRIES_PAGE_SIZE ] );
 
-		if( ( internal_list->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) == 0 )
+		if( ( list_entry->flags & LIBFDATA_LIST_ELEMENT_FLAG_IS_SET ) == 0 )
 		{
-			if( libfdata_mapped_range_get(
-			     mapped_range,
-			     &mapped_range_offset,
-			     &mapped_range_size,
+			if( libfdata_list_resolve_entry(
+			     internal_list,
+			     element_index,
+			     list_entry,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve values from mapped range: %d.",
+				 "%s: unable to resolve entry: %d.",
 				 function,
 				 element_index );
 
 				return( -1 );
 			}
-			libcnotify_printf(
-			 "%s: element: %03d\tmapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
-			 function,
-			 element_index,
-			 mapped_range_offset,
-			 mapped_range_offset + mapped_range_size,
-			 mapped_range_size );
 		}
-		libcnotify_printf(
-		 "\n" );
+		*entry = list_entry;
+	}
+	else
+	{
+		*entry = &( internal_list->entries[ element_index ] );
 	}
-#endif
-	internal_list->current_element_index = element_index;
-
 	return( 1 );
 }
 
-/* Prepends an element data range
+/* Sets the data range of an entry
+ * This also marks the entry as set and updates its time stamp
+ * Replacing the data range of an entry that was already set updates the time stamp
+ * of the list, which invalidates the cached element values of the list
  * Returns 1 if successful or -1 on error
  */
-int libfdata_list_prepend_element(
-     libfdata_list_t *list,
+int libfdata_list_set_entry_data_range(
+     libfdata_internal_list_t *internal_list,
+     libfdata_list_entry_t *entry,
      int element_file_index,
      off64_t element_offset,
      size64_t element_size,
      uint32_t element_flags,
      libcerror_error_t **error )
 {
-	libfdata_internal_list_t *internal_list = NULL;
-	libfdata_list_element_t *list_element   = NULL;
-	libfdata_mapped_range_t *mapped_range   = NULL;
-	static char *function                   = "libfdata_list_prepend_element";
-	off64_t mapped_offset                   = 0;
-	int element_index                       = 0;
-	int mapped_range_index                  = -1;
-	int number_of_elements                  = 0;
+	static char *function = "libfdata_list_set_entry_data_range";
 
-	if( list == NULL )
+	if( internal_list == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1162,204 +1376,261 @@ int libfdata_list_prepend_element(
 
 		return( -1 );
 	}
-	internal_list = (libfdata_internal_list_t *) list;
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
 
-	if( libfdata_mapped_range_initialize(
-	     &mapped_range,
-	     error ) != 1 )
+		return( -1 );
+	}
+	if( element_file_index < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create mapped range.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file index less than zero.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	mapped_offset = internal_list->mapped_offset + (off64_t) internal_list->size;
+	if( element_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
 
-	if( libfdata_mapped_range_set(
-	     mapped_range,
-	     mapped_offset,
-	     element_size,
-	     error ) != 1 )
+		return( -1 );
+	}
+	if( element_size > (size64_t) INT64_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set mapped range values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_array_append_entry(
-	     internal_list->mapped_ranges_array,
-	     &mapped_range_index,
-	     (intptr_t *) mapped_range,
-	     error ) != 1 )
+	/* Replacing the data range of an element invalidates the cached element values of the list
+	 */
+	if( ( entry->flags & LIBFDATA_LIST_ELEMENT_FLAG_IS_SET ) != 0 )
+	{
+		if( libfcache_date_time_get_timestamp(
+		     &( internal_list->timestamp ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache timestamp.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	entry->data_file_index = element_file_index;
+	entry->data_offset     = element_offset;
+	entry->data_size       = element_size;
+	entry->data_flags      = element_flags;
+	entry->flags          |= LIBFDATA_LIST_ELEMENT_FLAG_IS_SET;
+
+	return( 1 );
+}
+
+/* Creates the list elements (handles) if not already created
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_create_elements(
+     libfdata_internal_list_t *internal_list,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_list_create_elements";
+
+	if( internal_list == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append mapped range to array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfdata_list_element_initialize(
-	     &list_element,
-	     list,
-	     0,
-	     error ) != 1 )
+	if( ( internal_list->elements != NULL )
+	 || ( internal_list->number_of_allocated_entries == 0 ) )
+	{
+		return( 1 );
+	}
+	internal_list->elements = (libfdata_list_element_t **) memory_allocate(
+	                                                        sizeof( libfdata_list_element_t * ) * internal_list->number_of_allocated_entries );
+
+	if( internal_list->elements == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create list element.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create elements.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfdata_list_element_set_data_range(
-	     list_element,
-	     element_file_index,
-	     element_offset,
-	     element_size,
-	     element_flags,
-	     error ) != 1 )
+	if( memory_set(
+	     internal_list->elements,
+	     0,
+	     sizeof( libfdata_list_element_t * ) * internal_list->number_of_allocated_entries ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set data range of list element.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear elements.",
 		 function );
 
-		goto on_error;
+		memory_free(
+		 internal_list->elements );
+
+		internal_list->elements = NULL;
+
+		return( -1 );
 	}
-	if( libcdata_array_prepend_entry(
-	     internal_list->elements_array,
-	     (intptr_t *) list_element,
-	     error ) != 1 )
+	internal_list->number_of_allocated_elements = internal_list->number_of_allocated_entries;
+
+	return( 1 );
+}
+
+/* Retrieves the list element (handle) of a specific entry
+ * The list element is created on demand and remains owned by the list
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_get_element_handle(
+     libfdata_internal_list_t *internal_list,
+     int element_index,
+     libfdata_list_element_t **element,
+     libcerror_error_t **error )
+{
+	libfdata_list_entries_page_t *entries_page = NULL;
+	libfdata_list_element_t **list_element     = NULL;
+	static char *function                      = "libfdata_list_get_element_handle";
+
+	if( internal_list == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to prepend list element to elements array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	mapped_range_index = -1;
-	mapped_range       = NULL;
+	if( ( element_index < 0 )
+	 || ( element_index >= internal_list->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element index value out of bounds.",
+		 function );
 
-	if( libcdata_array_get_number_of_entries(
-	     internal_list->elements_array,
-	     &number_of_elements,
-	     error ) != 1 )
+		return( -1 );
+	}
+	if( element == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from elements array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	for( element_index = 0;
-	     element_index < number_of_elements;
-	     element_index++ )
+	if( internal_list->get_element_range != NULL )
 	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_list->elements_array,
+		if( libfdata_list_get_entries_page(
+		     internal_list,
 		     element_index,
-		     (intptr_t **) &list_element,
+		     &entries_page,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from elements array.",
+			 "%s: unable to retrieve entries page of element: %d.",
 			 function,
 			 element_index );
 
-			list_element = NULL;
+			return( -1 );
+		}
+		list_element = &( entries_page->elements[ element_index % LIBFDATA_LIST_ENTRIES_PAGE_SIZE ] );
+	}
+	else
+	{
+		if( libfdata_list_create_elements(
+		     internal_list,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create elements.",
+			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( libfdata_list_element_set_element_index(
+		list_element = &( internal_list->elements[ element_index ] );
+	}
+	if( *list_element == NULL )
+	{
+		if( libfdata_list_element_initialize(
 		     list_element,
+		     (libfdata_list_t *) internal_list,
 		     element_index,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set list element: %d index.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create list element: %d.",
 			 function,
 			 element_index );
 
-			list_element = NULL;
-
-			goto on_error;
+			return( -1 );
 		}
 	}
-	internal_list->current_element_index = 0;
-	internal_list->size                 += element_size;
-	internal_list->flags                |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+	*element = *list_element;
 
 	return( 1 );
-
-on_error:
-	if( list_element != NULL )
-	{
-		libfdata_list_element_free(
-		 &list_element,
-		 NULL );
-	}
-	if( mapped_range_index != -1 )
-	{
-		libcdata_array_set_entry_by_index(
-		 internal_list->mapped_ranges_array,
-		 mapped_range_index,
-		 NULL,
-		 NULL );
-	}
-	if( mapped_range != NULL )
-	{
-		libfdata_mapped_range_free(
-		 &mapped_range,
-		 NULL );
-	}
-	return( -1 );
 }
 
-/* Appends an element data range
+/* List elements functions
+ */
+
+/* Empties the list
  * Returns 1 if successful or -1 on error
  */
-int libfdata_list_append_element(
+int libfdata_list_empty(
      libfdata_list_t *list,
-     int *element_index,
-     int element_file_index,
-     off64_t element_offset,
-     size64_t element_size,
-     uint32_t element_flags,
      libcerror_error_t **error )
 {
 	libfdata_internal_list_t *internal_list = NULL;
-	libfdata_list_element_t *list_element   = NULL;
-	libfdata_mapped_range_t *mapped_range   = NULL;
-	static char *function                   = "libfdata_list_append_element";
-	off64_t mapped_offset                   = 0;
-	int mapped_range_index                  = -1;
+	static char *function                   = "libfdata_list_empty";
 
 	if( list == NULL )
 	{
@@ -1374,203 +1645,206 @@ int libfdata_list_append_element(
 	}
 	internal_list = (libfdata_internal_list_t *) list;
 
-	if( element_index == NULL )
+	if( internal_list->get_element_range != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid element index.",
-		 function );
-
-		return( -1 );
+		if( libfdata_list_free_entries_pages(
+		     internal_list,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free entries pages.",
+			 function );
+
+			return( -1 );
+		}
+		/* The entries of a lazy list are not stored in the entries array
+		 */
+		internal_list->get_element_range = NULL;
+		internal_list->number_of_entries = 0;
 	}
-	if( libfdata_mapped_range_initialize(
-	     &mapped_range,
+	if( libfdata_list_resize_entries(
+	     internal_list,
+	     0,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create mapped range.",
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to empty entries.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	mapped_offset = internal_list->mapped_offset + (off64_t) internal_list->size;
+	internal_list->size = 0;
 
-	if( libfdata_mapped_range_set(
-	     mapped_range,
-	     mapped_offset,
-	     element_size,
-	     error ) != 1 )
+	return( 1 );
+}
+
+/* Resizes the list
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_resize(
+     libfdata_list_t *list,
+     int number_of_elements,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_t *internal_list = NULL;
+	static char *function                   = "libfdata_list_resize";
+
+	if( list == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set mapped range values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_array_append_entry(
-	     internal_list->mapped_ranges_array,
-	     &mapped_range_index,
-	     (intptr_t *) mapped_range,
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( libfdata_list_materialize_entries(
+	     internal_list,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append mapped range to array.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve entries.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfdata_list_element_initialize(
-	     &list_element,
-	     list,
-	     0,
+	if( libfdata_list_resize_entries(
+	     internal_list,
+	     number_of_elements,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create list element.",
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize entries.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfdata_list_element_set_data_range(
-	     list_element,
-	     element_file_index,
-	     element_offset,
-	     element_size,
-	     element_flags,
-	     error ) != 1 )
+	internal_list->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+
+	return( 1 );
+}
+
+/* Reverses the order of the elements
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_reverse(
+     libfdata_list_t *list,
+     libcerror_error_t **error )
+{
+	libfdata_list_entry_t list_entry;
+
+	libfdata_internal_list_t *internal_list = NULL;
+	libfdata_list_element_t *list_element   = NULL;
+	static char *function                   = "libfdata_list_reverse";
+	int element_index                       = 0;
+	int last_element_index                  = 0;
+
+	if( list == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set data range of list element.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_array_append_entry(
-	     internal_list->elements_array,
-	     element_index,
-	     (intptr_t *) list_element,
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( libfdata_list_materialize_entries(
+	     internal_list,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append list element to elements array.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve entries.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	mapped_range_index = -1;
-	mapped_range       = NULL;
+	last_element_index = internal_list->number_of_entries - 1;
 
-	if( libfdata_list_element_set_element_index(
-	     list_element,
-	     *element_index,
-	     error ) != 1 )
+	for( element_index = 0;
+	     element_index < last_element_index;
+	     element_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set list element index.",
-		 function );
+		list_entry = internal_list->entries[ element_index ];
 
-		list_element = NULL;
+		internal_list->entries[ element_index ]      = internal_list->entries[ last_element_index ];
+		internal_list->entries[ last_element_index ] = list_entry;
 
-		goto on_error;
+		if( internal_list->elements != NULL )
+		{
+			list_element = internal_list->elements[ element_index ];
+
+			internal_list->elements[ element_index ]      = internal_list->elements[ last_element_index ];
+			internal_list->elements[ last_element_index ] = list_element;
+		}
+		last_element_index--;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( internal_list->elements != NULL )
 	{
-		libcnotify_printf(
-		 "%s: element: %03d\tfile index: %03d offset: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
-		 function,
-		 *element_index,
-		 element_file_index,
-		 element_offset,
-		 element_offset + element_size,
-		 element_size );
+		for( element_index = 0;
+		     element_index < internal_list->number_of_entries;
+		     element_index++ )
+		{
+			list_element = internal_list->elements[ element_index ];
 
-		libcnotify_printf(
-		 "%s: element: %03d\tmapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
-		 function,
-		 *element_index,
-		 mapped_offset,
-		 mapped_offset + element_size,
-		 element_size );
+			if( list_element == NULL )
+			{
+				continue;
+			}
+			if( libfdata_list_element_set_element_index(
+			     list_element,
+			     element_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set list element: %d index.",
+				 function,
+				 element_index );
 
-		libcnotify_printf(
-		 "\n" );
+				return( -1 );
+			}
+		}
 	}
-#endif
-	internal_list->current_element_index = *element_index;
-	internal_list->size                 += element_size;
+	internal_list->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
 
 	return( 1 );
-
-on_error:
-	if( list_element != NULL )
-	{
-		libfdata_list_element_free(
-		 &list_element,
-		 NULL );
-	}
-	if( mapped_range_index != -1 )
-	{
-		libcdata_array_set_entry_by_index(
-		 internal_list->mapped_ranges_array,
-		 mapped_range_index,
-		 NULL,
-		 NULL );
-	}
-	if( mapped_range != NULL )
-	{
-		libfdata_mapped_range_free(
-		 &mapped_range,
-		 NULL );
-	}
-	return( -1 );
 }
 
-/* Appends the element of the source list to the list
- * The source list is emptied if successful
+/* Retrieves the number of elements of the list
  * Returns 1 if successful or -1 on error
  */
-int libfdata_list_append_list(
+int libfdata_list_get_number_of_elements(
      libfdata_list_t *list,
-     libfdata_list_t *source_list,
+     int *number_of_elements,
      libcerror_error_t **error )
 {
-	libfdata_internal_list_t *internal_list        = NULL;
-	libfdata_internal_list_t *internal_source_list = NULL;
-	libfdata_list_element_t *list_element          = NULL;
-	libfdata_mapped_range_t *mapped_range          = NULL;
-	static char *function                          = "libfdata_list_append_list";
-	off64_t mapped_range_offset                    = 0;
-	size64_t mapped_range_size                     = 0;
-	int element_index                              = 0;
-	int new_number_of_elements                     = 0;
-	int number_of_elements                         = 0;
-	int result                                     = 1;
-	int source_element_index                       = 0;
-	int source_number_of_elements                  = 0;
+	libfdata_internal_list_t *internal_list = NULL;
+	static char *function                   = "libfdata_list_get_number_of_elements";
 
 	if( list == NULL )
 	{
@@ -1585,406 +1859,230 @@ int libfdata_list_append_list(
 	}
 	internal_list = (libfdata_internal_list_t *) list;
 
-	if( source_list == NULL )
+	if( number_of_elements == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid source list.",
+		 "%s: invalid number of elements.",
 		 function );
 
 		return( -1 );
 	}
-	internal_source_list = (libfdata_internal_list_t *) source_list;
+	*number_of_elements = internal_list->number_of_entries;
 
-	if( ( internal_list->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
-	{
-		if( libfdata_list_calculate_mapped_ranges(
-		     internal_list,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to calculate mapped ranges.",
-			 function );
+	return( 1 );
+}
 
-			goto on_error;
-		}
-	}
-	if( ( internal_source_list->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
-	{
-		if( libfdata_list_calculate_mapped_ranges(
-		     internal_source_list,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to calculate mapped ranges of source list.",
-			 function );
+/* Retrieves a specific list element
+ * The list element is NULL if the element is not set
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_get_list_element_by_index(
+     libfdata_list_t *list,
+     int element_index,
+     libfdata_list_element_t **element,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_t *internal_list = NULL;
+	libfdata_list_entry_t *list_entry       = NULL;
+	static char *function                   = "libfdata_list_get_list_element_by_index";
 
-			goto on_error;
-		}
-	}
-	if( ( internal_list->mapped_offset != 0 )
-	 || ( internal_source_list->mapped_offset != 0 ) )
+	if( list == NULL )
 	{
-		if( ( (size64_t) internal_list->mapped_offset + internal_list->size ) != (size64_t) internal_source_list->mapped_offset )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid source mapped offset value out of bounds.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
 
-			goto on_error;
-		}
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: appending source list with mapped offset: %" PRIi64 " and size: %" PRIu64 " to list with mapped offset: %" PRIi64 " and size: %" PRIu64 "\n",
-		 function,
-		 internal_source_list->mapped_offset,
-		 internal_source_list->size,
-		 internal_list->mapped_offset,
-		 internal_list->size );
+		return( -1 );
 	}
-#endif
-	if( libcdata_array_get_number_of_entries(
-	     internal_list->elements_array,
-	     &number_of_elements,
-	     error ) != 1 )
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( element == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of elements from elements array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_array_get_number_of_entries(
-	     internal_source_list->elements_array,
-	     &source_number_of_elements,
+	if( libfdata_list_get_entry_by_index(
+	     internal_list,
+	     element_index,
+	     &list_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of elements from source list elements array.",
-		 function );
+		 "%s: unable to retrieve list entry: %d.",
+		 function,
+		 element_index );
 
-		goto on_error;
+		return( -1 );
 	}
-	element_index          = number_of_elements;
-	new_number_of_elements = number_of_elements + source_number_of_elements;
-
-	if( libcdata_array_resize(
-	     internal_list->elements_array,
-	     new_number_of_elements,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_list_element_free,
-	     error ) != 1 )
+	if( ( list_entry->flags & LIBFDATA_LIST_ELEMENT_FLAG_IS_SET ) == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to resize elements array.",
-		 function );
-
-		goto on_error;
+		*element = NULL;
 	}
-	if( libcdata_array_resize(
-	     internal_list->mapped_ranges_array,
-	     new_number_of_elements,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
-	     error ) != 1 )
+	else if( libfdata_list_get_element_handle(
+	          internal_list,
+	          element_index,
+	          element,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to resize mapped ranges array.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve list element: %d.",
+		 function,
+		 element_index );
 
-		goto on_error;
+		return( -1 );
 	}
-	for( source_element_index = 0;
-	     source_element_index < source_number_of_elements;
-	     source_element_index++ )
-	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_source_list->elements_array,
-		     source_element_index,
-		     (intptr_t **) &list_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from source list elements array.",
-			 function,
-			 source_element_index );
-
-			goto on_error;
-		}
-		if( libcdata_array_set_entry_by_index(
-		     internal_list->elements_array,
-		     element_index,
-		     (intptr_t *) list_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set entry: %d in elements array.",
-			 function,
-			 element_index );
-
-			goto on_error;
-		}
-		if( libcdata_array_get_entry_by_index(
-		     internal_source_list->mapped_ranges_array,
-		     source_element_index,
-		     (intptr_t **) &mapped_range,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from source list mapped ranges array.",
-			 function,
-			 source_element_index );
+	internal_list->current_element_index = element_index;
 
-			goto on_error;
-		}
-		if( libcdata_array_set_entry_by_index(
-		     internal_list->mapped_ranges_array,
-		     element_index,
-		     (intptr_t *) mapped_range,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set entry: %d in mapped ranges array.",
-			 function,
-			 element_index );
+	return( 1 );
+}
 
-			goto on_error;
-		}
-		element_index++;
-	}
-	element_index          = number_of_elements;
-	number_of_elements     = new_number_of_elements;
-	new_number_of_elements = 0;
+/* Retrieves the data range of a specific element
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_get_element_by_index(
+     libfdata_list_t *list,
+     int element_index,
+     int *element_file_index,
+     off64_t *element_offset,
+     size64_t *element_size,
+     uint32_t *element_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_t *internal_list = NULL;
+	libfdata_list_entry_t *list_entry       = NULL;
+	static char *function                   = "libfdata_list_get_element_by_index";
 
-	if( libcdata_array_empty(
-	     internal_source_list->elements_array,
-	     NULL,
-	     error ) != 1 )
+	if( list == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to empty source list elements array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_source_list->mapped_ranges_array,
-	     NULL,
-	     error ) != 1 )
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( element_file_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to empty source list mapped ranges array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element file index.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	internal_source_list->size = 0;
-
-	while( element_index < number_of_elements )
+	if( element_offset == NULL )
 	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_list->elements_array,
-		     element_index,
-		     (intptr_t **) &list_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from elements array.",
-			 function,
-			 element_index );
-
-			goto on_error;
-		}
-		( (libfdata_internal_list_element_t *) list_element )->list          = list;
-		( (libfdata_internal_list_element_t *) list_element )->element_index = element_index;
-
-		if( libcdata_array_get_entry_by_index(
-		     internal_list->mapped_ranges_array,
-		     element_index,
-		     (intptr_t **) &mapped_range,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from mapped ranges array.",
-			 function,
-			 element_index );
-
-			goto on_error;
-		}
-		if( libfdata_mapped_range_get(
-		     mapped_range,
-		     &mapped_range_offset,
-		     &mapped_range_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve values from mapped range: %d.",
-			 function,
-			 element_index );
-
-			goto on_error;
-		}
-		if( libfdata_mapped_range_set(
-		     mapped_range,
-		     internal_list->size,
-		     mapped_range_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set values of mapped range: %d.",
-			 function,
-			 element_index );
-
-			goto on_error;
-		}
-		internal_list->size += mapped_range_size;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element offset.",
+		 function );
 
-		element_index++;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "\n" );
+		return( -1 );
 	}
-#endif
-	return( result );
-
-on_error:
-	if( new_number_of_elements != 0 )
+	if( element_size == NULL )
 	{
-		libcdata_array_resize(
-		 internal_list->mapped_ranges_array,
-		 number_of_elements,
-		 NULL,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element size.",
+		 function );
 
-		libcdata_array_resize(
-		 internal_list->elements_array,
-		 number_of_elements,
-		 NULL,
-		 NULL );
+		return( -1 );
 	}
-	return( -1 );
-}
-
-/* Determines if a specific element is set
- * Returns 1 if element is set, 0 if not or -1 on error
- */
-int libfdata_list_is_element_set(
-     libfdata_list_t *list,
-     int element_index,
-     libcerror_error_t **error )
-{
-	libfdata_internal_list_t *internal_list = NULL;
-	libfdata_list_element_t *list_element   = NULL;
-	static char *function                   = "libfdata_list_is_element_set";
-
-	if( list == NULL )
+	if( element_flags == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid list.",
+		 "%s: invalid element flags.",
 		 function );
 
 		return( -1 );
 	}
-	internal_list = (libfdata_internal_list_t *) list;
-
-	if( libcdata_array_get_entry_by_index(
-	     internal_list->elements_array,
+	if( libfdata_list_get_entry_by_index(
+	     internal_list,
 	     element_index,
-	     (intptr_t **) &list_element,
+	     &list_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from elements array.",
+		 "%s: unable to retrieve list entry: %d.",
 		 function,
 		 element_index );
 
 		return( -1 );
 	}
-	if( list_element == NULL )
+	if( ( list_entry->flags & LIBFDATA_LIST_ELEMENT_FLAG_IS_SET ) == 0 )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid list element: %d - value not set.",
+		 function,
+		 element_index );
+
+		return( -1 );
 	}
+	*element_file_index = list_entry->data_file_index;
+	*element_offset     = list_entry->data_offset;
+	*element_size       = list_entry->data_size;
+	*element_flags      = list_entry->data_flags;
+
 	internal_list->current_element_index = element_index;
 
 	return( 1 );
 }
 
-/* Mapped range functions
- */
-
-/* Retrieves the mapped offset
- * Returns 1 if successful, 0 if not set or -1 on error
+/* Sets the data range of a specific element
+ * Returns 1 if successful or -1 on error
  */
-int libfdata_list_get_mapped_offset(
+int libfdata_list_set_element_by_index(
      libfdata_list_t *list,
-     off64_t *mapped_offset,
+     int element_index,
+     int element_file_index,
+     off64_t element_offset,
+     size64_t element_size,
+     uint32_t element_flags,
      libcerror_error_t **error )
 {
 	libfdata_internal_list_t *internal_list = NULL;
-	static char *function                   = "libfdata_list_get_mapped_offset";
+	libfdata_list_entry_t *list_entry       = NULL;
+	static char *function                   = "libfdata_list_set_element_by_index";
+	size64_t mapped_size                    = 0;
+	size64_t previous_element_size          = 0;
+	uint8_t previous_entry_flags            = 0;
 
 	if( list == NULL )
 	{
@@ -1999,92 +2097,113 @@ int libfdata_list_get_mapped_offset(
 	}
 	internal_list = (libfdata_internal_list_t *) list;
 
-	if( mapped_offset == NULL )
+	if( libfdata_list_get_entry_by_index(
+	     internal_list,
+	     element_index,
+	     &list_entry,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid mapped offset.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve list entry: %d.",
+		 function,
+		 element_index );
 
 		return( -1 );
 	}
-	if( ( internal_list->flags & LIBFDATA_LIST_FLAG_HAS_MAPPED_OFFSET ) == 0 )
+	previous_entry_flags = list_entry->flags;
+
+	if( ( previous_entry_flags & LIBFDATA_LIST_ELEMENT_FLAG_HAS_MAPPED_SIZE ) != 0 )
 	{
-		return( 0 );
+		mapped_size = list_entry->mapped_size;
 	}
-	*mapped_offset = internal_list->mapped_offset;
-
-	return( 1 );
-}
-
-/* Sets the mapped offset
- * Returns 1 if successful or -1 on error
- */
-int libfdata_list_set_mapped_offset(
-     libfdata_list_t *list,
-     off64_t mapped_offset,
-     libcerror_error_t **error )
-{
-	libfdata_internal_list_t *internal_list = NULL;
-	static char *function                   = "libfdata_list_set_mapped_offset";
-
-	if( list == NULL )
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid list.",
-		 function );
-
-		return( -1 );
+		previous_element_size = list_entry->data_size;
 	}
-	internal_list = (libfdata_internal_list_t *) list;
-
-	if( mapped_offset < 0 )
+	if( libfdata_list_set_entry_data_range(
+	     internal_list,
+	     list_entry,
+	     element_file_index,
+	     element_offset,
+	     element_size,
+	     element_flags,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set data range of list entry: %d.",
+		 function,
+		 element_index );
 
 		return( -1 );
 	}
+	if( ( previous_entry_flags & LIBFDATA_LIST_ELEMENT_FLAG_IS_SET ) == 0 )
+	{
+		internal_list->size  += element_size;
+		internal_list->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+	}
+	/* If the size of the element is mapped or if the element size did not change
+	 * there is no need to recalculate the mapped range
+	 */
+	else if( ( mapped_size == 0 )
+	      && ( previous_element_size != element_size ) )
+	{
+		internal_list->size  -= previous_element_size;
+		internal_list->size  += element_size;
+		internal_list->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
 		libcnotify_printf(
-		 "%s: mapped offset: %" PRIi64 "\n",
+		 "%s: element: %03d\tfile index: %03d offset: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
 		 function,
-		 mapped_offset );
+		 element_index,
+		 element_file_index,
+		 element_offset,
+		 element_offset + element_size,
+		 element_size );
 
+		if( ( internal_list->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) == 0 )
+		{
+			libcnotify_printf(
+			 "%s: element: %03d\tmapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
+			 function,
+			 element_index,
+			 list_entry->mapped_range_offset,
+			 list_entry->mapped_range_offset + libfdata_list_entry_get_mapped_range_size( list_entry ),
+			 libfdata_list_entry_get_mapped_range_size( list_entry ) );
+		}
 		libcnotify_printf(
 		 "\n" );
 	}
 #endif
-	internal_list->mapped_offset = mapped_offset;
-	internal_list->flags        |= LIBFDATA_LIST_FLAG_HAS_MAPPED_OFFSET | LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+	internal_list->current_element_index = element_index;
 
 	return( 1 );
 }
 
-/* Retrieves the mapped size of a specific element
- * Returns 1 if successful, 0 if not set or -1 on error
+/* Prepends an element data range
+ * Returns 1 if successful or -1 on error
  */
-int libfdata_list_get_mapped_size_by_index(
+int libfdata_list_prepend_element(
      libfdata_list_t *list,
-     int element_index,
-     size64_t *mapped_size,
+     int element_file_index,
+     off64_t element_offset,
+     size64_t element_size,
+     uint32_t element_flags,
      libcerror_error_t **error )
 {
+	libfdata_list_entry_t list_entry;
+
 	libfdata_internal_list_t *internal_list = NULL;
-	libfdata_list_element_t *list_element   = NULL;
-	static char *function                   = "libfdata_list_get_mapped_size_by_index";
-	int result                              = 0;
+	static char *function                   = "libfdata_list_prepend_element";
+	int element_index                       = 0;
 
 	if( list == NULL )
 	{
@@ -2099,56 +2218,111 @@ int libfdata_list_get_mapped_size_by_index(
 	}
 	internal_list = (libfdata_internal_list_t *) list;
 
-	if( libcdata_array_get_entry_by_index(
-	     internal_list->elements_array,
-	     element_index,
-	     (intptr_t **) &list_element,
+	if( libfdata_list_materialize_entries(
+	     internal_list,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from elements array.",
-		 function,
-		 element_index );
+		 "%s: unable to resolve entries.",
+		 function );
 
 		return( -1 );
 	}
-	result = libfdata_list_element_get_mapped_size(
-	          list_element,
-	          mapped_size,
-	          error );
+	if( memory_set(
+	     &list_entry,
+	     0,
+	     sizeof( libfdata_list_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear list entry.",
+		 function );
 
-	if( result == -1 )
+		return( -1 );
+	}
+	if( libfdata_list_set_entry_data_range(
+	     internal_list,
+	     &list_entry,
+	     element_file_index,
+	     element_offset,
+	     element_size,
+	     element_flags,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve mapped size of element: %d.",
-		 function,
-		 element_index );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set data range of list entry.",
+		 function );
 
 		return( -1 );
 	}
-	internal_list->current_element_index = element_index;
+	if( libfdata_list_resize_entries(
+	     internal_list,
+	     internal_list->number_of_entries + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize entries.",
+		 function );
 
-	return( result );
+		return( -1 );
+	}
+	for( element_index = internal_list->number_of_entries - 1;
+	     element_index > 0;
+	     element_index-- )
+	{
+		internal_list->entries[ element_index ] = internal_list->entries[ element_index - 1 ];
+
+		if( internal_list->elements != NULL )
+		{
+			internal_list->elements[ element_index ] = internal_list->elements[ element_index - 1 ];
+
+			if( internal_list->elements[ element_index ] != NULL )
+			{
+				( (libfdata_internal_list_element_t *) internal_list->elements[ element_index ] )->element_index = element_index;
+			}
+		}
+	}
+	internal_list->entries[ 0 ] = list_entry;
+
+	if( internal_list->elements != NULL )
+	{
+		internal_list->elements[ 0 ] = NULL;
+	}
+	internal_list->current_element_index = 0;
+	internal_list->size                 += element_size;
+	internal_list->flags                |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+
+	return( 1 );
 }
 
-/* Sets the mapped size of a specific element
+/* Appends an element data range
  * Returns 1 if successful or -1 on error
  */
-int libfdata_list_set_mapped_size_by_index(
+int libfdata_list_append_element(
      libfdata_list_t *list,
-     int element_index,
-     size64_t mapped_size,
+     int *element_index,
+     int element_file_index,
+     off64_t element_offset,
+     size64_t element_size,
+     uint32_t element_flags,
      libcerror_error_t **error )
 {
 	libfdata_internal_list_t *internal_list = NULL;
-	libfdata_list_element_t *list_element   = NULL;
-	static char *function                   = "libfdata_list_set_mapped_size_by_index";
+	libfdata_list_entry_t *list_entry       = NULL;
+	static char *function                   = "libfdata_list_append_element";
+	off64_t mapped_offset                   = 0;
+	int number_of_elements                  = 0;
 
 	if( list == NULL )
 	{
@@ -2163,59 +2337,122 @@ int libfdata_list_set_mapped_size_by_index(
 	}
 	internal_list = (libfdata_internal_list_t *) list;
 
-	if( libcdata_array_get_entry_by_index(
-	     internal_list->elements_array,
-	     element_index,
-	     (intptr_t **) &list_element,
+	if( element_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_materialize_entries(
+	     internal_list,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from elements array.",
-		 function,
-		 element_index );
+		 "%s: unable to resolve entries.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_elements = internal_list->number_of_entries;
+
+	if( libfdata_list_resize_entries(
+	     internal_list,
+	     number_of_elements + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize entries.",
+		 function );
 
 		return( -1 );
 	}
-	if( libfdata_list_element_set_mapped_size(
-	     list_element,
-	     mapped_size,
+	list_entry = &( internal_list->entries[ number_of_elements ] );
+
+	if( libfdata_list_set_entry_data_range(
+	     internal_list,
+	     list_entry,
+	     element_file_index,
+	     element_offset,
+	     element_size,
+	     element_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set mapped size of element: %d.",
-		 function,
-		 element_index );
+		 "%s: unable to set data range of list entry.",
+		 function );
+
+		internal_list->number_of_entries = number_of_elements;
 
 		return( -1 );
 	}
-	internal_list->current_element_index = element_index;
+	mapped_offset = internal_list->mapped_offset + (off64_t) internal_list->size;
+
+	list_entry->mapped_range_offset = mapped_offset;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: element: %03d\tfile index: %03d offset: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
+		 function,
+		 number_of_elements,
+		 element_file_index,
+		 element_offset,
+		 element_offset + element_size,
+		 element_size );
+
+		libcnotify_printf(
+		 "%s: element: %03d\tmapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
+		 function,
+		 number_of_elements,
+		 mapped_offset,
+		 mapped_offset + element_size,
+		 element_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	*element_index = number_of_elements;
+
+	internal_list->current_element_index = number_of_elements;
+	internal_list->size                 += element_size;
 
 	return( 1 );
 }
 
-/* Retrieves the data range with its mapped size of a specific element
- * Returns 1 if successful, 0 if the element has no mapped size or -1 on error
+/* Appends the element of the source list to the list
+ * The list takes over the elements of the source list and the source list is emptied if successful
+ * If the list is empty the storage of the source list is taken over without copying
+ * Returns 1 if successful or -1 on error
  */
-int libfdata_list_get_element_by_index_with_mapped_size(
+int libfdata_list_append_list(
      libfdata_list_t *list,
-     int element_index,
-     int *element_file_index,
-     off64_t *element_offset,
-     size64_t *element_size,
-     uint32_t *element_flags,
-     size64_t *mapped_size,
+     libfdata_list_t *source_list,
      libcerror_error_t **error )
 {
-	libfdata_internal_list_t *internal_list = NULL;
-	libfdata_list_element_t *list_element   = NULL;
-	static char *function                   = "libfdata_list_get_element_by_index_with_mapped_size";
-	int result                              = 0;
+	libfdata_internal_list_element_t *internal_element = NULL;
+	libfdata_internal_list_t *internal_list            = NULL;
+	libfdata_internal_list_t *internal_source_list     = NULL;
+	libfdata_list_entry_t *list_entry                  = NULL;
+	static char *function                              = "libfdata_list_append_list";
+	int element_index                                  = 0;
+	int number_of_elements                             = 0;
+	int source_element_index                           = 0;
 
 	if( list == NULL )
 	{
@@ -2230,374 +2467,246 @@ int libfdata_list_get_element_by_index_with_mapped_size(
 	}
 	internal_list = (libfdata_internal_list_t *) list;
 
-	if( libcdata_array_get_entry_by_index(
-	     internal_list->elements_array,
-	     element_index,
-	     (intptr_t **) &list_element,
-	     error ) != 1 )
+	if( source_list == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from elements array.",
-		 function,
-		 element_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source list.",
+		 function );
 
 		return( -1 );
 	}
-	if( libfdata_list_element_get_data_range(
-	     list_element,
-	     element_file_index,
-	     element_offset,
-	     element_size,
-	     element_flags,
-	     error ) != 1 )
+	internal_source_list = (libfdata_internal_list_t *) source_list;
+
+	if( internal_source_list->number_of_entries > ( INT_MAX - internal_list->number_of_entries ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve data range from list element: %d.",
-		 function,
-		 element_index );
-
-		return( -1 );
-	}
-	result = libfdata_list_element_get_mapped_size(
-	          list_element,
-	          mapped_size,
-	          error );
-
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve mapped size of list element: %d.",
-		 function,
-		 element_index );
-
-		return( -1 );
-	}
-	internal_list->current_element_index = element_index;
-
-	return( result );
-}
-
-/* Sets the data range of a specific element with its mapped size
- * Returns 1 if successful or -1 on error
- */
-int libfdata_list_set_element_by_index_with_mapped_size(
-     libfdata_list_t *list,
-     int element_index,
-     int element_file_index,
-     off64_t element_offset,
-     size64_t element_size,
-     uint32_t element_flags,
-     size64_t mapped_size,
-     libcerror_error_t **error )
-{
-	libfdata_internal_list_t *internal_list = NULL;
-	libfdata_list_element_t *list_element   = NULL;
-	libfdata_mapped_range_t *mapped_range   = NULL;
-	static char *function                   = "libfdata_list_set_element_by_index_with_mapped_size";
-	off64_t previous_element_offset         = 0;
-	size64_t previous_element_size          = 0;
-	size64_t previous_mapped_size           = 0;
-	uint32_t previous_element_flags         = 0;
-	int previous_element_file_index         = 0;
-	int result                              = 0;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	off64_t mapped_range_offset             = 0;
-	size64_t mapped_range_size              = 0;
-#endif
-
-	if( list == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid list.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid source list number of elements value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	internal_list = (libfdata_internal_list_t *) list;
-
-	if( libcdata_array_get_entry_by_index(
-	     internal_list->elements_array,
-	     element_index,
-	     (intptr_t **) &list_element,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from elements array.",
-		 function,
-		 element_index );
-
-		return( -1 );
-	}
-	if( list_element == NULL )
+	if( ( internal_list->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
 	{
-		if( libfdata_list_element_initialize(
-		     &list_element,
-		     list,
-		     element_index,
+		if( libfdata_list_calculate_mapped_ranges(
+		     internal_list,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create list element.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate mapped ranges.",
 			 function );
 
 			return( -1 );
 		}
-		if( libcdata_array_set_entry_by_index(
-		     internal_list->elements_array,
-		     element_index,
-		     (intptr_t *) list_element,
+	}
+	if( ( internal_source_list->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
+	{
+		if( libfdata_list_calculate_mapped_ranges(
+		     internal_source_list,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set entry: %d in elements array.",
-			 function,
-			 element_index );
-
-			libfdata_list_element_free(
-			 &list_element,
-			 NULL );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate mapped ranges of source list.",
+			 function );
 
 			return( -1 );
 		}
 	}
-	else
+	if( ( internal_list->mapped_offset != 0 )
+	 || ( internal_source_list->mapped_offset != 0 ) )
 	{
-		result = libfdata_list_element_get_mapped_size(
-		          list_element,
-		          &previous_mapped_size,
-		          error );
-
-		if( result == -1 )
+		if( ( (size64_t) internal_list->mapped_offset + internal_list->size ) != (size64_t) internal_source_list->mapped_offset )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve mapped size of list element: %d.",
-			 function,
-			 element_index );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid source mapped offset value out of bounds.",
+			 function );
 
 			return( -1 );
 		}
-		else if( result == 0 )
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: appending source list with mapped offset: %" PRIi64 " and size: %" PRIu64 " to list with mapped offset: %" PRIi64 " and size: %" PRIu64 "\n",
+		 function,
+		 internal_source_list->mapped_offset,
+		 internal_source_list->size,
+		 internal_list->mapped_offset,
+		 internal_list->size );
+	}
+#endif
+	/* If the list is empty take over the entries and list elements of the source list
+	 */
+	if( internal_list->number_of_entries == 0 )
+	{
+		if( internal_list->entries != NULL )
+		{
+			memory_free(
+			 internal_list->entries );
+		}
+		if( internal_list->elements != NULL )
 		{
-			if( libfdata_list_element_get_data_range(
-			     list_element,
-			     &previous_element_file_index,
-			     &previous_element_offset,
-			     &previous_element_size,
-			     &previous_element_flags,
-			     error ) != 1 )
+			memory_free(
+			 internal_list->elements );
+		}
+		internal_list->entries                      = internal_source_list->entries;
+		internal_list->number_of_entries            = internal_source_list->number_of_entries;
+		internal_list->number_of_allocated_entries  = internal_source_list->number_of_allocated_entries;
+		internal_list->elements                     = internal_source_list->elements;
+		internal_list->number_of_allocated_elements = internal_source_list->number_of_allocated_elements;
+		internal_list->size                         = internal_source_list->size;
+
+		internal_source_list->entries                      = NULL;
+		internal_source_list->number_of_entries            = 0;
+		internal_source_list->number_of_allocated_entries  = 0;
+		internal_source_list->elements                     = NULL;
+		internal_source_list->number_of_allocated_elements = 0;
+		internal_source_list->size                         = 0;
+
+		if( internal_list->elements != NULL )
+		{
+			for( element_index = 0;
+			     element_index < internal_list->number_of_entries;
+			     element_index++ )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve data range of list element: %d.",
-				 function,
-				 element_index );
+				internal_element = (libfdata_internal_list_element_t *) internal_list->elements[ element_index ];
 
-				return( -1 );
+				if( internal_element != NULL )
+				{
+					internal_element->list = list;
+				}
 			}
 		}
+		return( 1 );
 	}
-	if( libfdata_list_element_set_data_range(
-	     list_element,
-	     element_file_index,
-	     element_offset,
-	     element_size,
-	     element_flags,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set data range of list element: %d.",
-		 function,
-		 element_index );
+	number_of_elements = internal_list->number_of_entries;
 
-		return( -1 );
-	}
-	if( libfdata_list_element_set_mapped_size(
-	     list_element,
-	     mapped_size,
+	if( libfdata_list_resize_entries(
+	     internal_list,
+	     number_of_elements + internal_source_list->number_of_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set mapped size of list element.",
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize entries.",
 		 function );
 
 		return( -1 );
 	}
-	/* Make sure the list has a mapped range entry for every element
+	/* Make sure the list can take over the list elements of the source list
 	 */
-	if( libcdata_array_get_entry_by_index(
-	     internal_list->mapped_ranges_array,
-	     element_index,
-	     (intptr_t **) &mapped_range,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from mapped ranges array.",
-		 function,
-		 element_index );
-
-		return( -1 );
-	}
-	if( mapped_range == NULL )
+	if( ( internal_source_list->elements != NULL )
+	 && ( internal_source_list->number_of_entries > 0 ) )
 	{
-		if( libfdata_mapped_range_initialize(
-		     &mapped_range,
+		if( libfdata_list_create_elements(
+		     internal_list,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create mapped range.",
+			 "%s: unable to create elements.",
 			 function );
 
+			libfdata_list_resize_entries(
+			 internal_list,
+			 number_of_elements,
+			 NULL );
+
 			return( -1 );
 		}
-		if( libcdata_array_set_entry_by_index(
-		     internal_list->mapped_ranges_array,
-		     element_index,
-		     (intptr_t *) mapped_range,
-		     error ) != 1 )
+	}
+	if( internal_source_list->number_of_entries > 0 )
+	{
+		if( memory_copy(
+		     &( internal_list->entries[ number_of_elements ] ),
+		     internal_source_list->entries,
+		     sizeof( libfdata_list_entry_t ) * internal_source_list->number_of_entries ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set entry: %d in mapped ranges array.",
-			 function,
-			 element_index );
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy source list entries.",
+			 function );
 
-			libfdata_mapped_range_free(
-			 &mapped_range,
+			libfdata_list_resize_entries(
+			 internal_list,
+			 number_of_elements,
 			 NULL );
 
 			return( -1 );
 		}
-		internal_list->size  += mapped_size;
-		internal_list->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
-	}
-        else if( previous_mapped_size != mapped_size )
-	{
-		if( previous_mapped_size != 0 )
-		{
-			internal_list->size -= previous_mapped_size;
-		}
-		else
-		{
-			internal_list->size -= previous_element_size;
-		}
-		if( mapped_size != 0 )
-		{
-			internal_list->size += mapped_size;
-		}
-		else
-		{
-			internal_list->size += element_size;
-		}
-		internal_list->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	element_index = number_of_elements;
+
+	for( source_element_index = 0;
+	     source_element_index < internal_source_list->number_of_entries;
+	     source_element_index++ )
 	{
-		libcnotify_printf(
-		 "%s: element: %03d\tfile index: %03d offset: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
-		 function,
-		 element_index,
-		 element_file_index,
-		 element_offset,
-		 element_offset + element_size,
-		 element_size );
+		list_entry = &( internal_list->entries[ element_index ] );
 
-		if( ( internal_list->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) == 0 )
+		list_entry->mapped_range_offset = internal_list->mapped_offset + (off64_t) internal_list->size;
+
+		internal_list->size += libfdata_list_entry_get_mapped_range_size( list_entry );
+
+		if( internal_source_list->elements != NULL )
 		{
-			if( libfdata_mapped_range_get(
-			     mapped_range,
-			     &mapped_range_offset,
-			     &mapped_range_size,
-			     error ) != 1 )
+			internal_element = (libfdata_internal_list_element_t *) internal_source_list->elements[ source_element_index ];
+
+			if( internal_element != NULL )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve values from mapped range: %d.",
-				 function,
-				 element_index );
+				internal_element->list          = list;
+				internal_element->element_index = element_index;
 
-				return( -1 );
+				internal_source_list->elements[ source_element_index ] = NULL;
 			}
-			libcnotify_printf(
-			 "%s: element: %03d\tmapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
-			 function,
-			 element_index,
-			 mapped_range_offset,
-			 mapped_range_offset + mapped_range_size,
-			 mapped_range_size );
+			internal_list->elements[ element_index ] = (libfdata_list_element_t *) internal_element;
 		}
+		element_index++;
+	}
+	internal_source_list->number_of_entries = 0;
+	internal_source_list->size              = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
 		libcnotify_printf(
 		 "\n" );
 	}
 #endif
-	internal_list->current_element_index = element_index;
-
 	return( 1 );
 }
 
-/* Appends an element data range with its mapped size
- * Returns 1 if successful or -1 on error
+/* Determines if a specific element is set
+ * Returns 1 if element is set, 0 if not or -1 on error
  */
-int libfdata_list_append_element_with_mapped_size(
+int libfdata_list_is_element_set(
      libfdata_list_t *list,
-     int *element_index,
-     int element_file_index,
-     off64_t element_offset,
-     size64_t element_size,
-     uint32_t element_flags,
-     size64_t mapped_size,
+     int element_index,
      libcerror_error_t **error )
 {
 	libfdata_internal_list_t *internal_list = NULL;
-	libfdata_list_element_t *list_element   = NULL;
-	libfdata_mapped_range_t *mapped_range   = NULL;
-	static char *function                   = "libfdata_list_append_element_with_mapped_size";
-	off64_t mapped_offset                   = 0;
-	int mapped_range_index                  = -1;
-	uint8_t list_flags                      = 0;
+	libfdata_list_entry_t *list_entry       = NULL;
+	static char *function                   = "libfdata_list_is_element_set";
 
 	if( list == NULL )
 	{
@@ -2612,225 +2721,221 @@ int libfdata_list_append_element_with_mapped_size(
 	}
 	internal_list = (libfdata_internal_list_t *) list;
 
-	if( element_index == NULL )
+	if( libfdata_list_get_entry_by_index(
+	     internal_list,
+	     element_index,
+	     &list_entry,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid element index.",
-		 function );
-
-		return( -1 );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve list entry: %d.",
+		 function,
+		 element_index );
+
+		return( -1 );
 	}
-	if( libfdata_mapped_range_initialize(
-	     &mapped_range,
-	     error ) != 1 )
+	if( ( list_entry->flags & LIBFDATA_LIST_ELEMENT_FLAG_IS_SET ) == 0 )
+	{
+		return( 0 );
+	}
+	internal_list->current_element_index = element_index;
+
+	return( 1 );
+}
+
+/* Mapped range functions
+ */
+
+/* Retrieves the mapped offset
+ * Returns 1 if successful, 0 if not set or -1 on error
+ */
+int libfdata_list_get_mapped_offset(
+     libfdata_list_t *list,
+     off64_t *mapped_offset,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_t *internal_list = NULL;
+	static char *function                   = "libfdata_list_get_mapped_offset";
+
+	if( list == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create mapped range.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	mapped_offset = internal_list->mapped_offset + (off64_t) internal_list->size;
+	internal_list = (libfdata_internal_list_t *) list;
 
-	if( libfdata_mapped_range_set(
-	     mapped_range,
-	     mapped_offset,
-	     mapped_size,
-	     error ) != 1 )
+	if( mapped_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set mapped range values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped offset.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_array_append_entry(
-	     internal_list->mapped_ranges_array,
-	     &mapped_range_index,
-	     (intptr_t *) mapped_range,
-	     error ) != 1 )
+	if( ( internal_list->flags & LIBFDATA_LIST_FLAG_HAS_MAPPED_OFFSET ) == 0 )
+	{
+		return( 0 );
+	}
+	*mapped_offset = internal_list->mapped_offset;
+
+	return( 1 );
+}
+
+/* Sets the mapped offset
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_set_mapped_offset(
+     libfdata_list_t *list,
+     off64_t mapped_offset,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_t *internal_list = NULL;
+	static char *function                   = "libfdata_list_set_mapped_offset";
+
+	if( list == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append mapped range to array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfdata_list_element_initialize(
-	     &list_element,
-	     list,
-	     0,
-	     error ) != 1 )
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( mapped_offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create list element.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfdata_list_element_set_data_range(
-	     list_element,
-	     element_file_index,
-	     element_offset,
-	     element_size,
-	     element_flags,
-	     error ) != 1 )
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: mapped offset: %" PRIi64 "\n",
+		 function,
+		 mapped_offset );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	internal_list->mapped_offset = mapped_offset;
+	internal_list->flags        |= LIBFDATA_LIST_FLAG_HAS_MAPPED_OFFSET | LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+
+	return( 1 );
+}
+
+/* Retrieves the mapped size of a specific element
+ * Returns 1 if successful, 0 if not set or -1 on error
+ */
+int libfdata_list_get_mapped_size_by_index(
+     libfdata_list_t *list,
+     int element_index,
+     size64_t *mapped_size,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_t *internal_list = NULL;
+	libfdata_list_entry_t *list_entry       = NULL;
+	static char *function                   = "libfdata_list_get_mapped_size_by_index";
+
+	if( list == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set data range of list element.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	list_flags = internal_list->flags;
+	internal_list = (libfdata_internal_list_t *) list;
 
-	if( libfdata_list_element_set_mapped_size(
-	     list_element,
-	     mapped_size,
-	     error ) != 1 )
+	if( mapped_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set mapped size of list element.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped size.",
 		 function );
 
-		goto on_error;
-	}
-	/* Setting the mapped size in the list element will set the calculate mapped ranges flag in the list
-	 * Reset the flag if it was not set before setting the mapped size in the list element
-	 */
-	if( ( list_flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) == 0 )
-	{
-		internal_list->flags &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
+		return( -1 );
 	}
-	if( libcdata_array_append_entry(
-	     internal_list->elements_array,
+	if( libfdata_list_get_entry_by_index(
+	     internal_list,
 	     element_index,
-	     (intptr_t *) list_element,
+	     &list_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append list element to elements array.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve list entry: %d.",
+		 function,
+		 element_index );
 
-		goto on_error;
+		return( -1 );
 	}
-	mapped_range_index = -1;
-	mapped_range       = NULL;
-
-	if( libfdata_list_element_set_element_index(
-	     list_element,
-	     *element_index,
-	     error ) != 1 )
+	if( ( list_entry->flags & LIBFDATA_LIST_ELEMENT_FLAG_IS_SET ) == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set list element index.",
-		 function );
-
-		list_element = NULL;
-
-		goto on_error;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: element: %03d\tfile index: %03d offset: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
-		 function,
-		 *element_index,
-		 element_file_index,
-		 element_offset,
-		 element_offset + element_size,
-		 element_size );
-
-		libcnotify_printf(
-		 "%s: element: %03d\tmapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid list element: %d - value not set.",
 		 function,
-		 *element_index,
-		 mapped_offset,
-		 mapped_offset + mapped_size,
-		 mapped_size );
+		 element_index );
 
-		libcnotify_printf(
-		 "\n" );
+		return( -1 );
 	}
-#endif
-	internal_list->current_element_index = *element_index;
-	internal_list->size                 += mapped_size;
-
-	return( 1 );
+	internal_list->current_element_index = element_index;
 
-on_error:
-	if( list_element != NULL )
-	{
-		libfdata_list_element_free(
-		 &list_element,
-		 NULL );
-	}
-	if( mapped_range_index != -1 )
+	if( ( list_entry->flags & LIBFDATA_LIST_ELEMENT_FLAG_HAS_MAPPED_SIZE ) == 0 )
 	{
-		libcdata_array_set_entry_by_index(
-		 internal_list->mapped_ranges_array,
-		 mapped_range_index,
-		 NULL,
-		 NULL );
-	}
-	if( mapped_range != NULL )
-	{
-		libfdata_mapped_range_free(
-		 &mapped_range,
-		 NULL );
+		return( 0 );
 	}
-	return( -1 );
+	*mapped_size = list_entry->mapped_size;
+
+	return( 1 );
 }
 
-/* Calculates the mapped ranges
+/* Sets the mapped size of a specific element
  * Returns 1 if successful or -1 on error
  */
-int libfdata_list_calculate_mapped_ranges(
-     libfdata_internal_list_t *internal_list,
+int libfdata_list_set_mapped_size_by_index(
+     libfdata_list_t *list,
+     int element_index,
+     size64_t mapped_size,
      libcerror_error_t **error )
 {
-	libfdata_list_element_t *list_element = NULL;
-	libfdata_mapped_range_t *mapped_range = NULL;
-	static char *function                 = "libfdata_list_calculate_mapped_ranges";
-	off64_t mapped_offset                 = 0;
-	off64_t element_offset                = 0;
-	size64_t element_size                 = 0;
-	size64_t mapped_size                  = 0;
-	uint32_t element_flags                = 0;
-	int element_file_index                = -1;
-	int element_index                     = -1;
-	int number_of_elements                = 0;
-	int result                            = 0;
+	libfdata_internal_list_t *internal_list = NULL;
+	libfdata_list_entry_t *list_entry       = NULL;
+	static char *function                   = "libfdata_list_set_mapped_size_by_index";
 
-	if( internal_list == NULL )
+	if( list == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2841,179 +2946,72 @@ int libfdata_list_calculate_mapped_ranges(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_number_of_entries(
-	     internal_list->elements_array,
-	     &number_of_elements,
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( mapped_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid mapped size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_entry_by_index(
+	     internal_list,
+	     element_index,
+	     &list_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of elements from elements array.",
-		 function );
+		 "%s: unable to retrieve list entry: %d.",
+		 function,
+		 element_index );
 
 		return( -1 );
 	}
-	mapped_offset = internal_list->mapped_offset;
-
-	for( element_index = 0;
-	     element_index < number_of_elements;
-	     element_index++ )
+	if( ( list_entry->flags & LIBFDATA_LIST_ELEMENT_FLAG_IS_SET ) == 0 )
 	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_list->elements_array,
-		     element_index,
-		     (intptr_t **) &list_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from elements array.",
-			 function,
-			 element_index );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid list element: %d - value not set.",
+		 function,
+		 element_index );
 
-			return( -1 );
-		}
-		if( libcdata_array_get_entry_by_index(
-		     internal_list->mapped_ranges_array,
-		     element_index,
-		     (intptr_t **) &mapped_range,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from mapped ranges array.",
-			 function,
-			 element_index );
+		return( -1 );
+	}
+	list_entry->mapped_size = mapped_size;
+	list_entry->flags      |= LIBFDATA_LIST_ELEMENT_FLAG_HAS_MAPPED_SIZE;
 
-			return( -1 );
-		}
-		if( libfdata_list_element_get_data_range(
-		     list_element,
-		     &element_file_index,
-		     &element_offset,
-		     &element_size,
-		     &element_flags,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve data range of list element: %d.",
-			 function,
-			 element_index );
-
-			return( -1 );
-		}
-		result = libfdata_list_element_get_mapped_size(
-		          list_element,
-		          &mapped_size,
-		          error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve mapped size of list element: %d.",
-			 function,
-			 element_index );
-
-			return( -1 );
-		}
-		else if( result == 0 )
-		{
-			mapped_size = element_size;
-		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: element: %03d\tfile index: %03d offset: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
-			 function,
-			 element_index,
-			 element_file_index,
-			 element_offset,
-			 element_offset + element_size,
-			 element_size );
-
-			libcnotify_printf(
-			 "%s: element: %03d\tmapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
-			 function,
-			 element_index,
-			 mapped_offset,
-			 mapped_offset + mapped_size,
-			 mapped_size );
-		}
-#endif
-		if( libfdata_mapped_range_set(
-		     mapped_range,
-		     mapped_offset,
-		     mapped_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set mapped range: %d values.",
-			 function,
-			 element_index );
-
-			return( -1 );
-		}
-		mapped_offset += (off64_t) mapped_size;
-	}
-	internal_list->size   = (size64_t) mapped_offset - internal_list->mapped_offset;
-	internal_list->flags &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
+	internal_list->current_element_index = element_index;
+	internal_list->flags                |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "\n" );
-	}
-#endif
 	return( 1 );
 }
 
-/* Retrieves the element index for a specific offset
- * The element_data_offset value is set to the offset relative to the start of the element
- * Returns 1 if successful, 0 if not or -1 on error
+/* Retrieves the data range with its mapped size of a specific element
+ * Returns 1 if successful, 0 if the element has no mapped size or -1 on error
  */
-int libfdata_list_get_element_index_at_offset(
+int libfdata_list_get_element_by_index_with_mapped_size(
      libfdata_list_t *list,
-     off64_t offset,
-     int *element_index,
-     off64_t *element_data_offset,
+     int element_index,
+     int *element_file_index,
+     off64_t *element_offset,
+     size64_t *element_size,
+     uint32_t *element_flags,
+     size64_t *mapped_size,
      libcerror_error_t **error )
 {
 	libfdata_internal_list_t *internal_list = NULL;
-	libfdata_mapped_range_t *mapped_range   = NULL;
-	static char *function                   = "libfdata_list_get_element_index_at_offset";
-	off64_t list_offset                     = 0;
-	off64_t mapped_range_end_offset         = 0;
-	off64_t mapped_range_start_offset       = 0;
-	size64_t mapped_range_size              = 0;
-	int initial_element_index               = 0;
-	int number_of_elements                  = 0;
-	int result                              = 0;
-	int search_element_index                = 0;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	libfdata_list_element_t *element        = NULL;
-	off64_t element_offset                  = 0;
-	size64_t element_size                   = 0;
-	uint32_t element_flags                  = 0;
-	int element_file_index                  = -1;
-#endif
+	libfdata_list_entry_t *list_entry       = NULL;
+	static char *function                   = "libfdata_list_get_element_by_index_with_mapped_size";
 
 	if( list == NULL )
 	{
@@ -3028,368 +3026,223 @@ int libfdata_list_get_element_index_at_offset(
 	}
 	internal_list = (libfdata_internal_list_t *) list;
 
-	if( offset < 0 )
+	if( mapped_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
-		 "%s: invalid offset value less than zero.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped size.",
 		 function );
 
 		return( -1 );
 	}
-	if( element_index == NULL )
+	if( libfdata_list_get_element_by_index(
+	     list,
+	     element_index,
+	     element_file_index,
+	     element_offset,
+	     element_size,
+	     element_flags,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid element index.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data range of list element: %d.",
+		 function,
+		 element_index );
 
 		return( -1 );
 	}
-	if( element_data_offset == NULL )
+	if( libfdata_list_get_entry_by_index(
+	     internal_list,
+	     element_index,
+	     &list_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve list entry: %d.",
+		 function,
+		 element_index );
+
+		return( -1 );
+	}
+	if( ( list_entry->flags & LIBFDATA_LIST_ELEMENT_FLAG_HAS_MAPPED_SIZE ) == 0 )
+	{
+		return( 0 );
+	}
+	*mapped_size = list_entry->mapped_size;
+
+	return( 1 );
+}
+
+/* Sets the data range of a specific element with its mapped size
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_set_element_by_index_with_mapped_size(
+     libfdata_list_t *list,
+     int element_index,
+     int element_file_index,
+     off64_t element_offset,
+     size64_t element_size,
+     uint32_t element_flags,
+     size64_t mapped_size,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_t *internal_list = NULL;
+	libfdata_list_entry_t *list_entry       = NULL;
+	static char *function                   = "libfdata_list_set_element_by_index_with_mapped_size";
+	size64_t previous_element_size          = 0;
+	size64_t previous_mapped_size           = 0;
+	uint8_t previous_entry_flags            = 0;
+
+	if( list == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid element data offset.",
+		 "%s: invalid list.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_list->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( mapped_size > (size64_t) INT64_MAX )
 	{
-		if( libfdata_list_calculate_mapped_ranges(
-		     internal_list,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to calculate mapped ranges.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid mapped size value exceeds maximum.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( libfdata_list_get_entry_by_index(
+	     internal_list,
+	     element_index,
+	     &list_entry,
+	     error ) != 1 )
 	{
-		libcnotify_printf(
-		 "%s: requested offset: 0x%08" PRIx64 "\n",
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve list entry: %d.",
 		 function,
-		 offset );
-	}
-#endif
-	if( internal_list->size == 0 )
-	{
-		return( 0 );
+		 element_index );
+
+		return( -1 );
 	}
-	if( offset < internal_list->mapped_offset )
+	previous_entry_flags = list_entry->flags;
+
+	if( ( previous_entry_flags & LIBFDATA_LIST_ELEMENT_FLAG_HAS_MAPPED_SIZE ) != 0 )
 	{
-		return( 0 );
+		previous_mapped_size = list_entry->mapped_size;
 	}
-	list_offset = offset - internal_list->mapped_offset;
-
-	if( (size64_t) list_offset >= internal_list->size )
+	else
 	{
-		return( 0 );
+		previous_element_size = list_entry->data_size;
 	}
-	if( libcdata_array_get_number_of_entries(
-	     internal_list->mapped_ranges_array,
-	     &number_of_elements,
+	if( libfdata_list_set_entry_data_range(
+	     internal_list,
+	     list_entry,
+	     element_file_index,
+	     element_offset,
+	     element_size,
+	     element_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from mapped ranges array.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set data range of list entry: %d.",
+		 function,
+		 element_index );
 
 		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	list_entry->mapped_size = mapped_size;
+	list_entry->flags      |= LIBFDATA_LIST_ELEMENT_FLAG_HAS_MAPPED_SIZE;
+
+	if( ( previous_entry_flags & LIBFDATA_LIST_ELEMENT_FLAG_IS_SET ) == 0 )
 	{
-		libcnotify_printf(
-		 "%s: number of elements: %d\n",
-		 function,
-		 number_of_elements );
+		internal_list->size += mapped_size;
 	}
-#endif
-	/* This assumes a fairly even distribution of the sizes of the elements
-	 */
-	initial_element_index = (int) ( ( number_of_elements * list_offset ) / internal_list->size );
-
-	/* Look for the corresponding element upwards in the array
-	 */
-	for( search_element_index = initial_element_index;
-	     search_element_index < number_of_elements;
-	     search_element_index++ )
-	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_list->mapped_ranges_array,
-		     search_element_index,
-		     (intptr_t **) &mapped_range,
-		     error ) != 1 )
+	else if( previous_mapped_size != mapped_size )
+	{
+		if( previous_mapped_size != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from mapped ranges array.",
-			 function,
-			 search_element_index );
-
-			return( -1 );
+			internal_list->size -= previous_mapped_size;
 		}
-		if( libfdata_mapped_range_get(
-		     mapped_range,
-		     &mapped_range_start_offset,
-		     &mapped_range_size,
-		     error ) != 1 )
+		else
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to retrieve values from mapped range: %d.",
-			 function,
-			 search_element_index );
-
-			return( -1 );
+			internal_list->size -= previous_element_size;
 		}
-		mapped_range_end_offset = mapped_range_start_offset + (off64_t) mapped_range_size;
-
-		if( mapped_range_end_offset < mapped_range_start_offset )
+		if( mapped_size != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid element: %d - mapped range value out of bounds.",
-			 function,
-			 search_element_index );
-
-			return( -1 );
-		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: element: %03d\tmapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
-			 function,
-			 search_element_index,
-			 mapped_range_start_offset,
-			 mapped_range_end_offset,
-			 mapped_range_size );
-		}
-#endif
-		/* Check if the offset is in the mapped range
-		 */
-		if( ( offset >= mapped_range_start_offset )
-		 && ( offset < mapped_range_end_offset ) )
-		{
-			offset -= mapped_range_start_offset;
-
-			break;
+			internal_list->size += mapped_size;
 		}
-		/* Check if the offset is out of bounds
-		 */
-		if( offset < mapped_range_start_offset )
+		else
 		{
-			search_element_index = number_of_elements;
-
-			break;
+			internal_list->size += element_size;
 		}
 	}
-	if( search_element_index >= number_of_elements )
-	{
-		/* Look for the corresponding element downwards in the array
-		 */
-		for( search_element_index = initial_element_index;
-		     search_element_index >= 0;
-		     search_element_index-- )
-		{
-			if( libcdata_array_get_entry_by_index(
-			     internal_list->mapped_ranges_array,
-			     search_element_index,
-			     (intptr_t **) &mapped_range,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve entry: %d from mapped ranges array.",
-				 function,
-				 search_element_index );
-
-				return( -1 );
-			}
-			if( libfdata_mapped_range_get(
-			     mapped_range,
-			     &mapped_range_start_offset,
-			     &mapped_range_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to retrieve values from mapped range: %d.",
-				 function,
-				 search_element_index );
-
-				return( -1 );
-			}
-			mapped_range_end_offset = mapped_range_start_offset + (off64_t) mapped_range_size;
-
-			if( mapped_range_end_offset < mapped_range_start_offset )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid element: %d - mapped range value out of bounds.",
-				 function,
-				 search_element_index );
+	internal_list->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
 
-				return( -1 );
-			}
 #if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: element: %03d\tmapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
-				 function,
-				 search_element_index,
-				 mapped_range_start_offset,
-				 mapped_range_end_offset,
-				 mapped_range_size );
-			}
-#endif
-			/* Check if the offset is in the mapped range
-			 */
-			if( ( offset >= mapped_range_start_offset )
-			 && ( offset < mapped_range_end_offset ) )
-			{
-				offset -= mapped_range_start_offset;
-
-				break;
-			}
-			/* Check if the offset is out of bounds
-			 */
-			if( offset > mapped_range_start_offset )
-			{
-				search_element_index--;
-
-				break;
-			}
-		}
-	}
-	if( ( search_element_index >= 0 )
-	 && ( search_element_index < number_of_elements ) )
+	if( libcnotify_verbose != 0 )
 	{
-		if( offset < 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid offset value out of bounds.",
-			 function );
-
-			return( -1 );
-		}
-		*element_data_offset = offset;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			if( libcdata_array_get_entry_by_index(
-			     internal_list->elements_array,
-			     search_element_index,
-			     (intptr_t **) &element,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve entry: %d from elements array.",
-				 function,
-				 search_element_index );
-
-				return( -1 );
-			}
-			if( libfdata_list_element_get_data_range(
-			     element,
-			     &element_file_index,
-			     &element_offset,
-			     &element_size,
-			     &element_flags,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve data range of list element: %d.",
-				 function,
-				 search_element_index );
+		libcnotify_printf(
+		 "%s: element: %03d\tfile index: %03d offset: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
+		 function,
+		 element_index,
+		 element_file_index,
+		 element_offset,
+		 element_offset + element_size,
+		 element_size );
 
-				return( -1 );
-			}
-			libcnotify_printf(
-			 "%s: element: %03d\tfile index: %03d offset: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
-			 function,
-			 search_element_index,
-			 element_file_index,
-			 element_offset,
-			 element_offset + element_size,
-			 element_size );
-		}
-#endif
-		internal_list->current_element_index = search_element_index;
+		libcnotify_printf(
+		 "%s: element: %03d\tmapped size: %" PRIu64 "\n",
+		 function,
+		 element_index,
+		 mapped_size );
 
-		result = 1;
-	}
-	if( result == 1 )
-	{
-		*element_index = search_element_index;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
 		libcnotify_printf(
 		 "\n" );
 	}
 #endif
-	return( result );
+	internal_list->current_element_index = element_index;
+
+	return( 1 );
 }
 
-/* Retrieves the list element for a specific offset
- * The element_data_offset value is set to the offset relative to the start of the element
- * Returns 1 if successful, 0 if not or -1 on error
+/* Appends an element data range with its mapped size
+ * Returns 1 if successful or -1 on error
  */
-int libfdata_list_get_list_element_at_offset(
+int libfdata_list_append_element_with_mapped_size(
      libfdata_list_t *list,
-     off64_t offset,
      int *element_index,
-     off64_t *element_data_offset,
-     libfdata_list_element_t **element,
+     int element_file_index,
+     off64_t element_offset,
+     size64_t element_size,
+     uint32_t element_flags,
+     size64_t mapped_size,
      libcerror_error_t **error )
 {
 	libfdata_internal_list_t *internal_list = NULL;
-	static char *function                   = "libfdata_list_get_list_element_at_offset";
-	int result                              = 0;
+	libfdata_list_entry_t *list_entry       = NULL;
+	static char *function                   = "libfdata_list_append_element_with_mapped_size";
+	off64_t mapped_offset                   = 0;
+	int number_of_elements                  = 0;
 
 	if( list == NULL )
 	{
@@ -3404,17 +3257,6 @@ int libfdata_list_get_list_element_at_offset(
 	}
 	internal_list = (libfdata_internal_list_t *) list;
 
-	if( offset < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
-		 "%s: invalid offset value less than zero.",
-		 function );
-
-		return( -1 );
-	}
 	if( element_index == NULL )
 	{
 		libcerror_error_set(
@@ -3426,188 +3268,120 @@ int libfdata_list_get_list_element_at_offset(
 
 		return( -1 );
 	}
-	if( element == NULL )
+	if( mapped_size > (size64_t) INT64_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid element.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid mapped size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	result = libfdata_list_get_element_index_at_offset(
-	          list,
-	          offset,
-	          element_index,
-	          element_data_offset,
-	          error );
-
-	if( result == -1 )
+	if( libfdata_list_materialize_entries(
+	     internal_list,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element index at offset: 0x%08" PRIx64 ".",
-		 function,
-		 offset );
+		 "%s: unable to resolve entries.",
+		 function );
 
 		return( -1 );
 	}
-	else if( result != 0 )
-	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_list->elements_array,
-		     *element_index,
-		     (intptr_t **) element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from elements array.",
-			 function,
-			 *element_index );
-
-			return( -1 );
-		}
-	}
-	return( result );
-}
-
-/* Retrieves the data range of an element at a specific offset
- * Returns 1 if successful, 0 if not or -1 on error
- */
-int libfdata_list_get_element_at_offset(
-     libfdata_list_t *list,
-     off64_t offset,
-     int *element_index,
-     off64_t *element_data_offset,
-     int *element_file_index,
-     off64_t *element_offset,
-     size64_t *element_size,
-     uint32_t *element_flags,
-     libcerror_error_t **error )
-{
-	libfdata_internal_list_t *internal_list = NULL;
-	libfdata_list_element_t *list_element   = NULL;
-	static char *function                   = "libfdata_list_get_element_at_offset";
-	int result                              = 0;
+	number_of_elements = internal_list->number_of_entries;
 
-	if( list == NULL )
+	if( libfdata_list_resize_entries(
+	     internal_list,
+	     number_of_elements + 1,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid list.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize entries.",
 		 function );
 
 		return( -1 );
 	}
-	internal_list = (libfdata_internal_list_t *) list;
+	list_entry = &( internal_list->entries[ number_of_elements ] );
 
-	if( element_index == NULL )
+	if( libfdata_list_set_entry_data_range(
+	     internal_list,
+	     list_entry,
+	     element_file_index,
+	     element_offset,
+	     element_size,
+	     element_flags,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid element index.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set data range of list entry.",
 		 function );
 
+		internal_list->number_of_entries = number_of_elements;
+
 		return( -1 );
 	}
-	result = libfdata_list_get_element_index_at_offset(
-	          list,
-	          offset,
-	          element_index,
-	          element_data_offset,
-	          error );
+	mapped_offset = internal_list->mapped_offset + (off64_t) internal_list->size;
 
-	if( result == -1 )
+	list_entry->mapped_range_offset = mapped_offset;
+	list_entry->mapped_size         = mapped_size;
+	list_entry->flags              |= LIBFDATA_LIST_ELEMENT_FLAG_HAS_MAPPED_SIZE;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element index at offset: 0x%08" PRIx64 ".",
+		libcnotify_printf(
+		 "%s: element: %03d\tfile index: %03d offset: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
 		 function,
-		 offset );
+		 number_of_elements,
+		 element_file_index,
+		 element_offset,
+		 element_offset + element_size,
+		 element_size );
 
-		return( -1 );
+		libcnotify_printf(
+		 "%s: element: %03d\tmapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
+		 function,
+		 number_of_elements,
+		 mapped_offset,
+		 mapped_offset + mapped_size,
+		 mapped_size );
+
+		libcnotify_printf(
+		 "\n" );
 	}
-	else if( result != 0 )
-	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_list->elements_array,
-		     *element_index,
-		     (intptr_t **) &list_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from elements array.",
-			 function,
-			 *element_index );
+#endif
+	*element_index = number_of_elements;
 
-			return( -1 );
-		}
-		if( libfdata_list_element_get_data_range(
-		     list_element,
-		     element_file_index,
-		     element_offset,
-		     element_size,
-		     element_flags,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve data range of list element: %d.",
-			 function,
-			 *element_index );
+	internal_list->current_element_index = number_of_elements;
+	internal_list->size                 += mapped_size;
 
-			return( -1 );
-		}
-	}
-	return( result );
+	return( 1 );
 }
 
-/* List element value functions
- */
-
-/* Caches the element value
+/* Calculates the mapped ranges
  * Returns 1 if successful or -1 on error
  */
-int libfdata_list_cache_element_value(
-     libfdata_list_t *list,
-     libfcache_cache_t *cache,
-     int element_index,
-     int element_file_index,
-     off64_t element_offset,
-     size64_t element_size,
-     uint32_t element_flags,
-     time_t element_timestamp,
-     intptr_t *element_value,
-     int (*free_element_value)(
-            intptr_t **element_value,
-            libcerror_error_t **error ),
-     uint8_t write_flags,
+int libfdata_list_calculate_mapped_ranges(
+     libfdata_internal_list_t *internal_list,
      libcerror_error_t **error )
 {
-	libfdata_internal_list_t *internal_list = NULL;
-	static char *function                   = "libfdata_list_cache_element_value";
-	int cache_entry_index                   = -1;
-	int number_of_cache_entries             = 0;
+	libfdata_list_entry_t *list_entry = NULL;
+	static char *function             = "libfdata_list_calculate_mapped_ranges";
+	off64_t mapped_offset             = 0;
+	size64_t mapped_size              = 0;
+	int element_index                 = 0;
 
-	if( list == NULL )
+	if( internal_list == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -3618,109 +3392,109 @@ int libfdata_list_cache_element_value(
 
 		return( -1 );
 	}
-	internal_list = (libfdata_internal_list_t *) list;
-
-	if( element_index < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid element index value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
-	if( libfcache_cache_get_number_of_entries(
-	     cache,
-	     &number_of_cache_entries,
+	/* The mapped ranges of a lazy list require all its elements
+	 */
+	if( libfdata_list_materialize_entries(
+	     internal_list,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of cache entries.",
+		 "%s: unable to resolve entries.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_cache_entries <= 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid number of cache entries value out of bounds.",
-		 function );
+	mapped_offset = internal_list->mapped_offset;
 
-		return( -1 );
-	}
-	if( internal_list->calculate_cache_entry_index == NULL )
-	{
-		cache_entry_index = element_index % number_of_cache_entries;
-	}
-	else
+	for( element_index = 0;
+	     element_index < internal_list->number_of_entries;
+	     element_index++ )
 	{
-		cache_entry_index = internal_list->calculate_cache_entry_index(
-		                     element_index,
-		                     element_file_index,
-		                     element_offset,
-		                     element_size,
-		                     element_flags,
-		                     number_of_cache_entries );
+		list_entry = &( internal_list->entries[ element_index ] );
+
+		if( ( list_entry->flags & LIBFDATA_LIST_ELEMENT_FLAG_IS_SET ) == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid list element: %d - value not set.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		if( ( list_entry->flags & LIBFDATA_LIST_ELEMENT_FLAG_HAS_MAPPED_SIZE ) != 0 )
+		{
+			mapped_size = list_entry->mapped_size;
+		}
+		else
+		{
+			mapped_size = list_entry->data_size;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: element: %03d\tfile index: %03d offset: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
+			 function,
+			 element_index,
+			 list_entry->data_file_index,
+			 list_entry->data_offset,
+			 list_entry->data_offset + list_entry->data_size,
+			 list_entry->data_size );
+
+			libcnotify_printf(
+			 "%s: element: %03d\tmapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
+			 function,
+			 element_index,
+			 mapped_offset,
+			 mapped_offset + mapped_size,
+			 mapped_size );
+		}
+#endif
+		list_entry->mapped_range_offset = mapped_offset;
+
+		mapped_offset += (off64_t) mapped_size;
 	}
-	if( libfcache_cache_set_value_by_index(
-	     cache,
-	     cache_entry_index,
-	     element_file_index,
-	     element_offset,
-	     element_timestamp,
-	     element_value,
-	     free_element_value,
-	     write_flags,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set value in cache entry: %d.",
-		 function,
-		 cache_entry_index );
+	internal_list->size   = (size64_t) mapped_offset - internal_list->mapped_offset;
+	internal_list->flags &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
 
-		return( -1 );
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "\n" );
 	}
+#endif
 	return( 1 );
 }
 
-/* Retrieves the element value
- * Returns 1 if successful or -1 on error
+/* Retrieves the element index for a specific offset
+ * The element_data_offset value is set to the offset relative to the start of the element
+ * Returns 1 if successful, 0 if not or -1 on error
  */
-int libfdata_list_get_element_value(
+int libfdata_list_get_element_index_at_offset(
      libfdata_list_t *list,
-     intptr_t *file_io_handle,
-     libfcache_cache_t *cache,
-     libfdata_list_element_t *element,
-     intptr_t **element_value,
-     uint8_t read_flags,
+     off64_t offset,
+     int *element_index,
+     off64_t *element_data_offset,
      libcerror_error_t **error )
 {
-	libfcache_cache_value_t *cache_value    = NULL;
 	libfdata_internal_list_t *internal_list = NULL;
-	static char *function                   = "libfdata_list_get_element_value";
-        off64_t cache_value_offset              = (off64_t) -1;
-	off64_t element_offset                  = 0;
-	size64_t element_size                   = 0;
-	time_t cache_value_timestamp            = 0;
-	time_t element_timestamp                = 0;
-	uint32_t element_flags                  = 0;
-	int cache_entry_index                   = -1;
-	int cache_value_file_index              = -1;
-	int element_file_index                  = -1;
-	int element_index                       = -1;
-	int number_of_cache_entries             = 0;
-	int result                              = 0;
+	libfdata_list_entry_t *list_entry       = NULL;
+	static char *function                   = "libfdata_list_get_element_index_at_offset";
+	off64_t list_offset                     = 0;
+	off64_t mapped_range_end_offset         = 0;
+	off64_t mapped_range_start_offset       = 0;
+	int lower_element_index                 = 0;
+	int middle_element_index                = 0;
+	int number_of_elements                  = 0;
+	int search_element_index                = -1;
+	int upper_element_index                 = 0;
 
 	if( list == NULL )
 	{
@@ -3735,314 +3509,1712 @@ int libfdata_list_get_element_value(
 	}
 	internal_list = (libfdata_internal_list_t *) list;
 
-	if( internal_list->read_element_data == NULL )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid list - missing read element data function.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfdata_list_element_get_data_range(
-	     element,
-	     &element_file_index,
-	     &element_offset,
-	     &element_size,
-	     &element_flags,
-	     error ) != 1 )
+	if( element_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve data range from list element.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element index.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfcache_cache_get_number_of_entries(
-	     cache,
-	     &number_of_cache_entries,
-	     error ) != 1 )
+	if( element_data_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of cache entries.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element data offset.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfdata_list_element_get_element_index(
-	     element,
-	     &element_index,
-	     error ) != 1 )
+	if( ( internal_list->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element index from list element.",
-		 function );
-
-		return( -1 );
-	}
-	if( number_of_cache_entries <= 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid number of cache entries value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
-	{
-		if( internal_list->calculate_cache_entry_index == NULL )
-		{
-			cache_entry_index = element_index % number_of_cache_entries;
-		}
-		else
-		{
-			cache_entry_index = internal_list->calculate_cache_entry_index(
-			                     element_index,
-			                     element_file_index,
-			                     element_offset,
-			                     element_size,
-			                     element_flags,
-			                     number_of_cache_entries );
-		}
-		if( libfcache_cache_get_value_by_index(
-		     cache,
-		     cache_entry_index,
-		     &cache_value,
+		if( libfdata_list_calculate_mapped_ranges(
+		     internal_list,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve cache entry: %d from cache.",
-			 function,
-			 cache_entry_index );
+			 "%s: unable to calculate mapped ranges.",
+			 function );
 
 			return( -1 );
 		}
-		if( cache_value != NULL )
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: requested offset: 0x%08" PRIx64 "\n",
+		 function,
+		 offset );
+	}
+#endif
+	if( internal_list->size == 0 )
+	{
+		return( 0 );
+	}
+	if( offset < internal_list->mapped_offset )
+	{
+		return( 0 );
+	}
+	list_offset = offset - internal_list->mapped_offset;
+
+	if( (size64_t) list_offset >= internal_list->size )
+	{
+		return( 0 );
+	}
+	number_of_elements = internal_list->number_of_entries;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: number of elements: %d\n",
+		 function,
+		 number_of_elements );
+	}
+#endif
+	/* The mapped ranges are contiguous and in element order, hence the mapped
+	 * range offsets of the entries form a sorted cumulative offset array.
+	 * The element containing the offset is the last element of which
+	 * the mapped range starts at or before the offset.
+	 */
+
+	/* First check the current element and its successor so that
+	 * sequential access does not need to search
+	 */
+	if( ( internal_list->current_element_index >= 0 )
+	 && ( internal_list->current_element_index < number_of_elements ) )
+	{
+		for( middle_element_index = internal_list->current_element_index;
+		     ( middle_element_index < number_of_elements )
+		  && ( middle_element_index <= ( internal_list->current_element_index + 1 ) );
+		     middle_element_index++ )
 		{
-			if( libfdata_list_element_get_timestamp(
-			     element,
-			     &element_timestamp,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve time stamp from list element.",
-				 function );
+			list_entry = &( internal_list->entries[ middle_element_index ] );
 
-				return( -1 );
-			}
-			if( libfcache_cache_value_get_identifier(
-			     cache_value,
-			     &cache_value_file_index,
-			     &cache_value_offset,
-			     &cache_value_timestamp,
-			     error ) != 1 )
+			if( ( offset >= list_entry->mapped_range_offset )
+			 && ( (size64_t) ( offset - list_entry->mapped_range_offset ) < libfdata_list_entry_get_mapped_range_size( list_entry ) ) )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve cache value identifier.",
-				 function );
+				search_element_index = middle_element_index;
 
-				return( -1 );
+				break;
 			}
 		}
-		if( ( element_file_index == cache_value_file_index )
-                 && ( element_offset == cache_value_offset )
-		 && ( element_timestamp == cache_value_timestamp ) )
-		{
-			result = 1;
-		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+	}
+	if( search_element_index == -1 )
+	{
+		lower_element_index = 0;
+		upper_element_index = number_of_elements - 1;
+
+		while( lower_element_index < upper_element_index )
 		{
-			if( result == 0 )
+			middle_element_index = upper_element_index - ( ( upper_element_index - lower_element_index ) / 2 );
+
+			if( offset < internal_list->entries[ middle_element_index ].mapped_range_offset )
 			{
-				libcnotify_printf(
-				 "%s: cache: 0x%08" PRIjx " miss (%d out of %d)\n",
-				 function,
-				 (intptr_t) cache,
-				 cache_entry_index,
-				 number_of_cache_entries );
+				upper_element_index = middle_element_index - 1;
 			}
 			else
 			{
-				libcnotify_printf(
-				 "%s: cache: 0x%08" PRIjx " hit (%d out of %d)\n",
-				 function,
-				 (intptr_t) cache,
-				 cache_entry_index,
-				 number_of_cache_entries );
+				lower_element_index = middle_element_index;
 			}
 		}
-#endif
+		search_element_index = lower_element_index;
 	}
-	if( result == 0 )
+	list_entry = &( internal_list->entries[ search_element_index ] );
+
+	mapped_range_start_offset = list_entry->mapped_range_offset;
+	mapped_range_end_offset   = mapped_range_start_offset + (off64_t) libfdata_list_entry_get_mapped_range_size( list_entry );
+
+	if( mapped_range_end_offset < mapped_range_start_offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element: %d - mapped range value out of bounds.",
+		 function,
+		 search_element_index );
+
+		return( -1 );
+	}
+	if( ( offset < mapped_range_start_offset )
+	 || ( offset >= mapped_range_end_offset ) )
 	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: reading element data at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIu64 "\n",
-			 function,
-			 element_offset,
-			 element_offset,
-			 element_size );
-		}
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: element: %03d\tmapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
+		 function,
+		 search_element_index,
+		 mapped_range_start_offset,
+		 mapped_range_end_offset,
+		 libfdata_list_entry_get_mapped_range_size( list_entry ) );
+
+		libcnotify_printf(
+		 "%s: element: %03d\tfile index: %03d offset: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
+		 function,
+		 search_element_index,
+		 list_entry->data_file_index,
+		 list_entry->data_offset,
+		 list_entry->data_offset + list_entry->data_size,
+		 list_entry->data_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
 #endif
-		if( internal_list->read_element_data(
-		     internal_list->data_handle,
-		     file_io_handle,
-		     element,
-		     cache,
-		     element_file_index,
-		     element_offset,
-		     element_size,
-		     element_flags,
-		     read_flags,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read element data at offset: 0x%08" PRIx64 ".",
-			 function,
-			 element_offset );
+	internal_list->current_element_index = search_element_index;
 
-			return( -1 );
-		}
-		if( internal_list->calculate_cache_entry_index == NULL )
-		{
-			cache_entry_index = element_index % number_of_cache_entries;
-		}
-		else
-		{
-			cache_entry_index = internal_list->calculate_cache_entry_index(
-			                     element_index,
-			                     element_file_index,
-			                     element_offset,
-			                     element_size,
-			                     element_flags,
-			                     number_of_cache_entries );
-		}
-		if( libfcache_cache_get_value_by_index(
-		     cache,
-		     cache_entry_index,
-		     &cache_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve cache entry: %d from cache.",
-			 function,
-			 cache_entry_index );
+	*element_index       = search_element_index;
+	*element_data_offset = offset - mapped_range_start_offset;
 
-			return( -1 );
-		}
-		if( cache_value != NULL )
-		{
-			if( libfdata_list_element_get_timestamp(
-			     element,
-			     &element_timestamp,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve time stamp from list element.",
-				 function );
+	return( 1 );
+}
 
-				return( -1 );
-			}
-			if( libfcache_cache_value_get_identifier(
-			     cache_value,
-			     &cache_value_file_index,
-			     &cache_value_offset,
-			     &cache_value_timestamp,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve cache value identifier.",
-				 function );
+/* Retrieves the list element for a specific offset
+ * The element_data_offset value is set to the offset relative to the start of the element
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libfdata_list_get_list_element_at_offset(
+     libfdata_list_t *list,
+     off64_t offset,
+     int *element_index,
+     off64_t *element_data_offset,
+     libfdata_list_element_t **element,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_t *internal_list = NULL;
+	static char *function                   = "libfdata_list_get_list_element_at_offset";
+	int result                              = 0;
 
-				return( -1 );
-			}
-		}
-		if( ( element_file_index != cache_value_file_index )
-		 || ( element_offset != cache_value_offset )
-		 || ( element_timestamp != cache_value_timestamp ) )
-		{
-			libcerror_error_set(
+	if( list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
+	}
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element index.",
+		 function );
+
+		return( -1 );
+	}
+	if( element == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfdata_list_get_element_index_at_offset(
+	          list,
+	          offset,
+	          element_index,
+	          element_data_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element index at offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libfdata_list_get_element_handle(
+		     internal_list,
+		     *element_index,
+		     element,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve list element: %d.",
+			 function,
+			 *element_index );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the data range of an element at a specific offset
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libfdata_list_get_element_at_offset(
+     libfdata_list_t *list,
+     off64_t offset,
+     int *element_index,
+     off64_t *element_data_offset,
+     int *element_file_index,
+     off64_t *element_offset,
+     size64_t *element_size,
+     uint32_t *element_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_t *internal_list = NULL;
+	libfdata_list_entry_t *list_entry       = NULL;
+	static char *function                   = "libfdata_list_get_element_at_offset";
+	int result                              = 0;
+
+	if( list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
+	}
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( element_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element index.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_file_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element file index.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element size.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element flags.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfdata_list_get_element_index_at_offset(
+	          list,
+	          offset,
+	          element_index,
+	          element_data_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element index at offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		list_entry = &( internal_list->entries[ *element_index ] );
+
+		*element_file_index = list_entry->data_file_index;
+		*element_offset     = list_entry->data_offset;
+		*element_size       = list_entry->data_size;
+		*element_flags      = list_entry->data_flags;
+	}
+	return( result );
+}
+
+/* List element value functions
+ */
+
+/* Caches the element value
+ * The cache value is identified by the element data file index and offset
+ * and the time stamp of the list, the element time stamp is ignored
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_cache_element_value(
+     libfdata_list_t *list,
+     libfcache_cache_t *cache,
+     int element_index,
+     int element_file_index,
+     off64_t element_offset,
+     size64_t element_size,
+     uint32_t element_flags,
+     time_t element_timestamp LIBFDATA_ATTRIBUTE_UNUSED,
+     intptr_t *element_value,
+     int (*free_element_value)(
+            intptr_t **element_value,
+            libcerror_error_t **error ),
+     uint8_t write_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_t *internal_list = NULL;
+	static char *function                   = "libfdata_list_cache_element_value";
+	int cache_entry_index                   = -1;
+	int number_of_cache_entries             = 0;
+
+	LIBFDATA_UNREFERENCED_PARAMETER( element_timestamp )
+
+	if( list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
+	}
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( element_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cache entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_list->calculate_cache_entry_index == NULL )
+	{
+		cache_entry_index = element_index % number_of_cache_entries;
+	}
+	else
+	{
+		cache_entry_index = internal_list->calculate_cache_entry_index(
+		                     element_index,
+		                     element_file_index,
+		                     element_offset,
+		                     element_size,
+		                     element_flags,
+		                     number_of_cache_entries );
+	}
+	if( libfcache_cache_set_value_by_index(
+	     cache,
+	     cache_entry_index,
+	     element_file_index,
+	     element_offset,
+	     internal_list->timestamp,
+	     element_value,
+	     free_element_value,
+	     write_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set value in cache entry: %d.",
+		 function,
+		 cache_entry_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the element value
+ * The cache value is identified by the element data file index and offset
+ * and the time stamp of the list, hence a cache hit does not require
+ * the time stamp of the element
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_get_element_value(
+     libfdata_list_t *list,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     libfdata_list_element_t *element,
+     intptr_t **element_value,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value    = NULL;
+	libfdata_internal_list_t *internal_list = NULL;
+	static char *function                   = "libfdata_list_get_element_value";
+        off64_t cache_value_offset              = (off64_t) -1;
+	off64_t element_offset                  = 0;
+	size64_t element_size                   = 0;
+	time_t cache_value_timestamp            = 0;
+	uint32_t element_flags                  = 0;
+	int cache_entry_index                   = -1;
+	int cache_value_file_index              = -1;
+	int element_file_index                  = -1;
+	int element_index                       = -1;
+	int number_of_cache_entries             = 0;
+	int result                              = 0;
+
+	if( list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
+	}
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( internal_list->read_element_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid list - missing read element data function.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_element_get_data_range(
+	     element,
+	     &element_file_index,
+	     &element_offset,
+	     &element_size,
+	     &element_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data range from list element.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_element_get_element_index(
+	     element,
+	     &element_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element index from list element.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cache entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The cache entry index is calculated once and reused after the element data was read
+	 */
+	if( internal_list->calculate_cache_entry_index == NULL )
+	{
+		cache_entry_index = element_index % number_of_cache_entries;
+	}
+	else
+	{
+		cache_entry_index = internal_list->calculate_cache_entry_index(
+		                     element_index,
+		                     element_file_index,
+		                     element_offset,
+		                     element_size,
+		                     element_flags,
+		                     number_of_cache_entries );
+	}
+	if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
+	{
+		if( libfcache_cache_get_value_by_index(
+		     cache,
+		     cache_entry_index,
+		     &cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache entry: %d from cache.",
+			 function,
+			 cache_entry_index );
+
+			return( -1 );
+		}
+		if( cache_value != NULL )
+		{
+			if( libfcache_cache_value_get_identifier(
+			     cache_value,
+			     &cache_value_file_index,
+			     &cache_value_offset,
+			     &cache_value_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve cache value identifier.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( ( element_file_index == cache_value_file_index )
+                 && ( element_offset == cache_value_offset )
+		 && ( internal_list->timestamp == cache_value_timestamp ) )
+		{
+			result = 1;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( result == 0 )
+			{
+				libcnotify_printf(
+				 "%s: cache: 0x%08" PRIjx " miss (%d out of %d)\n",
+				 function,
+				 (intptr_t) cache,
+				 cache_entry_index,
+				 number_of_cache_entries );
+			}
+			else
+			{
+				libcnotify_printf(
+				 "%s: cache: 0x%08" PRIjx " hit (%d out of %d)\n",
+				 function,
+				 (intptr_t) cache,
+				 cache_entry_index,
+				 number_of_cache_entries );
+			}
+		}
+#endif
+	}
+	if( result == 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading element data at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIu64 "\n",
+			 function,
+			 element_offset,
+			 element_offset,
+			 element_size );
+		}
+#endif
+		if( internal_list->read_element_data(
+		     internal_list->data_handle,
+		     file_io_handle,
+		     element,
+		     cache,
+		     element_file_index,
+		     element_offset,
+		     element_size,
+		     element_flags,
+		     read_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read element data at offset: 0x%08" PRIx64 ".",
+			 function,
+			 element_offset );
+
+			return( -1 );
+		}
+		if( libfcache_cache_get_value_by_index(
+		     cache,
+		     cache_entry_index,
+		     &cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache entry: %d from cache.",
+			 function,
+			 cache_entry_index );
+
+			return( -1 );
+		}
+		if( cache_value != NULL )
+		{
+			if( libfcache_cache_value_get_identifier(
+			     cache_value,
+			     &cache_value_file_index,
+			     &cache_value_offset,
+			     &cache_value_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve cache value identifier.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( ( element_file_index != cache_value_file_index )
+		 || ( element_offset != cache_value_offset )
+		 || ( internal_list->timestamp != cache_value_timestamp ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing cache value.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libfcache_cache_value_get_value(
+	     cache_value,
+	     element_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element value.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the value of a specific element
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_get_element_value_by_index(
+     libfdata_list_t *list,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     int element_index,
+     intptr_t **element_value,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_element_t list_element;
+
+	libfdata_internal_list_t *internal_list = NULL;
+	libfdata_list_entry_t *list_entry       = NULL;
+	static char *function                   = "libfdata_list_get_element_value_by_index";
+
+	if( list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
+	}
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( libfdata_list_get_entry_by_index(
+	     internal_list,
+	     element_index,
+	     &list_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve list entry: %d.",
+		 function,
+		 element_index );
+
+		return( -1 );
+	}
+	if( ( list_entry->flags & LIBFDATA_LIST_ELEMENT_FLAG_IS_SET ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid list element: %d - value not set.",
+		 function,
+		 element_index );
+
+		return( -1 );
+	}
+	/* Use a transient list element to prevent creating a list element for every element value
+	 */
+	list_element.list          = list;
+	list_element.element_index = element_index;
+
+	if( libfdata_list_get_element_value(
+	     list,
+	     file_io_handle,
+	     cache,
+	     (libfdata_list_element_t *) &list_element,
+	     element_value,
+	     read_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element value.",
+		 function );
+
+		return( -1 );
+	}
+	internal_list->current_element_index = element_index;
+
+	return( 1 );
+}
+
+/* Compares the data ranges of two read ranges by file index and offset
+ * Returns -1 if the data of the first range is stored before that of the second range,
+ * 1 if after or 0 if at the same offset
+ */
+int libfdata_list_read_range_compare(
+     const libfdata_list_read_range_t *first_read_range,
+     const libfdata_list_read_range_t *second_read_range )
+{
+	if( first_read_range->file_index != second_read_range->file_index )
+	{
+		return( ( first_read_range->file_index < second_read_range->file_index ) ? -1 : 1 );
+	}
+	if( first_read_range->offset != second_read_range->offset )
+	{
+		return( ( first_read_range->offset < second_read_range->offset ) ? -1 : 1 );
+	}
+	return( 0 );
+}
+
+/* Determines if the value of the element of a read range is cached
+ * Returns 1 if cached, 0 if not or -1 on error
+ */
+int libfdata_list_is_element_value_cached(
+     libfdata_internal_list_t *internal_list,
+     libfcache_cache_t *cache,
+     int number_of_cache_entries,
+     libfdata_list_read_range_t *read_range,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value = NULL;
+	static char *function                = "libfdata_list_is_element_value_cached";
+	off64_t cache_value_offset           = (off64_t) -1;
+	time_t cache_value_timestamp         = 0;
+	int cache_entry_index                = -1;
+	int cache_value_file_index           = -1;
+
+	if( internal_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cache entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read range.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_list->calculate_cache_entry_index == NULL )
+	{
+		cache_entry_index = read_range->element_index % number_of_cache_entries;
+	}
+	else
+	{
+		cache_entry_index = internal_list->calculate_cache_entry_index(
+		                     read_range->element_index,
+		                     read_range->file_index,
+		                     read_range->offset,
+		                     read_range->size,
+		                     read_range->flags,
+		                     number_of_cache_entries );
+	}
+	if( libfcache_cache_get_value_by_index(
+	     cache,
+	     cache_entry_index,
+	     &cache_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache entry: %d from cache.",
+		 function,
+		 cache_entry_index );
+
+		return( -1 );
+	}
+	if( cache_value == NULL )
+	{
+		return( 0 );
+	}
+	if( libfcache_cache_value_get_identifier(
+	     cache_value,
+	     &cache_value_file_index,
+	     &cache_value_offset,
+	     &cache_value_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache value identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_range->file_index != cache_value_file_index )
+	 || ( read_range->offset != cache_value_offset )
+	 || ( internal_list->timestamp != cache_value_timestamp ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Prefetches the values of a range of elements into the cache
+ * The element data is read sorted by file index and offset instead of in element order,
+ * elements of which the value is already cached are not read again
+ * If a read elements data function was set, consecutive elements of which the data
+ * is stored contiguously in the same file are read with a single call to it
+ * At most the number of cache entries elements are prefetched
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_prefetch_element_values(
+     libfdata_list_t *list,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     int first_element_index,
+     int number_of_elements,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_element_t list_element;
+
+	libfdata_internal_list_t *internal_list       = NULL;
+	libfdata_list_entry_t *list_entry             = NULL;
+	libfdata_list_read_range_t *first_read_range  = NULL;
+	libfdata_list_read_range_t *read_range        = NULL;
+	libfdata_list_read_range_t *read_ranges       = NULL;
+	intptr_t *element_value                       = NULL;
+	static char *function                         = "libfdata_list_prefetch_element_values";
+	size64_t run_data_size                        = 0;
+	int number_of_cache_entries                   = 0;
+	int read_range_index                          = 0;
+	int result                                    = 0;
+	int run_number_of_elements                    = 0;
+
+	if( list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
+	}
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( ( first_element_index < 0 )
+	 || ( first_element_index > internal_list->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first element index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_elements < 0 )
+	 || ( number_of_elements > ( internal_list->number_of_entries - first_element_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of elements value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	/* Elements that do not fit in the cache would evict other prefetched elements
+	 */
+	if( number_of_elements > number_of_cache_entries )
+	{
+		number_of_elements = number_of_cache_entries;
+	}
+	if( number_of_elements <= 0 )
+	{
+		return( 1 );
+	}
+	read_ranges = (libfdata_list_read_range_t *) memory_allocate(
+	                                              sizeof( libfdata_list_read_range_t ) * number_of_elements );
+
+	if( read_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read ranges.",
+		 function );
+
+		goto on_error;
+	}
+	for( read_range_index = 0;
+	     read_range_index < number_of_elements;
+	     read_range_index++ )
+	{
+		if( libfdata_list_get_entry_by_index(
+		     internal_list,
+		     first_element_index + read_range_index,
+		     &list_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve list entry: %d.",
+			 function,
+			 first_element_index + read_range_index );
+
+			goto on_error;
+		}
+		if( ( list_entry->flags & LIBFDATA_LIST_ELEMENT_FLAG_IS_SET ) == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid list element: %d - value not set.",
+			 function,
+			 first_element_index + read_range_index );
+
+			goto on_error;
+		}
+		read_ranges[ read_range_index ].offset        = list_entry->data_offset;
+		read_ranges[ read_range_index ].size          = list_entry->data_size;
+		read_ranges[ read_range_index ].flags         = list_entry->data_flags;
+		read_ranges[ read_range_index ].file_index    = list_entry->data_file_index;
+		read_ranges[ read_range_index ].element_index = first_element_index + read_range_index;
+	}
+	qsort(
+	 read_ranges,
+	 (size_t) number_of_elements,
+	 sizeof( libfdata_list_read_range_t ),
+	 (int (*)(const void *, const void *)) &libfdata_list_read_range_compare );
+
+	/* Use a transient list element to prevent creating a list element for every element value
+	 */
+	list_element.list = list;
+
+	read_range_index = 0;
+
+	while( read_range_index < number_of_elements )
+	{
+		first_read_range       = &( read_ranges[ read_range_index ] );
+		run_number_of_elements = 1;
+		run_data_size          = first_read_range->size;
+
+		if( internal_list->read_elements_data != NULL )
+		{
+			if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
+			{
+				result = libfdata_list_is_element_value_cached(
+				          internal_list,
+				          cache,
+				          number_of_cache_entries,
+				          first_read_range,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine if element: %d value is cached.",
+					 function,
+					 first_read_range->element_index );
+
+					goto on_error;
+				}
+				else if( result != 0 )
+				{
+					read_range_index++;
+
+					continue;
+				}
+			}
+			/* Extend the run with the following elements of which the data directly
+			 * follows that of the run, the ranges are sorted by file index and offset
+			 */
+			while( ( read_range_index + run_number_of_elements ) < number_of_elements )
+			{
+				read_range = &( read_ranges[ read_range_index + run_number_of_elements ] );
+
+				if( ( read_range->element_index != ( first_read_range->element_index + run_number_of_elements ) )
+				 || ( read_range->file_index != first_read_range->file_index )
+				 || ( read_range->offset != ( first_read_range->offset + (off64_t) run_data_size ) )
+				 || ( read_range->flags != first_read_range->flags ) )
+				{
+					break;
+				}
+				if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
+				{
+					result = libfdata_list_is_element_value_cached(
+					          internal_list,
+					          cache,
+					          number_of_cache_entries,
+					          read_range,
+					          error );
+
+					if( result == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to determine if element: %d value is cached.",
+						 function,
+						 read_range->element_index );
+
+						goto on_error;
+					}
+					else if( result != 0 )
+					{
+						break;
+					}
+				}
+				run_data_size          += read_range->size;
+				run_number_of_elements += 1;
+			}
+		}
+		if( run_number_of_elements == 1 )
+		{
+			list_element.element_index = first_read_range->element_index;
+
+			if( libfdata_list_get_element_value(
+			     list,
+			     file_io_handle,
+			     cache,
+			     (libfdata_list_element_t *) &list_element,
+			     &element_value,
+			     read_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve element: %d value.",
+				 function,
+				 list_element.element_index );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: reading elements: %d to %d data at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIu64 "\n",
+				 function,
+				 first_read_range->element_index,
+				 first_read_range->element_index + run_number_of_elements - 1,
+				 first_read_range->offset,
+				 first_read_range->offset,
+				 run_data_size );
+			}
+#endif
+			if( internal_list->read_elements_data(
+			     internal_list->data_handle,
+			     file_io_handle,
+			     list,
+			     cache,
+			     first_read_range->element_index,
+			     run_number_of_elements,
+			     first_read_range->file_index,
+			     first_read_range->offset,
+			     run_data_size,
+			     first_read_range->flags,
+			     read_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read elements: %d to %d data at offset: 0x%08" PRIx64 ".",
+				 function,
+				 first_read_range->element_index,
+				 first_read_range->element_index + run_number_of_elements - 1,
+				 first_read_range->offset );
+
+				goto on_error;
+			}
+		}
+		read_range_index += run_number_of_elements;
+	}
+	memory_free(
+	 read_ranges );
+
+	return( 1 );
+
+on_error:
+	if( read_ranges != NULL )
+	{
+		memory_free(
+		 read_ranges );
+	}
+	return( -1 );
+}
+
+/* Retrieves the value an element at a specific offset
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libfdata_list_get_element_value_at_offset(
+     libfdata_list_t *list,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     off64_t offset,
+     int *element_index,
+     off64_t *element_data_offset,
+     intptr_t **element_value,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_list_get_element_value_at_offset";
+	int result            = 0;
+
+	if( element_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element index.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfdata_list_get_element_index_at_offset(
+	          list,
+	          offset,
+	          element_index,
+	          element_data_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element index at offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libfdata_list_get_element_value_by_index(
+		     list,
+		     file_io_handle,
+		     cache,
+		     *element_index,
+		     element_value,
+		     read_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing cache value.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d value.",
+			 function,
+			 *element_index );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Sets the value of a specific element
+ *
+ * If the flag LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED is set the list
+ * takes over management of the value and the value is freed when
+ * no longer needed.
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_set_element_value(
+     libfdata_list_t *list,
+     intptr_t *file_io_handle LIBFDATA_ATTRIBUTE_UNUSED,
+     libfcache_cache_t *cache,
+     libfdata_list_element_t *element,
+     intptr_t *element_value,
+     int (*free_element_value)(
+            intptr_t **element_value,
+            libcerror_error_t **error ),
+     uint8_t write_flags,
+     libcerror_error_t **error )
+{
+	static char *function  = "libfdata_list_set_element_value";
+	off64_t element_offset = 0;
+	size64_t element_size  = 0;
+	uint32_t element_flags = 0;
+	int element_file_index = -1;
+	int element_index      = -1;
+
+	LIBFDATA_UNREFERENCED_PARAMETER( file_io_handle )
+
+	if( libfdata_list_element_get_data_range(
+	     element,
+	     &element_file_index,
+	     &element_offset,
+	     &element_size,
+	     &element_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data range from list element.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_element_get_element_index(
+	     element,
+	     &element_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element index from list element.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_cache_element_value(
+	     list,
+	     cache,
+	     element_index,
+	     element_file_index,
+	     element_offset,
+	     element_size,
+	     element_flags,
+	     0,
+	     element_value,
+	     free_element_value,
+	     write_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to cache element value.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the value of a specific element
+ *
+ * If the flag LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED is set the list
+ * takes over management of the value and the value is freed when
+ * no longer needed.
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_set_element_value_by_index(
+     libfdata_list_t *list,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     int element_index,
+     intptr_t *element_value,
+     int (*free_element_value)(
+            intptr_t **element_value,
+            libcerror_error_t **error ),
+     uint8_t write_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_element_t list_element;
+
+	libfdata_internal_list_t *internal_list = NULL;
+	libfdata_list_entry_t *list_entry       = NULL;
+	static char *function                   = "libfdata_list_set_element_value_by_index";
+
+	if( list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
+	}
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( libfdata_list_get_entry_by_index(
+	     internal_list,
+	     element_index,
+	     &list_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve list entry: %d.",
+		 function,
+		 element_index );
+
+		return( -1 );
+	}
+	if( ( list_entry->flags & LIBFDATA_LIST_ELEMENT_FLAG_IS_SET ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid list element: %d - value not set.",
+		 function,
+		 element_index );
+
+		return( -1 );
+	}
+	/* Use a transient list element to prevent creating a list element for every element value
+	 */
+	list_element.list          = list;
+	list_element.element_index = element_index;
+
+	if( libfdata_list_set_element_value(
+	     list,
+	     file_io_handle,
+	     cache,
+	     (libfdata_list_element_t *) &list_element,
+	     element_value,
+	     free_element_value,
+	     write_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set element value.",
+		 function );
+
+		return( -1 );
+	}
+	internal_list->current_element_index = element_index;
+
+	return( 1 );
+}
+
+/* Sets the value of an element at a specific offset
+ *
+ * If the flag LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED is set the list
+ * takes over management of the value and the value is freed when
+ * no longer needed.
+ *
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libfdata_list_set_element_value_at_offset(
+     libfdata_list_t *list,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     off64_t offset,
+     intptr_t *element_value,
+     int (*free_element_value)(
+            intptr_t **element_value,
+            libcerror_error_t **error ),
+     uint8_t write_flags,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfdata_list_set_element_value_at_offset";
+	off64_t element_data_offset = 0;
+	int element_index           = 0;
+	int result                  = 0;
 
-			return( -1 );
-		}
-	}
-	if( libfcache_cache_value_get_value(
-	     cache_value,
-	     element_value,
-	     error ) != 1 )
+	result = libfdata_list_get_element_index_at_offset(
+	          list,
+	          offset,
+	          &element_index,
+	          &element_data_offset,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element value.",
-		 function );
+		 "%s: unable to retrieve element index at offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
 
 		return( -1 );
 	}
-	return( 1 );
+	else if( result != 0 )
+	{
+		if( libfdata_list_set_element_value_by_index(
+		     list,
+		     file_io_handle,
+		     cache,
+		     element_index,
+		     element_value,
+		     free_element_value,
+		     write_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set value of element: %d.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+	}
+	return( result );
 }
 
-/* Retrieves the value of a specific element
+/* Determines the chunks in which the elements are processed by libfdata_list_parallel_for_each
+ * A chunk only contains consecutive elements of which the data is stored in
+ * the same file, so that a run of elements stored in the same file (segment)
+ * is not split between threads unless it exceeds the maximum chunk size.
+ * Multiple chunks are created per thread, so that threads that finish early
+ * can take over the remaining chunks.
  * Returns 1 if successful or -1 on error
  */
-int libfdata_list_get_element_value_by_index(
-     libfdata_list_t *list,
-     intptr_t *file_io_handle,
-     libfcache_cache_t *cache,
-     int element_index,
-     intptr_t **element_value,
-     uint8_t read_flags,
+int libfdata_list_get_for_each_chunks(
+     libfdata_internal_list_t *internal_list,
+     int maximum_number_of_threads,
+     libfdata_list_for_each_chunk_t **chunks,
+     int *number_of_chunks,
      libcerror_error_t **error )
 {
-	libfdata_internal_list_t *internal_list = NULL;
-	libfdata_list_element_t *list_element   = NULL;
-	static char *function                   = "libfdata_list_get_element_value_by_index";
+	static char *function  = "libfdata_list_get_for_each_chunks";
+	int chunk_index        = 0;
+	int chunk_size         = 0;
+	int element_index      = 0;
+	int maximum_chunk_size = 0;
+	int pass               = 0;
 
-	if( list == NULL )
+	if( internal_list == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -4053,105 +5225,209 @@ int libfdata_list_get_element_value_by_index(
 
 		return( -1 );
 	}
-	internal_list = (libfdata_internal_list_t *) list;
-
-	if( libcdata_array_get_entry_by_index(
-	     internal_list->elements_array,
-	     element_index,
-	     (intptr_t **) &list_element,
-	     error ) != 1 )
+	if( internal_list->get_element_range != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from elements array.",
-		 function,
-		 element_index );
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid list - unsupported lazy list.",
+		 function );
 
 		return( -1 );
 	}
-	if( libfdata_list_get_element_value(
-	     list,
-	     file_io_handle,
-	     cache,
-	     list_element,
-	     element_value,
-	     read_flags,
-	     error ) != 1 )
+	if( chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunks != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element value.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunks value already set.",
 		 function );
 
 		return( -1 );
 	}
-	internal_list->current_element_index = element_index;
+	if( number_of_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_threads < 1 )
+	{
+		maximum_number_of_threads = 1;
+	}
+	maximum_chunk_size = internal_list->number_of_entries / ( maximum_number_of_threads * LIBFDATA_LIST_FOR_EACH_NUMBER_OF_CHUNKS_PER_THREAD );
+
+	if( maximum_chunk_size < LIBFDATA_LIST_FOR_EACH_MINIMUM_CHUNK_SIZE )
+	{
+		maximum_chunk_size = LIBFDATA_LIST_FOR_EACH_MINIMUM_CHUNK_SIZE;
+	}
+	/* The first pass determines the number of chunks
+	 * the second pass fills the chunks
+	 */
+	for( pass = 0;
+	     pass < 2;
+	     pass++ )
+	{
+		chunk_index = 0;
+		chunk_size  = 0;
+
+		for( element_index = 0;
+		     element_index < internal_list->number_of_entries;
+		     element_index++ )
+		{
+			if( ( chunk_size == maximum_chunk_size )
+			 || ( ( chunk_size > 0 )
+			  && ( internal_list->entries[ element_index ].data_file_index != internal_list->entries[ element_index - 1 ].data_file_index ) ) )
+			{
+				chunk_index++;
+
+				chunk_size = 0;
+			}
+			if( pass != 0 )
+			{
+				if( chunk_size == 0 )
+				{
+					( *chunks )[ chunk_index ].first_element_index = element_index;
+				}
+				( *chunks )[ chunk_index ].number_of_elements = chunk_size + 1;
+			}
+			chunk_size++;
+		}
+		if( chunk_size > 0 )
+		{
+			chunk_index++;
+		}
+		if( ( pass != 0 )
+		 || ( chunk_index == 0 ) )
+		{
+			break;
+		}
+		*chunks = (libfdata_list_for_each_chunk_t *) memory_allocate(
+		                                              sizeof( libfdata_list_for_each_chunk_t ) * (size_t) chunk_index );
+
+		if( *chunks == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create chunks.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*number_of_chunks = chunk_index;
 
 	return( 1 );
 }
 
-/* Retrieves the value an element at a specific offset
- * Returns 1 if successful, 0 if not or -1 on error
+/* Retrieves the values of the elements of a chunk and passes them to the visit element value function
+ * The chunk is read with its own cache, so that chunks can be processed
+ * on multiple threads without sharing a cache
+ * Returns 1 if successful or -1 on error
  */
-int libfdata_list_get_element_value_at_offset(
-     libfdata_list_t *list,
-     intptr_t *file_io_handle,
-     libfcache_cache_t *cache,
-     off64_t offset,
-     int *element_index,
-     off64_t *element_data_offset,
-     intptr_t **element_value,
-     uint8_t read_flags,
+int libfdata_list_visit_chunk(
+     libfdata_list_for_each_arguments_t *arguments,
+     libfdata_list_for_each_chunk_t *chunk,
      libcerror_error_t **error )
 {
-	libfdata_list_element_t *list_element = NULL;
-	static char *function                 = "libfdata_list_get_element_value_at_offset";
-	int result                            = 0;
+	libfdata_internal_list_element_t list_element;
 
-	if( element_index == NULL )
+	libfdata_internal_list_t *internal_list = NULL;
+	libfcache_cache_t *cache                = NULL;
+	intptr_t *element_value                 = NULL;
+	static char *function                   = "libfdata_list_visit_chunk";
+	int element_index                       = 0;
+	int last_element_index                  = 0;
+
+	if( arguments == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid element index.",
+		 "%s: invalid arguments.",
 		 function );
 
 		return( -1 );
 	}
-	result = libfdata_list_get_list_element_at_offset(
-	          list,
-	          offset,
-	          element_index,
-	          element_data_offset,
-	          &list_element,
-	          error );
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
 
-	if( result == -1 )
+		return( -1 );
+	}
+	internal_list = (libfdata_internal_list_t *) arguments->list;
+
+	if( libfcache_cache_initialize(
+	     &cache,
+	     arguments->number_of_cache_entries,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element at offset: 0x%08" PRIx64 ".",
-		 function,
-		 offset );
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	else if( result != 0 )
+	last_element_index = chunk->first_element_index + chunk->number_of_elements;
+
+	for( element_index = chunk->first_element_index;
+	     element_index < last_element_index;
+	     element_index++ )
 	{
+		if( ( internal_list->entries[ element_index ].flags & LIBFDATA_LIST_ELEMENT_FLAG_IS_SET ) == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid list element: %d - value not set.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		/* Use a transient list element, libfdata_list_get_element_value_by_index
+		 * is not used since it updates the current element index of the list
+		 */
+		list_element.list          = arguments->list;
+		list_element.element_index = element_index;
+
 		if( libfdata_list_get_element_value(
-		     list,
-		     file_io_handle,
+		     arguments->list,
+		     arguments->file_io_handle,
 		     cache,
-		     list_element,
-		     element_value,
-		     read_flags,
+		     (libfdata_list_element_t *) &list_element,
+		     &element_value,
+		     arguments->read_flags,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -4160,262 +5436,415 @@ int libfdata_list_get_element_value_at_offset(
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 			 "%s: unable to retrieve element: %d value.",
 			 function,
-			 *element_index );
+			 element_index );
 
-			return( -1 );
+			goto on_error;
+		}
+		if( arguments->visit_element_value(
+		     element_value,
+		     element_index,
+		     arguments->visitor_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to visit element: %d value.",
+			 function,
+			 element_index );
+
+			goto on_error;
 		}
 	}
-	return( result );
+	if( libfcache_cache_free(
+	     &cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( cache != NULL )
+	{
+		libfcache_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+
+/* Processes a chunk on a worker thread
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_parallel_for_each_callback(
+     libfdata_list_for_each_chunk_t *chunk,
+     libfdata_list_for_each_arguments_t *arguments )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_failed     = 0;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	/* Remaining chunks are skipped once a chunk could not be processed
+	 */
+	if( libcthreads_mutex_grab(
+	     arguments->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	number_of_failed = arguments->number_of_failed_chunks;
+
+	libcthreads_mutex_release(
+	 arguments->mutex,
+	 NULL );
+
+	if( number_of_failed != 0 )
+	{
+		return( 1 );
+	}
+	if( libfdata_list_visit_chunk(
+	     arguments,
+	     chunk,
+	     &error ) == 1 )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_grab(
+	     arguments->mutex,
+	     NULL ) == 1 )
+	{
+		arguments->number_of_failed_chunks += 1;
+
+		libcthreads_mutex_release(
+		 arguments->mutex,
+		 NULL );
+	}
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
 }
 
-/* Sets the value of a specific element
+#endif /* defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT ) */
+
+/* Retrieves the value of every element and passes it to the visit element value function
+ * The elements are split into chunks of consecutive elements stored in the same file.
+ * If the maximum number of threads is more than 1 and multi-thread support
+ * is available the chunks are distributed over a pool of worker threads,
+ * otherwise they are processed on the calling thread.
  *
- * If the flag LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED is set the list
- * takes over management of the value and the value is freed when
- * no longer needed.
+ * The entries of a lazy list are resolved on the calling thread first.
+ *
+ * Every chunk is read with its own cache of number of cache entries,
+ * the caches are freed when the chunk has been processed. The element value
+ * passed to the visit element value function is only valid during the call.
+ *
+ * When the chunks are processed on multiple threads, the visit element value
+ * function is called concurrently and the read element data function of
+ * the list and the file IO handle must be safe to use from multiple threads.
+ * The elements are visited in ascending order within a chunk, but the order
+ * between chunks is undefined.
  *
  * Returns 1 if successful or -1 on error
  */
-int libfdata_list_set_element_value(
+int libfdata_list_parallel_for_each(
      libfdata_list_t *list,
-     intptr_t *file_io_handle LIBFDATA_ATTRIBUTE_UNUSED,
-     libfcache_cache_t *cache,
-     libfdata_list_element_t *element,
-     intptr_t *element_value,
-     int (*free_element_value)(
-            intptr_t **element_value,
+     intptr_t *file_io_handle,
+     int number_of_cache_entries,
+     int maximum_number_of_threads,
+     int (*visit_element_value)(
+            intptr_t *element_value,
+            int element_index,
+            intptr_t *visitor_data,
             libcerror_error_t **error ),
-     uint8_t write_flags,
+     intptr_t *visitor_data,
+     uint8_t read_flags,
      libcerror_error_t **error )
 {
-	static char *function    = "libfdata_list_set_element_value";
-	off64_t element_offset   = 0;
-	size64_t element_size    = 0;
-	time_t element_timestamp = 0;
-	uint32_t element_flags   = 0;
-	int element_file_index   = -1;
-	int element_index        = -1;
+	libfdata_list_for_each_arguments_t arguments;
 
-	LIBFDATA_UNREFERENCED_PARAMETER( file_io_handle )
+	libfdata_internal_list_t *internal_list = NULL;
+	libfdata_list_for_each_chunk_t *chunks  = NULL;
+	static char *function                   = "libfdata_list_parallel_for_each";
+	int chunk_index                         = 0;
+	int number_of_chunks                    = 0;
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool  = NULL;
+	int number_of_threads                   = 0;
+#endif
 
-	if( libfdata_list_element_get_data_range(
-	     element,
-	     &element_file_index,
-	     &element_offset,
-	     &element_size,
-	     &element_flags,
-	     error ) != 1 )
+	if( list == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve data range from list element.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfdata_list_element_get_element_index(
-	     element,
-	     &element_index,
-	     error ) != 1 )
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( internal_list->read_element_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element index from list element.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid list - missing read element data function.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfdata_list_element_get_timestamp(
-	     element,
-	     &element_timestamp,
-	     error ) != 1 )
+	if( number_of_cache_entries <= 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve time stamp from list element.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of cache entries value zero or less.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfdata_list_cache_element_value(
-	     list,
-	     cache,
-	     element_index,
-	     element_file_index,
-	     element_offset,
-	     element_size,
-	     element_flags,
-	     element_timestamp,
-	     element_value,
-	     free_element_value,
-	     write_flags,
-	     error ) != 1 )
+	if( maximum_number_of_threads < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to cache element value.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of threads value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-}
-
-/* Sets the value of a specific element
- *
- * If the flag LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED is set the list
- * takes over management of the value and the value is freed when
- * no longer needed.
- *
- * Returns 1 if successful or -1 on error
- */
-int libfdata_list_set_element_value_by_index(
-     libfdata_list_t *list,
-     intptr_t *file_io_handle,
-     libfcache_cache_t *cache,
-     int element_index,
-     intptr_t *element_value,
-     int (*free_element_value)(
-            intptr_t **element_value,
-            libcerror_error_t **error ),
-     uint8_t write_flags,
-     libcerror_error_t **error )
-{
-	libfdata_internal_list_t *internal_list = NULL;
-	libfdata_list_element_t *list_element   = NULL;
-	static char *function                   = "libfdata_list_set_element_value_by_index";
-
-	if( list == NULL )
+	if( visit_element_value == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid list.",
+		 "%s: invalid visit element value function.",
 		 function );
 
 		return( -1 );
 	}
-	internal_list = (libfdata_internal_list_t *) list;
+	arguments.list                    = list;
+	arguments.file_io_handle          = file_io_handle;
+	arguments.number_of_cache_entries = number_of_cache_entries;
+	arguments.visit_element_value     = visit_element_value;
+	arguments.visitor_data            = visitor_data;
+	arguments.read_flags              = read_flags;
+	arguments.number_of_failed_chunks = 0;
 
-	if( libcdata_array_get_entry_by_index(
-	     internal_list->elements_array,
-	     element_index,
-	     (intptr_t **) &list_element,
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	arguments.mutex                   = NULL;
+#endif
+
+	/* The worker threads only read the list entries, hence the entries of
+	 * a lazy list are resolved before the chunks are processed
+	 */
+	if( libfdata_list_materialize_entries(
+	     internal_list,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from elements array.",
-		 function,
-		 element_index );
+		 "%s: unable to resolve entries.",
+		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( libfdata_list_set_element_value(
-	     list,
-	     file_io_handle,
-	     cache,
-	     list_element,
-	     element_value,
-	     free_element_value,
-	     write_flags,
+	if( libfdata_list_get_for_each_chunks(
+	     internal_list,
+	     maximum_number_of_threads,
+	     &chunks,
+	     &number_of_chunks,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set element value.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine chunks.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_list->current_element_index = element_index;
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	/* Only use a thread pool if there are multiple chunks to process
+	 */
+	if( ( maximum_number_of_threads > 1 )
+	 && ( number_of_chunks > 1 ) )
+	{
+		number_of_threads = maximum_number_of_threads;
 
-	return( 1 );
-}
+		if( number_of_threads > number_of_chunks )
+		{
+			number_of_threads = number_of_chunks;
+		}
+		if( libcthreads_mutex_initialize(
+		     &( arguments.mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create mutex.",
+			 function );
 
-/* Sets the value of an element at a specific offset
- *
- * If the flag LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED is set the list
- * takes over management of the value and the value is freed when
- * no longer needed.
- *
- * Returns 1 if successful, 0 if not or -1 on error
- */
-int libfdata_list_set_element_value_at_offset(
-     libfdata_list_t *list,
-     intptr_t *file_io_handle,
-     libfcache_cache_t *cache,
-     off64_t offset,
-     intptr_t *element_value,
-     int (*free_element_value)(
-            intptr_t **element_value,
-            libcerror_error_t **error ),
-     uint8_t write_flags,
-     libcerror_error_t **error )
-{
-	libfdata_list_element_t *list_element = NULL;
-	static char *function                 = "libfdata_list_set_element_value_at_offset";
-	off64_t element_data_offset           = 0;
-	int element_index                     = 0;
-	int result                            = 0;
+			goto on_error;
+		}
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     number_of_threads,
+		     number_of_chunks,
+		     (int (*)(intptr_t *, void *)) &libfdata_list_parallel_for_each_callback,
+		     (void *) &arguments,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
 
-	result = libfdata_list_get_list_element_at_offset(
-	          list,
-	          offset,
-	          &element_index,
-	          &element_data_offset,
-	          &list_element,
-	          error );
+			goto on_error;
+		}
+		for( chunk_index = 0;
+		     chunk_index < number_of_chunks;
+		     chunk_index++ )
+		{
+			if( libcthreads_thread_pool_push(
+			     thread_pool,
+			     (intptr_t *) &( chunks[ chunk_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push chunk: %d onto thread pool.",
+				 function,
+				 chunk_index );
 
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element at offset: 0x%08" PRIx64 ".",
-		 function,
-		 offset );
+				goto on_error;
+			}
+		}
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
 
-		return( -1 );
-	}
-	else if( result != 0 )
-	{
-		if( libfdata_list_set_element_value(
-		     list,
-		     file_io_handle,
-		     cache,
-		     list_element,
-		     element_value,
-		     free_element_value,
-		     write_flags,
+			goto on_error;
+		}
+		if( libcthreads_mutex_free(
+		     &( arguments.mutex ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set value of element: %d.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( arguments.number_of_failed_chunks != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to process %d chunks.",
 			 function,
-			 element_index );
+			 arguments.number_of_failed_chunks );
 
-			return( -1 );
+			goto on_error;
 		}
 	}
-	return( result );
+	else
+#endif /* defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT ) */
+	{
+		for( chunk_index = 0;
+		     chunk_index < number_of_chunks;
+		     chunk_index++ )
+		{
+			if( libfdata_list_visit_chunk(
+			     &arguments,
+			     &( chunks[ chunk_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to process chunk: %d.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+	}
+	if( chunks != NULL )
+	{
+		memory_free(
+		 chunks );
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	if( arguments.mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( arguments.mutex ),
+		 NULL );
+	}
+#endif
+	if( chunks != NULL )
+	{
+		memory_free(
+		 chunks );
+	}
+	return( -1 );
 }
 
 /* Retrieves the size of the list
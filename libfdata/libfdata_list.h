@@ -26,8 +26,8 @@
 #include <types.h>
 
 #include "libfdata_extern.h"
-#include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
+#include "libfdata_libcthreads.h"
 #include "libfdata_libfcache.h"
 #include "libfdata_types.h"
 
@@ -35,6 +35,87 @@
 extern "C" {
 #endif
 
+/* Retrieves the size of the mapped range of a list entry
+ * which is the mapped size if set or the data size otherwise
+ */
+#define libfdata_list_entry_get_mapped_range_size( list_entry ) \
+	( ( ( list_entry->flags & LIBFDATA_LIST_ELEMENT_FLAG_HAS_MAPPED_SIZE ) != 0 ) ? list_entry->mapped_size : list_entry->data_size )
+
+typedef struct libfdata_list_entry libfdata_list_entry_t;
+
+struct libfdata_list_entry
+{
+	/* The (element) data offset
+	 */
+	off64_t data_offset;
+
+	/* The (element) data size
+	 */
+	size64_t data_size;
+
+	/* The mapped range offset
+	 */
+	off64_t mapped_range_offset;
+
+	/* The (element) mapped size
+	 */
+	size64_t mapped_size;
+
+	/* The (element) data flags
+	 */
+	uint32_t data_flags;
+
+	/* The (element) data file index
+	 */
+	int data_file_index;
+
+	/* The (element) flags
+	 */
+	uint8_t flags;
+};
+
+typedef struct libfdata_list_read_range libfdata_list_read_range_t;
+
+struct libfdata_list_read_range
+{
+	/* The (element) data offset
+	 */
+	off64_t offset;
+
+	/* The (element) data size
+	 */
+	size64_t size;
+
+	/* The (element) data flags
+	 */
+	uint32_t flags;
+
+	/* The (element) data file index
+	 */
+	int file_index;
+
+	/* The element index
+	 */
+	int element_index;
+};
+
+/* The number of entries in an entries page of a lazy list
+ */
+#define LIBFDATA_LIST_ENTRIES_PAGE_SIZE		64
+
+typedef struct libfdata_list_entries_page libfdata_list_entries_page_t;
+
+struct libfdata_list_entries_page
+{
+	/* The (element) entries
+	 */
+	libfdata_list_entry_t entries[ LIBFDATA_LIST_ENTRIES_PAGE_SIZE ];
+
+	/* The (list) elements
+	 */
+	libfdata_list_element_t *elements[ LIBFDATA_LIST_ENTRIES_PAGE_SIZE ];
+};
+
 typedef struct libfdata_internal_list libfdata_internal_list_t;
 
 struct libfdata_internal_list
@@ -51,13 +132,55 @@ struct libfdata_internal_list
 	 */
 	size64_t size;
 
-	/* The (list) elements array
+	/* The time stamp
+	 * identifies the cached element values of the list
+	 */
+	time_t timestamp;
+
+	/* The (element) entries
+	 * contains the data range, mapped range and mapped size of every element
+	 */
+	libfdata_list_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The number of allocated entries
+	 */
+	int number_of_allocated_entries;
+
+	/* The (list) elements
+	 * contains the list element handles, which are created on demand
+	 */
+	libfdata_list_element_t **elements;
+
+	/* The number of allocated elements
+	 */
+	int number_of_allocated_elements;
+
+	/* The (lazy) entries pages
+	 * contains the entries that have been resolved by the get element range function
+	 * a page is only allocated when one of its entries is accessed
 	 */
-	libcdata_array_t *elements_array;
+	libfdata_list_entries_page_t **entries_pages;
 
-	/* The mapped ranges array
+	/* The number of entries pages
 	 */
-	libcdata_array_t *mapped_ranges_array;
+	int number_of_entries_pages;
+
+	/* The get element range function
+	 * if set the list is lazy and its entries are resolved on demand
+	 */
+	int (*get_element_range)(
+	       intptr_t *data_handle,
+	       int element_index,
+	       int *element_file_index,
+	       off64_t *element_offset,
+	       size64_t *element_size,
+	       uint32_t *element_flags,
+	       size64_t *mapped_size,
+	       libcerror_error_t **error );
 
 	/* The flags
 	 */
@@ -104,6 +227,22 @@ struct libfdata_internal_list
                uint8_t read_flags,
 	       libcerror_error_t **error );
 
+	/* The read elements data function
+	 */
+	int (*read_elements_data)(
+	       intptr_t *data_handle,
+	       intptr_t *file_io_handle,
+	       libfdata_list_t *list,
+	       libfcache_cache_t *cache,
+	       int first_element_index,
+	       int number_of_elements,
+	       int elements_data_file_index,
+	       off64_t elements_data_offset,
+	       size64_t elements_data_size,
+	       uint32_t elements_data_flags,
+	       uint8_t read_flags,
+	       libcerror_error_t **error );
+
 	/* The write element data function
 	 */
 	int (*write_element_data)(
@@ -119,6 +258,62 @@ struct libfdata_internal_list
 	       libcerror_error_t **error );
 };
 
+typedef struct libfdata_list_for_each_chunk libfdata_list_for_each_chunk_t;
+
+struct libfdata_list_for_each_chunk
+{
+	/* The index of the first element of the chunk
+	 */
+	int first_element_index;
+
+	/* The number of elements of the chunk
+	 */
+	int number_of_elements;
+};
+
+typedef struct libfdata_list_for_each_arguments libfdata_list_for_each_arguments_t;
+
+struct libfdata_list_for_each_arguments
+{
+	/* The list
+	 */
+	libfdata_list_t *list;
+
+	/* The file IO handle
+	 */
+	intptr_t *file_io_handle;
+
+	/* The number of cache entries of the cache used to read a chunk
+	 */
+	int number_of_cache_entries;
+
+	/* The visit element value function
+	 */
+	int (*visit_element_value)(
+	       intptr_t *element_value,
+	       int element_index,
+	       intptr_t *visitor_data,
+	       libcerror_error_t **error );
+
+	/* The visitor data
+	 */
+	intptr_t *visitor_data;
+
+	/* The read flags
+	 */
+	uint8_t read_flags;
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	/* The mutex that protects the number of failed chunks
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+
+	/* The number of chunks that could not be processed
+	 */
+	int number_of_failed_chunks;
+};
+
 LIBFDATA_EXTERN \
 int libfdata_list_initialize(
      libfdata_list_t **list,
@@ -170,6 +365,89 @@ int libfdata_list_set_calculate_mapped_ranges_flag(
      libfdata_list_t *list,
      libcerror_error_t **error );
 
+LIBFDATA_EXTERN \
+int libfdata_list_set_read_elements_data_function(
+     libfdata_list_t *list,
+     int (*read_elements_data)(
+            intptr_t *data_handle,
+            intptr_t *file_io_handle,
+            libfdata_list_t *list,
+            libfcache_cache_t *cache,
+            int first_element_index,
+            int number_of_elements,
+            int elements_data_file_index,
+            off64_t elements_data_offset,
+            size64_t elements_data_size,
+            uint32_t elements_data_flags,
+            uint8_t read_flags,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_list_set_element_range_function(
+     libfdata_list_t *list,
+     int number_of_elements,
+     int (*get_element_range)(
+            intptr_t *data_handle,
+            int element_index,
+            int *element_file_index,
+            off64_t *element_offset,
+            size64_t *element_size,
+            uint32_t *element_flags,
+            size64_t *mapped_size,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libfdata_list_free_entries_pages(
+     libfdata_internal_list_t *internal_list,
+     libcerror_error_t **error );
+
+int libfdata_list_get_entries_page(
+     libfdata_internal_list_t *internal_list,
+     int element_index,
+     libfdata_list_entries_page_t **entries_page,
+     libcerror_error_t **error );
+
+int libfdata_list_resolve_entry(
+     libfdata_internal_list_t *internal_list,
+     int element_index,
+     libfdata_list_entry_t *entry,
+     libcerror_error_t **error );
+
+int libfdata_list_materialize_entries(
+     libfdata_internal_list_t *internal_list,
+     libcerror_error_t **error );
+
+int libfdata_list_resize_entries(
+     libfdata_internal_list_t *internal_list,
+     int number_of_entries,
+     libcerror_error_t **error );
+
+int libfdata_list_get_entry_by_index(
+     libfdata_internal_list_t *internal_list,
+     int element_index,
+     libfdata_list_entry_t **entry,
+     libcerror_error_t **error );
+
+int libfdata_list_set_entry_data_range(
+     libfdata_internal_list_t *internal_list,
+     libfdata_list_entry_t *entry,
+     int element_file_index,
+     off64_t element_offset,
+     size64_t element_size,
+     uint32_t element_flags,
+     libcerror_error_t **error );
+
+int libfdata_list_create_elements(
+     libfdata_internal_list_t *internal_list,
+     libcerror_error_t **error );
+
+int libfdata_list_get_element_handle(
+     libfdata_internal_list_t *internal_list,
+     int element_index,
+     libfdata_list_element_t **element,
+     libcerror_error_t **error );
+
 /* List elements functions
  */
 LIBFDATA_EXTERN \
@@ -388,6 +666,27 @@ int libfdata_list_get_element_value_by_index(
      uint8_t read_flags,
      libcerror_error_t **error );
 
+int libfdata_list_read_range_compare(
+     const libfdata_list_read_range_t *first_read_range,
+     const libfdata_list_read_range_t *second_read_range );
+
+int libfdata_list_is_element_value_cached(
+     libfdata_internal_list_t *internal_list,
+     libfcache_cache_t *cache,
+     int number_of_cache_entries,
+     libfdata_list_read_range_t *read_range,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_list_prefetch_element_values(
+     libfdata_list_t *list,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     int first_element_index,
+     int number_of_elements,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
 LIBFDATA_EXTERN \
 int libfdata_list_get_element_value_at_offset(
      libfdata_list_t *list,
@@ -438,6 +737,41 @@ int libfdata_list_set_element_value_at_offset(
      uint8_t write_flags,
      libcerror_error_t **error );
 
+int libfdata_list_get_for_each_chunks(
+     libfdata_internal_list_t *internal_list,
+     int maximum_number_of_threads,
+     libfdata_list_for_each_chunk_t **chunks,
+     int *number_of_chunks,
+     libcerror_error_t **error );
+
+int libfdata_list_visit_chunk(
+     libfdata_list_for_each_arguments_t *arguments,
+     libfdata_list_for_each_chunk_t *chunk,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+
+int libfdata_list_parallel_for_each_callback(
+     libfdata_list_for_each_chunk_t *chunk,
+     libfdata_list_for_each_arguments_t *arguments );
+
+#endif /* defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT ) */
+
+LIBFDATA_EXTERN \
+int libfdata_list_parallel_for_each(
+     libfdata_list_t *list,
+     intptr_t *file_io_handle,
+     int number_of_cache_entries,
+     int maximum_number_of_threads,
+     int (*visit_element_value)(
+            intptr_t *element_value,
+            int element_index,
+            intptr_t *visitor_data,
+            libcerror_error_t **error ),
+     intptr_t *visitor_data,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
 /* IO functions
  */
 LIBFDATA_EXTERN \
@@ -29,10 +29,10 @@
 #include "libfdata_libfcache.h"
 #include "libfdata_list.h"
 #include "libfdata_list_element.h"
-#include "libfdata_range.h"
 #include "libfdata_types.h"
 
 /* Creates an element
+ * The element is a handle to an entry in the list
  * Make sure the value element is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
  */
@@ -101,71 +101,14 @@ int libfdata_list_element_initialize(
 		 "%s: unable to create element.",
 		 function );
 
-		goto on_error;
-	}
-	if( memory_set(
-	     internal_element,
-	     0,
-	     sizeof( libfdata_internal_list_element_t ) ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear element.",
-		 function );
-
-		memory_free(
-		 internal_element );
-
 		return( -1 );
 	}
-	if( libfdata_range_initialize(
-	     &( internal_element->data_range ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create data range.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfcache_date_time_get_timestamp(
-	     &( internal_element->timestamp ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve cache timestamp.",
-		 function );
-
-		goto on_error;
-	}
 	internal_element->list          = list;
 	internal_element->element_index = element_index;
 
 	*element = (libfdata_list_element_t *) internal_element;
 
 	return( 1 );
-
-on_error:
-	if( internal_element != NULL )
-	{
-		if( internal_element->data_range != NULL )
-		{
-			libfdata_range_free(
-			 &( internal_element->data_range ),
-			 NULL );
-		}
-		memory_free(
-		 internal_element );
-	}
-	return( -1 );
 }
 
 /* Frees an element
@@ -175,9 +118,7 @@ int libfdata_list_element_free(
      libfdata_list_element_t **element,
      libcerror_error_t **error )
 {
-	libfdata_internal_list_element_t *internal_element = NULL;
-	static char *function                              = "libfdata_list_element_free";
-	int result                                         = 1;
+	static char *function = "libfdata_list_element_free";
 
 	if( element == NULL )
 	{
@@ -192,173 +133,12 @@ int libfdata_list_element_free(
 	}
 	if( *element != NULL )
 	{
-		internal_element = (libfdata_internal_list_element_t *) *element;
-		*element         = NULL;
-
-		if( libfdata_range_free(
-		     &( internal_element->data_range ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free data range.",
-			 function );
-
-			result = -1;
-		}
-		memory_free(
-		 internal_element );
-	}
-	return( result );
-}
-
-/* Clones (duplicates) the element
- * Returns 1 if successful or -1 on error
- */
-int libfdata_list_element_clone(
-     libfdata_list_element_t **destination_element,
-     libfdata_list_element_t *source_element,
-     libfdata_list_t *list,
-     int element_index,
-     libcerror_error_t **error )
-{
-	libfdata_internal_list_element_t *internal_destination_element = NULL;
-	libfdata_internal_list_element_t *internal_source_element      = NULL;
-	static char *function                                          = "libfdata_list_element_clone";
-
-	if( destination_element == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid destination element.",
-		 function );
-
-		return( -1 );
-	}
-	if( *destination_element != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: destination element already set.",
-		 function );
-
-		return( -1 );
-	}
-	if( list == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid list.",
-		 function );
-
-		return( -1 );
-	}
-	if( element_index < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
-		 "%s: invalid element index value less than zero.",
-		 function );
-
-		return( -1 );
-	}
-	if( source_element == NULL )
-	{
-		*destination_element = NULL;
-
-		return( 1 );
-	}
-	internal_source_element = (libfdata_internal_list_element_t *) source_element;
-
-	internal_destination_element = memory_allocate_structure(
-	                                libfdata_internal_list_element_t );
-
-	if( internal_destination_element == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create destination element.",
-		 function );
-
-		goto on_error;
-	}
-	if( memory_set(
-	     internal_destination_element,
-	     0,
-	     sizeof( libfdata_internal_list_element_t ) ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear destination element.",
-		 function );
-
 		memory_free(
-		 internal_destination_element );
+		 *element );
 
-		return( -1 );
+		*element = NULL;
 	}
-	if( libfdata_range_clone(
-	     &( internal_destination_element->data_range ),
-	     internal_source_element->data_range,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination data range.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfcache_date_time_get_timestamp(
-	     &( internal_destination_element->timestamp ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve destination timestamp.",
-		 function );
-
-		goto on_error;
-	}
-	internal_destination_element->list          = list;
-	internal_destination_element->element_index = element_index;
-	internal_destination_element->mapped_size   = internal_source_element->mapped_size;
-
-	*destination_element = (libfdata_list_element_t *) internal_destination_element;
-
 	return( 1 );
-
-on_error:
-	if( internal_destination_element != NULL )
-	{
-		if( internal_destination_element->data_range != NULL )
-		{
-			libfdata_range_free(
-			 &( internal_destination_element->data_range ),
-			 NULL );
-		}
-		memory_free(
-		 internal_destination_element );
-	}
-	return( -1 );
 }
 
 /* Retrieves the element index
@@ -476,7 +256,20 @@ int libfdata_list_element_get_timestamp(
 
 		return( -1 );
 	}
-	*timestamp = internal_element->timestamp;
+	if( internal_element->list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid element - missing list.",
+		 function );
+
+		return( -1 );
+	}
+	/* The cached element values are identified by the time stamp of the list
+	 */
+	*timestamp = ( (libfdata_internal_list_t *) internal_element->list )->timestamp;
 
 	return( 1 );
 }
@@ -496,6 +289,7 @@ int libfdata_list_element_get_data_range(
      libcerror_error_t **error )
 {
 	libfdata_internal_list_element_t *internal_element = NULL;
+	libfdata_list_entry_t *list_entry                  = NULL;
 	static char *function                              = "libfdata_list_element_get_data_range";
 
 	if( element == NULL )
@@ -511,23 +305,71 @@ int libfdata_list_element_get_data_range(
 	}
 	internal_element = (libfdata_internal_list_element_t *) element;
 
-	if( libfdata_range_get(
-	     internal_element->data_range,
-	     file_index,
-	     offset,
-	     size,
-	     flags,
+	if( file_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file index.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_entry_by_index(
+	     (libfdata_internal_list_t *) internal_element->list,
+	     internal_element->element_index,
+	     &list_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve data range.",
-		 function );
+		 "%s: unable to retrieve list entry: %d.",
+		 function,
+		 internal_element->element_index );
 
 		return( -1 );
 	}
+	*file_index = list_entry->data_file_index;
+	*offset     = list_entry->data_offset;
+	*size       = list_entry->data_size;
+	*flags      = list_entry->data_flags;
+
 	return( 1 );
 }
 
@@ -543,6 +385,7 @@ int libfdata_list_element_set_data_range(
      libcerror_error_t **error )
 {
 	libfdata_internal_list_element_t *internal_element = NULL;
+	libfdata_list_entry_t *list_entry                  = NULL;
 	static char *function                              = "libfdata_list_element_set_data_range";
 
 	if( element == NULL )
@@ -558,41 +401,25 @@ int libfdata_list_element_set_data_range(
 	}
 	internal_element = (libfdata_internal_list_element_t *) element;
 
-	if( file_index < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
-		 "%s: invalid file index less than zero.",
-		 function );
-
-		return( -1 );
-	}
-	if( offset < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
-		 "%s: invalid offset value less than zero.",
-		 function );
-
-		return( -1 );
-	}
-	if( size > (size64_t) INT64_MAX )
+	if( libfdata_list_get_entry_by_index(
+	     (libfdata_internal_list_t *) internal_element->list,
+	     internal_element->element_index,
+	     &list_entry,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid size value exceeds maximum.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve list entry: %d.",
+		 function,
+		 internal_element->element_index );
 
 		return( -1 );
 	}
-	if( libfdata_range_set(
-	     internal_element->data_range,
+	if( libfdata_list_set_entry_data_range(
+	     (libfdata_internal_list_t *) internal_element->list,
+	     list_entry,
 	     file_index,
 	     offset,
 	     size,
@@ -608,19 +435,6 @@ int libfdata_list_element_set_data_range(
 
 		return( -1 );
 	}
-	if( libfcache_date_time_get_timestamp(
-	     &( internal_element->timestamp ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve cache timestamp.",
-		 function );
-
-		return( -1 );
-	}
 	return( 1 );
 }
 
@@ -636,6 +450,7 @@ int libfdata_list_element_get_mapped_size(
      libcerror_error_t **error )
 {
 	libfdata_internal_list_element_t *internal_element = NULL;
+	libfdata_list_entry_t *list_entry                  = NULL;
 	static char *function                              = "libfdata_list_element_get_mapped_size";
 
 	if( element == NULL )
@@ -662,11 +477,27 @@ int libfdata_list_element_get_mapped_size(
 
 		return( -1 );
 	}
-	if( ( internal_element->flags & LIBFDATA_LIST_ELEMENT_FLAG_HAS_MAPPED_SIZE ) == 0 )
+	if( libfdata_list_get_entry_by_index(
+	     (libfdata_internal_list_t *) internal_element->list,
+	     internal_element->element_index,
+	     &list_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve list entry: %d.",
+		 function,
+		 internal_element->element_index );
+
+		return( -1 );
+	}
+	if( ( list_entry->flags & LIBFDATA_LIST_ELEMENT_FLAG_HAS_MAPPED_SIZE ) == 0 )
 	{
 		return( 0 );
 	}
-	*mapped_size = internal_element->mapped_size;
+	*mapped_size = list_entry->mapped_size;
 
 	return( 1 );
 }
@@ -680,6 +511,7 @@ int libfdata_list_element_set_mapped_size(
      libcerror_error_t **error )
 {
 	libfdata_internal_list_element_t *internal_element = NULL;
+	libfdata_list_entry_t *list_entry                  = NULL;
 	static char *function                              = "libfdata_list_element_set_mapped_size";
 
 	if( element == NULL )
@@ -706,6 +538,22 @@ int libfdata_list_element_set_mapped_size(
 
 		return( -1 );
 	}
+	if( libfdata_list_get_entry_by_index(
+	     (libfdata_internal_list_t *) internal_element->list,
+	     internal_element->element_index,
+	     &list_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve list entry: %d.",
+		 function,
+		 internal_element->element_index );
+
+		return( -1 );
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -719,8 +567,8 @@ int libfdata_list_element_set_mapped_size(
 		 "\n" );
 	}
 #endif
-	internal_element->mapped_size = mapped_size;
-	internal_element->flags      |= LIBFDATA_LIST_ELEMENT_FLAG_HAS_MAPPED_SIZE;
+	list_entry->mapped_size = mapped_size;
+	list_entry->flags      |= LIBFDATA_LIST_ELEMENT_FLAG_HAS_MAPPED_SIZE;
 
 	if( libfdata_list_set_calculate_mapped_ranges_flag(
 	     internal_element->list,
@@ -28,7 +28,6 @@
 #include "libfdata_extern.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libfcache.h"
-#include "libfdata_range.h"
 #include "libfdata_types.h"
 
 #if defined( __cplusplus )
@@ -46,22 +45,6 @@ struct libfdata_internal_list_element
 	/* The (list) element index
 	 */
 	int element_index;
-
-	/* The (element) data range
-	 */
-	libfdata_range_t *data_range;
-
-	/* The (element) mapped size
-	 */
-	size64_t mapped_size;
-
-	/* The time stamp
-	 */
-	time_t timestamp;
-
-	/* The flags
-	 */
-	uint8_t flags;
 };
 
 int libfdata_list_element_initialize(
@@ -74,13 +57,6 @@ int libfdata_list_element_free(
      libfdata_list_element_t **element,
      libcerror_error_t **error );
 
-int libfdata_list_element_clone(
-     libfdata_list_element_t **destination_element,
-     libfdata_list_element_t *source_element,
-     libfdata_list_t *list,
-     int element_index,
-     libcerror_error_t **error );
-
 int libfdata_list_element_get_element_index(
      libfdata_list_element_t *element,
      int *element_index,
@@ -24,7 +24,6 @@
 #include <types.h>
 
 #include "libfdata_definitions.h"
-#include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libcnotify.h"
 #include "libfdata_libfcache.h"
@@ -33,6 +32,8 @@
 #include "libfdata_range_list.h"
 #include "libfdata_types.h"
 
+#define LIBFDATA_RANGE_LIST_INITIAL_NUMBER_OF_ALLOCATED_ENTRIES	16
+
 /* Creates a range list
  * Make sure the value range_list is referencing, is set to NULL
  *
@@ -144,19 +145,6 @@ int libfdata_range_list_initialize(
 
 		return( -1 );
 	}
-	if( libcdata_range_list_initialize(
-	     &( internal_range_list->elements_range_list ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create elements range list.",
-		 function );
-
-		goto on_error;
-	}
 	internal_range_list->flags             |= flags;
 	internal_range_list->data_handle        = data_handle;
 	internal_range_list->free_data_handle   = free_data_handle;
@@ -171,13 +159,6 @@ int libfdata_range_list_initialize(
 on_error:
 	if( internal_range_list != NULL )
 	{
-		if( internal_range_list->elements_range_list != NULL )
-		{
-			libcdata_range_list_free(
-			 &( internal_range_list->elements_range_list ),
-			 NULL,
-			 NULL );
-		}
 		memory_free(
 		 internal_range_list );
 	}
@@ -193,6 +174,7 @@ int libfdata_range_list_free(
 {
 	libfdata_internal_range_list_t *internal_range_list = NULL;
 	static char *function                               = "libfdata_range_list_free";
+	int entry_index                                     = 0;
 	int result                                          = 1;
 
 	if( range_list == NULL )
@@ -211,19 +193,29 @@ int libfdata_range_list_free(
 		internal_range_list = (libfdata_internal_range_list_t *) *range_list;
 		*range_list         = NULL;
 
-		if( libcdata_range_list_free(
-		     &( internal_range_list->elements_range_list ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_list_free,
-		     error ) != 1 )
+		if( internal_range_list->entries != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free the elements range list.",
-			 function );
+			for( entry_index = 0;
+			     entry_index < internal_range_list->number_of_entries;
+			     entry_index++ )
+			{
+				if( libfdata_list_free(
+				     &( internal_range_list->entries[ entry_index ].list ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free list: %d.",
+					 function,
+					 entry_index );
 
-			result = -1;
+					result = -1;
+				}
+			}
+			memory_free(
+			 internal_range_list->entries );
 		}
 		if( ( internal_range_list->flags & LIBFDATA_DATA_HANDLE_FLAG_MANAGED ) != 0 )
 		{
@@ -272,6 +264,7 @@ int libfdata_range_list_clone(
 	libfdata_internal_range_list_t *internal_destination_range_list = NULL;
 	libfdata_internal_range_list_t *internal_source_range_list      = NULL;
 	static char *function                                           = "libfdata_range_list_clone";
+	int entry_index                                                 = 0;
 
 	if( destination_range_list == NULL )
 	{
@@ -373,22 +366,43 @@ int libfdata_range_list_clone(
 			goto on_error;
 		}
 	}
-	if( libcdata_range_list_clone(
-	     &( internal_destination_range_list->elements_range_list ),
-	     internal_source_range_list->elements_range_list,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_list_free,
-	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libfdata_list_clone,
+	if( libfdata_range_list_resize_entries(
+	     internal_destination_range_list,
+	     internal_source_range_list->number_of_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination elements range list.",
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize destination entries.",
 		 function );
 
 		goto on_error;
 	}
+	for( entry_index = 0;
+	     entry_index < internal_source_range_list->number_of_entries;
+	     entry_index++ )
+	{
+		internal_destination_range_list->entries[ entry_index ].mapped_range_offset = internal_source_range_list->entries[ entry_index ].mapped_range_offset;
+		internal_destination_range_list->entries[ entry_index ].mapped_range_size   = internal_source_range_list->entries[ entry_index ].mapped_range_size;
+
+		if( libfdata_list_clone(
+		     &( internal_destination_range_list->entries[ entry_index ].list ),
+		     internal_source_range_list->entries[ entry_index ].list,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination list: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+	}
 	internal_destination_range_list->flags              = internal_source_range_list->flags | LIBFDATA_DATA_HANDLE_FLAG_MANAGED;
 	internal_destination_range_list->free_data_handle   = internal_source_range_list->free_data_handle;
 	internal_destination_range_list->clone_data_handle  = internal_source_range_list->clone_data_handle;
@@ -402,6 +416,22 @@ int libfdata_range_list_clone(
 on_error:
 	if( internal_destination_range_list != NULL )
 	{
+		if( internal_destination_range_list->entries != NULL )
+		{
+			for( entry_index = 0;
+			     entry_index < internal_destination_range_list->number_of_entries;
+			     entry_index++ )
+			{
+				if( internal_destination_range_list->entries[ entry_index ].list != NULL )
+				{
+					libfdata_list_free(
+					 &( internal_destination_range_list->entries[ entry_index ].list ),
+					 NULL );
+				}
+			}
+			memory_free(
+			 internal_destination_range_list->entries );
+		}
 		if( ( internal_destination_range_list->data_handle != NULL )
 		 && ( internal_source_range_list->free_data_handle != NULL ) )
 		{
@@ -415,20 +445,20 @@ on_error:
 	return( -1 );
 }
 
-/* List elements functions
- */
-
-/* Empties the range list
+/* Resizes the entries
+ * New entries are not set
  * Returns 1 if successful or -1 on error
  */
-int libfdata_range_list_empty(
-     libfdata_range_list_t *range_list,
+int libfdata_range_list_resize_entries(
+     libfdata_internal_range_list_t *internal_range_list,
+     int number_of_entries,
      libcerror_error_t **error )
 {
-	libfdata_internal_range_list_t *internal_range_list = NULL;
-	static char *function                               = "libfdata_range_list_empty";
+	static char *function           = "libfdata_range_list_resize_entries";
+	void *reallocation              = NULL;
+	int number_of_allocated_entries = 0;
 
-	if( range_list == NULL )
+	if( internal_range_list == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -439,74 +469,202 @@ int libfdata_range_list_empty(
 
 		return( -1 );
 	}
-	internal_range_list = (libfdata_internal_range_list_t *) range_list;
-
-	if( libcdata_range_list_empty(
-	     internal_range_list->elements_range_list,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_list_free,
-	     error ) != 1 )
+	if( number_of_entries < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to empty elements range list.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of entries value less than zero.",
 		 function );
 
 		return( -1 );
 	}
+	if( number_of_entries > internal_range_list->number_of_allocated_entries )
+	{
+		number_of_allocated_entries = internal_range_list->number_of_allocated_entries;
+
+		if( number_of_allocated_entries == 0 )
+		{
+			number_of_allocated_entries = LIBFDATA_RANGE_LIST_INITIAL_NUMBER_OF_ALLOCATED_ENTRIES;
+		}
+		while( number_of_allocated_entries < number_of_entries )
+		{
+			if( number_of_allocated_entries > ( INT_MAX / 2 ) )
+			{
+				number_of_allocated_entries = number_of_entries;
+
+				break;
+			}
+			number_of_allocated_entries *= 2;
+		}
+		if( (size_t) number_of_allocated_entries > ( (size_t) SSIZE_MAX / sizeof( libfdata_range_list_entry_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated entries value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                internal_range_list->entries,
+		                sizeof( libfdata_range_list_entry_t ) * number_of_allocated_entries );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize entries.",
+			 function );
+
+			return( -1 );
+		}
+		internal_range_list->entries                     = (libfdata_range_list_entry_t *) reallocation;
+		internal_range_list->number_of_allocated_entries = number_of_allocated_entries;
+	}
+	if( number_of_entries > internal_range_list->number_of_entries )
+	{
+		if( memory_set(
+		     &( internal_range_list->entries[ internal_range_list->number_of_entries ] ),
+		     0,
+		     sizeof( libfdata_range_list_entry_t ) * ( number_of_entries - internal_range_list->number_of_entries ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entries.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	internal_range_list->number_of_entries = number_of_entries;
+
 	return( 1 );
 }
 
-/* Mapped range functions
+/* Retrieves the index of the last entry of which the mapped range starts at or before a specific offset
+ * Uses a binary search on the entries sorted by mapped range offset
+ * Returns 1 if successful, 0 if no such entry or -1 on error
  */
+int libfdata_range_list_get_entry_index_at_offset(
+     libfdata_internal_range_list_t *internal_range_list,
+     off64_t offset,
+     int *entry_index,
+     libcerror_error_t **error )
+{
+	static char *function  = "libfdata_range_list_get_entry_index_at_offset";
+	int lower_entry_index  = 0;
+	int middle_entry_index = 0;
+	int upper_entry_index  = 0;
 
-/* Retrieves the list element for a specific offset
- * Returns 1 if successful, 0 if not or -1 on error
+	if( internal_range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range list.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_range_list->number_of_entries == 0 )
+	 || ( offset < internal_range_list->entries[ 0 ].mapped_range_offset ) )
+	{
+		return( 0 );
+	}
+	lower_entry_index = 0;
+	upper_entry_index = internal_range_list->number_of_entries - 1;
+
+	while( lower_entry_index < upper_entry_index )
+	{
+		middle_entry_index = upper_entry_index - ( ( upper_entry_index - lower_entry_index ) / 2 );
+
+		if( offset < internal_range_list->entries[ middle_entry_index ].mapped_range_offset )
+		{
+			upper_entry_index = middle_entry_index - 1;
+		}
+		else
+		{
+			lower_entry_index = middle_entry_index;
+		}
+	}
+	*entry_index = lower_entry_index;
+
+	return( 1 );
+}
+
+/* Retrieves the list of the mapped range that contains a specific offset
+ * Returns 1 if successful, 0 if no such mapped range or -1 on error
  */
-int libfdata_range_list_get_list_element_at_offset(
-     libfdata_range_list_t *range_list,
+int libfdata_range_list_get_list_at_offset(
+     libfdata_internal_range_list_t *internal_range_list,
      off64_t offset,
-     off64_t *element_data_offset,
-     libfdata_list_element_t **element,
+     off64_t *mapped_range_offset,
+     size64_t *mapped_range_size,
+     libfdata_list_t **list,
      libcerror_error_t **error )
 {
-	libfdata_internal_range_list_t *internal_range_list = NULL;
-	libfdata_list_t *list                               = NULL;
-	static char *function                               = "libfdata_range_list_get_list_element_at_offset";
-	off64_t mapped_range_offset                         = 0;
-	size64_t mapped_range_size                          = 0;
-	int element_index                                   = 0;
-	int result                                          = 0;
+	libfdata_range_list_entry_t *range_list_entry = NULL;
+	static char *function                         = "libfdata_range_list_get_list_at_offset";
+	int entry_index                               = 0;
+	int result                                    = 0;
 
-	if( range_list == NULL )
+	if( mapped_range_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid range list.",
+		 "%s: invalid mapped range offset.",
 		 function );
 
 		return( -1 );
 	}
-	internal_range_list = (libfdata_internal_range_list_t *) range_list;
+	if( mapped_range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped range size.",
+		 function );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+		return( -1 );
+	}
+	if( list == NULL )
 	{
-		libcnotify_printf(
-		 "%s: requested offset: 0x%08" PRIx64 "\n",
-		 function,
-		 offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
 	}
-#endif
-	result = libcdata_range_list_get_range_at_offset(
-	          internal_range_list->elements_range_list,
-	          (uint64_t) offset,
-	          (uint64_t *) &mapped_range_offset,
-	          (uint64_t *) &mapped_range_size,
-	          (intptr_t **) &list,
+	result = libfdata_range_list_get_entry_index_at_offset(
+	          internal_range_list,
+	          offset,
+	          &entry_index,
 	          error );
 
 	if( result == -1 )
@@ -515,90 +673,660 @@ int libfdata_range_list_get_list_element_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve range from elements range list for offset: %" PRIi64 ".",
+		 "%s: unable to retrieve entry index for offset: %" PRIi64 ".",
 		 function,
 		 offset );
 
 		return( -1 );
 	}
-	else if( result != 0 )
+	else if( result == 0 )
 	{
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: mapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
-			 function,
-			 mapped_range_offset,
-			 mapped_range_offset + mapped_range_size,
-			 mapped_range_size );
-		}
-#endif
-		result = libfdata_list_get_list_element_at_offset(
-		          list,
-		          offset,
-		          &element_index,
-		          element_data_offset,
-		          element,
-		          error );
+		return( 0 );
+	}
+	range_list_entry = &( internal_range_list->entries[ entry_index ] );
 
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve element from list for offset: %" PRIi64 ".",
-			 function,
-			 offset );
+	if( (size64_t) ( offset - range_list_entry->mapped_range_offset ) >= range_list_entry->mapped_range_size )
+	{
+		return( 0 );
+	}
+	*mapped_range_offset = range_list_entry->mapped_range_offset;
+	*mapped_range_size   = range_list_entry->mapped_range_size;
+	*list                = range_list_entry->list;
 
-			return( -1 );
-		}
-		else if( result == 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid list - element missing for offset: %" PRIi64 ".",
-			 function,
-			 offset );
+	return( 1 );
+}
+
+/* Creates the list of a mapped range
+ * Make sure the value list is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_range_list_create_list(
+     libfdata_internal_range_list_t *internal_range_list,
+     off64_t mapped_range_offset,
+     libfdata_list_t **list,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_range_list_create_list";
+
+	if( internal_range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range list.",
+		 function );
+
+		return( -1 );
+	}
+	if( list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_initialize(
+	     list,
+	     internal_range_list->data_handle,
+	     internal_range_list->free_data_handle,
+	     internal_range_list->clone_data_handle,
+	     internal_range_list->read_element_data,
+	     internal_range_list->write_element_data,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_set_mapped_offset(
+	     *list,
+	     mapped_range_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set mapped offset in list.",
+		 function );
+
+		libfdata_list_free(
+		 list,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Inserts the list of a mapped range
+ * A mapped range that is adjacent to the previous mapped range is merged with it,
+ * otherwise a mapped range that is adjacent to the next mapped range is merged with it
+ * Adjacent mapped ranges that are not merged remain separate entries
+ * The range list takes over the list if successful
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_range_list_insert_list(
+     libfdata_internal_range_list_t *internal_range_list,
+     off64_t mapped_range_offset,
+     size64_t mapped_range_size,
+     libfdata_list_t *list,
+     libcerror_error_t **error )
+{
+	libfdata_range_list_entry_t *next_entry     = NULL;
+	libfdata_range_list_entry_t *previous_entry = NULL;
+	static char *function                       = "libfdata_range_list_insert_list";
+	off64_t mapped_range_end_offset             = 0;
+	int entry_index                             = 0;
+	int move_entry_index                        = 0;
+	int result                                  = 0;
+
+	if( internal_range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range list.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapped_range_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid mapped range offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapped_range_size > (size64_t) ( INT64_MAX - mapped_range_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid mapped range size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
+	}
+	mapped_range_end_offset = mapped_range_offset + (off64_t) mapped_range_size;
+
+	result = libfdata_range_list_get_entry_index_at_offset(
+	          internal_range_list,
+	          mapped_range_offset,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry index for offset: %" PRIi64 ".",
+		 function,
+		 mapped_range_offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		previous_entry = &( internal_range_list->entries[ entry_index ] );
+
+		/* The index of the entry after the previous entry
+		 */
+		entry_index++;
+	}
+	else
+	{
+		entry_index = 0;
+	}
+	if( entry_index < internal_range_list->number_of_entries )
+	{
+		next_entry = &( internal_range_list->entries[ entry_index ] );
+
+		if( mapped_range_end_offset > next_entry->mapped_range_offset )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid mapped range value out of bounds - overlaps with next mapped range.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( previous_entry != NULL )
+	{
+		if( mapped_range_offset < ( previous_entry->mapped_range_offset + (off64_t) previous_entry->mapped_range_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid mapped range value out of bounds - overlaps with previous mapped range.",
+			 function );
+
+			return( -1 );
+		}
+		if( mapped_range_offset != ( previous_entry->mapped_range_offset + (off64_t) previous_entry->mapped_range_size ) )
+		{
+			previous_entry = NULL;
+		}
+	}
+	if( ( next_entry != NULL )
+	 && ( mapped_range_end_offset != next_entry->mapped_range_offset ) )
+	{
+		next_entry = NULL;
+	}
+	if( previous_entry != NULL )
+	{
+		/* Merge the mapped range with the previous mapped range
+		 */
+		if( libfdata_list_append_list(
+		     previous_entry->list,
+		     list,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append list to previous list.",
+			 function );
+
+			return( -1 );
+		}
+		previous_entry->mapped_range_size += mapped_range_size;
+
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	else if( next_entry != NULL )
+	{
+		/* Merge the next mapped range with the mapped range
+		 */
+		if( libfdata_list_append_list(
+		     list,
+		     next_entry->list,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append next list to list.",
+			 function );
+
+			return( -1 );
+		}
+		libfdata_list_free(
+		 &( next_entry->list ),
+		 NULL );
+
+		next_entry->mapped_range_offset = mapped_range_offset;
+		next_entry->mapped_range_size  += mapped_range_size;
+		next_entry->list                = list;
+	}
+	else
+	{
+		if( libfdata_range_list_resize_entries(
+		     internal_range_list,
+		     internal_range_list->number_of_entries + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize entries.",
+			 function );
+
+			return( -1 );
+		}
+		for( move_entry_index = internal_range_list->number_of_entries - 1;
+		     move_entry_index > entry_index;
+		     move_entry_index-- )
+		{
+			internal_range_list->entries[ move_entry_index ] = internal_range_list->entries[ move_entry_index - 1 ];
+		}
+		internal_range_list->entries[ entry_index ].mapped_range_offset = mapped_range_offset;
+		internal_range_list->entries[ entry_index ].mapped_range_size   = mapped_range_size;
+		internal_range_list->entries[ entry_index ].list                = list;
+	}
+	return( 1 );
+}
+
+/* List elements functions
+ */
+
+/* Empties the range list
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_range_list_empty(
+     libfdata_range_list_t *range_list,
+     libcerror_error_t **error )
+{
+	libfdata_internal_range_list_t *internal_range_list = NULL;
+	static char *function                               = "libfdata_range_list_empty";
+	int entry_index                                     = 0;
+	int result                                          = 1;
+
+	if( range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range list.",
+		 function );
+
+		return( -1 );
+	}
+	internal_range_list = (libfdata_internal_range_list_t *) range_list;
+
+	for( entry_index = 0;
+	     entry_index < internal_range_list->number_of_entries;
+	     entry_index++ )
+	{
+		if( libfdata_list_free(
+		     &( internal_range_list->entries[ entry_index ].list ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free list: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+		}
+	}
+	internal_range_list->number_of_entries = 0;
+
+	return( result );
+}
+
+/* Mapped range functions
+ */
+
+/* Retrieves the list element for a specific offset
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libfdata_range_list_get_list_element_at_offset(
+     libfdata_range_list_t *range_list,
+     off64_t offset,
+     off64_t *element_data_offset,
+     libfdata_list_element_t **element,
+     libcerror_error_t **error )
+{
+	libfdata_internal_range_list_t *internal_range_list = NULL;
+	libfdata_list_t *list                               = NULL;
+	static char *function                               = "libfdata_range_list_get_list_element_at_offset";
+	off64_t mapped_range_offset                         = 0;
+	size64_t mapped_range_size                          = 0;
+	int element_index                                   = 0;
+	int result                                          = 0;
+
+	if( range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range list.",
+		 function );
+
+		return( -1 );
+	}
+	internal_range_list = (libfdata_internal_range_list_t *) range_list;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: requested offset: 0x%08" PRIx64 "\n",
+		 function,
+		 offset );
+	}
+#endif
+	result = libfdata_range_list_get_list_at_offset(
+	          internal_range_list,
+	          offset,
+	          &mapped_range_offset,
+	          &mapped_range_size,
+	          &list,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve list for offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: mapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
+			 function,
+			 mapped_range_offset,
+			 mapped_range_offset + mapped_range_size,
+			 mapped_range_size );
+		}
+#endif
+		result = libfdata_list_get_list_element_at_offset(
+		          list,
+		          offset,
+		          &element_index,
+		          element_data_offset,
+		          element,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element from list for offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid list - element missing for offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the data range of an element at a specific offset
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libfdata_range_list_get_element_at_offset(
+     libfdata_range_list_t *range_list,
+     off64_t offset,
+     off64_t *element_data_offset,
+     int *element_file_index,
+     off64_t *element_offset,
+     size64_t *element_size,
+     uint32_t *element_flags,
+     libcerror_error_t **error )
+{
+	libfdata_list_element_t *list_element = NULL;
+	static char *function                 = "libfdata_list_get_element_at_offset";
+	int result                            = 0;
+
+	result = libfdata_range_list_get_list_element_at_offset(
+	          range_list,
+	          offset,
+	          element_data_offset,
+	          &list_element,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libfdata_list_element_get_data_range(
+		     list_element,
+		     element_file_index,
+		     element_offset,
+		     element_size,
+		     element_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data range of list element at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the list elements that overlap with a specific range
+ * The list elements are returned in order of their mapped offset
+ * At most maximum number of elements are stored in elements, the number of elements
+ * is set to the number of overlapping list elements, which allows to determine the
+ * required number of elements by calling this function with a maximum of 0
+ * Returns 1 if successful, 0 if no list element overlaps with the range or -1 on error
+ */
+int libfdata_range_list_get_elements_in_range(
+     libfdata_range_list_t *range_list,
+     off64_t offset,
+     size64_t size,
+     libfdata_list_element_t **elements,
+     int maximum_number_of_elements,
+     int *number_of_elements,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_t *internal_list             = NULL;
+	libfdata_internal_range_list_t *internal_range_list = NULL;
+	libfdata_list_entry_t *list_entry                   = NULL;
+	libfdata_range_list_entry_t *entry                  = NULL;
+	static char *function                               = "libfdata_range_list_get_elements_in_range";
+	off64_t element_data_offset                         = 0;
+	off64_t range_end_offset                            = 0;
+	int element_index                                   = 0;
+	int entry_index                                     = 0;
+	int number_of_list_elements                         = 0;
+	int result                                          = 0;
+	int safe_number_of_elements                         = 0;
+
+	if( range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range list.",
+		 function );
+
+		return( -1 );
+	}
+	internal_range_list = (libfdata_internal_range_list_t *) range_list;
+
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size64_t) ( INT64_MAX - offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_elements < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of elements value less than zero.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( ( elements == NULL )
+	 && ( maximum_number_of_elements > 0 ) )
 	{
-		libcnotify_printf(
-		 "\n" );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid elements.",
+		 function );
+
+		return( -1 );
 	}
-#endif
-	return( result );
-}
+	if( number_of_elements == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of elements.",
+		 function );
 
-/* Retrieves the data range of an element at a specific offset
- * Returns 1 if successful, 0 if not or -1 on error
- */
-int libfdata_range_list_get_element_at_offset(
-     libfdata_range_list_t *range_list,
-     off64_t offset,
-     off64_t *element_data_offset,
-     int *element_file_index,
-     off64_t *element_offset,
-     size64_t *element_size,
-     uint32_t *element_flags,
-     libcerror_error_t **error )
-{
-	libfdata_list_element_t *list_element = NULL;
-	static char *function                 = "libfdata_list_get_element_at_offset";
-	int result                            = 0;
+		return( -1 );
+	}
+	*number_of_elements = 0;
 
-	result = libfdata_range_list_get_list_element_at_offset(
-	          range_list,
+	if( size == 0 )
+	{
+		return( 0 );
+	}
+	range_end_offset = offset + (off64_t) size;
+
+	result = libfdata_range_list_get_entry_index_at_offset(
+	          internal_range_list,
 	          offset,
-	          element_data_offset,
-	          &list_element,
+	          &entry_index,
 	          error );
 
 	if( result == -1 )
@@ -607,34 +1335,150 @@ int libfdata_range_list_get_element_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element at offset: %" PRIi64 ".",
+		 "%s: unable to retrieve entry index for offset: %" PRIi64 ".",
 		 function,
 		 offset );
 
 		return( -1 );
 	}
-	else if( result != 0 )
+	else if( result == 0 )
 	{
-		if( libfdata_list_element_get_data_range(
-		     list_element,
-		     element_file_index,
-		     element_offset,
-		     element_size,
-		     element_flags,
+		entry_index = 0;
+	}
+	else
+	{
+		entry = &( internal_range_list->entries[ entry_index ] );
+
+		if( offset >= ( entry->mapped_range_offset + (off64_t) entry->mapped_range_size ) )
+		{
+			entry_index++;
+		}
+	}
+	while( entry_index < internal_range_list->number_of_entries )
+	{
+		entry = &( internal_range_list->entries[ entry_index ] );
+
+		if( entry->mapped_range_offset >= range_end_offset )
+		{
+			break;
+		}
+		if( libfdata_list_get_number_of_elements(
+		     entry->list,
+		     &number_of_list_elements,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve data range of list element at offset: %" PRIi64 ".",
+			 "%s: unable to retrieve number of elements from list: %d.",
 			 function,
-			 offset );
+			 entry_index );
 
 			return( -1 );
 		}
+		internal_list = (libfdata_internal_list_t *) entry->list;
+
+		if( ( internal_list->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
+		{
+			if( libfdata_list_calculate_mapped_ranges(
+			     internal_list,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate mapped ranges of list: %d.",
+				 function,
+				 entry_index );
+
+				return( -1 );
+			}
+		}
+		if( offset > entry->mapped_range_offset )
+		{
+			result = libfdata_list_get_element_index_at_offset(
+			          entry->list,
+			          offset,
+			          &element_index,
+			          &element_data_offset,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve element index from list: %d for offset: %" PRIi64 ".",
+				 function,
+				 entry_index,
+				 offset );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			element_index = 0;
+		}
+		while( element_index < number_of_list_elements )
+		{
+			if( libfdata_list_get_entry_by_index(
+			     internal_list,
+			     element_index,
+			     &list_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve list entry: %d from list: %d.",
+				 function,
+				 element_index,
+				 entry_index );
+
+				return( -1 );
+			}
+			if( list_entry->mapped_range_offset >= range_end_offset )
+			{
+				break;
+			}
+			if( safe_number_of_elements < maximum_number_of_elements )
+			{
+				if( libfdata_list_get_list_element_by_index(
+				     entry->list,
+				     element_index,
+				     &( elements[ safe_number_of_elements ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve list element: %d from list: %d.",
+					 function,
+					 element_index,
+					 entry_index );
+
+					return( -1 );
+				}
+			}
+			safe_number_of_elements++;
+
+			element_index++;
+		}
+		entry_index++;
 	}
-	return( result );
+	*number_of_elements = safe_number_of_elements;
+
+	if( safe_number_of_elements == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
 }
 
 /* Inserts an element data range based on its mapped range
@@ -715,12 +1559,12 @@ int libfdata_range_list_insert_element(
 		 size );
 	}
 #endif
-	result = libcdata_range_list_get_range_at_offset(
-	          internal_range_list->elements_range_list,
-	          (uint64_t) offset,
-	          (uint64_t *) &mapped_range_offset,
-	          (uint64_t *) &mapped_range_size,
-	          (intptr_t **) &list,
+	result = libfdata_range_list_get_list_at_offset(
+	          internal_range_list,
+	          offset,
+	          &mapped_range_offset,
+	          &mapped_range_size,
+	          &list,
 	          error );
 
 	if( result == -1 )
@@ -729,7 +1573,7 @@ int libfdata_range_list_insert_element(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve range from elements range list for offset: %" PRIi64 ".",
+		 "%s: unable to retrieve list for offset: %" PRIi64 ".",
 		 function,
 		 offset );
 
@@ -846,14 +1690,10 @@ int libfdata_range_list_insert_element(
 			 function );
 		}
 #endif
-		if( libfdata_list_initialize(
+		if( libfdata_range_list_create_list(
+		     internal_range_list,
+		     offset,
 		     &list,
-		     internal_range_list->data_handle,
-		     internal_range_list->free_data_handle,
-		     internal_range_list->clone_data_handle,
-		     internal_range_list->read_element_data,
-		     internal_range_list->write_element_data,
-		     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -865,24 +1705,6 @@ int libfdata_range_list_insert_element(
 
 			return( -1 );
 		}
-		if( libfdata_list_set_mapped_offset(
-		     list,
-		     offset,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set mapped offset in list.",
-			 function );
-
-			libfdata_list_free(
-			 &list,
-			 NULL );
-
-			return( -1 );
-		}
 		if( libfdata_list_append_element_with_mapped_size(
 		     list,
 		     &element_index,
@@ -906,20 +1728,18 @@ int libfdata_range_list_insert_element(
 
 			return( -1 );
 		}
-		if( libcdata_range_list_insert_range(
-		     internal_range_list->elements_range_list,
-		     (uint64_t) offset,
-		     (uint64_t) size,
-		     (intptr_t *) list,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_list_free,
-		     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libfdata_list_append_list,
+		if( libfdata_range_list_insert_list(
+		     internal_range_list,
+		     offset,
+		     size,
+		     list,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to insert range in elements range list.",
+			 "%s: unable to insert list in range list.",
 			 function );
 
 			libfdata_list_free(
@@ -940,6 +1760,290 @@ int libfdata_range_list_insert_element(
 	return( 1 );
 }
 
+/* Inserts multiple element data ranges based on their mapped ranges
+ * The mapped ranges must be sorted by offset and must not overlap
+ * Mapped ranges that follow the last mapped range of the range list are appended
+ * without a lookup, which allows to load a range list in linear time
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_range_list_insert_elements(
+     libfdata_range_list_t *range_list,
+     int number_of_elements,
+     off64_t *offsets,
+     size64_t *sizes,
+     int *element_file_indexes,
+     off64_t *element_offsets,
+     size64_t *element_sizes,
+     uint32_t *element_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_range_list_t *internal_range_list = NULL;
+	libfdata_list_t *list                               = NULL;
+	libfdata_range_list_entry_t *last_entry             = NULL;
+	static char *function                               = "libfdata_range_list_insert_elements";
+	off64_t last_range_end_offset                       = 0;
+	off64_t previous_range_end_offset                   = 0;
+	int element_index                                   = 0;
+	int list_element_index                              = 0;
+
+	if( range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range list.",
+		 function );
+
+		return( -1 );
+	}
+	internal_range_list = (libfdata_internal_range_list_t *) range_list;
+
+	if( number_of_elements < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of elements value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_file_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element file indexes.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element flags.",
+		 function );
+
+		return( -1 );
+	}
+	for( element_index = 0;
+	     element_index < number_of_elements;
+	     element_index++ )
+	{
+		if( ( offsets[ element_index ] < 0 )
+		 || ( offsets[ element_index ] < previous_range_end_offset ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid offset: %d value out of bounds.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		if( sizes[ element_index ] > (size64_t) ( INT64_MAX - offsets[ element_index ] ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid size: %d value exceeds maximum.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		previous_range_end_offset = offsets[ element_index ] + (off64_t) sizes[ element_index ];
+	}
+	for( element_index = 0;
+	     element_index < number_of_elements;
+	     element_index++ )
+	{
+		last_entry = NULL;
+
+		if( internal_range_list->number_of_entries > 0 )
+		{
+			last_entry = &( internal_range_list->entries[ internal_range_list->number_of_entries - 1 ] );
+
+			last_range_end_offset = last_entry->mapped_range_offset + (off64_t) last_entry->mapped_range_size;
+		}
+		if( ( last_entry != NULL )
+		 && ( offsets[ element_index ] < last_range_end_offset ) )
+		{
+			/* The mapped range does not follow the last mapped range
+			 */
+			if( libfdata_range_list_insert_element(
+			     range_list,
+			     offsets[ element_index ],
+			     sizes[ element_index ],
+			     element_file_indexes[ element_index ],
+			     element_offsets[ element_index ],
+			     element_sizes[ element_index ],
+			     element_flags[ element_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert element: %d.",
+				 function,
+				 element_index );
+
+				return( -1 );
+			}
+		}
+		else if( ( last_entry != NULL )
+		      && ( offsets[ element_index ] == last_range_end_offset ) )
+		{
+			/* The mapped range is adjacent to the last mapped range
+			 */
+			if( libfdata_list_append_element_with_mapped_size(
+			     last_entry->list,
+			     &list_element_index,
+			     element_file_indexes[ element_index ],
+			     element_offsets[ element_index ],
+			     element_sizes[ element_index ],
+			     element_flags[ element_index ],
+			     sizes[ element_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append element: %d to list.",
+				 function,
+				 element_index );
+
+				return( -1 );
+			}
+			last_entry->mapped_range_size += sizes[ element_index ];
+		}
+		else
+		{
+			if( libfdata_range_list_create_list(
+			     internal_range_list,
+			     offsets[ element_index ],
+			     &list,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create list.",
+				 function );
+
+				goto on_error;
+			}
+			if( libfdata_list_append_element_with_mapped_size(
+			     list,
+			     &list_element_index,
+			     element_file_indexes[ element_index ],
+			     element_offsets[ element_index ],
+			     element_sizes[ element_index ],
+			     element_flags[ element_index ],
+			     sizes[ element_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append element: %d to list.",
+				 function,
+				 element_index );
+
+				goto on_error;
+			}
+			if( libfdata_range_list_resize_entries(
+			     internal_range_list,
+			     internal_range_list->number_of_entries + 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize entries.",
+				 function );
+
+				goto on_error;
+			}
+			last_entry = &( internal_range_list->entries[ internal_range_list->number_of_entries - 1 ] );
+
+			last_entry->mapped_range_offset = offsets[ element_index ];
+			last_entry->mapped_range_size   = sizes[ element_index ];
+			last_entry->list                = list;
+
+			list = NULL;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( list != NULL )
+	{
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* List element value functions
  */
 
@@ -986,12 +2090,12 @@ int libfdata_range_list_get_element_value_at_offset(
 		 offset );
 	}
 #endif
-	result = libcdata_range_list_get_range_at_offset(
-	          internal_range_list->elements_range_list,
-	          (uint64_t) offset,
-	          (uint64_t *) &mapped_range_offset,
-	          (uint64_t *) &mapped_range_size,
-	          (intptr_t **) &list,
+	result = libfdata_range_list_get_list_at_offset(
+	          internal_range_list,
+	          offset,
+	          &mapped_range_offset,
+	          &mapped_range_size,
+	          &list,
 	          error );
 
 	if( result == -1 )
@@ -1000,7 +2104,7 @@ int libfdata_range_list_get_element_value_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve range from elements range list for offset: %" PRIi64 ".",
+		 "%s: unable to retrieve list for offset: %" PRIi64 ".",
 		 function,
 		 offset );
 
@@ -1114,12 +2218,12 @@ int libfdata_range_list_set_element_value_at_offset(
 		 offset );
 	}
 #endif
-	result = libcdata_range_list_get_range_at_offset(
-	          internal_range_list->elements_range_list,
-	          (uint64_t) offset,
-	          (uint64_t *) &mapped_range_offset,
-	          (uint64_t *) &mapped_range_size,
-	          (intptr_t **) &list,
+	result = libfdata_range_list_get_list_at_offset(
+	          internal_range_list,
+	          offset,
+	          &mapped_range_offset,
+	          &mapped_range_size,
+	          &list,
 	          error );
 
 	if( result == -1 )
@@ -1128,7 +2232,7 @@ int libfdata_range_list_set_element_value_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve range from elements range list for offset: %" PRIi64 ".",
+		 "%s: unable to retrieve list for offset: %" PRIi64 ".",
 		 function,
 		 offset );
 
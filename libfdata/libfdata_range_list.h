@@ -26,7 +26,6 @@
 #include <types.h>
 
 #include "libfdata_extern.h"
-#include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_types.h"
 
@@ -34,13 +33,39 @@
 extern "C" {
 #endif
 
+typedef struct libfdata_range_list_entry libfdata_range_list_entry_t;
+
+struct libfdata_range_list_entry
+{
+	/* The mapped range offset
+	 */
+	off64_t mapped_range_offset;
+
+	/* The mapped range size
+	 */
+	size64_t mapped_range_size;
+
+	/* The list that contains the elements of the mapped range
+	 */
+	libfdata_list_t *list;
+};
+
 typedef struct libfdata_internal_range_list libfdata_internal_range_list_t;
 
 struct libfdata_internal_range_list
 {
-	/* The (list) elements range list
+	/* The (mapped range) entries
+	 * the entries are sorted by mapped range offset and do not overlap
 	 */
-	libcdata_range_list_t *elements_range_list;
+	libfdata_range_list_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The number of allocated entries
+	 */
+	int number_of_allocated_entries;
 
 	/* The flags
 	 */
@@ -139,6 +164,38 @@ int libfdata_range_list_clone(
      libfdata_range_list_t *source_range_list,
      libcerror_error_t **error );
 
+int libfdata_range_list_resize_entries(
+     libfdata_internal_range_list_t *internal_range_list,
+     int number_of_entries,
+     libcerror_error_t **error );
+
+int libfdata_range_list_get_entry_index_at_offset(
+     libfdata_internal_range_list_t *internal_range_list,
+     off64_t offset,
+     int *entry_index,
+     libcerror_error_t **error );
+
+int libfdata_range_list_get_list_at_offset(
+     libfdata_internal_range_list_t *internal_range_list,
+     off64_t offset,
+     off64_t *mapped_range_offset,
+     size64_t *mapped_range_size,
+     libfdata_list_t **list,
+     libcerror_error_t **error );
+
+int libfdata_range_list_create_list(
+     libfdata_internal_range_list_t *internal_range_list,
+     off64_t mapped_range_offset,
+     libfdata_list_t **list,
+     libcerror_error_t **error );
+
+int libfdata_range_list_insert_list(
+     libfdata_internal_range_list_t *internal_range_list,
+     off64_t mapped_range_offset,
+     size64_t mapped_range_size,
+     libfdata_list_t *list,
+     libcerror_error_t **error );
+
 /* List elements functions
  */
 LIBFDATA_EXTERN \
@@ -168,6 +225,16 @@ int libfdata_range_list_get_element_at_offset(
      uint32_t *element_flags,
      libcerror_error_t **error );
 
+LIBFDATA_EXTERN \
+int libfdata_range_list_get_elements_in_range(
+     libfdata_range_list_t *range_list,
+     off64_t offset,
+     size64_t size,
+     libfdata_list_element_t **elements,
+     int maximum_number_of_elements,
+     int *number_of_elements,
+     libcerror_error_t **error );
+
 LIBFDATA_EXTERN \
 int libfdata_range_list_insert_element(
      libfdata_range_list_t *range_list,
@@ -179,6 +246,18 @@ int libfdata_range_list_insert_element(
      uint32_t element_flags,
      libcerror_error_t **error );
 
+LIBFDATA_EXTERN \
+int libfdata_range_list_insert_elements(
+     libfdata_range_list_t *range_list,
+     int number_of_elements,
+     off64_t *offsets,
+     size64_t *sizes,
+     int *element_file_indexes,
+     off64_t *element_offsets,
+     size64_t *element_sizes,
+     uint32_t *element_flags,
+     libcerror_error_t **error );
+
 /* List element value functions
  */
 
@@ -23,14 +23,25 @@
 #include <memory.h>
 #include <types.h>
 
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
 #include "libfdata_definitions.h"
+#include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libcnotify.h"
+#include "libfdata_libcthreads.h"
 #include "libfdata_libfcache.h"
 #include "libfdata_tree.h"
 #include "libfdata_tree_node.h"
+#include "libfdata_tree_node_slab.h"
 #include "libfdata_types.h"
 
+/* The number of nodes per node slab block
+ */
+#define LIBFDATA_TREE_NODE_SLAB_NUMBER_OF_ELEMENTS_PER_BLOCK	256
+
 /* Creates a tree
  * Make sure the value tree is referencing, is set to NULL
  *
@@ -150,6 +161,36 @@ int libfdata_tree_initialize(
 
 		goto on_error;
 	}
+	if( libfdata_tree_node_slab_initialize(
+	     &( internal_tree->node_slab ),
+	     sizeof( libfdata_internal_tree_node_t ),
+	     LIBFDATA_TREE_NODE_SLAB_NUMBER_OF_ELEMENTS_PER_BLOCK,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create node slab.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( internal_tree->node_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create node mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	internal_tree->flags            |= flags;
 	internal_tree->data_handle       = data_handle;
 	internal_tree->free_data_handle  = free_data_handle;
@@ -164,6 +205,12 @@ int libfdata_tree_initialize(
 on_error:
 	if( internal_tree != NULL )
 	{
+		if( internal_tree->node_slab != NULL )
+		{
+			libfdata_tree_node_slab_free(
+			 &( internal_tree->node_slab ),
+			 NULL );
+		}
 		memory_free(
 		 internal_tree );
 	}
@@ -213,6 +260,36 @@ int libfdata_tree_free(
 				result = -1;
 			}
 		}
+		/* The nodes are freed before the node slab that contains them
+		 */
+		if( libfdata_tree_node_slab_free(
+		     &( internal_tree->node_slab ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free node slab.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( internal_tree->node_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free node mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		if( ( internal_tree->flags & LIBFDATA_DATA_HANDLE_FLAG_MANAGED ) != 0 )
 		{
 			if( internal_tree->data_handle != NULL )
@@ -257,14 +334,10 @@ int libfdata_tree_clone(
      libfdata_tree_t *source_tree,
      libcerror_error_t **error )
 {
-	libfdata_internal_tree_t *internal_source_tree = NULL;
-	libfdata_tree_node_t *source_tree_root_node    = NULL;
-	intptr_t *destination_data_handle              = NULL;
-	static char *function                          = "libfdata_tree_clone";
-	off64_t node_offset                            = 0;
-	size64_t node_size                             = 0;
-	uint32_t node_flags                            = 0;
-	int node_file_index                            = -1;
+	libfdata_internal_tree_t *internal_destination_tree = NULL;
+	libfdata_internal_tree_t *internal_source_tree      = NULL;
+	intptr_t *destination_data_handle                   = NULL;
+	static char *function                               = "libfdata_tree_clone";
 
 	if( destination_tree == NULL )
 	{
@@ -356,100 +429,214 @@ int libfdata_tree_clone(
 	}
 	destination_data_handle = NULL;
 
-	if( libfdata_tree_get_root_node(
-	     source_tree,
-	     &source_tree_root_node,
-	     error ) != 1 )
+	internal_destination_tree = (libfdata_internal_tree_t *) *destination_tree;
+
+	internal_destination_tree->maximum_number_of_nodes   = internal_source_tree->maximum_number_of_nodes;
+	internal_destination_tree->maximum_number_of_threads = internal_source_tree->maximum_number_of_threads;
+	internal_destination_tree->read_nodes                = internal_source_tree->read_nodes;
+
+	/* The nodes that have been read are cloned so that the destination tree
+	 * does not need to read them again
+	 */
+	if( internal_source_tree->root_node != NULL )
+	{
+		if( libfdata_tree_node_clone(
+		     &( internal_destination_tree->root_node ),
+		     internal_source_tree->root_node,
+		     *destination_tree,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination tree root node.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *destination_tree != NULL )
+	{
+		libfdata_tree_free(
+		 destination_tree,
+		 NULL );
+	}
+	if( destination_data_handle != NULL )
+	{
+		internal_source_tree->free_data_handle(
+		 &destination_data_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the number of nodes
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_get_number_of_nodes(
+     libfdata_tree_t *tree,
+     int *number_of_nodes,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_t *internal_tree = NULL;
+	static char *function                   = "libfdata_tree_get_number_of_nodes";
+
+	if( tree == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve source tree root node.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfdata_tree_node_get_data_range(
-	     source_tree_root_node,
-	     &node_file_index,
-	     &node_offset,
-	     &node_size,
-	     &node_flags,
-	     error ) != 1 )
+	internal_tree = (libfdata_internal_tree_t *) tree;
+
+	if( number_of_nodes == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve source tree root node data range.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of nodes.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfdata_tree_set_root_node(
-	     *destination_tree,
-	     node_file_index,
-	     node_offset,
-	     node_size,
-	     node_flags,
-	     error ) != 1 )
+	*number_of_nodes = internal_tree->node_slab->number_of_allocated_elements;
+
+	return( 1 );
+}
+
+/* Sets the maximum number of nodes
+ * If the maximum is exceeded the sub nodes of the least recently used nodes are freed,
+ * these are read again when needed. Only the sub nodes read after the maximum is set
+ * are freed. A value of 0 represents no maximum.
+ *
+ * Note that when a maximum is set, references to nodes of the tree are only valid
+ * until the next function call that can read sub nodes
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_set_maximum_number_of_nodes(
+     libfdata_tree_t *tree,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_t *internal_tree = NULL;
+	static char *function                   = "libfdata_tree_set_maximum_number_of_nodes";
+
+	if( tree == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set destination tree root node.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+	internal_tree = (libfdata_internal_tree_t *) tree;
+
+	if( maximum_number_of_nodes < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of nodes value less than zero.",
+		 function );
+
+		return( -1 );
 	}
-	/* TODO or clone all the tree nodes ? */
+	internal_tree->maximum_number_of_nodes = maximum_number_of_nodes;
 
 	return( 1 );
+}
 
-on_error:
-	if( *destination_tree != NULL )
+/* Sets the maximum number of threads used to read sub trees
+ * A value of 0 or 1 reads the sub trees on the calling thread
+ *
+ * If more than 1 thread is used the sub trees of the root node are read in
+ * parallel when the leaf nodes are counted, the read node and read sub nodes
+ * functions are then called from multiple threads at the same time and must
+ * be safe to do so. Every sub tree is read with its own cache.
+ *
+ * The sub trees are not read in parallel if a maximum number of nodes is set
+ * The value is ignored if multi-thread support is not available
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_set_maximum_number_of_threads(
+     libfdata_tree_t *tree,
+     int maximum_number_of_threads,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_t *internal_tree = NULL;
+	static char *function                   = "libfdata_tree_set_maximum_number_of_threads";
+
+	if( tree == NULL )
 	{
-		libfdata_tree_free(
-		 destination_tree,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
 	}
-	if( destination_data_handle != NULL )
+	internal_tree = (libfdata_internal_tree_t *) tree;
+
+	if( maximum_number_of_threads < 0 )
 	{
-		internal_source_tree->free_data_handle(
-		 &destination_data_handle,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of threads value less than zero.",
+		 function );
+
+		return( -1 );
 	}
-	return( -1 );
+	internal_tree->maximum_number_of_threads = maximum_number_of_threads;
+
+	return( 1 );
 }
 
-/* Retrieves the node value of the node
+/* Sets the read nodes function
+ * The function reads the node data of a number of nodes, which is stored
+ * contiguously in a single file, and sets their node values in the cache
+ * It is used to read the node data of adjacent nodes of a level with a single
+ * read in libfdata_tree_read_all_sub_nodes, without it every node is read on its own
  * Returns 1 if successful or -1 on error
  */
-int libfdata_tree_get_node_value(
+int libfdata_tree_set_read_nodes_function(
      libfdata_tree_t *tree,
-     intptr_t *file_io_handle,
-     libfcache_cache_t *cache,
-     libfdata_tree_node_t *node,
-     intptr_t **node_value,
-     uint8_t read_flags,
+     int (*read_nodes)(
+            intptr_t *data_handle,
+            intptr_t *file_io_handle,
+            libfdata_tree_node_t **nodes,
+            int number_of_nodes,
+            libfcache_cache_t *cache,
+            int nodes_file_index,
+            off64_t nodes_offset,
+            size64_t nodes_size,
+            uint32_t nodes_flags,
+            uint8_t read_flags,
+            libcerror_error_t **error ),
      libcerror_error_t **error )
 {
-	libfcache_cache_value_t *cache_value    = NULL;
 	libfdata_internal_tree_t *internal_tree = NULL;
-	static char *function                   = "libfdata_tree_get_node_value";
-	off64_t cache_value_offset              = (off64_t) -1;
-	off64_t node_offset                     = 0;
-	size64_t node_size                      = 0;
-	time_t cache_value_timestamp            = 0;
-	time_t node_timestamp                   = 0;
-	uint32_t node_flags                     = 0;
-	int cache_entry_index                   = -1;
-	int cache_value_file_index              = -1;
-	int number_of_cache_entries             = 0;
-	int node_file_index                     = -1;
-	int result                              = 0;
+	static char *function                   = "libfdata_tree_set_read_nodes_function";
 
 	if( tree == NULL )
 	{
@@ -464,60 +651,249 @@ int libfdata_tree_get_node_value(
 	}
 	internal_tree = (libfdata_internal_tree_t *) tree;
 
-	if( internal_tree->read_node == NULL )
+	internal_tree->read_nodes = read_nodes;
+
+	return( 1 );
+}
+
+/* Allocates a node element from the node slab
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_allocate_node_element(
+     libfdata_tree_t *tree,
+     intptr_t **element,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_t *internal_tree = NULL;
+	static char *function                   = "libfdata_tree_allocate_node_element";
+	int result                              = 1;
+
+	if( tree == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid tree - missing read node function.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfdata_tree_node_get_data_range(
-	     node,
-	     &node_file_index,
-	     &node_offset,
-	     &node_size,
-	     &node_flags,
+	internal_tree = (libfdata_internal_tree_t *) tree;
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_tree->node_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve data range from tree node.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab node mutex.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfcache_cache_get_number_of_entries(
-	     cache,
-	     &number_of_cache_entries,
+#endif
+	if( libfdata_tree_node_slab_allocate_element(
+	     internal_tree->node_slab,
+	     element,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of cache entries.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to allocate element from node slab.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( number_of_cache_entries <= 0 )
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_tree->node_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid number of cache entries value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release node mutex.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
+#endif
+	return( result );
+}
+
+/* Frees a node element and returns it to the node slab
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_free_node_element(
+     libfdata_tree_t *tree,
+     intptr_t *element,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_t *internal_tree = NULL;
+	static char *function                   = "libfdata_tree_free_node_element";
+	int result                              = 1;
+
+	if( tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree = (libfdata_internal_tree_t *) tree;
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_tree->node_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab node mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfdata_tree_node_slab_free_element(
+	     internal_tree->node_slab,
+	     element,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free element in node slab.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_tree->node_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release node mutex.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the node value of the node
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_get_node_value(
+     libfdata_tree_t *tree,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     libfdata_tree_node_t *node,
+     intptr_t **node_value,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value    = NULL;
+	libfdata_internal_tree_t *internal_tree = NULL;
+	static char *function                   = "libfdata_tree_get_node_value";
+	off64_t cache_value_offset              = (off64_t) -1;
+	off64_t node_offset                     = 0;
+	size64_t node_size                      = 0;
+	time_t cache_value_timestamp            = 0;
+	time_t node_timestamp                   = 0;
+	uint32_t node_flags                     = 0;
+	int cache_entry_index                   = -1;
+	int cache_value_file_index              = -1;
+	int number_of_cache_entries             = 0;
+	int node_file_index                     = -1;
+	int result                              = 0;
+
+	if( tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree = (libfdata_internal_tree_t *) tree;
+
+	if( internal_tree->read_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid tree - missing read node function.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_tree_node_get_data_range(
+	     node,
+	     &node_file_index,
+	     &node_offset,
+	     &node_size,
+	     &node_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data range from tree node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cache entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
 	{
 		if( ( ( ( (libfdata_internal_tree_node_t *) node )->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) == 0 )
 		 && ( ( ( (libfdata_internal_tree_node_t *) node )->flags & LIBFDATA_TREE_NODE_FLAG_IS_LEAF ) != 0 ) )
@@ -871,23 +1247,28 @@ int libfdata_tree_set_node_value(
 	return( 1 );
 }
 
-/* Reads the sub nodes of the node
+/* Releases the node value of the node from the cache
+ * The cache entry is only released if it contains the value of the node
  * Returns 1 if successful or -1 on error
  */
-int libfdata_tree_read_sub_nodes(
+int libfdata_tree_release_node_value(
      libfdata_tree_t *tree,
-     intptr_t *file_io_handle,
      libfcache_cache_t *cache,
      libfdata_tree_node_t *node,
-     uint8_t read_flags,
      libcerror_error_t **error )
 {
-	libfdata_internal_tree_t *internal_tree = NULL;
-	static char *function                   = "libfdata_tree_read_sub_nodes";
-	off64_t sub_nodes_offset                = 0;
-	size64_t sub_nodes_size                 = 0;
-        uint32_t sub_nodes_flags                = 0;
-	int sub_nodes_file_index                = -1;
+	libfcache_cache_value_t *cache_value = NULL;
+	static char *function                = "libfdata_tree_release_node_value";
+	off64_t cache_value_offset           = (off64_t) -1;
+	off64_t node_offset                  = 0;
+	size64_t node_size                   = 0;
+	time_t cache_value_timestamp         = 0;
+	time_t node_timestamp                = 0;
+	uint32_t node_flags                  = 0;
+	int cache_entry_index                = -1;
+	int cache_value_file_index           = -1;
+	int node_file_index                  = -1;
+	int number_of_cache_entries          = 0;
 
 	if( tree == NULL )
 	{
@@ -900,99 +1281,1362 @@ int libfdata_tree_read_sub_nodes(
 
 		return( -1 );
 	}
-	internal_tree = (libfdata_internal_tree_t *) tree;
-
-	if( internal_tree->read_sub_nodes == NULL )
+	if( libfdata_tree_node_get_data_range(
+	     node,
+	     &node_file_index,
+	     &node_offset,
+	     &node_size,
+	     &node_flags,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid tree - missing read sub nodes function.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data range from tree node.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfdata_tree_node_get_sub_nodes_data_range(
+	if( libfdata_tree_node_get_timestamp(
 	     node,
-	     &sub_nodes_file_index,
-	     &sub_nodes_offset,
-	     &sub_nodes_size,
-	     &sub_nodes_flags,
+	     &node_timestamp,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve sub nodes data range.",
+		 "%s: unable to retrieve timestamp from tree node.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_tree->read_sub_nodes(
-	     internal_tree->data_handle,
-	     file_io_handle,
-	     node,
+	if( libfcache_cache_get_number_of_entries(
 	     cache,
-	     sub_nodes_file_index,
-	     sub_nodes_offset,
-	     sub_nodes_size,
-	     sub_nodes_flags,
-	     read_flags,
+	     &number_of_cache_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read sub nodes at offset: 0x%08" PRIx64 ".",
-		 function,
-		 sub_nodes_offset );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries.",
+		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-}
-
-/* Retrieves the offset and size of the root node
- * Returns 1 if successful or -1 on error
- */
-int libfdata_tree_get_root_node(
-     libfdata_tree_t *tree,
-     libfdata_tree_node_t **root_node,
-     libcerror_error_t **error )
-{
-	libfdata_internal_tree_t *internal_tree = NULL;
-	static char *function                   = "libfdata_tree_get_root_node";
-
-	if( tree == NULL )
+	if( number_of_cache_entries <= 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid tree.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cache entries value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	internal_tree = (libfdata_internal_tree_t *) tree;
-
-	if( root_node == NULL )
+	if( ( ( ( (libfdata_internal_tree_node_t *) node )->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) == 0 )
+	 && ( ( ( (libfdata_internal_tree_node_t *) node )->flags & LIBFDATA_TREE_NODE_FLAG_IS_LEAF ) != 0 ) )
+	{
+		cache_entry_index = libfdata_tree_node_calculate_leaf_node_cache_entry_index(
+				     node_offset,
+				     number_of_cache_entries );
+	}
+	else
+	{
+		cache_entry_index = libfdata_tree_node_calculate_branch_node_cache_entry_index(
+				     node_offset,
+				     number_of_cache_entries );
+	}
+	if( libfcache_cache_get_value_by_index(
+	     cache,
+	     cache_entry_index,
+	     &cache_value,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid root node.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache entry: %d from cache.",
+		 function,
+		 cache_entry_index );
 
 		return( -1 );
 	}
-	*root_node = internal_tree->root_node;
-
-	return( 1 );
+	if( cache_value == NULL )
+	{
+		return( 1 );
+	}
+	if( libfcache_cache_value_get_identifier(
+	     cache_value,
+	     &cache_value_file_index,
+	     &cache_value_offset,
+	     &cache_value_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache value identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( node_file_index != cache_value_file_index )
+	 || ( node_offset != cache_value_offset )
+	 || ( node_timestamp != cache_value_timestamp ) )
+	{
+		return( 1 );
+	}
+	/* Replacing the cache entry frees a managed node value
+	 */
+	if( libfcache_cache_set_value_by_index(
+	     cache,
+	     cache_entry_index,
+	     -1,
+	     (off64_t) -1,
+	     0,
+	     NULL,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release value in cache entry: %d.",
+		 function,
+		 cache_entry_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines if the node value is cached
+ * Returns 1 if cached, 0 if not or -1 on error
+ */
+int libfdata_tree_is_node_value_cached(
+     libfdata_internal_tree_t *internal_tree,
+     libfcache_cache_t *cache,
+     libfdata_tree_node_t *node,
+     int number_of_cache_entries,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value              = NULL;
+	libfdata_internal_tree_node_t *internal_tree_node = NULL;
+	static char *function                             = "libfdata_tree_is_node_value_cached";
+	off64_t cache_value_offset                        = (off64_t) -1;
+	time_t cache_value_timestamp                      = 0;
+	int cache_entry_index                             = -1;
+	int cache_value_file_index                        = -1;
+
+	if( internal_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cache entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) == 0 )
+	 && ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_LEAF ) != 0 ) )
+	{
+		cache_entry_index = libfdata_tree_node_calculate_leaf_node_cache_entry_index(
+		                     internal_tree_node->node_data_range.offset,
+		                     number_of_cache_entries );
+	}
+	else
+	{
+		cache_entry_index = libfdata_tree_node_calculate_branch_node_cache_entry_index(
+		                     internal_tree_node->node_data_range.offset,
+		                     number_of_cache_entries );
+	}
+	if( libfcache_cache_get_value_by_index(
+	     cache,
+	     cache_entry_index,
+	     &cache_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache entry: %d from cache.",
+		 function,
+		 cache_entry_index );
+
+		return( -1 );
+	}
+	if( cache_value == NULL )
+	{
+		return( 0 );
+	}
+	if( libfcache_cache_value_get_identifier(
+	     cache_value,
+	     &cache_value_file_index,
+	     &cache_value_offset,
+	     &cache_value_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache value identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_tree_node->node_data_range.file_index != cache_value_file_index )
+	 || ( internal_tree_node->node_data_range.offset != cache_value_offset )
+	 || ( internal_tree_node->timestamp != cache_value_timestamp ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Reads the sub nodes of the node
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_read_sub_nodes(
+     libfdata_tree_t *tree,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     libfdata_tree_node_t *node,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_t *internal_tree = NULL;
+	static char *function                   = "libfdata_tree_read_sub_nodes";
+	off64_t sub_nodes_offset                = 0;
+	size64_t sub_nodes_size                 = 0;
+        uint32_t sub_nodes_flags                = 0;
+	int sub_nodes_file_index                = -1;
+
+	if( tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree = (libfdata_internal_tree_t *) tree;
+
+	if( internal_tree->read_sub_nodes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid tree - missing read sub nodes function.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_tree_node_get_sub_nodes_data_range(
+	     node,
+	     &sub_nodes_file_index,
+	     &sub_nodes_offset,
+	     &sub_nodes_size,
+	     &sub_nodes_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub nodes data range.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_tree->read_sub_nodes(
+	     internal_tree->data_handle,
+	     file_io_handle,
+	     node,
+	     cache,
+	     sub_nodes_file_index,
+	     sub_nodes_offset,
+	     sub_nodes_size,
+	     sub_nodes_flags,
+	     read_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub nodes at offset: 0x%08" PRIx64 ".",
+		 function,
+		 sub_nodes_offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads all the sub nodes of the tree in level order
+ *
+ * The node data of the nodes of a level is read in order of file index and offset,
+ * followed by the sub nodes data of the nodes of the level, before continuing with
+ * the next level. Reading the tree depth first, reads the node data in the order
+ * of the tree instead of the order in which it is stored.
+ *
+ * If a read nodes function was set, the node data of nodes of a level that is
+ * stored contiguously in the same file is read with a single call to it.
+ * The sub nodes data is read per node.
+ *
+ * This function cannot be used if a maximum number of nodes is set,
+ * since all the nodes of the tree are read
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_read_all_sub_nodes(
+     libfdata_tree_t *tree,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_t *internal_tree           = NULL;
+	libfdata_internal_tree_node_t *internal_tree_node = NULL;
+	libfdata_internal_tree_node_t *run_tree_node      = NULL;
+	libfdata_tree_node_t **level_nodes                = NULL;
+	libfdata_tree_node_t **sub_level_nodes            = NULL;
+	intptr_t *node_value                              = NULL;
+	static char *function                             = "libfdata_tree_read_all_sub_nodes";
+	size64_t run_data_size                            = 0;
+	int level_node_index                              = 0;
+	int number_of_cache_entries                       = 0;
+	int number_of_level_nodes                         = 0;
+	int number_of_run_nodes                           = 0;
+	int number_of_sub_level_nodes                     = 0;
+	int number_of_sub_nodes                           = 0;
+	int result                                        = 0;
+	int run_node_index                                = 0;
+	int sub_level_node_index                          = 0;
+	int sub_node_index                                = 0;
+
+	if( tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree = (libfdata_internal_tree_t *) tree;
+
+	if( internal_tree->root_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid tree - missing root node.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_tree->maximum_number_of_nodes != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid tree - unsupported maximum number of nodes.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_tree->read_nodes != NULL )
+	{
+		if( libfcache_cache_get_number_of_entries(
+		     cache,
+		     &number_of_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of cache entries.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	level_nodes = (libfdata_tree_node_t **) memory_allocate(
+	                                         sizeof( libfdata_tree_node_t * ) );
+
+	if( level_nodes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create level nodes.",
+		 function );
+
+		goto on_error;
+	}
+	level_nodes[ 0 ]      = internal_tree->root_node;
+	number_of_level_nodes = 1;
+
+	while( number_of_level_nodes > 0 )
+	{
+		qsort(
+		 level_nodes,
+		 (size_t) number_of_level_nodes,
+		 sizeof( libfdata_tree_node_t * ),
+		 (int (*)(const void *, const void *)) &libfdata_tree_node_compare_data_ranges );
+
+		level_node_index = 0;
+
+		while( level_node_index < number_of_level_nodes )
+		{
+			internal_tree_node = (libfdata_internal_tree_node_t *) level_nodes[ level_node_index ];
+
+			if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) != 0 )
+			 || ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ ) != 0 )
+			 || ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_NOTE_DATA_READ ) != 0 ) )
+			{
+				level_node_index++;
+
+				continue;
+			}
+			number_of_run_nodes = 1;
+			run_data_size       = internal_tree_node->node_data_range.size;
+
+			/* A node that is not cached is read together with the following nodes
+			 * of which the node data directly follows that of the run
+			 */
+			if( internal_tree->read_nodes != NULL )
+			{
+				result = 0;
+
+				if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
+				{
+					result = libfdata_tree_is_node_value_cached(
+					          internal_tree,
+					          cache,
+					          level_nodes[ level_node_index ],
+					          number_of_cache_entries,
+					          error );
+
+					if( result == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to determine if node value is cached.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				while( ( result == 0 )
+				    && ( ( level_node_index + number_of_run_nodes ) < number_of_level_nodes ) )
+				{
+					run_tree_node = (libfdata_internal_tree_node_t *) level_nodes[ level_node_index + number_of_run_nodes ];
+
+					if( ( ( run_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) != 0 )
+					 || ( ( run_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ ) != 0 )
+					 || ( ( run_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_NOTE_DATA_READ ) != 0 )
+					 || ( run_tree_node->node_data_range.file_index != internal_tree_node->node_data_range.file_index )
+					 || ( run_tree_node->node_data_range.offset != ( internal_tree_node->node_data_range.offset + (off64_t) run_data_size ) )
+					 || ( run_tree_node->node_data_range.flags != internal_tree_node->node_data_range.flags ) )
+					{
+						break;
+					}
+					if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
+					{
+						result = libfdata_tree_is_node_value_cached(
+						          internal_tree,
+						          cache,
+						          level_nodes[ level_node_index + number_of_run_nodes ],
+						          number_of_cache_entries,
+						          error );
+
+						if( result == -1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+							 "%s: unable to determine if node value is cached.",
+							 function );
+
+							goto on_error;
+						}
+						else if( result != 0 )
+						{
+							break;
+						}
+					}
+					run_data_size       += run_tree_node->node_data_range.size;
+					number_of_run_nodes += 1;
+				}
+			}
+			if( number_of_run_nodes == 1 )
+			{
+				if( libfdata_tree_get_node_value(
+				     tree,
+				     file_io_handle,
+				     cache,
+				     level_nodes[ level_node_index ],
+				     &node_value,
+				     read_flags,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve node value.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			else
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: reading %d nodes at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIu64 "\n",
+					 function,
+					 number_of_run_nodes,
+					 internal_tree_node->node_data_range.offset,
+					 internal_tree_node->node_data_range.offset,
+					 run_data_size );
+				}
+#endif
+				if( internal_tree->read_nodes(
+				     internal_tree->data_handle,
+				     file_io_handle,
+				     &( level_nodes[ level_node_index ] ),
+				     number_of_run_nodes,
+				     cache,
+				     internal_tree_node->node_data_range.file_index,
+				     internal_tree_node->node_data_range.offset,
+				     run_data_size,
+				     internal_tree_node->node_data_range.flags,
+				     read_flags,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read %d nodes at offset: 0x%08" PRIx64 ".",
+					 function,
+					 number_of_run_nodes,
+					 internal_tree_node->node_data_range.offset );
+
+					goto on_error;
+				}
+			}
+			for( run_node_index = 0;
+			     run_node_index < number_of_run_nodes;
+			     run_node_index++ )
+			{
+				run_tree_node = (libfdata_internal_tree_node_t *) level_nodes[ level_node_index + run_node_index ];
+
+				run_tree_node->flags |= LIBFDATA_TREE_NODE_FLAG_NOTE_DATA_READ;
+			}
+			level_node_index += number_of_run_nodes;
+		}
+		qsort(
+		 level_nodes,
+		 (size_t) number_of_level_nodes,
+		 sizeof( libfdata_tree_node_t * ),
+		 (int (*)(const void *, const void *)) &libfdata_tree_node_compare_sub_nodes_data_ranges );
+
+		number_of_sub_level_nodes = 0;
+
+		for( level_node_index = 0;
+		     level_node_index < number_of_level_nodes;
+		     level_node_index++ )
+		{
+			internal_tree_node = (libfdata_internal_tree_node_t *) level_nodes[ level_node_index ];
+
+			if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) == 0 )
+			 && ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ ) == 0 ) )
+			{
+				if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_DATA_RANGE_SET ) != 0 )
+				{
+					if( libfdata_tree_read_sub_nodes(
+					     tree,
+					     file_io_handle,
+					     cache,
+					     level_nodes[ level_node_index ],
+					     read_flags,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read sub nodes.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				internal_tree_node->flags |= LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ;
+			}
+			else if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ ) == 0 )
+			{
+				if( libfdata_tree_node_read_virtual_sub_nodes(
+				     level_nodes[ level_node_index ],
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to read virtual sub nodes.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( libcdata_array_get_number_of_entries(
+			     internal_tree_node->sub_nodes,
+			     &number_of_sub_nodes,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of entries from sub nodes array.",
+				 function );
+
+				goto on_error;
+			}
+			if( number_of_sub_nodes > ( INT_MAX - number_of_sub_level_nodes ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid number of sub level nodes value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			number_of_sub_level_nodes += number_of_sub_nodes;
+		}
+		if( number_of_sub_level_nodes == 0 )
+		{
+			break;
+		}
+		if( (size_t) number_of_sub_level_nodes > ( (size_t) SSIZE_MAX / sizeof( libfdata_tree_node_t * ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of sub level nodes value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		sub_level_nodes = (libfdata_tree_node_t **) memory_allocate(
+		                                             sizeof( libfdata_tree_node_t * ) * number_of_sub_level_nodes );
+
+		if( sub_level_nodes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sub level nodes.",
+			 function );
+
+			goto on_error;
+		}
+		sub_level_node_index = 0;
+
+		for( level_node_index = 0;
+		     level_node_index < number_of_level_nodes;
+		     level_node_index++ )
+		{
+			internal_tree_node = (libfdata_internal_tree_node_t *) level_nodes[ level_node_index ];
+
+			if( libcdata_array_get_number_of_entries(
+			     internal_tree_node->sub_nodes,
+			     &number_of_sub_nodes,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of entries from sub nodes array.",
+				 function );
+
+				goto on_error;
+			}
+			for( sub_node_index = 0;
+			     sub_node_index < number_of_sub_nodes;
+			     sub_node_index++ )
+			{
+				if( libcdata_array_get_entry_by_index(
+				     internal_tree_node->sub_nodes,
+				     sub_node_index,
+				     (intptr_t **) &( sub_level_nodes[ sub_level_node_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve entry: %d from sub nodes array.",
+					 function,
+					 sub_node_index );
+
+					goto on_error;
+				}
+				if( sub_level_nodes[ sub_level_node_index ] == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing sub node: %d.",
+					 function,
+					 sub_node_index );
+
+					goto on_error;
+				}
+				sub_level_node_index++;
+			}
+		}
+		memory_free(
+		 level_nodes );
+
+		level_nodes           = sub_level_nodes;
+		number_of_level_nodes = number_of_sub_level_nodes;
+		sub_level_nodes       = NULL;
+	}
+	memory_free(
+	 level_nodes );
+
+	return( 1 );
+
+on_error:
+	if( sub_level_nodes != NULL )
+	{
+		memory_free(
+		 sub_level_nodes );
+	}
+	if( level_nodes != NULL )
+	{
+		memory_free(
+		 level_nodes );
+	}
+	return( -1 );
+}
+
+/* Marks the node as the most recently used node of which the sub nodes were read
+ * If the maximum number of nodes is exceeded the sub nodes of the least recently
+ * used nodes are freed
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_set_node_used(
+     libfdata_tree_t *tree,
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_t *internal_tree           = NULL;
+	libfdata_internal_tree_node_t *internal_tree_node = NULL;
+	libfdata_tree_node_t *used_node                   = NULL;
+	static char *function                             = "libfdata_tree_set_node_used";
+	int result                                        = 0;
+
+	if( tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree = (libfdata_internal_tree_t *) tree;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
+	if( internal_tree->maximum_number_of_nodes == 0 )
+	{
+		return( 1 );
+	}
+	/* Only the nodes of which the sub nodes can be read again are tracked
+	 */
+	if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) != 0 )
+	 || ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_DATA_RANGE_SET ) == 0 )
+	 || ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ ) == 0 ) )
+	{
+		return( 1 );
+	}
+	if( internal_tree->most_recently_used_node != node )
+	{
+		if( libfdata_tree_unset_node_used(
+		     tree,
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to unset node used.",
+			 function );
+
+			return( -1 );
+		}
+		internal_tree_node->next_used_node = internal_tree->most_recently_used_node;
+
+		if( internal_tree->most_recently_used_node != NULL )
+		{
+			( (libfdata_internal_tree_node_t *) internal_tree->most_recently_used_node )->previous_used_node = node;
+		}
+		else
+		{
+			internal_tree->least_recently_used_node = node;
+		}
+		internal_tree->most_recently_used_node = node;
+	}
+	used_node = internal_tree->least_recently_used_node;
+
+	while( ( used_node != NULL )
+	    && ( internal_tree->node_slab->number_of_allocated_elements > internal_tree->maximum_number_of_nodes ) )
+	{
+		result = libfdata_tree_node_sub_nodes_can_be_freed(
+		          used_node,
+		          node,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if sub nodes can be freed.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			used_node = ( (libfdata_internal_tree_node_t *) used_node )->previous_used_node;
+
+			continue;
+		}
+		if( libfdata_tree_node_free_sub_nodes(
+		     used_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sub nodes.",
+			 function );
+
+			return( -1 );
+		}
+		/* Freeing the sub nodes can remove other nodes from the list
+		 */
+		used_node = internal_tree->least_recently_used_node;
+	}
+	return( 1 );
+}
+
+/* Removes the node from the nodes of which the sub nodes were read
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_unset_node_used(
+     libfdata_tree_t *tree,
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_t *internal_tree           = NULL;
+	libfdata_internal_tree_node_t *internal_tree_node = NULL;
+	static char *function                             = "libfdata_tree_unset_node_used";
+
+	if( tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree = (libfdata_internal_tree_t *) tree;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
+	if( internal_tree_node->previous_used_node != NULL )
+	{
+		( (libfdata_internal_tree_node_t *) internal_tree_node->previous_used_node )->next_used_node = internal_tree_node->next_used_node;
+	}
+	else if( internal_tree->most_recently_used_node == node )
+	{
+		internal_tree->most_recently_used_node = internal_tree_node->next_used_node;
+	}
+	else
+	{
+		/* The node is not in the list
+		 */
+		return( 1 );
+	}
+	if( internal_tree_node->next_used_node != NULL )
+	{
+		( (libfdata_internal_tree_node_t *) internal_tree_node->next_used_node )->previous_used_node = internal_tree_node->previous_used_node;
+	}
+	else
+	{
+		internal_tree->least_recently_used_node = internal_tree_node->previous_used_node;
+	}
+	internal_tree_node->previous_used_node = NULL;
+	internal_tree_node->next_used_node     = NULL;
+
+	return( 1 );
+}
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+
+/* Reads the sub tree of a sub node on a worker thread
+ * The sub nodes are read and the leaf nodes are counted
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_read_sub_trees_callback(
+     libfdata_tree_node_t *sub_node,
+     libfdata_tree_read_sub_trees_arguments_t *arguments )
+{
+	libcerror_error_t *error = NULL;
+	libfcache_cache_t *cache = NULL;
+	static char *function    = "libfdata_tree_read_sub_trees_callback";
+	int number_of_leaf_nodes = 0;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	/* The cache is not shared between threads, the node values read
+	 * by the worker thread are only needed to read the sub nodes
+	 */
+	if( libfcache_cache_initialize(
+	     &cache,
+	     arguments->number_of_cache_entries,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_node_get_number_of_leaf_nodes(
+	     sub_node,
+	     arguments->file_io_handle,
+	     cache,
+	     &number_of_leaf_nodes,
+	     arguments->read_flags,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfcache_cache_free(
+	     &cache,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( cache != NULL )
+	{
+		libfcache_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( libcthreads_mutex_grab(
+	     arguments->internal_tree->node_mutex,
+	     NULL ) == 1 )
+	{
+		arguments->number_of_failed_sub_trees += 1;
+
+		libcthreads_mutex_release(
+		 arguments->internal_tree->node_mutex,
+		 NULL );
+	}
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Reads the sub trees of the sub nodes of a node in parallel
+ * The sub trees of which the leaf nodes have not been counted are distributed
+ * over a pool of worker threads. Every worker thread only modifies the nodes
+ * of the sub tree it reads, hence the leaf nodes of the node itself are
+ * counted afterwards on the calling thread.
+ *
+ * The sub trees are not read in parallel if a maximum number of nodes is set,
+ * since freeing sub nodes can affect the sub trees of other threads
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_read_sub_trees_parallel(
+     libfdata_internal_tree_t *internal_tree,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     libfdata_tree_node_t *node,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfdata_tree_read_sub_trees_arguments_t arguments;
+
+	libcthreads_thread_pool_t *thread_pool           = NULL;
+	libfdata_internal_tree_node_t *internal_sub_node = NULL;
+	static char *function                            = "libfdata_tree_read_sub_trees_parallel";
+	int number_of_cache_entries                      = 0;
+	int number_of_sub_nodes                          = 0;
+	int number_of_threads                            = 0;
+	int number_of_unread_sub_trees                   = 0;
+	int pass                                         = 0;
+	int sub_node_index                               = 0;
+
+	if( internal_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_tree->maximum_number_of_nodes != 0 )
+	{
+		return( 1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_tree_node_get_number_of_sub_nodes(
+	     node,
+	     file_io_handle,
+	     cache,
+	     &number_of_sub_nodes,
+	     read_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	/* The first pass determines the number of unread sub trees
+	 * the second pass pushes the unread sub trees onto the thread pool
+	 */
+	for( pass = 0;
+	     pass < 2;
+	     pass++ )
+	{
+		for( sub_node_index = 0;
+		     sub_node_index < number_of_sub_nodes;
+		     sub_node_index++ )
+		{
+			if( libfdata_tree_node_get_sub_node_by_index(
+			     node,
+			     file_io_handle,
+			     cache,
+			     sub_node_index,
+			     (libfdata_tree_node_t **) &internal_sub_node,
+			     read_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve sub node: %d.",
+				 function,
+				 sub_node_index );
+
+				goto on_error;
+			}
+			if( internal_sub_node == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing sub node: %d.",
+				 function,
+				 sub_node_index );
+
+				goto on_error;
+			}
+			/* Leaf nodes and sub trees of which the leaf nodes were counted
+			 * before are not read by a worker thread
+			 */
+			if( ( ( internal_sub_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_LEAF ) != 0 )
+			 || ( ( internal_sub_node->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) == 0 ) )
+			{
+				continue;
+			}
+			if( pass == 0 )
+			{
+				number_of_unread_sub_trees++;
+			}
+			else if( libcthreads_thread_pool_push(
+			          thread_pool,
+			          (intptr_t *) internal_sub_node,
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push sub node: %d onto thread pool.",
+				 function,
+				 sub_node_index );
+
+				goto on_error;
+			}
+		}
+		if( pass != 0 )
+		{
+			break;
+		}
+		/* Only use a thread pool if there are multiple sub trees to read
+		 */
+		if( number_of_unread_sub_trees < 2 )
+		{
+			return( 1 );
+		}
+		number_of_threads = internal_tree->maximum_number_of_threads;
+
+		if( number_of_threads > number_of_unread_sub_trees )
+		{
+			number_of_threads = number_of_unread_sub_trees;
+		}
+		arguments.internal_tree              = internal_tree;
+		arguments.file_io_handle             = file_io_handle;
+		arguments.number_of_cache_entries    = number_of_cache_entries;
+		arguments.read_flags                 = read_flags;
+		arguments.number_of_failed_sub_trees = 0;
+
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     number_of_threads,
+		     number_of_unread_sub_trees,
+		     (int (*)(intptr_t *, void *)) &libfdata_tree_read_sub_trees_callback,
+		     (void *) &arguments,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_thread_pool_join(
+	     &thread_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( arguments.number_of_failed_sub_trees != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read %d sub trees.",
+		 function,
+		 arguments.number_of_failed_sub_trees );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT ) */
+
+/* Retrieves the offset and size of the root node
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_get_root_node(
+     libfdata_tree_t *tree,
+     libfdata_tree_node_t **root_node,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_t *internal_tree = NULL;
+	static char *function                   = "libfdata_tree_get_root_node";
+
+	if( tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree = (libfdata_internal_tree_t *) tree;
+
+	if( root_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid root node.",
+		 function );
+
+		return( -1 );
+	}
+	*root_node = internal_tree->root_node;
+
+	return( 1 );
 }
 
 /* Sets the root node
@@ -1087,6 +2731,29 @@ int libfdata_tree_get_number_of_leaf_nodes(
 	}
 	internal_tree = (libfdata_internal_tree_t *) tree;
 
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( ( internal_tree->maximum_number_of_threads > 1 )
+	 && ( internal_tree->root_node != NULL ) )
+	{
+		if( libfdata_tree_read_sub_trees_parallel(
+		     internal_tree,
+		     file_io_handle,
+		     cache,
+		     internal_tree->root_node,
+		     read_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sub trees.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( libfdata_tree_node_get_number_of_leaf_nodes(
 	     internal_tree->root_node,
 	     file_io_handle,
@@ -1184,6 +2851,29 @@ int libfdata_tree_get_number_of_deleted_leaf_nodes(
 	}
 	internal_tree = (libfdata_internal_tree_t *) tree;
 
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( ( internal_tree->maximum_number_of_threads > 1 )
+	 && ( internal_tree->root_node != NULL ) )
+	{
+		if( libfdata_tree_read_sub_trees_parallel(
+		     internal_tree,
+		     file_io_handle,
+		     cache,
+		     internal_tree->root_node,
+		     read_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sub trees.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( libfdata_tree_node_get_number_of_deleted_leaf_nodes(
 	     internal_tree->root_node,
 	     file_io_handle,
@@ -27,7 +27,9 @@
 
 #include "libfdata_extern.h"
 #include "libfdata_libcerror.h"
+#include "libfdata_libcthreads.h"
 #include "libfdata_libfcache.h"
+#include "libfdata_tree_node_slab.h"
 #include "libfdata_types.h"
 
 #if defined( __cplusplus )
@@ -42,6 +44,33 @@ struct libfdata_internal_tree
 	 */
 	libfdata_tree_node_t *root_node;
 
+	/* The node slab
+	 */
+	libfdata_tree_node_slab_t *node_slab;
+
+	/* The maximum number of nodes
+	 * 0 represents no maximum
+	 */
+	int maximum_number_of_nodes;
+
+	/* The most recently used node of which the sub nodes were read
+	 */
+	libfdata_tree_node_t *most_recently_used_node;
+
+	/* The least recently used node of which the sub nodes were read
+	 */
+	libfdata_tree_node_t *least_recently_used_node;
+
+	/* The maximum number of threads used to read sub trees
+	 */
+	int maximum_number_of_threads;
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	/* The mutex used to serialize access to the node slab
+	 */
+	libcthreads_mutex_t *node_mutex;
+#endif
+
 	/* The flags
 	 */
 	uint8_t flags;
@@ -87,6 +116,21 @@ struct libfdata_internal_tree
                uint8_t read_flags,
 	       libcerror_error_t **error );
 
+	/* The read nodes function
+	 */
+	int (*read_nodes)(
+	       intptr_t *data_handle,
+	       intptr_t *file_io_handle,
+	       libfdata_tree_node_t **nodes,
+	       int number_of_nodes,
+	       libfcache_cache_t *cache,
+	       int nodes_file_index,
+	       off64_t nodes_offset,
+	       size64_t nodes_size,
+	       uint32_t nodes_flags,
+	       uint8_t read_flags,
+	       libcerror_error_t **error );
+
 	/* The read sub nodes function
 	 */
 	int (*read_sub_nodes)(
@@ -102,6 +146,35 @@ struct libfdata_internal_tree
 	       libcerror_error_t **error );
 };
 
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+
+typedef struct libfdata_tree_read_sub_trees_arguments libfdata_tree_read_sub_trees_arguments_t;
+
+struct libfdata_tree_read_sub_trees_arguments
+{
+	/* The tree
+	 */
+	libfdata_internal_tree_t *internal_tree;
+
+	/* The file IO handle
+	 */
+	intptr_t *file_io_handle;
+
+	/* The number of cache entries of the cache used to read a sub tree
+	 */
+	int number_of_cache_entries;
+
+	/* The read flags
+	 */
+	uint8_t read_flags;
+
+	/* The number of sub trees that could not be read
+	 */
+	int number_of_failed_sub_trees;
+};
+
+#endif /* defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT ) */
+
 LIBFDATA_EXTERN \
 int libfdata_tree_initialize(
      libfdata_tree_t **tree,
@@ -149,6 +222,51 @@ int libfdata_tree_clone(
      libfdata_tree_t *source_tree,
      libcerror_error_t **error );
 
+LIBFDATA_EXTERN \
+int libfdata_tree_get_number_of_nodes(
+     libfdata_tree_t *tree,
+     int *number_of_nodes,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_tree_set_maximum_number_of_nodes(
+     libfdata_tree_t *tree,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_tree_set_maximum_number_of_threads(
+     libfdata_tree_t *tree,
+     int maximum_number_of_threads,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_tree_set_read_nodes_function(
+     libfdata_tree_t *tree,
+     int (*read_nodes)(
+            intptr_t *data_handle,
+            intptr_t *file_io_handle,
+            libfdata_tree_node_t **nodes,
+            int number_of_nodes,
+            libfcache_cache_t *cache,
+            int nodes_file_index,
+            off64_t nodes_offset,
+            size64_t nodes_size,
+            uint32_t nodes_flags,
+            uint8_t read_flags,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libfdata_tree_allocate_node_element(
+     libfdata_tree_t *tree,
+     intptr_t **element,
+     libcerror_error_t **error );
+
+int libfdata_tree_free_node_element(
+     libfdata_tree_t *tree,
+     intptr_t *element,
+     libcerror_error_t **error );
+
 /* Node value functions
  */
 int libfdata_tree_get_node_value(
@@ -171,6 +289,19 @@ int libfdata_tree_set_node_value(
      uint8_t flags,
      libcerror_error_t **error );
 
+int libfdata_tree_release_node_value(
+     libfdata_tree_t *tree,
+     libfcache_cache_t *cache,
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error );
+
+int libfdata_tree_is_node_value_cached(
+     libfdata_internal_tree_t *internal_tree,
+     libfcache_cache_t *cache,
+     libfdata_tree_node_t *node,
+     int number_of_cache_entries,
+     libcerror_error_t **error );
+
 /* Sub node functions
  */
 int libfdata_tree_read_sub_nodes(
@@ -181,6 +312,40 @@ int libfdata_tree_read_sub_nodes(
      uint8_t read_flags,
      libcerror_error_t **error );
 
+LIBFDATA_EXTERN \
+int libfdata_tree_read_all_sub_nodes(
+     libfdata_tree_t *tree,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
+int libfdata_tree_set_node_used(
+     libfdata_tree_t *tree,
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error );
+
+int libfdata_tree_unset_node_used(
+     libfdata_tree_t *tree,
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+
+int libfdata_tree_read_sub_trees_callback(
+     libfdata_tree_node_t *sub_node,
+     libfdata_tree_read_sub_trees_arguments_t *arguments );
+
+int libfdata_tree_read_sub_trees_parallel(
+     libfdata_internal_tree_t *internal_tree,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     libfdata_tree_node_t *node,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT ) */
+
 /* Root node functions
  */
 LIBFDATA_EXTERN \
@@ -0,0 +1,609 @@
+/*
+ * The tree iterator functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfdata_definitions.h"
+#include "libfdata_libcerror.h"
+#include "libfdata_libfcache.h"
+#include "libfdata_tree.h"
+#include "libfdata_tree_iterator.h"
+#include "libfdata_tree_node.h"
+#include "libfdata_types.h"
+
+/* The initial number of allocated nodes on the path
+ */
+#define LIBFDATA_TREE_ITERATOR_INITIAL_NUMBER_OF_NODES	16
+
+/* Creates a tree iterator
+ * Make sure the value iterator is referencing, is set to NULL
+ *
+ * The iterator visits the nodes of the tree in pre-order or post-order
+ * and reads the sub nodes on demand. When the iterator leaves a node
+ * the cached node value and the sub nodes of that node are released,
+ * hence only the nodes on the path to the current node and their
+ * direct sub nodes are kept in memory.
+ *
+ * The tree must not be freed before the iterator.
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_iterator_initialize(
+     libfdata_tree_iterator_t **iterator,
+     libfdata_tree_t *tree,
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_iterator_t *internal_iterator = NULL;
+	static char *function                                = "libfdata_tree_iterator_initialize";
+
+	if( iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( *iterator != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid iterator value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( flags & ~( LIBFDATA_TREE_ITERATOR_FLAG_POST_ORDER ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported flags: 0x%02" PRIx8 ".",
+		 function,
+		 flags );
+
+		return( -1 );
+	}
+	internal_iterator = memory_allocate_structure(
+	                     libfdata_internal_tree_iterator_t );
+
+	if( internal_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create iterator.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_iterator,
+	     0,
+	     sizeof( libfdata_internal_tree_iterator_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear iterator.",
+		 function );
+
+		memory_free(
+		 internal_iterator );
+
+		return( -1 );
+	}
+	internal_iterator->nodes = (libfdata_tree_node_t **) memory_allocate(
+	                                                      sizeof( libfdata_tree_node_t * ) * LIBFDATA_TREE_ITERATOR_INITIAL_NUMBER_OF_NODES );
+
+	if( internal_iterator->nodes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create nodes.",
+		 function );
+
+		goto on_error;
+	}
+	internal_iterator->sub_node_indexes = (int *) memory_allocate(
+	                                               sizeof( int ) * LIBFDATA_TREE_ITERATOR_INITIAL_NUMBER_OF_NODES );
+
+	if( internal_iterator->sub_node_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sub node indexes.",
+		 function );
+
+		goto on_error;
+	}
+	internal_iterator->tree                      = tree;
+	internal_iterator->number_of_allocated_nodes = LIBFDATA_TREE_ITERATOR_INITIAL_NUMBER_OF_NODES;
+	internal_iterator->flags                     = flags;
+
+	*iterator = (libfdata_tree_iterator_t *) internal_iterator;
+
+	return( 1 );
+
+on_error:
+	if( internal_iterator != NULL )
+	{
+		if( internal_iterator->nodes != NULL )
+		{
+			memory_free(
+			 internal_iterator->nodes );
+		}
+		memory_free(
+		 internal_iterator );
+	}
+	return( -1 );
+}
+
+/* Frees a tree iterator
+ * The nodes that were not left by the iterator are not released
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_iterator_free(
+     libfdata_tree_iterator_t **iterator,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_iterator_t *internal_iterator = NULL;
+	static char *function                                = "libfdata_tree_iterator_free";
+
+	if( iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( *iterator != NULL )
+	{
+		internal_iterator = (libfdata_internal_tree_iterator_t *) *iterator;
+		*iterator         = NULL;
+
+		memory_free(
+		 internal_iterator->sub_node_indexes );
+
+		memory_free(
+		 internal_iterator->nodes );
+
+		memory_free(
+		 internal_iterator );
+	}
+	return( 1 );
+}
+
+/* Pushes a node onto the path of the iterator
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_iterator_push_node(
+     libfdata_internal_tree_iterator_t *internal_iterator,
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	static char *function         = "libfdata_tree_iterator_push_node";
+	void *reallocation            = NULL;
+	int number_of_allocated_nodes = 0;
+
+	if( internal_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_iterator->number_of_nodes >= internal_iterator->number_of_allocated_nodes )
+	{
+		if( internal_iterator->number_of_allocated_nodes > ( INT_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of allocated nodes value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_allocated_nodes = internal_iterator->number_of_allocated_nodes * 2;
+
+		if( (size_t) number_of_allocated_nodes > ( (size_t) SSIZE_MAX / sizeof( libfdata_tree_node_t * ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid nodes size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                internal_iterator->nodes,
+		                sizeof( libfdata_tree_node_t * ) * number_of_allocated_nodes );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize nodes.",
+			 function );
+
+			return( -1 );
+		}
+		internal_iterator->nodes = (libfdata_tree_node_t **) reallocation;
+
+		reallocation = memory_reallocate(
+		                internal_iterator->sub_node_indexes,
+		                sizeof( int ) * number_of_allocated_nodes );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize sub node indexes.",
+			 function );
+
+			return( -1 );
+		}
+		internal_iterator->sub_node_indexes          = (int *) reallocation;
+		internal_iterator->number_of_allocated_nodes = number_of_allocated_nodes;
+	}
+	internal_iterator->nodes[ internal_iterator->number_of_nodes ]            = node;
+	internal_iterator->sub_node_indexes[ internal_iterator->number_of_nodes ] = 0;
+
+	internal_iterator->number_of_nodes++;
+
+	return( 1 );
+}
+
+/* Releases the cached node value and the sub nodes of a node the iterator has left
+ * Sub nodes that cannot be read again are not freed
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_iterator_release_node(
+     libfdata_internal_tree_iterator_t *internal_iterator,
+     libfcache_cache_t *cache,
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_node_t *internal_tree_node = NULL;
+	static char *function                             = "libfdata_tree_iterator_release_node";
+	int result                                        = 0;
+
+	if( internal_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
+	if( libfdata_tree_release_node_value(
+	     internal_iterator->tree,
+	     cache,
+	     node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release node value.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) != 0 )
+	 || ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_DATA_RANGE_SET ) == 0 )
+	 || ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ ) == 0 ) )
+	{
+		return( 1 );
+	}
+	result = libfdata_tree_node_sub_nodes_can_be_freed(
+	          node,
+	          NULL,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if sub nodes can be freed.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libfdata_tree_node_free_sub_nodes(
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sub nodes.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the next node
+ * The node remains valid until the iterator leaves its parent node
+ * Returns 1 if successful, 0 if no more nodes are available or -1 on error
+ */
+int libfdata_tree_iterator_get_next_node(
+     libfdata_tree_iterator_t *iterator,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     libfdata_tree_node_t **node,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_iterator_t *internal_iterator = NULL;
+	libfdata_tree_node_t *parent_node                    = NULL;
+	libfdata_tree_node_t *sub_node                       = NULL;
+	static char *function                                = "libfdata_tree_iterator_get_next_node";
+	int number_of_sub_nodes                              = 0;
+	int sub_node_index                                   = 0;
+
+	if( iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid iterator.",
+		 function );
+
+		return( -1 );
+	}
+	internal_iterator = (libfdata_internal_tree_iterator_t *) iterator;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_iterator->is_started == 0 )
+	{
+		if( libfdata_tree_get_root_node(
+		     internal_iterator->tree,
+		     &sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve root node.",
+			 function );
+
+			return( -1 );
+		}
+		internal_iterator->is_started = 1;
+
+		if( sub_node == NULL )
+		{
+			return( 0 );
+		}
+		if( libfdata_tree_iterator_push_node(
+		     internal_iterator,
+		     sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push root node.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( internal_iterator->flags & LIBFDATA_TREE_ITERATOR_FLAG_POST_ORDER ) == 0 )
+		{
+			*node = sub_node;
+
+			return( 1 );
+		}
+	}
+	while( internal_iterator->number_of_nodes > 0 )
+	{
+		parent_node    = internal_iterator->nodes[ internal_iterator->number_of_nodes - 1 ];
+		sub_node_index = internal_iterator->sub_node_indexes[ internal_iterator->number_of_nodes - 1 ];
+
+		if( sub_node_index >= 0 )
+		{
+			if( libfdata_tree_node_get_number_of_sub_nodes(
+			     parent_node,
+			     file_io_handle,
+			     cache,
+			     &number_of_sub_nodes,
+			     read_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of sub nodes.",
+				 function );
+
+				return( -1 );
+			}
+			if( sub_node_index < number_of_sub_nodes )
+			{
+				if( libfdata_tree_node_get_sub_node_by_index(
+				     parent_node,
+				     file_io_handle,
+				     cache,
+				     sub_node_index,
+				     &sub_node,
+				     read_flags,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve sub node: %d.",
+					 function,
+					 sub_node_index );
+
+					return( -1 );
+				}
+				internal_iterator->sub_node_indexes[ internal_iterator->number_of_nodes - 1 ] += 1;
+
+				if( libfdata_tree_iterator_push_node(
+				     internal_iterator,
+				     sub_node,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to push sub node: %d.",
+					 function,
+					 sub_node_index );
+
+					return( -1 );
+				}
+				if( ( internal_iterator->flags & LIBFDATA_TREE_ITERATOR_FLAG_POST_ORDER ) == 0 )
+				{
+					*node = sub_node;
+
+					return( 1 );
+				}
+				continue;
+			}
+			/* All sub nodes have been visited, in post-order the node is
+			 * returned first and released on the next call
+			 */
+			if( ( internal_iterator->flags & LIBFDATA_TREE_ITERATOR_FLAG_POST_ORDER ) != 0 )
+			{
+				internal_iterator->sub_node_indexes[ internal_iterator->number_of_nodes - 1 ] = -1;
+
+				*node = parent_node;
+
+				return( 1 );
+			}
+		}
+		if( libfdata_tree_iterator_release_node(
+		     internal_iterator,
+		     cache,
+		     parent_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release node.",
+			 function );
+
+			return( -1 );
+		}
+		internal_iterator->number_of_nodes -= 1;
+	}
+	return( 0 );
+}
+
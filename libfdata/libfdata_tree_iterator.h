@@ -0,0 +1,108 @@
+/*
+ * The tree iterator functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFDATA_INTERNAL_TREE_ITERATOR_H )
+#define _LIBFDATA_INTERNAL_TREE_ITERATOR_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfdata_extern.h"
+#include "libfdata_libcerror.h"
+#include "libfdata_libfcache.h"
+#include "libfdata_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfdata_internal_tree_iterator libfdata_internal_tree_iterator_t;
+
+struct libfdata_internal_tree_iterator
+{
+	/* The tree
+	 */
+	libfdata_tree_t *tree;
+
+	/* The nodes on the path from the root node to the current node
+	 */
+	libfdata_tree_node_t **nodes;
+
+	/* The index of the next sub node to visit per node on the path
+	 * -1 if the node was returned after its sub nodes
+	 */
+	int *sub_node_indexes;
+
+	/* The number of allocated nodes on the path
+	 */
+	int number_of_allocated_nodes;
+
+	/* The number of nodes on the path
+	 */
+	int number_of_nodes;
+
+	/* The flags
+	 */
+	uint8_t flags;
+
+	/* Value to indicate the iteration has started
+	 */
+	uint8_t is_started;
+};
+
+LIBFDATA_EXTERN \
+int libfdata_tree_iterator_initialize(
+     libfdata_tree_iterator_t **iterator,
+     libfdata_tree_t *tree,
+     uint8_t flags,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_tree_iterator_free(
+     libfdata_tree_iterator_t **iterator,
+     libcerror_error_t **error );
+
+int libfdata_tree_iterator_push_node(
+     libfdata_internal_tree_iterator_t *internal_iterator,
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error );
+
+int libfdata_tree_iterator_release_node(
+     libfdata_internal_tree_iterator_t *internal_iterator,
+     libfcache_cache_t *cache,
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_tree_iterator_get_next_node(
+     libfdata_tree_iterator_t *iterator,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     libfdata_tree_node_t **node,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFDATA_INTERNAL_TREE_ITERATOR_H ) */
+
@@ -28,6 +28,7 @@
 #include "libfdata_libcerror.h"
 #include "libfdata_libfcache.h"
 #include "libfdata_range.h"
+#include "libfdata_tree.h"
 #include "libfdata_tree_node.h"
 #include "libfdata_types.h"
 
@@ -77,10 +78,12 @@ int libfdata_tree_node_initialize(
 
 		return( -1 );
 	}
-	internal_tree_node = memory_allocate_structure(
-	                      libfdata_internal_tree_node_t );
-
-	if( internal_tree_node == NULL )
+	/* The node is allocated from the node slab of the tree and is cleared
+	 */
+	if( libfdata_tree_allocate_node_element(
+	     tree,
+	     (intptr_t **) &internal_tree_node,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -89,51 +92,13 @@ int libfdata_tree_node_initialize(
 		 "%s: unable to create node.",
 		 function );
 
-		goto on_error;
-	}
-	if( memory_set(
-	     internal_tree_node,
-	     0,
-	     sizeof( libfdata_internal_tree_node_t ) ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear node.",
-		 function );
-
-		memory_free(
-		 internal_tree_node );
-
 		return( -1 );
 	}
-	if( libfdata_range_initialize(
-	     &( internal_tree_node->node_data_range ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create node data range.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfdata_range_initialize(
-	     &( internal_tree_node->sub_nodes_data_range ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sub nodes data range.",
-		 function );
+	internal_tree_node->node_data_range.file_index      = -1;
+	internal_tree_node->node_data_range.offset          = (off64_t) -1;
+	internal_tree_node->sub_nodes_data_range.file_index = -1;
+	internal_tree_node->sub_nodes_data_range.offset     = (off64_t) -1;
 
-		goto on_error;
-	}
 	if( libcdata_array_initialize(
 	     &( internal_tree_node->sub_nodes ),
 	     0,
@@ -179,20 +144,10 @@ on_error:
 			 NULL,
 			 NULL );
 		}
-		if( internal_tree_node->sub_nodes_data_range != NULL )
-		{
-			libfdata_range_free(
-			 &( internal_tree_node->sub_nodes_data_range ),
-			 NULL );
-		}
-		if( internal_tree_node->node_data_range != NULL )
-		{
-			libfdata_range_free(
-			 &( internal_tree_node->node_data_range ),
-			 NULL );
-		}
-		memory_free(
-		 internal_tree_node );
+		libfdata_tree_free_node_element(
+		 tree,
+		 (intptr_t *) internal_tree_node,
+		 NULL );
 	}
 	return( -1 );
 }
@@ -208,6 +163,10 @@ int libfdata_tree_node_free(
 	static char *function                             = "libfdata_tree_node_free";
 	int result                                        = 1;
 
+	int (*free_sub_node)(
+	       intptr_t **sub_node,
+	       libcerror_error_t **error ) = NULL;
+
 	if( node == NULL )
 	{
 		libcerror_error_set(
@@ -224,54 +183,86 @@ int libfdata_tree_node_free(
 		internal_tree_node = (libfdata_internal_tree_node_t *) *node;
 		*node              = NULL;
 
-		if( internal_tree_node->node_data_range != NULL )
+		if( libfdata_tree_unset_node_used(
+		     internal_tree_node->tree,
+		     (libfdata_tree_node_t *) internal_tree_node,
+		     error ) != 1 )
 		{
-			if( libfdata_range_free(
-			     &( internal_tree_node->node_data_range ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free node data range.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to unset node used.",
+			 function );
 
-				result = -1;
-			}
+			result = -1;
+		}
+		/* The split sub nodes are freed by the node of which the sub nodes were split
+		 */
+		if( libfdata_tree_node_has_split_sub_nodes( internal_tree_node ) )
+		{
+			free_sub_node = NULL;
+		}
+		else
+		{
+			free_sub_node = (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_tree_node_free;
 		}
-		if( internal_tree_node->sub_nodes_data_range != NULL )
+		if( libcdata_array_free(
+		     &( internal_tree_node->sub_nodes ),
+		     free_sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free the sub nodes array.",
+			 function );
+
+			result = -1;
+		}
+		if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) == 0 )
+		 && ( internal_tree_node->split_sub_nodes != NULL ) )
 		{
-			if( libfdata_range_free(
-			     &( internal_tree_node->sub_nodes_data_range ),
+			if( libcdata_array_free(
+			     &( internal_tree_node->split_sub_nodes ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_tree_node_free,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free sub nodes data range.",
+				 "%s: unable to free the split sub nodes array.",
 				 function );
 
 				result = -1;
 			}
 		}
-		if( libcdata_array_free(
-		     &( internal_tree_node->sub_nodes ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_tree_node_free,
+		if( internal_tree_node->cumulative_leaf_node_counts != NULL )
+		{
+			memory_free(
+			 internal_tree_node->cumulative_leaf_node_counts );
+		}
+		if( internal_tree_node->deleted_sub_node_indexes != NULL )
+		{
+			memory_free(
+			 internal_tree_node->deleted_sub_node_indexes );
+		}
+		if( libfdata_tree_free_node_element(
+		     internal_tree_node->tree,
+		     (intptr_t *) internal_tree_node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free the sub nodes array.",
+			 "%s: unable to free node.",
 			 function );
 
 			result = -1;
 		}
-		memory_free(
-		 internal_tree_node );
 	}
 	return( result );
 }
@@ -300,9 +291,23 @@ int libfdata_tree_node_free_single(
 	}
 	if( *node != NULL )
 	{
-		internal_tree_node = (libfdata_internal_tree_node_t *) node;
+		internal_tree_node = (libfdata_internal_tree_node_t *) *node;
 		*node              = NULL;
 
+		if( libfdata_tree_unset_node_used(
+		     internal_tree_node->tree,
+		     (libfdata_tree_node_t *) internal_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to unset node used.",
+			 function );
+
+			result = -1;
+		}
 		if( libcdata_array_free(
 		     &( internal_tree_node->sub_nodes ),
 		     NULL,
@@ -317,198 +322,389 @@ int libfdata_tree_node_free_single(
 
 			result = -1;
 		}
-		memory_free(
-		 internal_tree_node );
+		if( internal_tree_node->cumulative_leaf_node_counts != NULL )
+		{
+			memory_free(
+			 internal_tree_node->cumulative_leaf_node_counts );
+		}
+		if( internal_tree_node->deleted_sub_node_indexes != NULL )
+		{
+			memory_free(
+			 internal_tree_node->deleted_sub_node_indexes );
+		}
+		if( libfdata_tree_free_node_element(
+		     internal_tree_node->tree,
+		     (intptr_t *) internal_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free node.",
+			 function );
+
+			result = -1;
+		}
 	}
 	return( result );
 }
 
-/* Sets the parent node
+/* Clones (duplicates) the node and the sub nodes that have been read
+ * The destination node is created in the destination tree
+ * The virtual sub nodes are not cloned but created again from the split sub nodes
  * Returns 1 if successful or -1 on error
  */
-int libfdata_tree_node_set_parent_node(
-     libfdata_tree_node_t *node,
-     libfdata_tree_node_t *parent_node,
+int libfdata_tree_node_clone(
+     libfdata_tree_node_t **destination_node,
+     libfdata_tree_node_t *source_node,
+     libfdata_tree_t *destination_tree,
+     libfdata_tree_node_t *destination_parent_node,
      libcerror_error_t **error )
 {
-	libfdata_internal_tree_node_t *internal_tree_node = NULL;
-	static char *function                             = "libfdata_tree_node_set_parent_node";
-
-	if( node == NULL )
+	libcdata_array_t *destination_sub_nodes_array            = NULL;
+	libcdata_array_t *source_sub_nodes_array                 = NULL;
+	libfdata_internal_tree_node_t *internal_destination_node = NULL;
+	libfdata_internal_tree_node_t *internal_source_node      = NULL;
+	libfdata_tree_node_t *destination_sub_node               = NULL;
+	libfdata_tree_node_t *source_sub_node                    = NULL;
+	static char *function                                    = "libfdata_tree_node_clone";
+	size_t deleted_sub_node_indexes_size                     = 0;
+	size_t leaf_node_counts_size                             = 0;
+	int number_of_sub_nodes                                  = 0;
+	int sub_node_index                                       = 0;
+
+	if( destination_node == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid node.",
+		 "%s: invalid destination node.",
 		 function );
 
 		return( -1 );
 	}
-	internal_tree_node = (libfdata_internal_tree_node_t *) node;
-
-	internal_tree_node->parent_node = parent_node;
-
-	return( 1 );
-}
-
-/* Determines if the node is a root node
- * Returns 1 if a root node, 0 if not or -1 on error
- */
-int libfdata_tree_node_is_root(
-     libfdata_tree_node_t *node,
-     libcerror_error_t **error )
-{
-	libfdata_internal_tree_node_t *internal_tree_node = NULL;
-	static char *function                             = "libfdata_tree_node_is_root";
-
-	if( node == NULL )
+	if( *destination_node != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid node.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination node value already set.",
 		 function );
 
 		return( -1 );
 	}
-	internal_tree_node = (libfdata_internal_tree_node_t *) node;
-
-	if( internal_tree_node->parent_node == NULL )
-	{
-		return( 1 );
-	}
-	return( 0 );
-}
-
-/* Retrieves the data offset and size
- * Returns 1 if successful or -1 on error
- */
-int libfdata_tree_node_get_data_range(
-     libfdata_tree_node_t *node,
-     int *node_file_index,
-     off64_t *node_offset,
-     size64_t *node_size,
-     uint32_t *node_flags,
-     libcerror_error_t **error )
-{
-	libfdata_internal_tree_node_t *internal_tree_node = NULL;
-	static char *function                             = "libfdata_tree_node_get_data_range";
-
-	if( node == NULL )
+	if( source_node == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid node.",
+		 "%s: invalid source node.",
 		 function );
 
 		return( -1 );
 	}
-	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+	internal_source_node = (libfdata_internal_tree_node_t *) source_node;
 
-	if( libfdata_range_get(
-	     internal_tree_node->node_data_range,
-	     node_file_index,
-	     node_offset,
-	     node_size,
-	     node_flags,
-	     error ) != 1 )
+	if( ( internal_source_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve node data range.",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid source node - node is virtual.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-}
-
-/* Sets the data offset and size
- * Returns 1 if successful or -1 on error
- */
-int libfdata_tree_node_set_data_range(
-     libfdata_tree_node_t *node,
-     int node_file_index,
-     off64_t node_offset,
-     size64_t node_size,
-     uint32_t node_flags,
-     libcerror_error_t **error )
-{
-	libfdata_internal_tree_node_t *internal_tree_node = NULL;
-	static char *function                             = "libfdata_tree_node_set_data_range";
-
-	if( node == NULL )
+	if( libfdata_tree_node_initialize(
+	     destination_node,
+	     destination_tree,
+	     destination_parent_node,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid node.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination node.",
 		 function );
 
 		return( -1 );
 	}
-	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+	internal_destination_node = (libfdata_internal_tree_node_t *) *destination_node;
+
+	/* The timestamp is copied so that the cached node values can be shared
+	 */
+	internal_destination_node->node_data_range                       = internal_source_node->node_data_range;
+	internal_destination_node->sub_nodes_data_range                  = internal_source_node->sub_nodes_data_range;
+	internal_destination_node->timestamp                             = internal_source_node->timestamp;
+	internal_destination_node->flags                                 = internal_source_node->flags;
+	internal_destination_node->maximum_number_of_virtual_sub_nodes   = internal_source_node->maximum_number_of_virtual_sub_nodes;
+	internal_destination_node->number_of_leaf_nodes                  = internal_source_node->number_of_leaf_nodes;
+	internal_destination_node->number_of_deleted_leaf_nodes          = internal_source_node->number_of_deleted_leaf_nodes;
+	internal_destination_node->first_leaf_node_index                 = internal_source_node->first_leaf_node_index;
+	internal_destination_node->first_deleted_leaf_node_index         = internal_source_node->first_deleted_leaf_node_index;
+	internal_destination_node->is_counted                            = internal_source_node->is_counted;
+	internal_destination_node->last_leaf_node_sub_node_index         = internal_source_node->last_leaf_node_sub_node_index;
+	internal_destination_node->last_deleted_leaf_node_entry_index    = internal_source_node->last_deleted_leaf_node_entry_index;
+
+	if( internal_source_node->split_sub_nodes != NULL )
+	{
+		source_sub_nodes_array = internal_source_node->split_sub_nodes;
+
+		if( libcdata_array_initialize(
+		     &( internal_destination_node->split_sub_nodes ),
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination split sub nodes array.",
+			 function );
 
-	if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) != 0 )
+			goto on_error;
+		}
+		destination_sub_nodes_array = internal_destination_node->split_sub_nodes;
+	}
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid node - node is virtual.",
-		 function );
-
-		return( -1 );
+		source_sub_nodes_array      = internal_source_node->sub_nodes;
+		destination_sub_nodes_array = internal_destination_node->sub_nodes;
 	}
-	if( libfdata_range_set(
-	     internal_tree_node->node_data_range,
-	     node_file_index,
-	     node_offset,
-	     node_size,
-	     node_flags,
+	if( libcdata_array_get_number_of_entries(
+	     source_sub_nodes_array,
+	     &number_of_sub_nodes,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set node data range.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from source sub nodes array.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( libfcache_date_time_get_timestamp(
-	     &( internal_tree_node->timestamp ),
+	if( libcdata_array_resize(
+	     destination_sub_nodes_array,
+	     number_of_sub_nodes,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_tree_node_free,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve cache timestamp.",
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize destination sub nodes array.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	return( 1 );
-}
-
-/* Determines if the sub nodes data range has been set
- * Returns 1 if sub nodes have been set, 0 if not or -1 on error
- */
-int libfdata_tree_node_sub_nodes_data_range_is_set(
-     libfdata_tree_node_t *node,
-     libcerror_error_t **error )
-{
+	for( sub_node_index = 0;
+	     sub_node_index < number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     source_sub_nodes_array,
+		     sub_node_index,
+		     (intptr_t **) &source_sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from source sub nodes array.",
+			 function,
+			 sub_node_index );
+
+			goto on_error;
+		}
+		if( source_sub_node == NULL )
+		{
+			continue;
+		}
+		destination_sub_node = NULL;
+
+		if( libfdata_tree_node_clone(
+		     &destination_sub_node,
+		     source_sub_node,
+		     destination_tree,
+		     *destination_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			goto on_error;
+		}
+		if( libcdata_array_set_entry_by_index(
+		     destination_sub_nodes_array,
+		     sub_node_index,
+		     (intptr_t *) destination_sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set entry: %d in destination sub nodes array.",
+			 function,
+			 sub_node_index );
+
+			libfdata_tree_node_free(
+			 &destination_sub_node,
+			 NULL );
+
+			goto on_error;
+		}
+		if( internal_source_node->split_sub_nodes != NULL )
+		{
+			( (libfdata_internal_tree_node_t *) destination_sub_node )->is_counted = 0;
+		}
+	}
+	if( internal_source_node->split_sub_nodes != NULL )
+	{
+		/* The virtual sub nodes are created again and their leaf nodes are counted again
+		 */
+		if( libfdata_tree_node_append_virtual_sub_nodes(
+		     *destination_node,
+		     internal_destination_node->sub_nodes,
+		     internal_destination_node->split_sub_nodes,
+		     0,
+		     number_of_sub_nodes,
+		     internal_destination_node->maximum_number_of_virtual_sub_nodes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append virtual sub nodes.",
+			 function );
+
+			goto on_error;
+		}
+		internal_destination_node->number_of_leaf_nodes         = 0;
+		internal_destination_node->number_of_deleted_leaf_nodes = 0;
+		internal_destination_node->flags                       |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+	}
+	else if( internal_source_node->cumulative_leaf_node_counts != NULL )
+	{
+		leaf_node_counts_size = sizeof( libfdata_tree_node_leaf_node_counts_t )
+		                      * internal_source_node->number_of_allocated_cumulative_leaf_node_counts;
+
+		internal_destination_node->cumulative_leaf_node_counts = (libfdata_tree_node_leaf_node_counts_t *) memory_allocate(
+		                                                          leaf_node_counts_size );
+
+		if( internal_destination_node->cumulative_leaf_node_counts == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create cumulative leaf node counts.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     internal_destination_node->cumulative_leaf_node_counts,
+		     internal_source_node->cumulative_leaf_node_counts,
+		     leaf_node_counts_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy cumulative leaf node counts.",
+			 function );
+
+			goto on_error;
+		}
+		deleted_sub_node_indexes_size = sizeof( int )
+		                              * internal_source_node->number_of_allocated_cumulative_leaf_node_counts;
+
+		internal_destination_node->deleted_sub_node_indexes = (int *) memory_allocate(
+		                                                       deleted_sub_node_indexes_size );
+
+		if( internal_destination_node->deleted_sub_node_indexes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create deleted sub node indexes.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     internal_destination_node->deleted_sub_node_indexes,
+		     internal_source_node->deleted_sub_node_indexes,
+		     deleted_sub_node_indexes_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy deleted sub node indexes.",
+			 function );
+
+			goto on_error;
+		}
+		internal_destination_node->number_of_allocated_cumulative_leaf_node_counts = internal_source_node->number_of_allocated_cumulative_leaf_node_counts;
+		internal_destination_node->number_of_counted_sub_nodes                     = internal_source_node->number_of_counted_sub_nodes;
+		internal_destination_node->number_of_deleted_sub_node_indexes              = internal_source_node->number_of_deleted_sub_node_indexes;
+	}
+	/* The node is marked as used after its sub nodes were cloned
+	 * so that the maximum number of nodes of the destination tree is maintained
+	 */
+	if( libfdata_tree_set_node_used(
+	     destination_tree,
+	     *destination_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set node used.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	libfdata_tree_node_free(
+	 destination_node,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Sets the parent node
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_node_set_parent_node(
+     libfdata_tree_node_t *node,
+     libfdata_tree_node_t *parent_node,
+     libcerror_error_t **error )
+{
 	libfdata_internal_tree_node_t *internal_tree_node = NULL;
-	static char *function                             = "libfdata_tree_node_sub_nodes_data_range_is_set";
+	static char *function                             = "libfdata_tree_node_set_parent_node";
 
 	if( node == NULL )
 	{
@@ -523,26 +719,20 @@ int libfdata_tree_node_sub_nodes_data_range_is_set(
 	}
 	internal_tree_node = (libfdata_internal_tree_node_t *) node;
 
-	if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_DATA_RANGE_SET ) != 0 )
-	{
-		return( 1 );
-	}
-	return( 0 );
+	internal_tree_node->parent_node = parent_node;
+
+	return( 1 );
 }
 
-/* Retrieves the sub nodes data range
- * Returns 1 if successful or -1 on error
+/* Determines if the node is a root node
+ * Returns 1 if a root node, 0 if not or -1 on error
  */
-int libfdata_tree_node_get_sub_nodes_data_range(
+int libfdata_tree_node_is_root(
      libfdata_tree_node_t *node,
-     int *sub_nodes_file_index,
-     off64_t *sub_nodes_offset,
-     size64_t *sub_nodes_size,
-     uint32_t *sub_nodes_flags,
      libcerror_error_t **error )
 {
 	libfdata_internal_tree_node_t *internal_tree_node = NULL;
-	static char *function                             = "libfdata_tree_node_get_sub_nodes_data_range";
+	static char *function                             = "libfdata_tree_node_is_root";
 
 	if( node == NULL )
 	{
@@ -557,30 +747,53 @@ int libfdata_tree_node_get_sub_nodes_data_range(
 	}
 	internal_tree_node = (libfdata_internal_tree_node_t *) node;
 
-	if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_DATA_RANGE_SET ) == 0 )
+	if( internal_tree_node->parent_node == NULL )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the data offset and size
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_node_get_data_range(
+     libfdata_tree_node_t *node,
+     int *node_file_index,
+     off64_t *node_offset,
+     size64_t *node_size,
+     uint32_t *node_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_node_t *internal_tree_node = NULL;
+	static char *function                             = "libfdata_tree_node_get_data_range";
+
+	if( node == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid node - sub nodes range has not been set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
 		 function );
 
 		return( -1 );
 	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
 	if( libfdata_range_get(
-	     internal_tree_node->sub_nodes_data_range,
-	     sub_nodes_file_index,
-	     sub_nodes_offset,
-	     sub_nodes_size,
-	     sub_nodes_flags,
+	     &( internal_tree_node->node_data_range ),
+	     node_file_index,
+	     node_offset,
+	     node_size,
+	     node_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve sub nodes data range.",
+		 "%s: unable to retrieve node data range.",
 		 function );
 
 		return( -1 );
@@ -588,20 +801,19 @@ int libfdata_tree_node_get_sub_nodes_data_range(
 	return( 1 );
 }
 
-/* Sets the sub nodes data range
- * The sub nodes data range cannot be set after the sub nodes have been read
+/* Sets the data offset and size
  * Returns 1 if successful or -1 on error
  */
-int libfdata_tree_node_set_sub_nodes_data_range(
+int libfdata_tree_node_set_data_range(
      libfdata_tree_node_t *node,
-     int sub_nodes_file_index,
-     off64_t sub_nodes_offset,
-     size64_t sub_nodes_size,
-     uint32_t sub_nodes_flags,
+     int node_file_index,
+     off64_t node_offset,
+     size64_t node_size,
+     uint32_t node_flags,
      libcerror_error_t **error )
 {
 	libfdata_internal_tree_node_t *internal_tree_node = NULL;
-	static char *function                             = "libfdata_tree_node_set_sub_nodes_data_range";
+	static char *function                             = "libfdata_tree_node_set_data_range";
 
 	if( node == NULL )
 	{
@@ -627,61 +839,48 @@ int libfdata_tree_node_set_sub_nodes_data_range(
 
 		return( -1 );
 	}
-	if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) == 0 )
-	 && ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_LEAF ) != 0 ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid node - node is a leaf.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ ) != 0 )
+	if( libfdata_range_set(
+	     &( internal_tree_node->node_data_range ),
+	     node_file_index,
+	     node_offset,
+	     node_size,
+	     node_flags,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid node - sub nodes range has already been read.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set node data range.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfdata_range_set(
-	     internal_tree_node->sub_nodes_data_range,
-	     sub_nodes_file_index,
-	     sub_nodes_offset,
-	     sub_nodes_size,
-	     sub_nodes_flags,
+	if( libfcache_date_time_get_timestamp(
+	     &( internal_tree_node->timestamp ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set sub nodes data range.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache timestamp.",
 		 function );
 
 		return( -1 );
 	}
-	internal_tree_node->flags |= LIBFDATA_TREE_NODE_FLAG_SUB_NODES_DATA_RANGE_SET;
-
 	return( 1 );
 }
 
-/* Retrieves the time stamp
- * Returns 1 if successful or -1 on error
+/* Determines if the sub nodes data range has been set
+ * Returns 1 if sub nodes have been set, 0 if not or -1 on error
  */
-int libfdata_tree_node_get_timestamp(
+int libfdata_tree_node_sub_nodes_data_range_is_set(
      libfdata_tree_node_t *node,
-     time_t *timestamp,
      libcerror_error_t **error )
 {
 	libfdata_internal_tree_node_t *internal_tree_node = NULL;
-	static char *function                             = "libfdata_tree_node_get_timestamp";
+	static char *function                             = "libfdata_tree_node_sub_nodes_data_range_is_set";
 
 	if( node == NULL )
 	{
@@ -696,16 +895,239 @@ int libfdata_tree_node_get_timestamp(
 	}
 	internal_tree_node = (libfdata_internal_tree_node_t *) node;
 
-	if( timestamp == NULL )
+	if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_DATA_RANGE_SET ) != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid node time stamp.",
-		 function );
-
-		return( -1 );
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the sub nodes data range
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_node_get_sub_nodes_data_range(
+     libfdata_tree_node_t *node,
+     int *sub_nodes_file_index,
+     off64_t *sub_nodes_offset,
+     size64_t *sub_nodes_size,
+     uint32_t *sub_nodes_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_node_t *internal_tree_node = NULL;
+	static char *function                             = "libfdata_tree_node_get_sub_nodes_data_range";
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
+	if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_DATA_RANGE_SET ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid node - sub nodes range has not been set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_range_get(
+	     &( internal_tree_node->sub_nodes_data_range ),
+	     sub_nodes_file_index,
+	     sub_nodes_offset,
+	     sub_nodes_size,
+	     sub_nodes_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub nodes data range.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the sub nodes data range
+ * The sub nodes data range cannot be set after the sub nodes have been read
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_node_set_sub_nodes_data_range(
+     libfdata_tree_node_t *node,
+     int sub_nodes_file_index,
+     off64_t sub_nodes_offset,
+     size64_t sub_nodes_size,
+     uint32_t sub_nodes_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_node_t *internal_tree_node = NULL;
+	static char *function                             = "libfdata_tree_node_set_sub_nodes_data_range";
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
+	if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid node - node is virtual.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) == 0 )
+	 && ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_LEAF ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid node - node is a leaf.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid node - sub nodes range has already been read.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_range_set(
+	     &( internal_tree_node->sub_nodes_data_range ),
+	     sub_nodes_file_index,
+	     sub_nodes_offset,
+	     sub_nodes_size,
+	     sub_nodes_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set sub nodes data range.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node->flags |= LIBFDATA_TREE_NODE_FLAG_SUB_NODES_DATA_RANGE_SET;
+
+	return( 1 );
+}
+
+/* Compares the data ranges of two nodes by file index and offset
+ * Returns -1 if the data of the first node is stored before that of the second node,
+ * 1 if after or 0 if at the same offset
+ */
+int libfdata_tree_node_compare_data_ranges(
+     const libfdata_tree_node_t **first_node,
+     const libfdata_tree_node_t **second_node )
+{
+	const libfdata_range_t *first_range  = NULL;
+	const libfdata_range_t *second_range = NULL;
+
+	first_range  = &( ( (const libfdata_internal_tree_node_t *) *first_node )->node_data_range );
+	second_range = &( ( (const libfdata_internal_tree_node_t *) *second_node )->node_data_range );
+
+	if( first_range->file_index != second_range->file_index )
+	{
+		return( ( first_range->file_index < second_range->file_index ) ? -1 : 1 );
+	}
+	if( first_range->offset != second_range->offset )
+	{
+		return( ( first_range->offset < second_range->offset ) ? -1 : 1 );
+	}
+	return( 0 );
+}
+
+/* Compares the sub nodes data ranges of two nodes by file index and offset
+ * Returns -1 if the sub nodes data of the first node is stored before that of the second node,
+ * 1 if after or 0 if at the same offset
+ */
+int libfdata_tree_node_compare_sub_nodes_data_ranges(
+     const libfdata_tree_node_t **first_node,
+     const libfdata_tree_node_t **second_node )
+{
+	const libfdata_range_t *first_range  = NULL;
+	const libfdata_range_t *second_range = NULL;
+
+	first_range  = &( ( (const libfdata_internal_tree_node_t *) *first_node )->sub_nodes_data_range );
+	second_range = &( ( (const libfdata_internal_tree_node_t *) *second_node )->sub_nodes_data_range );
+
+	if( first_range->file_index != second_range->file_index )
+	{
+		return( ( first_range->file_index < second_range->file_index ) ? -1 : 1 );
+	}
+	if( first_range->offset != second_range->offset )
+	{
+		return( ( first_range->offset < second_range->offset ) ? -1 : 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the time stamp
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_node_get_timestamp(
+     libfdata_tree_node_t *node,
+     time_t *timestamp,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_node_t *internal_tree_node = NULL;
+	static char *function                             = "libfdata_tree_node_get_timestamp";
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node time stamp.",
+		 function );
+
+		return( -1 );
 	}
 	*timestamp = internal_tree_node->timestamp;
 
@@ -959,6 +1381,17 @@ int libfdata_tree_node_resize_sub_nodes(
 
 		return( -1 );
 	}
+	if( internal_tree_node->split_sub_nodes != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid node - sub nodes have been split lazily.",
+		 function );
+
+		return( -1 );
+	}
 	if( libcdata_array_resize(
 	     internal_tree_node->sub_nodes,
 	     number_of_sub_nodes,
@@ -1054,6 +1487,36 @@ int libfdata_tree_node_get_number_of_sub_nodes(
 		}
 		internal_tree_node->flags |= LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ;
 	}
+	else if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ ) == 0 )
+	{
+		if( libfdata_tree_node_read_virtual_sub_nodes(
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read virtual sub nodes.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libfdata_tree_set_node_used(
+	     internal_tree_node->tree,
+	     node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set node used.",
+		 function );
+
+		return( -1 );
+	}
 	if( libcdata_array_get_number_of_entries(
 	     internal_tree_node->sub_nodes,
 	     number_of_sub_nodes,
@@ -1071,21 +1534,20 @@ int libfdata_tree_node_get_number_of_sub_nodes(
 	return( 1 );
 }
 
-/* Retrieves a specific sub node
+/* Frees the sub nodes
+ * The sub nodes are read again when needed
  * Returns 1 if successful or -1 on error
  */
-int libfdata_tree_node_get_sub_node_by_index(
+int libfdata_tree_node_free_sub_nodes(
      libfdata_tree_node_t *node,
-     intptr_t *file_io_handle,
-     libfcache_cache_t *cache,
-     int sub_node_index,
-     libfdata_tree_node_t **sub_node,
-     uint8_t read_flags,
      libcerror_error_t **error )
 {
 	libfdata_internal_tree_node_t *internal_tree_node = NULL;
-	intptr_t *node_value                              = NULL;
-	static char *function                             = "libfdata_tree_node_get_sub_node_by_index";
+	static char *function                             = "libfdata_tree_node_free_sub_nodes";
+
+	int (*free_sub_node)(
+	       intptr_t **sub_node,
+	       libcerror_error_t **error ) = NULL;
 
 	if( node == NULL )
 	{
@@ -1100,22 +1562,196 @@ int libfdata_tree_node_get_sub_node_by_index(
 	}
 	internal_tree_node = (libfdata_internal_tree_node_t *) node;
 
-	if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) == 0 )
-	 && ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_LEAF ) != 0 ) )
+	if( libfdata_tree_unset_node_used(
+	     internal_tree_node->tree,
+	     node,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid node - node is a leaf.",
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to unset node used.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) == 0 )
-	 && ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ ) == 0 ) )
+	/* The split sub nodes are freed by the node of which the sub nodes were split
+	 */
+	if( libfdata_tree_node_has_split_sub_nodes( internal_tree_node ) )
 	{
-		/* Make sure the node data is read before the sub nodes
+		free_sub_node = NULL;
+	}
+	else
+	{
+		free_sub_node = (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_tree_node_free;
+	}
+	/* The leaf node counts are kept since they do not change
+	 * when the sub nodes are read again
+	 */
+	if( libcdata_array_empty(
+	     internal_tree_node->sub_nodes,
+	     free_sub_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty sub nodes array.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) == 0 )
+	 && ( internal_tree_node->split_sub_nodes != NULL ) )
+	{
+		if( libcdata_array_free(
+		     &( internal_tree_node->split_sub_nodes ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_tree_node_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free split sub nodes array.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	internal_tree_node->flags &= ~( LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ );
+
+	return( 1 );
+}
+
+/* Determines if the sub nodes of a node can be freed
+ * The sub nodes of the node cannot be freed if they cannot be read again,
+ * or if the node is the node that is in use or one of its parent nodes
+ * Returns 1 if the sub nodes can be freed, 0 if not or -1 on error
+ */
+int libfdata_tree_node_sub_nodes_can_be_freed(
+     libfdata_tree_node_t *node,
+     libfdata_tree_node_t *node_in_use,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_node_t *internal_tree_node = NULL;
+	libfdata_tree_node_t *parent_node                 = NULL;
+	libfdata_tree_node_t *sub_node                    = NULL;
+	static char *function                             = "libfdata_tree_node_sub_nodes_can_be_freed";
+	int number_of_sub_nodes                           = 0;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
+	for( parent_node = node_in_use;
+	     parent_node != NULL;
+	     parent_node = ( (libfdata_internal_tree_node_t *) parent_node )->parent_node )
+	{
+		if( parent_node == node )
+		{
+			return( 0 );
+		}
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_tree_node->sub_nodes,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from sub nodes array.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sub_nodes > 0 )
+	{
+		/* Virtual sub nodes are the result of splitting the sub nodes
+		 * and are not created when the sub nodes are read again
+		 */
+		if( libcdata_array_get_entry_by_index(
+		     internal_tree_node->sub_nodes,
+		     0,
+		     (intptr_t **) &sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: 0 from sub nodes array.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( sub_node != NULL )
+		 && ( ( ( (libfdata_internal_tree_node_t *) sub_node )->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) != 0 ) )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific sub node
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_node_get_sub_node_by_index(
+     libfdata_tree_node_t *node,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     int sub_node_index,
+     libfdata_tree_node_t **sub_node,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_node_t *internal_tree_node = NULL;
+	intptr_t *node_value                              = NULL;
+	static char *function                             = "libfdata_tree_node_get_sub_node_by_index";
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
+	if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) == 0 )
+	 && ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_LEAF ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid node - node is a leaf.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) == 0 )
+	 && ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ ) == 0 ) )
+	{
+		/* Make sure the node data is read before the sub nodes
 		 */
 		if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_NOTE_DATA_READ ) == 0 )
 		{
@@ -1161,6 +1797,36 @@ int libfdata_tree_node_get_sub_node_by_index(
 		}
 		internal_tree_node->flags |= LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ;
 	}
+	else if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ ) == 0 )
+	{
+		if( libfdata_tree_node_read_virtual_sub_nodes(
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read virtual sub nodes.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libfdata_tree_set_node_used(
+	     internal_tree_node->tree,
+	     node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set node used.",
+		 function );
+
+		return( -1 );
+	}
 	if( libcdata_array_get_entry_by_index(
 	     internal_tree_node->sub_nodes,
 	     sub_node_index,
@@ -1225,6 +1891,17 @@ int libfdata_tree_node_set_sub_node_by_index(
 
 		return( -1 );
 	}
+	if( internal_tree_node->split_sub_nodes != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid node - sub nodes have been split lazily.",
+		 function );
+
+		return( -1 );
+	}
 	if( libcdata_array_get_entry_by_index(
 	     internal_tree_node->sub_nodes,
 	     sub_node_index,
@@ -1362,6 +2039,17 @@ int libfdata_tree_node_append_sub_node(
 
 		return( -1 );
 	}
+	if( internal_tree_node->split_sub_nodes != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid node - sub nodes have been split lazily.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfdata_tree_node_initialize(
 	     &sub_node,
 	     internal_tree_node->tree,
@@ -1496,6 +2184,17 @@ int libfdata_tree_node_insert_sub_node(
 
 		return( -1 );
 	}
+	if( internal_tree_node->split_sub_nodes != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid node - sub nodes have been split lazily.",
+		 function );
+
+		return( -1 );
+	}
 	if( node_value_compare_function == NULL )
 	{
 		libcerror_error_set(
@@ -1845,6 +2544,7 @@ on_error:
 }
 
 /* Splits the sub nodes
+ * The sub nodes are moved into number of splits virtual sub nodes
  * Returns 1 if successful or -1 on error
  */
 int libfdata_tree_node_split_sub_nodes(
@@ -1890,6 +2590,17 @@ int libfdata_tree_node_split_sub_nodes(
 
 		return( -1 );
 	}
+	if( internal_tree_node->split_sub_nodes != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid node - sub nodes have been split lazily.",
+		 function );
+
+		return( -1 );
+	}
 	if( number_of_splits < 0 )
 	{
 		libcerror_error_set(
@@ -1933,6 +2644,21 @@ int libfdata_tree_node_split_sub_nodes(
 
 		return( -1 );
 	}
+	/* The leaf nodes are counted again per virtual sub node
+	 */
+	if( libfdata_tree_node_reset_leaf_node_values(
+	     node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reset leaf node values.",
+		 function );
+
+		return( -1 );
+	}
 	if( libcdata_array_initialize(
 	     &virtual_sub_nodes_array,
 	     number_of_splits,
@@ -2083,33 +2809,14 @@ int libfdata_tree_node_split_sub_nodes(
 
 					break;
 				}
-				if( ( (libfdata_internal_tree_node_t *) sub_node )->node_data_range == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: invalid sub node: %d - missing node data range.",
-					 function,
-					 sub_node_index );
-
-					libcdata_array_free(
-					 &virtual_sub_nodes_array,
-					 (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_tree_node_free_single,
-					 NULL );
-
-					result = -1;
-
-					break;
-				}
 				/* The node data range of a virtual node cannot be set by the set_data_range function
 				 */
 				if( libfdata_tree_node_get_data_range(
 			             sub_node,
-			             &( ( (libfdata_internal_tree_node_t *) virtual_sub_node )->node_data_range->file_index ),
-			             &( ( (libfdata_internal_tree_node_t *) virtual_sub_node )->node_data_range->offset ),
-			             &( ( (libfdata_internal_tree_node_t *) virtual_sub_node )->node_data_range->size ),
-			             &( ( (libfdata_internal_tree_node_t *) virtual_sub_node )->node_data_range->flags ),
+			             &( ( (libfdata_internal_tree_node_t *) virtual_sub_node )->node_data_range.file_index ),
+			             &( ( (libfdata_internal_tree_node_t *) virtual_sub_node )->node_data_range.offset ),
+			             &( ( (libfdata_internal_tree_node_t *) virtual_sub_node )->node_data_range.size ),
+			             &( ( (libfdata_internal_tree_node_t *) virtual_sub_node )->node_data_range.flags ),
 			             error ) != 1 )
 				{
 					libcerror_error_set(
@@ -2241,15 +2948,24 @@ int libfdata_tree_node_split_sub_nodes(
 	return( result );
 }
 
-/* Determines if the node is deleted
- * Returns 1 if deleted, 0 if not or -1 on error
+/* Splits the sub nodes lazily
+ *
+ * The sub nodes are split in place into a tree of virtual sub nodes, where every
+ * virtual sub node contains at most maximum number of sub nodes sub nodes. The sub
+ * nodes are not copied, the virtual sub nodes reference a range of the split sub
+ * nodes and are created when their sub nodes are first accessed.
+ *
+ * Returns 1 if successful or -1 on error
  */
-int libfdata_tree_node_is_deleted(
+int libfdata_tree_node_split_sub_nodes_lazy(
      libfdata_tree_node_t *node,
+     int maximum_number_of_sub_nodes,
      libcerror_error_t **error )
 {
+	libcdata_array_t *virtual_sub_nodes_array         = NULL;
 	libfdata_internal_tree_node_t *internal_tree_node = NULL;
-	static char *function                             = "libfdata_tree_node_is_deleted";
+	static char *function                             = "libfdata_tree_node_split_sub_nodes_lazy";
+	int number_of_sub_nodes                           = 0;
 
 	if( node == NULL )
 	{
@@ -2264,20 +2980,523 @@ int libfdata_tree_node_is_deleted(
 	}
 	internal_tree_node = (libfdata_internal_tree_node_t *) node;
 
-	if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) == 0 )
-	 && ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_DELETED ) != 0 ) )
+	if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) != 0 )
 	{
-		return( 1 );
-	}
-	return( 0 );
-}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid node - node is virtual.",
+		 function );
 
-/* Marks a node as deleted
- * Returns 1 if successful or -1 on error
- */
-int libfdata_tree_node_set_deleted(
-     libfdata_tree_node_t *node,
-     libcerror_error_t **error )
+		return( -1 );
+	}
+	if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_LEAF ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid node - node is a leaf.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_tree_node->split_sub_nodes != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid node - sub nodes have already been split.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_sub_nodes < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of sub nodes value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_sub_nodes == 0 )
+	{
+		return( 1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_tree_node->sub_nodes,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from sub nodes array.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_sub_nodes / maximum_number_of_sub_nodes ) < 2 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: number of sub nodes too small to split in: %d.",
+		 function,
+		 maximum_number_of_sub_nodes );
+
+		return( -1 );
+	}
+	/* The leaf nodes are counted again per virtual sub node
+	 */
+	if( libfdata_tree_node_reset_leaf_node_values(
+	     node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reset leaf node values.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &virtual_sub_nodes_array,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create virtual sub nodes array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_node_append_virtual_sub_nodes(
+	     node,
+	     virtual_sub_nodes_array,
+	     internal_tree_node->sub_nodes,
+	     0,
+	     number_of_sub_nodes,
+	     maximum_number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append virtual sub nodes.",
+		 function );
+
+		goto on_error;
+	}
+	internal_tree_node->split_sub_nodes                     = internal_tree_node->sub_nodes;
+	internal_tree_node->sub_nodes                           = virtual_sub_nodes_array;
+	internal_tree_node->maximum_number_of_virtual_sub_nodes = maximum_number_of_sub_nodes;
+
+	return( 1 );
+
+on_error:
+	if( virtual_sub_nodes_array != NULL )
+	{
+		libcdata_array_free(
+		 &virtual_sub_nodes_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_tree_node_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Appends virtual sub nodes for a range of split sub nodes
+ * The range is divided in at most maximum number of virtual sub nodes of equal size
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_node_append_virtual_sub_nodes(
+     libfdata_tree_node_t *node,
+     libcdata_array_t *virtual_sub_nodes_array,
+     libcdata_array_t *split_sub_nodes,
+     int first_split_sub_node_index,
+     int number_of_split_sub_nodes,
+     int maximum_number_of_virtual_sub_nodes,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_node_t *internal_tree_node    = NULL;
+	libfdata_internal_tree_node_t *internal_virtual_node = NULL;
+	libfdata_tree_node_t *sub_node                       = NULL;
+	libfdata_tree_node_t *virtual_sub_node               = NULL;
+	static char *function                                = "libfdata_tree_node_append_virtual_sub_nodes";
+	int entry_index                                      = 0;
+	int last_split_sub_node_index                        = 0;
+	int number_of_virtual_split_sub_nodes                = 0;
+	int split_sub_node_index                             = 0;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
+	if( first_split_sub_node_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid first split sub node index value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_split_sub_nodes <= 0 )
+	 || ( number_of_split_sub_nodes > ( INT_MAX - first_split_sub_node_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of split sub nodes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_virtual_sub_nodes <= 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of virtual sub nodes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Divide the range so that the tree of virtual sub nodes is balanced
+	 */
+	number_of_virtual_split_sub_nodes = number_of_split_sub_nodes / maximum_number_of_virtual_sub_nodes;
+
+	if( ( number_of_split_sub_nodes % maximum_number_of_virtual_sub_nodes ) != 0 )
+	{
+		number_of_virtual_split_sub_nodes += 1;
+	}
+	last_split_sub_node_index = first_split_sub_node_index + number_of_split_sub_nodes;
+
+	for( split_sub_node_index = first_split_sub_node_index;
+	     split_sub_node_index < last_split_sub_node_index;
+	     split_sub_node_index += number_of_virtual_split_sub_nodes )
+	{
+		if( number_of_virtual_split_sub_nodes > ( last_split_sub_node_index - split_sub_node_index ) )
+		{
+			number_of_virtual_split_sub_nodes = last_split_sub_node_index - split_sub_node_index;
+		}
+		if( libcdata_array_get_entry_by_index(
+		     split_sub_nodes,
+		     split_sub_node_index,
+		     (intptr_t **) &sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from split sub nodes array.",
+			 function,
+			 split_sub_node_index );
+
+			goto on_error;
+		}
+		if( sub_node == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing sub node: %d.",
+			 function,
+			 split_sub_node_index );
+
+			goto on_error;
+		}
+		if( libfdata_tree_node_initialize(
+		     &virtual_sub_node,
+		     internal_tree_node->tree,
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create virtual sub node.",
+			 function );
+
+			goto on_error;
+		}
+		internal_virtual_node = (libfdata_internal_tree_node_t *) virtual_sub_node;
+
+		internal_virtual_node->flags                              |= LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL;
+		internal_virtual_node->split_sub_nodes                     = split_sub_nodes;
+		internal_virtual_node->first_split_sub_node_index          = split_sub_node_index;
+		internal_virtual_node->number_of_split_sub_nodes           = number_of_virtual_split_sub_nodes;
+		internal_virtual_node->maximum_number_of_virtual_sub_nodes = maximum_number_of_virtual_sub_nodes;
+
+		/* The node data range of a virtual node cannot be set by the set_data_range function
+		 */
+		if( libfdata_tree_node_get_data_range(
+		     sub_node,
+		     &( internal_virtual_node->node_data_range.file_index ),
+		     &( internal_virtual_node->node_data_range.offset ),
+		     &( internal_virtual_node->node_data_range.size ),
+		     &( internal_virtual_node->node_data_range.flags ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set virtual sub node data range.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     virtual_sub_nodes_array,
+		     &entry_index,
+		     (intptr_t *) virtual_sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append virtual sub node to array.",
+			 function );
+
+			goto on_error;
+		}
+		virtual_sub_node = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( virtual_sub_node != NULL )
+	{
+		libfdata_tree_node_free(
+		 &virtual_sub_node,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the sub nodes of a virtual node
+ * The sub nodes are either the split sub nodes of the range of the virtual node
+ * or, if the range is too large, virtual sub nodes that divide the range
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_node_read_virtual_sub_nodes(
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_node_t *internal_tree_node = NULL;
+	libfdata_tree_node_t *sub_node                    = NULL;
+	static char *function                             = "libfdata_tree_node_read_virtual_sub_nodes";
+	int sub_node_index                                = 0;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
+	if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) == 0 )
+	 || ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ ) != 0 ) )
+	{
+		return( 1 );
+	}
+	/* The sub nodes of a virtual node created by split sub nodes are set directly
+	 */
+	if( internal_tree_node->split_sub_nodes == NULL )
+	{
+		return( 1 );
+	}
+	if( libfdata_tree_node_has_split_sub_nodes( internal_tree_node ) )
+	{
+		if( libcdata_array_resize(
+		     internal_tree_node->sub_nodes,
+		     internal_tree_node->number_of_split_sub_nodes,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize sub nodes array.",
+			 function );
+
+			goto on_error;
+		}
+		for( sub_node_index = 0;
+		     sub_node_index < internal_tree_node->number_of_split_sub_nodes;
+		     sub_node_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_tree_node->split_sub_nodes,
+			     internal_tree_node->first_split_sub_node_index + sub_node_index,
+			     (intptr_t **) &sub_node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve entry: %d from split sub nodes array.",
+				 function,
+				 internal_tree_node->first_split_sub_node_index + sub_node_index );
+
+				goto on_error;
+			}
+			if( libcdata_array_set_entry_by_index(
+			     internal_tree_node->sub_nodes,
+			     sub_node_index,
+			     (intptr_t *) sub_node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set entry: %d in sub nodes array.",
+				 function,
+				 sub_node_index );
+
+				goto on_error;
+			}
+			/* The virtual node becomes the parent so that changes to the leaf nodes
+			 * of the sub node are propagated via the virtual node
+			 */
+			if( libfdata_tree_node_set_parent_node(
+			     sub_node,
+			     node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set parent node in sub node: %d.",
+				 function,
+				 sub_node_index );
+
+				goto on_error;
+			}
+		}
+	}
+	else
+	{
+		if( libfdata_tree_node_append_virtual_sub_nodes(
+		     node,
+		     internal_tree_node->sub_nodes,
+		     internal_tree_node->split_sub_nodes,
+		     internal_tree_node->first_split_sub_node_index,
+		     internal_tree_node->number_of_split_sub_nodes,
+		     internal_tree_node->maximum_number_of_virtual_sub_nodes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append virtual sub nodes.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	internal_tree_node->flags |= LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ;
+
+	return( 1 );
+
+on_error:
+	if( libfdata_tree_node_has_split_sub_nodes( internal_tree_node ) )
+	{
+		libcdata_array_empty(
+		 internal_tree_node->sub_nodes,
+		 NULL,
+		 NULL );
+	}
+	else
+	{
+		libcdata_array_empty(
+		 internal_tree_node->sub_nodes,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_tree_node_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Determines if the node is deleted
+ * Returns 1 if deleted, 0 if not or -1 on error
+ */
+int libfdata_tree_node_is_deleted(
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_node_t *internal_tree_node = NULL;
+	static char *function                             = "libfdata_tree_node_is_deleted";
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
+	if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) == 0 )
+	 && ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_DELETED ) != 0 ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Marks a node as deleted
+ * All the leaf nodes in the sub tree of a deleted branch node are considered deleted
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_node_set_deleted(
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error )
 {
 	libfdata_internal_tree_node_t *internal_tree_node = NULL;
 	static char *function                             = "libfdata_tree_node_set_deleted";
@@ -2295,14 +3514,13 @@ int libfdata_tree_node_set_deleted(
 	}
 	internal_tree_node = (libfdata_internal_tree_node_t *) node;
 
-/* TODO add deleted branch node support */
-	if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_DATA_RANGE_SET ) != 0 )
+	if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: invalid node - currently only deleted leaf nodes are supported.",
+		 "%s: invalid node - node is virtual.",
 		 function );
 
 		return( -1 );
@@ -2337,18 +3555,309 @@ int libfdata_tree_node_set_deleted_sub_node(
 	libfdata_tree_node_t *sub_node                    = NULL;
 	static char *function                             = "libfdata_tree_node_set_deleted_sub_node";
 
-	if( node == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid node.",
-		 function );
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
+	if( libcdata_array_get_entry_by_index(
+	     internal_tree_node->sub_nodes,
+	     sub_node_index,
+	     (intptr_t **) &sub_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry: %d from sub nodes array.",
+		 function,
+		 sub_node_index );
+
+		return( -1 );
+	}
+	if( sub_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing sub node: %d.",
+		 function,
+		 sub_node_index );
+
+		return( -1 );
+	}
+	if( libfdata_tree_node_set_deleted(
+	     sub_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to set deleted in sub node: %d.",
+		 function,
+		 sub_node_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the flag to calculate the leaf node values and propagates this up to its parent node
+ * If the leaf nodes of the node were counted in the parent node, the leaf node values
+ * of the parent node are reset and calculated again
+ * Returns 1 if the successful or -1 on error
+ */
+int libfdata_tree_node_set_calculate_leaf_node_values(
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_node_t *internal_tree_node = NULL;
+	static char *function                             = "libfdata_tree_node_set_calculate_leaf_node_values";
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
+	/* The leaf node values of the parent node only need to be calculated again
+	 * if they include the leaf nodes of the node, otherwise the leaf nodes of
+	 * the node are counted when the parent node continues counting
+	 */
+	if( ( internal_tree_node->parent_node != NULL )
+	 && ( internal_tree_node->is_counted != 0 ) )
+	{
+		if( libfdata_tree_node_reset_leaf_node_values(
+		     internal_tree_node->parent_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reset leaf node values in parent node.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfdata_tree_node_set_calculate_leaf_node_values(
+		     internal_tree_node->parent_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set calculate leaf node values in parent node.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	internal_tree_node->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+
+	return( 1 );
+}
+
+/* Resets the leaf node values
+ * The leaf nodes of the sub nodes need to be counted again
+ * Returns 1 if the successful or -1 on error
+ */
+int libfdata_tree_node_reset_leaf_node_values(
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_node_t *internal_sub_node  = NULL;
+	libfdata_internal_tree_node_t *internal_tree_node = NULL;
+	static char *function                             = "libfdata_tree_node_reset_leaf_node_values";
+	int number_of_sub_nodes                           = 0;
+	int sub_node_index                                = 0;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
+	/* The sub nodes can have been freed after they were counted
+	 */
+	if( libcdata_array_get_number_of_entries(
+	     internal_tree_node->sub_nodes,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from sub nodes array.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sub_nodes > internal_tree_node->number_of_counted_sub_nodes )
+	{
+		number_of_sub_nodes = internal_tree_node->number_of_counted_sub_nodes;
+	}
+	for( sub_node_index = 0;
+	     sub_node_index < number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_tree_node->sub_nodes,
+		     sub_node_index,
+		     (intptr_t **) &internal_sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from sub nodes array.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		if( internal_sub_node != NULL )
+		{
+			internal_sub_node->is_counted = 0;
+		}
+	}
+	internal_tree_node->number_of_leaf_nodes               = 0;
+	internal_tree_node->number_of_deleted_leaf_nodes       = 0;
+	internal_tree_node->number_of_counted_sub_nodes        = 0;
+	internal_tree_node->number_of_deleted_sub_node_indexes = 0;
+	internal_tree_node->flags                             |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+
+	return( 1 );
+}
+
+/* Counts the leaf nodes of the next sub node that has not been counted
+ * Returns 1 if the successful or -1 on error
+ */
+int libfdata_tree_node_count_sub_node_leaf_nodes(
+     libfdata_tree_node_t *node,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_tree_node_t *internal_tree_node = NULL;
+	libfdata_tree_node_t *sub_node                    = NULL;
+	void *reallocation                                = NULL;
+	static char *function                             = "libfdata_tree_node_count_sub_node_leaf_nodes";
+	int number_of_counted_deleted_leaf_nodes          = 0;
+	int number_of_deleted_leaf_nodes                  = 0;
+	int number_of_leaf_nodes                          = 0;
+	int number_of_sub_nodes                           = 0;
+	int result                                        = 0;
+	int sub_node_index                                = 0;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+
+	sub_node_index = internal_tree_node->number_of_counted_sub_nodes;
+
+	if( sub_node_index >= internal_tree_node->number_of_allocated_cumulative_leaf_node_counts )
+	{
+		if( libcdata_array_get_number_of_entries(
+		     internal_tree_node->sub_nodes,
+		     &number_of_sub_nodes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of entries from sub nodes array.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( number_of_sub_nodes <= sub_node_index )
+		 || ( (size_t) number_of_sub_nodes > ( (size_t) SSIZE_MAX / sizeof( libfdata_tree_node_leaf_node_counts_t ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of sub nodes value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                internal_tree_node->cumulative_leaf_node_counts,
+		                sizeof( libfdata_tree_node_leaf_node_counts_t ) * number_of_sub_nodes );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize cumulative leaf node counts.",
+			 function );
+
+			return( -1 );
+		}
+		internal_tree_node->cumulative_leaf_node_counts = (libfdata_tree_node_leaf_node_counts_t *) reallocation;
 
-		return( -1 );
+		reallocation = memory_reallocate(
+		                internal_tree_node->deleted_sub_node_indexes,
+		                sizeof( int ) * number_of_sub_nodes );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize deleted sub node indexes.",
+			 function );
+
+			return( -1 );
+		}
+		internal_tree_node->deleted_sub_node_indexes                        = (int *) reallocation;
+		internal_tree_node->number_of_allocated_cumulative_leaf_node_counts = number_of_sub_nodes;
 	}
-	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+	number_of_counted_deleted_leaf_nodes = internal_tree_node->number_of_deleted_leaf_nodes;
 
 	if( libcdata_array_get_entry_by_index(
 	     internal_tree_node->sub_nodes,
@@ -2378,68 +3887,159 @@ int libfdata_tree_node_set_deleted_sub_node(
 
 		return( -1 );
 	}
-	if( libfdata_tree_node_set_deleted(
+	if( libfdata_tree_node_get_number_of_leaf_nodes(
 	     sub_node,
+	     file_io_handle,
+	     cache,
+	     &number_of_leaf_nodes,
+	     read_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to set deleted in sub node: %d.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of leaf nodes from sub node: %d.",
 		 function,
 		 sub_node_index );
 
 		return( -1 );
 	}
-	return( 1 );
-}
-
-/* Sets the flag to calculate the leaf node values and propagates this up to its parent node
- * Returns 1 if the successful or -1 on error
- */
-int libfdata_tree_node_set_calculate_leaf_node_values(
-     libfdata_tree_node_t *node,
-     libcerror_error_t **error )
-{
-	libfdata_internal_tree_node_t *internal_tree_node = NULL;
-	static char *function                             = "libfdata_tree_node_set_calculate_leaf_node_values";
+	if( libfdata_tree_node_get_number_of_deleted_leaf_nodes(
+	     sub_node,
+	     file_io_handle,
+	     cache,
+	     &number_of_deleted_leaf_nodes,
+	     read_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of deleted leaf nodes from sub node: %d.",
+		 function,
+		 sub_node_index );
 
-	if( node == NULL )
+		return( -1 );
+	}
+	if( libfdata_tree_node_set_first_leaf_node_index(
+	     sub_node,
+	     internal_tree_node->number_of_leaf_nodes,
+	     internal_tree_node->number_of_deleted_leaf_nodes,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid node.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set first leaf node index in sub node: %d.",
+		 function,
+		 sub_node_index );
 
 		return( -1 );
 	}
-	internal_tree_node = (libfdata_internal_tree_node_t *) node;
+	if( ( number_of_leaf_nodes == 0 )
+	 && ( number_of_deleted_leaf_nodes == 0 ) )
+	{
+		/* It is possible to have branch nodes without leaf nodes
+		 */
+		result = libfdata_tree_node_is_leaf(
+			  sub_node,
+			  file_io_handle,
+			  cache,
+			  read_flags,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if sub node: %d is a leaf.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			result = libfdata_tree_node_is_deleted(
+				  sub_node,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if sub node: %d is deleted.",
+				 function,
+				 sub_node_index );
 
-	if( internal_tree_node->parent_node != NULL )
+				return( -1 );
+			}
+			else if( result == 0 )
+			{
+				internal_tree_node->number_of_leaf_nodes++;
+			}
+			else
+			{
+				internal_tree_node->number_of_deleted_leaf_nodes++;
+			}
+		}
+	}
+	else
 	{
-		if( libfdata_tree_node_set_calculate_leaf_node_values(
-		     internal_tree_node->parent_node,
-		     error ) != 1 )
+		result = libfdata_tree_node_is_deleted(
+			  sub_node,
+			  error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set calculate leaf node values in parent node.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if sub node: %d is deleted.",
+			 function,
+			 sub_node_index );
 
 			return( -1 );
 		}
+		else if( result == 0 )
+		{
+			internal_tree_node->number_of_leaf_nodes         += number_of_leaf_nodes;
+			internal_tree_node->number_of_deleted_leaf_nodes += number_of_deleted_leaf_nodes;
+		}
+		else
+		{
+			/* All the leaf nodes of a deleted branch node are deleted
+			 */
+			internal_tree_node->number_of_deleted_leaf_nodes += number_of_leaf_nodes + number_of_deleted_leaf_nodes;
+		}
+	}
+	internal_tree_node->cumulative_leaf_node_counts[ sub_node_index ].number_of_leaf_nodes         = internal_tree_node->number_of_leaf_nodes;
+	internal_tree_node->cumulative_leaf_node_counts[ sub_node_index ].number_of_deleted_leaf_nodes = internal_tree_node->number_of_deleted_leaf_nodes;
+
+	if( internal_tree_node->number_of_deleted_leaf_nodes > number_of_counted_deleted_leaf_nodes )
+	{
+		internal_tree_node->deleted_sub_node_indexes[ internal_tree_node->number_of_deleted_sub_node_indexes ] = sub_node_index;
+
+		internal_tree_node->number_of_deleted_sub_node_indexes += 1;
 	}
-	internal_tree_node->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+
+	( (libfdata_internal_tree_node_t *) sub_node )->is_counted = 1;
+
+	internal_tree_node->number_of_counted_sub_nodes += 1;
 
 	return( 1 );
 }
 
 /* Reads the leaf node values
+ * The leaf nodes of sub nodes that were counted before are not counted again
  * Returns 1 if the successful or -1 on error
  */
 int libfdata_tree_node_read_leaf_node_values(
@@ -2450,14 +4050,9 @@ int libfdata_tree_node_read_leaf_node_values(
      libcerror_error_t **error )
 {
 	libfdata_internal_tree_node_t *internal_tree_node = NULL;
-	libfdata_tree_node_t *sub_node                    = NULL;
 	intptr_t *node_value                              = NULL;
 	static char *function                             = "libfdata_tree_node_read_leaf_node_values";
-	int number_of_deleted_leaf_nodes                  = 0;
-	int number_of_leaf_nodes                          = 0;
 	int number_of_sub_nodes                           = 0;
-	int result                                        = 0;
-	int sub_node_index                                = 0;
 
 	if( node == NULL )
 	{
@@ -2520,152 +4115,72 @@ int libfdata_tree_node_read_leaf_node_values(
 			}
 		}
 		internal_tree_node->flags |= LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ;
-	}
-	internal_tree_node->number_of_leaf_nodes         = 0;
-	internal_tree_node->number_of_deleted_leaf_nodes = 0;
-
-	if( libcdata_array_get_number_of_entries(
-	     internal_tree_node->sub_nodes,
-	     &number_of_sub_nodes,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from sub nodes array.",
-		 function );
-
-		return( -1 );
-	}
-	for( sub_node_index = 0;
-	     sub_node_index < number_of_sub_nodes;
-	     sub_node_index++ )
-	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_tree_node->sub_nodes,
-		     sub_node_index,
-		     (intptr_t **) &sub_node,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from sub nodes array.",
-			 function,
-			 sub_node_index );
 
-			return( -1 );
-		}
-		if( libfdata_tree_node_get_number_of_leaf_nodes(
-		     sub_node,
-		     file_io_handle,
-		     cache,
-		     &number_of_leaf_nodes,
-		     read_flags,
+		if( libfdata_tree_set_node_used(
+		     internal_tree_node->tree,
+		     node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of leaf nodes from sub node: %d.",
-			 function,
-			 sub_node_index );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set node used.",
+			 function );
 
 			return( -1 );
 		}
-		if( libfdata_tree_node_get_number_of_deleted_leaf_nodes(
-		     sub_node,
-		     file_io_handle,
-		     cache,
-		     &number_of_deleted_leaf_nodes,
-		     read_flags,
+	}
+	else if( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ ) == 0 )
+	{
+		if( libfdata_tree_node_read_virtual_sub_nodes(
+		     node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of deleted leaf nodes from sub node: %d.",
-			 function,
-			 sub_node_index );
-
-			return( -1 );
-		}
-		if( libfdata_tree_node_set_first_leaf_node_index(
-		     sub_node,
-		     internal_tree_node->number_of_leaf_nodes,
-		     internal_tree_node->number_of_deleted_leaf_nodes,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set first leaf node index in sub node: %d.",
-			 function,
-			 sub_node_index );
+			 "%s: unable to read virtual sub nodes.",
+			 function );
 
 			return( -1 );
 		}
-		if( ( number_of_leaf_nodes == 0 )
-		 && ( number_of_deleted_leaf_nodes == 0 ) )
-		{
-			/* It is possible to have branch nodes without leaf nodes
-			 */
-			result = libfdata_tree_node_is_leaf(
-				  sub_node,
-				  file_io_handle,
-				  cache,
-				  read_flags,
-				  error );
-
-			if( result == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if sub node: %d is a leaf.",
-				 function,
-				 sub_node_index );
-
-				return( -1 );
-			}
-			else if( result != 0 )
-			{
-				result = libfdata_tree_node_is_deleted(
-					  sub_node,
-					  error );
-
-				if( result == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to determine if sub node: %d is deleted.",
-					 function,
-					 sub_node_index );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_tree_node->sub_nodes,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from sub nodes array.",
+		 function );
 
-					return( -1 );
-				}
-				else if( result == 0 )
-				{
-					internal_tree_node->number_of_leaf_nodes++;
-				}
-				else
-				{
-					internal_tree_node->number_of_deleted_leaf_nodes++;
-				}
-			}
-		}
-		else
+		return( -1 );
+	}
+	/* Continue with the sub nodes that have not been counted before
+	 */
+	while( internal_tree_node->number_of_counted_sub_nodes < number_of_sub_nodes )
+	{
+		if( libfdata_tree_node_count_sub_node_leaf_nodes(
+		     node,
+		     file_io_handle,
+		     cache,
+		     read_flags,
+		     error ) != 1 )
 		{
-			internal_tree_node->number_of_leaf_nodes         += number_of_leaf_nodes;
-			internal_tree_node->number_of_deleted_leaf_nodes += number_of_deleted_leaf_nodes;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to count leaf nodes of sub node: %d.",
+			 function,
+			 internal_tree_node->number_of_counted_sub_nodes );
+
+			return( -1 );
 		}
 	}
 	return( 1 );
@@ -2746,6 +4261,21 @@ int libfdata_tree_node_is_leaf(
 			}
 		}
 		internal_tree_node->flags |= LIBFDATA_TREE_NODE_FLAG_SUB_NODES_READ;
+
+		if( libfdata_tree_set_node_used(
+		     internal_tree_node->tree,
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set node used.",
+			 function );
+
+			return( -1 );
+		}
 	}
 	if( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) == 0 )
 	 && ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_LEAF ) != 0 ) )
@@ -2940,27 +4470,34 @@ int libfdata_tree_node_get_number_of_leaf_nodes(
 	return( 1 );
 }
 
-/* Retrieves a specific leaf node
- * Returns 1 if successful or -1 on error
+/* Finds a specific (deleted) leaf node
+ * The leaf nodes are counted lazily, only the sub nodes up to the one that contains
+ * the leaf node are counted and sub trees are only counted as far as needed
+ * Returns 1 if successful, 0 if the sub tree of the node does not contain the leaf node or -1 on error
  */
-int libfdata_tree_node_get_leaf_node_by_index(
+int libfdata_tree_node_find_leaf_node_by_index(
      libfdata_tree_node_t *node,
      intptr_t *file_io_handle,
      libfcache_cache_t *cache,
      int leaf_node_index,
+     uint8_t is_deleted,
      libfdata_tree_node_t **leaf_node,
      uint8_t read_flags,
      libcerror_error_t **error )
 {
 	libfdata_internal_tree_node_t *internal_tree_node = NULL;
 	libfdata_tree_node_t *sub_node                    = NULL;
-	static char *function                             = "libfdata_tree_node_get_leaf_node_by_index";
-	int first_deleted_leaf_node_index                 = 0;
+	static char *function                             = "libfdata_tree_node_find_leaf_node_by_index";
+	int entry_index                                   = 0;
 	int first_leaf_node_index                         = 0;
-	int number_of_leaf_nodes                          = 0;
+	int last_entry_index                              = 0;
+	int lower_entry_index                             = 0;
+	int number_of_counted_leaf_nodes                  = 0;
+	int number_of_entries                             = 0;
 	int number_of_sub_nodes                           = 0;
 	int result                                        = 0;
 	int sub_node_index                                = 0;
+	int upper_entry_index                             = 0;
 
 	if( node == NULL )
 	{
@@ -2975,55 +4512,137 @@ int libfdata_tree_node_get_leaf_node_by_index(
 	}
 	internal_tree_node = (libfdata_internal_tree_node_t *) node;
 
-	if( leaf_node == NULL )
+	if( leaf_node_index < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid leaf node.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid leaf node index value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_tree_node->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
+	if( leaf_node == NULL )
 	{
-		if( libfdata_tree_node_read_leaf_node_values(
-		     node,
-		     file_io_handle,
-		     cache,
-		     read_flags,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve node value.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid leaf node.",
+		 function );
 
-			return( -1 );
-		}
-		internal_tree_node->flags &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
+		return( -1 );
 	}
-	if( libcdata_array_get_number_of_entries(
-	     internal_tree_node->sub_nodes,
+	/* Make sure the sub nodes are read
+	 */
+	if( libfdata_tree_node_get_number_of_sub_nodes(
+	     node,
+	     file_io_handle,
+	     cache,
 	     &number_of_sub_nodes,
+	     read_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from sub nodes array.",
+		 "%s: unable to retrieve number of sub nodes.",
 		 function );
 
 		return( -1 );
 	}
-	for( sub_node_index = 0;
-	     sub_node_index < number_of_sub_nodes;
-	     sub_node_index++ )
+	if( is_deleted == 0 )
+	{
+		number_of_counted_leaf_nodes = internal_tree_node->number_of_leaf_nodes;
+		number_of_entries            = internal_tree_node->number_of_counted_sub_nodes;
+		last_entry_index             = internal_tree_node->last_leaf_node_sub_node_index;
+	}
+	else
+	{
+		/* Only the sub nodes that contain deleted leaf nodes are searched
+		 */
+		number_of_counted_leaf_nodes = internal_tree_node->number_of_deleted_leaf_nodes;
+		number_of_entries            = internal_tree_node->number_of_deleted_sub_node_indexes;
+		last_entry_index             = internal_tree_node->last_deleted_leaf_node_entry_index;
+	}
+	if( leaf_node_index < number_of_counted_leaf_nodes )
 	{
+		/* The leaf node is in the sub nodes that have been counted
+		 * first check the sub node that contained the last leaf node found
+		 * and the one after it, so that enumerating the leaf nodes in order
+		 * does not require a search
+		 */
+		entry_index = -1;
+
+		for( lower_entry_index = last_entry_index;
+		     lower_entry_index <= ( last_entry_index + 1 );
+		     lower_entry_index++ )
+		{
+			if( lower_entry_index >= number_of_entries )
+			{
+				break;
+			}
+			if( lower_entry_index > 0 )
+			{
+				first_leaf_node_index = libfdata_tree_node_get_cumulative_number_of_leaf_nodes(
+				                         internal_tree_node,
+				                         lower_entry_index - 1,
+				                         is_deleted );
+			}
+			else
+			{
+				first_leaf_node_index = 0;
+			}
+			if( ( leaf_node_index >= first_leaf_node_index )
+			 && ( leaf_node_index < libfdata_tree_node_get_cumulative_number_of_leaf_nodes( internal_tree_node, lower_entry_index, is_deleted ) ) )
+			{
+				entry_index = lower_entry_index;
+
+				break;
+			}
+		}
+		if( entry_index == -1 )
+		{
+			/* Search for the first sub node of which the cumulative leaf node count
+			 * exceeds the leaf node index
+			 */
+			lower_entry_index = 0;
+			upper_entry_index = number_of_entries - 1;
+
+			while( lower_entry_index < upper_entry_index )
+			{
+				entry_index = lower_entry_index + ( ( upper_entry_index - lower_entry_index ) / 2 );
+
+				if( libfdata_tree_node_get_cumulative_number_of_leaf_nodes( internal_tree_node, entry_index, is_deleted ) > leaf_node_index )
+				{
+					upper_entry_index = entry_index;
+				}
+				else
+				{
+					lower_entry_index = entry_index + 1;
+				}
+			}
+			entry_index = lower_entry_index;
+
+			if( entry_index > 0 )
+			{
+				first_leaf_node_index = libfdata_tree_node_get_cumulative_number_of_leaf_nodes(
+				                         internal_tree_node,
+				                         entry_index - 1,
+				                         is_deleted );
+			}
+			else
+			{
+				first_leaf_node_index = 0;
+			}
+		}
+		sub_node_index = libfdata_tree_node_get_entry_sub_node_index(
+		                  internal_tree_node,
+		                  entry_index,
+		                  is_deleted );
+
 		if( libcdata_array_get_entry_by_index(
 		     internal_tree_node->sub_nodes,
 		     sub_node_index,
@@ -3040,44 +4659,267 @@ int libfdata_tree_node_get_leaf_node_by_index(
 
 			return( -1 );
 		}
-		if( libfdata_tree_node_get_number_of_leaf_nodes(
-		     sub_node,
-		     file_io_handle,
-		     cache,
-		     &number_of_leaf_nodes,
-		     read_flags,
+		if( is_deleted == 0 )
+		{
+			internal_tree_node->last_leaf_node_sub_node_index = entry_index;
+		}
+		else
+		{
+			internal_tree_node->last_deleted_leaf_node_entry_index = entry_index;
+		}
+		result = libfdata_tree_node_is_leaf(
+			  sub_node,
+			  file_io_handle,
+			  cache,
+			  read_flags,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if sub node: %d is a leaf.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			*leaf_node = sub_node;
+
+			return( 1 );
+		}
+		/* Note that the first_leaf_node_index is relative for a branch
+		 * the leaf nodes of a deleted branch are all deleted leaf nodes
+		 */
+		if( is_deleted == 0 )
+		{
+			result = 0;
+		}
+		else
+		{
+			result = libfdata_tree_node_is_deleted(
+				  sub_node,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if sub node: %d is deleted.",
+				 function,
+				 sub_node_index );
+
+				return( -1 );
+			}
+		}
+		if( result != 0 )
+		{
+			result = libfdata_tree_node_find_deleted_branch_leaf_node_by_index(
+			          sub_node,
+			          file_io_handle,
+			          cache,
+			          leaf_node_index - first_leaf_node_index,
+			          leaf_node,
+			          read_flags,
+			          error );
+		}
+		else
+		{
+			result = libfdata_tree_node_find_leaf_node_by_index(
+			          sub_node,
+			          file_io_handle,
+			          cache,
+			          leaf_node_index - first_leaf_node_index,
+			          is_deleted,
+			          leaf_node,
+			          read_flags,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve leaf node: %d from sub node: %d.",
+			 function,
+			 leaf_node_index - first_leaf_node_index,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	/* Count the leaf nodes of the remaining sub nodes until the leaf node is found
+	 */
+	while( internal_tree_node->number_of_counted_sub_nodes < number_of_sub_nodes )
+	{
+		sub_node_index = internal_tree_node->number_of_counted_sub_nodes;
+
+		if( libcdata_array_get_entry_by_index(
+		     internal_tree_node->sub_nodes,
+		     sub_node_index,
+		     (intptr_t **) &sub_node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of leaf nodes from sub node: %d.",
+			 "%s: unable to retrieve entry: %d from sub nodes array.",
 			 function,
 			 sub_node_index );
 
 			return( -1 );
 		}
-		if( libfdata_tree_node_get_first_leaf_node_index(
-		     sub_node,
-		     &first_leaf_node_index,
-		     &first_deleted_leaf_node_index,
+		result = libfdata_tree_node_is_leaf(
+			  sub_node,
+			  file_io_handle,
+			  cache,
+			  read_flags,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if sub node: %d is a leaf.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			result = libfdata_tree_node_is_deleted(
+				  sub_node,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if sub node: %d is deleted.",
+				 function,
+				 sub_node_index );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			result = 1;
+		}
+		if( result == 0 )
+		{
+			/* Search the sub tree of the branch before it is completely counted,
+			 * a sub tree that does not contain the leaf node is completely counted
+			 * the sub tree of a deleted branch is counted before it is searched
+			 */
+			if( libfdata_tree_node_set_first_leaf_node_index(
+			     sub_node,
+			     internal_tree_node->number_of_leaf_nodes,
+			     internal_tree_node->number_of_deleted_leaf_nodes,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set first leaf node index in sub node: %d.",
+				 function,
+				 sub_node_index );
+
+				return( -1 );
+			}
+			result = libfdata_tree_node_find_leaf_node_by_index(
+			          sub_node,
+			          file_io_handle,
+			          cache,
+			          leaf_node_index - number_of_counted_leaf_nodes,
+			          is_deleted,
+			          leaf_node,
+			          read_flags,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve leaf node: %d from sub node: %d.",
+				 function,
+				 leaf_node_index - number_of_counted_leaf_nodes,
+				 sub_node_index );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				/* The sub node becomes the next deleted sub node index when it is counted
+				 */
+				if( is_deleted == 0 )
+				{
+					internal_tree_node->last_leaf_node_sub_node_index = sub_node_index;
+				}
+				else
+				{
+					internal_tree_node->last_deleted_leaf_node_entry_index = internal_tree_node->number_of_deleted_sub_node_indexes;
+				}
+				return( 1 );
+			}
+		}
+		if( libfdata_tree_node_count_sub_node_leaf_nodes(
+		     node,
+		     file_io_handle,
+		     cache,
+		     read_flags,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve first leaf node index from sub node: %d.",
+			 "%s: unable to count leaf nodes of sub node: %d.",
 			 function,
 			 sub_node_index );
 
 			return( -1 );
 		}
-		if( number_of_leaf_nodes == 0 )
+		first_leaf_node_index = number_of_counted_leaf_nodes;
+
+		if( is_deleted == 0 )
+		{
+			number_of_counted_leaf_nodes = internal_tree_node->number_of_leaf_nodes;
+		}
+		else
+		{
+			number_of_counted_leaf_nodes = internal_tree_node->number_of_deleted_leaf_nodes;
+		}
+		if( leaf_node_index < number_of_counted_leaf_nodes )
 		{
-			/* It is possible to have branch nodes without leaf nodes
+			/* Only a leaf sub node or a deleted branch sub node can contain
+			 * the leaf node at this point
 			 */
+			if( is_deleted == 0 )
+			{
+				internal_tree_node->last_leaf_node_sub_node_index = sub_node_index;
+			}
+			else
+			{
+				internal_tree_node->last_deleted_leaf_node_entry_index = internal_tree_node->number_of_deleted_sub_node_indexes - 1;
+			}
 			result = libfdata_tree_node_is_leaf(
 				  sub_node,
 				  file_io_handle,
@@ -3099,39 +4941,11 @@ int libfdata_tree_node_get_leaf_node_by_index(
 			}
 			else if( result != 0 )
 			{
-				result = libfdata_tree_node_is_deleted(
-					  sub_node,
-					  error );
-
-				if( result == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to determine if sub node: %d is deleted.",
-					 function,
-					 sub_node_index );
-
-					return( -1 );
-				}
-				else if( result == 0 )
-				{
-					if( leaf_node_index == first_leaf_node_index )
-					{
-						*leaf_node = sub_node;
+				*leaf_node = sub_node;
 
-						break;
-					}
-				}
+				return( 1 );
 			}
-		}
-		else if( ( leaf_node_index >= first_leaf_node_index )
-		      && ( leaf_node_index < ( first_leaf_node_index + number_of_leaf_nodes ) ) )
-		{
-			/* Note that the first_leaf_node_index is relative for a branch
-			 */
-			if( libfdata_tree_node_get_leaf_node_by_index(
+			if( libfdata_tree_node_find_deleted_branch_leaf_node_by_index(
 			     sub_node,
 			     file_io_handle,
 			     cache,
@@ -3144,114 +4958,159 @@ int libfdata_tree_node_get_leaf_node_by_index(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve leaf node: %d from sub node: %d.",
+				 "%s: unable to retrieve deleted leaf node: %d from sub node: %d.",
 				 function,
 				 leaf_node_index - first_leaf_node_index,
 				 sub_node_index );
 
 				return( -1 );
 			}
-			break;
+			return( 1 );
 		}
 	}
-	if( sub_node_index >= number_of_sub_nodes )
+	internal_tree_node->flags &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
+
+	return( 0 );
+}
+
+/* Finds a specific deleted leaf node in the sub tree of a deleted branch node
+ * All the leaf nodes in the sub tree of a deleted branch node are deleted,
+ * the leaf nodes are followed by the deleted leaf nodes of the sub tree
+ * Returns 1 if successful, 0 if the sub tree of the node does not contain the leaf node or -1 on error
+ */
+int libfdata_tree_node_find_deleted_branch_leaf_node_by_index(
+     libfdata_tree_node_t *node,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     int deleted_leaf_node_index,
+     libfdata_tree_node_t **deleted_leaf_node,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	static char *function    = "libfdata_tree_node_find_deleted_branch_leaf_node_by_index";
+	int number_of_leaf_nodes = 0;
+	int result               = 0;
+
+	if( libfdata_tree_node_get_number_of_leaf_nodes(
+	     node,
+	     file_io_handle,
+	     cache,
+	     &number_of_leaf_nodes,
+	     read_flags,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid sub node index value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of leaf nodes.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
+	if( deleted_leaf_node_index < number_of_leaf_nodes )
+	{
+		result = libfdata_tree_node_find_leaf_node_by_index(
+		          node,
+		          file_io_handle,
+		          cache,
+		          deleted_leaf_node_index,
+		          0,
+		          deleted_leaf_node,
+		          read_flags,
+		          error );
+	}
+	else
+	{
+		result = libfdata_tree_node_find_leaf_node_by_index(
+		          node,
+		          file_io_handle,
+		          cache,
+		          deleted_leaf_node_index - number_of_leaf_nodes,
+		          1,
+		          deleted_leaf_node,
+		          read_flags,
+		          error );
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve deleted leaf node: %d.",
+		 function,
+		 deleted_leaf_node_index );
+
+		return( -1 );
+	}
+	return( result );
 }
 
-/* Retrieves the number of deleted leaf nodes
+/* Retrieves a specific leaf node
  * Returns 1 if successful or -1 on error
  */
-int libfdata_tree_node_get_number_of_deleted_leaf_nodes(
+int libfdata_tree_node_get_leaf_node_by_index(
      libfdata_tree_node_t *node,
      intptr_t *file_io_handle,
      libfcache_cache_t *cache,
-     int *number_of_deleted_leaf_nodes,
+     int leaf_node_index,
+     libfdata_tree_node_t **leaf_node,
      uint8_t read_flags,
      libcerror_error_t **error )
 {
-	libfdata_internal_tree_node_t *internal_tree_node = NULL;
-	static char *function                             = "libfdata_tree_node_get_number_of_deleted_leaf_nodes";
+	static char *function = "libfdata_tree_node_get_leaf_node_by_index";
+	int result            = 0;
 
-	if( node == NULL )
+	result = libfdata_tree_node_find_leaf_node_by_index(
+	          node,
+	          file_io_handle,
+	          cache,
+	          leaf_node_index,
+	          0,
+	          leaf_node,
+	          read_flags,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid node.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve leaf node: %d.",
+		 function,
+		 leaf_node_index );
 
 		return( -1 );
 	}
-	internal_tree_node = (libfdata_internal_tree_node_t *) node;
-
-	if( number_of_deleted_leaf_nodes == NULL )
+	else if( result == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid number of deleted leaf nodes.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid leaf node index value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_tree_node->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
-	{
-		if( libfdata_tree_node_read_leaf_node_values(
-		     node,
-		     file_io_handle,
-		     cache,
-		     read_flags,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve node value.",
-			 function );
-
-			return( -1 );
-		}
-		internal_tree_node->flags &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
-	}
-	*number_of_deleted_leaf_nodes = internal_tree_node->number_of_deleted_leaf_nodes;
-
 	return( 1 );
 }
 
-/* Retrieves a specific deleted leaf node
+/* Retrieves the number of deleted leaf nodes
  * Returns 1 if successful or -1 on error
  */
-int libfdata_tree_node_get_deleted_leaf_node_by_index(
+int libfdata_tree_node_get_number_of_deleted_leaf_nodes(
      libfdata_tree_node_t *node,
      intptr_t *file_io_handle,
      libfcache_cache_t *cache,
-     int deleted_leaf_node_index,
-     libfdata_tree_node_t **deleted_leaf_node,
+     int *number_of_deleted_leaf_nodes,
      uint8_t read_flags,
      libcerror_error_t **error )
 {
 	libfdata_internal_tree_node_t *internal_tree_node = NULL;
-	libfdata_tree_node_t *sub_node                    = NULL;
-	static char *function                             = "libfdata_tree_node_get_deleted_leaf_node_by_index";
-	int first_deleted_leaf_node_index                 = 0;
-	int first_leaf_node_index                         = 0;
-	int number_of_deleted_leaf_nodes                  = 0;
-	int number_of_sub_nodes                           = 0;
-	int result                                        = 0;
-	int sub_node_index                                = 0;
+	static char *function                             = "libfdata_tree_node_get_number_of_deleted_leaf_nodes";
 
 	if( node == NULL )
 	{
@@ -3266,13 +5125,13 @@ int libfdata_tree_node_get_deleted_leaf_node_by_index(
 	}
 	internal_tree_node = (libfdata_internal_tree_node_t *) node;
 
-	if( deleted_leaf_node == NULL )
+	if( number_of_deleted_leaf_nodes == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid deleted leaf node.",
+		 "%s: invalid number of deleted leaf nodes.",
 		 function );
 
 		return( -1 );
@@ -3297,161 +5156,55 @@ int libfdata_tree_node_get_deleted_leaf_node_by_index(
 		}
 		internal_tree_node->flags &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
 	}
-	if( libcdata_array_get_number_of_entries(
-	     internal_tree_node->sub_nodes,
-	     &number_of_sub_nodes,
-	     error ) != 1 )
+	*number_of_deleted_leaf_nodes = internal_tree_node->number_of_deleted_leaf_nodes;
+
+	return( 1 );
+}
+
+/* Retrieves a specific deleted leaf node
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_node_get_deleted_leaf_node_by_index(
+     libfdata_tree_node_t *node,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     int deleted_leaf_node_index,
+     libfdata_tree_node_t **deleted_leaf_node,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_tree_node_get_deleted_leaf_node_by_index";
+	int result            = 0;
+
+	result = libfdata_tree_node_find_leaf_node_by_index(
+	          node,
+	          file_io_handle,
+	          cache,
+	          deleted_leaf_node_index,
+	          1,
+	          deleted_leaf_node,
+	          read_flags,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from sub nodes array.",
-		 function );
+		 "%s: unable to retrieve deleted leaf node: %d.",
+		 function,
+		 deleted_leaf_node_index );
 
 		return( -1 );
 	}
-	for( sub_node_index = 0;
-	     sub_node_index < number_of_sub_nodes;
-	     sub_node_index++ )
-	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_tree_node->sub_nodes,
-		     sub_node_index,
-		     (intptr_t **) &sub_node,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from sub nodes array.",
-			 function,
-			 sub_node_index );
-
-			return( -1 );
-		}
-		if( libfdata_tree_node_get_number_of_deleted_leaf_nodes(
-		     sub_node,
-		     file_io_handle,
-		     cache,
-		     &number_of_deleted_leaf_nodes,
-		     read_flags,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of leaf nodes from sub node: %d.",
-			 function,
-			 sub_node_index );
-
-			return( -1 );
-		}
-		if( libfdata_tree_node_get_first_leaf_node_index(
-		     sub_node,
-		     &first_leaf_node_index,
-		     &first_deleted_leaf_node_index,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve first leaf node index from sub node: %d.",
-			 function,
-			 sub_node_index );
-
-			return( -1 );
-		}
-		if( number_of_deleted_leaf_nodes == 0 )
-		{
-			/* It is possible to have branch nodes without leaf nodes
-			 */
-			result = libfdata_tree_node_is_leaf(
-				  sub_node,
-				  file_io_handle,
-				  cache,
-				  read_flags,
-				  error );
-
-			if( result == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if sub node: %d is a leaf.",
-				 function,
-				 sub_node_index );
-
-				return( -1 );
-			}
-			else if( result != 0 )
-			{
-				result = libfdata_tree_node_is_deleted(
-					  sub_node,
-					  error );
-
-				if( result == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to determine if sub node: %d is deleted.",
-					 function,
-					 sub_node_index );
-
-					return( -1 );
-				}
-				else if( result != 0 )
-				{
-					if( deleted_leaf_node_index == first_deleted_leaf_node_index )
-					{
-						*deleted_leaf_node = sub_node;
-
-						break;
-					}
-				}
-			}
-		}
-		else if( ( deleted_leaf_node_index >= first_deleted_leaf_node_index )
-		      && ( deleted_leaf_node_index < ( first_deleted_leaf_node_index + number_of_deleted_leaf_nodes ) ) )
-		{
-			/* Note that the first_deleted_leaf_node_index is relative for a branch
-			 */
-			if( libfdata_tree_node_get_deleted_leaf_node_by_index(
-			     sub_node,
-			     file_io_handle,
-			     cache,
-			     deleted_leaf_node_index - first_deleted_leaf_node_index,
-			     deleted_leaf_node,
-			     read_flags,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve deleted leaf node: %d from sub node: %d.",
-				 function,
-				 deleted_leaf_node_index - first_deleted_leaf_node_index,
-				 sub_node_index );
-
-				return( -1 );
-			}
-			break;
-		}
-	}
-	if( sub_node_index >= number_of_sub_nodes )
+	else if( result == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid sub node index value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid deleted leaf node index value out of bounds.",
 		 function );
 
 		return( -1 );
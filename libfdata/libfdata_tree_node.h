@@ -43,6 +43,34 @@ extern "C" {
 #define libfdata_tree_node_calculate_leaf_node_cache_entry_index( node_offset, number_of_cache_entries ) \
 	( number_of_cache_entries > 4 ) ? ( number_of_cache_entries / 4 ) + ( node_offset % ( ( number_of_cache_entries * 3 ) / 4 ) ) : ( node_offset % number_of_cache_entries )
 
+/* Determines if the sub nodes of a virtual node are the split sub nodes,
+ * which are freed by the node of which the sub nodes were split
+ */
+#define libfdata_tree_node_has_split_sub_nodes( internal_tree_node ) \
+	( ( ( internal_tree_node->flags & LIBFDATA_TREE_NODE_FLAG_IS_VIRTUAL ) != 0 ) && ( internal_tree_node->split_sub_nodes != NULL ) && ( internal_tree_node->number_of_split_sub_nodes <= internal_tree_node->maximum_number_of_virtual_sub_nodes ) )
+
+/* Retrieves the index of the sub node of a counted sub node entry
+ * the entries of the deleted leaf nodes are the deleted sub node indexes
+ */
+#define libfdata_tree_node_get_entry_sub_node_index( internal_tree_node, entry_index, is_deleted ) \
+	( ( is_deleted == 0 ) ? entry_index : internal_tree_node->deleted_sub_node_indexes[ entry_index ] )
+
+#define libfdata_tree_node_get_cumulative_number_of_leaf_nodes( internal_tree_node, entry_index, is_deleted ) \
+	( ( is_deleted == 0 ) ? internal_tree_node->cumulative_leaf_node_counts[ entry_index ].number_of_leaf_nodes : internal_tree_node->cumulative_leaf_node_counts[ internal_tree_node->deleted_sub_node_indexes[ entry_index ] ].number_of_deleted_leaf_nodes )
+
+typedef struct libfdata_tree_node_leaf_node_counts libfdata_tree_node_leaf_node_counts_t;
+
+struct libfdata_tree_node_leaf_node_counts
+{
+	/* The number of leaf nodes
+	 */
+	int number_of_leaf_nodes;
+
+	/* The number of deleted leaf nodes
+	 */
+	int number_of_deleted_leaf_nodes;
+};
+
 typedef struct libfdata_internal_tree_node libfdata_internal_tree_node_t;
 
 struct libfdata_internal_tree_node
@@ -57,11 +85,11 @@ struct libfdata_internal_tree_node
 
 	/* The node data range
 	 */
-	libfdata_range_t *node_data_range;
+	libfdata_range_t node_data_range;
 
 	/* The sub nodes data range
 	 */
-	libfdata_range_t *sub_nodes_data_range;
+	libfdata_range_t sub_nodes_data_range;
 
 	/* The time stamp
 	 */
@@ -75,6 +103,24 @@ struct libfdata_internal_tree_node
 	 */
 	libcdata_array_t *sub_nodes;
 
+	/* The split sub nodes (array)
+	 * contains the original sub nodes of a node of which the sub nodes were split,
+	 * virtual nodes reference the split sub nodes of the node that was split
+	 */
+	libcdata_array_t *split_sub_nodes;
+
+	/* The index of the first split sub node of a virtual node
+	 */
+	int first_split_sub_node_index;
+
+	/* The number of split sub nodes of a virtual node
+	 */
+	int number_of_split_sub_nodes;
+
+	/* The maximum number of sub nodes of a virtual node
+	 */
+	int maximum_number_of_virtual_sub_nodes;
+
 	/* The number of leaf nodes
 	 */
 	int number_of_leaf_nodes;
@@ -90,6 +136,51 @@ struct libfdata_internal_tree_node
 	/* The relative first deleted leaf node index
 	 */
 	int first_deleted_leaf_node_index;
+
+	/* The number of sub nodes of which the leaf nodes have been counted
+	 * the leaf nodes are counted in order of the sub nodes
+	 */
+	int number_of_counted_sub_nodes;
+
+	/* Value to indicate the leaf nodes of the node have been counted in the parent node
+	 */
+	uint8_t is_counted;
+
+	/* The cumulative leaf node counts of the counted sub nodes
+	 * the counts of a sub node include the leaf nodes of the preceding sub nodes
+	 */
+	libfdata_tree_node_leaf_node_counts_t *cumulative_leaf_node_counts;
+
+	/* The number of allocated cumulative leaf node counts
+	 */
+	int number_of_allocated_cumulative_leaf_node_counts;
+
+	/* The indexes of the counted sub nodes that contain deleted leaf nodes
+	 * sub nodes without deleted leaf nodes are not indexed, so that searching
+	 * for a deleted leaf node skips their sub trees
+	 * the number of allocated indexes is that of the cumulative leaf node counts
+	 */
+	int *deleted_sub_node_indexes;
+
+	/* The number of deleted sub node indexes
+	 */
+	int number_of_deleted_sub_node_indexes;
+
+	/* The index of the sub node that contained the last leaf node found
+	 */
+	int last_leaf_node_sub_node_index;
+
+	/* The index of the deleted sub node index that contained the last deleted leaf node found
+	 */
+	int last_deleted_leaf_node_entry_index;
+
+	/* The previous (more recently) used node of which the sub nodes were read
+	 */
+	libfdata_tree_node_t *previous_used_node;
+
+	/* The next (less recently) used node of which the sub nodes were read
+	 */
+	libfdata_tree_node_t *next_used_node;
 };
 
 int libfdata_tree_node_initialize(
@@ -106,6 +197,13 @@ int libfdata_tree_node_free_single(
      libfdata_tree_node_t **node,
      libcerror_error_t **error );
 
+int libfdata_tree_node_clone(
+     libfdata_tree_node_t **destination_node,
+     libfdata_tree_node_t *source_node,
+     libfdata_tree_t *destination_tree,
+     libfdata_tree_node_t *destination_parent_node,
+     libcerror_error_t **error );
+
 int libfdata_tree_node_set_parent_node(
      libfdata_tree_node_t *node,
      libfdata_tree_node_t *parent_node,
@@ -157,6 +255,14 @@ int libfdata_tree_node_set_sub_nodes_data_range(
      uint32_t sub_nodes_flags,
      libcerror_error_t **error );
 
+int libfdata_tree_node_compare_data_ranges(
+     const libfdata_tree_node_t **first_node,
+     const libfdata_tree_node_t **second_node );
+
+int libfdata_tree_node_compare_sub_nodes_data_ranges(
+     const libfdata_tree_node_t **first_node,
+     const libfdata_tree_node_t **second_node );
+
 int libfdata_tree_node_get_timestamp(
      libfdata_tree_node_t *node,
      time_t *timestamp,
@@ -213,6 +319,16 @@ int libfdata_tree_node_get_number_of_sub_nodes(
      uint8_t read_flags,
      libcerror_error_t **error );
 
+LIBFDATA_EXTERN \
+int libfdata_tree_node_free_sub_nodes(
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error );
+
+int libfdata_tree_node_sub_nodes_can_be_freed(
+     libfdata_tree_node_t *node,
+     libfdata_tree_node_t *node_in_use,
+     libcerror_error_t **error );
+
 LIBFDATA_EXTERN \
 int libfdata_tree_node_get_sub_node_by_index(
      libfdata_tree_node_t *node,
@@ -267,6 +383,25 @@ int libfdata_tree_node_split_sub_nodes(
      int number_of_splits,
      libcerror_error_t **error );
 
+LIBFDATA_EXTERN \
+int libfdata_tree_node_split_sub_nodes_lazy(
+     libfdata_tree_node_t *node,
+     int maximum_number_of_sub_nodes,
+     libcerror_error_t **error );
+
+int libfdata_tree_node_append_virtual_sub_nodes(
+     libfdata_tree_node_t *node,
+     libcdata_array_t *virtual_sub_nodes_array,
+     libcdata_array_t *split_sub_nodes,
+     int first_split_sub_node_index,
+     int number_of_split_sub_nodes,
+     int maximum_number_of_virtual_sub_nodes,
+     libcerror_error_t **error );
+
+int libfdata_tree_node_read_virtual_sub_nodes(
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error );
+
 /* Deleted node functions
  */
 LIBFDATA_EXTERN \
@@ -291,6 +426,17 @@ int libfdata_tree_node_set_calculate_leaf_node_values(
      libfdata_tree_node_t *node,
      libcerror_error_t **error );
 
+int libfdata_tree_node_reset_leaf_node_values(
+     libfdata_tree_node_t *node,
+     libcerror_error_t **error );
+
+int libfdata_tree_node_count_sub_node_leaf_nodes(
+     libfdata_tree_node_t *node,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
 int libfdata_tree_node_read_leaf_node_values(
      libfdata_tree_node_t *node,
      intptr_t *file_io_handle,
@@ -325,6 +471,25 @@ int libfdata_tree_node_get_number_of_leaf_nodes(
      uint8_t read_flags,
      libcerror_error_t **error );
 
+int libfdata_tree_node_find_leaf_node_by_index(
+     libfdata_tree_node_t *node,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     int leaf_node_index,
+     uint8_t is_deleted,
+     libfdata_tree_node_t **leaf_node,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
+int libfdata_tree_node_find_deleted_branch_leaf_node_by_index(
+     libfdata_tree_node_t *node,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     int deleted_leaf_node_index,
+     libfdata_tree_node_t **deleted_leaf_node,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
 int libfdata_tree_node_get_leaf_node_by_index(
      libfdata_tree_node_t *node,
      intptr_t *file_io_handle,
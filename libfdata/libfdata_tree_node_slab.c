@@ -0,0 +1,341 @@
+/*
+ * The tree node slab functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfdata_libcerror.h"
+#include "libfdata_tree_node_slab.h"
+
+/* The alignment of the elements, must be a power of 2
+ */
+#define LIBFDATA_TREE_NODE_SLAB_ELEMENT_ALIGNMENT	16
+
+/* Aligns a size to the element alignment
+ */
+#define libfdata_tree_node_slab_align_size( size ) \
+	( ( ( size ) + ( LIBFDATA_TREE_NODE_SLAB_ELEMENT_ALIGNMENT - 1 ) ) & ~( (size_t) LIBFDATA_TREE_NODE_SLAB_ELEMENT_ALIGNMENT - 1 ) )
+
+/* The size of the block header, the elements are stored directly after it
+ */
+#define LIBFDATA_TREE_NODE_SLAB_BLOCK_HEADER_SIZE \
+	libfdata_tree_node_slab_align_size( sizeof( libfdata_tree_node_slab_block_t ) )
+
+/* Creates a slab
+ * Make sure the value slab is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_node_slab_initialize(
+     libfdata_tree_node_slab_t **slab,
+     size_t element_size,
+     int number_of_elements_per_block,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_tree_node_slab_initialize";
+
+	if( slab == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid slab.",
+		 function );
+
+		return( -1 );
+	}
+	if( *slab != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid slab value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( element_size == 0 )
+	 || ( element_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_size < sizeof( uint8_t * ) )
+	{
+		element_size = sizeof( uint8_t * );
+	}
+	element_size = libfdata_tree_node_slab_align_size(
+	                element_size );
+
+	if( ( number_of_elements_per_block <= 0 )
+	 || ( (size_t) number_of_elements_per_block > ( ( (size_t) SSIZE_MAX - LIBFDATA_TREE_NODE_SLAB_BLOCK_HEADER_SIZE ) / element_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of elements per block value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*slab = memory_allocate_structure(
+	         libfdata_tree_node_slab_t );
+
+	if( *slab == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slab.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *slab,
+	     0,
+	     sizeof( libfdata_tree_node_slab_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear slab.",
+		 function );
+
+		goto on_error;
+	}
+	( *slab )->element_size                 = element_size;
+	( *slab )->number_of_elements_per_block = number_of_elements_per_block;
+
+	return( 1 );
+
+on_error:
+	if( *slab != NULL )
+	{
+		memory_free(
+		 *slab );
+
+		*slab = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a slab
+ * All the elements are freed at once, including those that were not freed individually
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_node_slab_free(
+     libfdata_tree_node_slab_t **slab,
+     libcerror_error_t **error )
+{
+	libfdata_tree_node_slab_block_t *block = NULL;
+	static char *function                  = "libfdata_tree_node_slab_free";
+
+	if( slab == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid slab.",
+		 function );
+
+		return( -1 );
+	}
+	if( *slab != NULL )
+	{
+		while( ( *slab )->blocks != NULL )
+		{
+			block             = ( *slab )->blocks;
+			( *slab )->blocks = block->next_block;
+
+			memory_free(
+			 block );
+		}
+		memory_free(
+		 *slab );
+
+		*slab = NULL;
+	}
+	return( 1 );
+}
+
+/* Allocates an element
+ * The element is cleared
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_node_slab_allocate_element(
+     libfdata_tree_node_slab_t *slab,
+     intptr_t **element,
+     libcerror_error_t **error )
+{
+	libfdata_tree_node_slab_block_t *block = NULL;
+	uint8_t *slab_element                  = NULL;
+	static char *function                  = "libfdata_tree_node_slab_allocate_element";
+
+	if( slab == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid slab.",
+		 function );
+
+		return( -1 );
+	}
+	if( element == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element.",
+		 function );
+
+		return( -1 );
+	}
+	if( slab->free_elements != NULL )
+	{
+		/* Reuse an element that was freed before
+		 */
+		slab_element = slab->free_elements;
+
+		slab->free_elements = *( (uint8_t **) slab_element );
+	}
+	else
+	{
+		block = slab->blocks;
+
+		if( ( block == NULL )
+		 || ( block->number_of_used_elements >= slab->number_of_elements_per_block ) )
+		{
+			block = (libfdata_tree_node_slab_block_t *) memory_allocate(
+			                                             LIBFDATA_TREE_NODE_SLAB_BLOCK_HEADER_SIZE + ( slab->element_size * slab->number_of_elements_per_block ) );
+
+			if( block == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create block.",
+				 function );
+
+				return( -1 );
+			}
+			block->next_block              = slab->blocks;
+			block->number_of_used_elements = 0;
+
+			slab->blocks = block;
+		}
+		slab_element = &( ( (uint8_t *) block )[ LIBFDATA_TREE_NODE_SLAB_BLOCK_HEADER_SIZE + ( slab->element_size * block->number_of_used_elements ) ] );
+
+		block->number_of_used_elements += 1;
+	}
+	if( memory_set(
+	     slab_element,
+	     0,
+	     slab->element_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear element.",
+		 function );
+
+		*( (uint8_t **) slab_element ) = slab->free_elements;
+		slab->free_elements            = slab_element;
+
+		return( -1 );
+	}
+	slab->number_of_allocated_elements += 1;
+
+	*element = (intptr_t *) slab_element;
+
+	return( 1 );
+}
+
+/* Frees an element
+ * The element is kept by the slab to be reused
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_tree_node_slab_free_element(
+     libfdata_tree_node_slab_t *slab,
+     intptr_t *element,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_tree_node_slab_free_element";
+
+	if( slab == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid slab.",
+		 function );
+
+		return( -1 );
+	}
+	if( element == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element.",
+		 function );
+
+		return( -1 );
+	}
+	if( slab->number_of_allocated_elements <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid slab - number of allocated elements value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*( (uint8_t **) element ) = slab->free_elements;
+	slab->free_elements       = (uint8_t *) element;
+
+	slab->number_of_allocated_elements -= 1;
+
+	return( 1 );
+}
+
@@ -0,0 +1,101 @@
+/*
+ * The tree node slab functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _LIBFDATA_TREE_NODE_SLAB_H )
+#define _LIBFDATA_TREE_NODE_SLAB_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfdata_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfdata_tree_node_slab_block libfdata_tree_node_slab_block_t;
+
+struct libfdata_tree_node_slab_block
+{
+	/* The next block
+	 */
+	libfdata_tree_node_slab_block_t *next_block;
+
+	/* The number of used elements
+	 */
+	int number_of_used_elements;
+};
+
+typedef struct libfdata_tree_node_slab libfdata_tree_node_slab_t;
+
+struct libfdata_tree_node_slab
+{
+	/* The element size
+	 * this value is a multiple of the element alignment
+	 */
+	size_t element_size;
+
+	/* The number of elements per block
+	 */
+	int number_of_elements_per_block;
+
+	/* The blocks
+	 * the first block is the one elements are currently allocated from
+	 */
+	libfdata_tree_node_slab_block_t *blocks;
+
+	/* The free elements
+	 * the first bytes of a free element contain a reference to the next free element
+	 */
+	uint8_t *free_elements;
+
+	/* The number of allocated elements
+	 */
+	int number_of_allocated_elements;
+};
+
+int libfdata_tree_node_slab_initialize(
+     libfdata_tree_node_slab_t **slab,
+     size_t element_size,
+     int number_of_elements_per_block,
+     libcerror_error_t **error );
+
+int libfdata_tree_node_slab_free(
+     libfdata_tree_node_slab_t **slab,
+     libcerror_error_t **error );
+
+int libfdata_tree_node_slab_allocate_element(
+     libfdata_tree_node_slab_t *slab,
+     intptr_t **element,
+     libcerror_error_t **error );
+
+int libfdata_tree_node_slab_free_element(
+     libfdata_tree_node_slab_t *slab,
+     intptr_t *element,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFDATA_TREE_NODE_SLAB_H ) */
+
@@ -27,6 +27,7 @@
 #include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libcnotify.h"
+#include "libfdata_libcthreads.h"
 #include "libfdata_libfcache.h"
 #include "libfdata_mapped_range.h"
 #include "libfdata_range.h"
@@ -35,6 +36,24 @@
 #include "libfdata_unused.h"
 #include "libfdata_vector.h"
 
+/* The number of consecutive sequential element retrievals after which
+ * the following elements are read ahead
+ */
+#define LIBFDATA_VECTOR_READ_AHEAD_SEQUENTIAL_ACCESS_THRESHOLD		2
+
+/* The maximum number of elements that are read ahead
+ */
+#define LIBFDATA_VECTOR_MAXIMUM_NUMBER_OF_READ_AHEAD_ELEMENTS		16
+
+/* The number of chunks per thread in which the elements are processed
+ * by libfdata_vector_parallel_for_each
+ */
+#define LIBFDATA_VECTOR_FOR_EACH_NUMBER_OF_CHUNKS_PER_THREAD		4
+
+/* The minimum number of elements of a chunk
+ */
+#define LIBFDATA_VECTOR_FOR_EACH_MINIMUM_CHUNK_SIZE			16
+
 /* Creates a vector
  * Make sure the value vector is referencing, is set to NULL
  *
@@ -192,6 +211,7 @@ int libfdata_vector_initialize(
 	}
 	internal_vector->element_data_size  = element_data_size;
 	internal_vector->flags             |= flags;
+	internal_vector->last_element_index = -1;
 	internal_vector->data_handle        = data_handle;
 	internal_vector->free_data_handle   = free_data_handle;
 	internal_vector->clone_data_handle  = clone_data_handle;
@@ -456,10 +476,12 @@ int libfdata_vector_clone(
 	internal_destination_vector->element_data_size  = internal_source_vector->element_data_size;
 	internal_destination_vector->timestamp          = internal_source_vector->timestamp;
 	internal_destination_vector->flags              = internal_source_vector->flags | LIBFDATA_DATA_HANDLE_FLAG_MANAGED;
+	internal_destination_vector->last_element_index = -1;
 	internal_destination_vector->data_handle        = internal_source_vector->data_handle;
 	internal_destination_vector->free_data_handle   = internal_source_vector->free_data_handle;
 	internal_destination_vector->clone_data_handle  = internal_source_vector->clone_data_handle;
 	internal_destination_vector->read_element_data  = internal_source_vector->read_element_data;
+	internal_destination_vector->read_elements_data = internal_source_vector->read_elements_data;
 	internal_destination_vector->write_element_data = internal_source_vector->write_element_data;
 
 	return( 1 );
@@ -487,6 +509,51 @@ on_error:
 	return( -1 );
 }
 
+/* Sets the read elements data function
+ * The function reads the data of a number of consecutive elements, which is
+ * stored contiguously in a single segment, and sets their values in the cache
+ * It is used to read ahead the elements following an element on sequential access,
+ * without it no elements are read ahead
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_vector_set_read_elements_data_function(
+     libfdata_vector_t *vector,
+     int (*read_elements_data)(
+            intptr_t *data_handle,
+            intptr_t *file_io_handle,
+            libfdata_vector_t *vector,
+            libfcache_cache_t *cache,
+            int first_element_index,
+            int number_of_elements,
+            int elements_data_file_index,
+            off64_t elements_data_offset,
+            size64_t elements_data_size,
+            uint32_t elements_data_flags,
+            uint8_t read_flags,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	libfdata_internal_vector_t *internal_vector = NULL;
+	static char *function                       = "libfdata_vector_set_read_elements_data_function";
+
+	if( vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid vector.",
+		 function );
+
+		return( -1 );
+	}
+	internal_vector = (libfdata_internal_vector_t *) vector;
+
+	internal_vector->read_elements_data = read_elements_data;
+
+	return( 1 );
+}
+
 /* Segment functions
  */
 
@@ -1362,22 +1429,259 @@ int libfdata_vector_get_element_index_at_offset(
 /* Vector element value functions
  */
 
+/* Reads the value of a specific element together with the values of the elements following it
+ * The data of the elements is read with a single call to the read elements data function
+ * and is bounded by the segment that contains the element, the number of cache entries
+ * and the maximum element index, if not -1.
+ * The elements end before the first following element that is already cached or
+ * that would replace the cache entry of the element
+ * Returns 1 if successful, 0 if the elements were not read or -1 on error
+ */
+int libfdata_vector_read_ahead_element_values(
+     libfdata_internal_vector_t *internal_vector,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     int element_index,
+     int maximum_element_index,
+     libfdata_range_t *segment_data_range,
+     off64_t element_data_offset,
+     int cache_entry_index,
+     int number_of_cache_entries,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value   = NULL;
+	static char *function                  = "libfdata_vector_read_ahead_element_values";
+	size64_t remaining_segment_size        = 0;
+	off64_t cache_value_offset             = (off64_t) -1;
+	off64_t read_ahead_element_data_offset = 0;
+	time_t cache_value_timestamp           = 0;
+	int cache_value_file_index             = -1;
+	int maximum_number_of_elements         = 0;
+	int number_of_elements                 = 0;
+	int read_ahead_cache_entry_index       = 0;
+	int read_ahead_element_index           = 0;
+
+	if( internal_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_vector->element_data_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid vector - element data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_data_range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment data range.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( element_data_offset < segment_data_range->offset )
+	 || ( (size64_t) ( element_data_offset - segment_data_range->offset ) > segment_data_range->size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_vector->read_elements_data == NULL )
+	{
+		return( 0 );
+	}
+	/* Only read the elements that are fully contained in the segment
+	 * of the element and in the vector
+	 */
+	remaining_segment_size = segment_data_range->size - (size64_t) ( element_data_offset - segment_data_range->offset );
+
+	if( ( remaining_segment_size / internal_vector->element_data_size ) < (size64_t) LIBFDATA_VECTOR_MAXIMUM_NUMBER_OF_READ_AHEAD_ELEMENTS )
+	{
+		maximum_number_of_elements = (int) ( remaining_segment_size / internal_vector->element_data_size );
+	}
+	else
+	{
+		maximum_number_of_elements = LIBFDATA_VECTOR_MAXIMUM_NUMBER_OF_READ_AHEAD_ELEMENTS;
+	}
+	if( ( internal_vector->size / internal_vector->element_data_size ) <= (size64_t) element_index )
+	{
+		return( 0 );
+	}
+	if( ( ( internal_vector->size / internal_vector->element_data_size ) - element_index ) < (size64_t) maximum_number_of_elements )
+	{
+		maximum_number_of_elements = (int) ( ( internal_vector->size / internal_vector->element_data_size ) - element_index );
+	}
+	if( maximum_number_of_elements > number_of_cache_entries )
+	{
+		maximum_number_of_elements = number_of_cache_entries;
+	}
+	if( maximum_element_index >= 0 )
+	{
+		if( maximum_element_index < element_index )
+		{
+			return( 0 );
+		}
+		if( ( maximum_element_index - element_index ) < ( maximum_number_of_elements - 1 ) )
+		{
+			maximum_number_of_elements = maximum_element_index - element_index + 1;
+		}
+	}
+	read_ahead_element_index       = element_index;
+	read_ahead_element_data_offset = element_data_offset;
+
+	for( number_of_elements = 1;
+	     number_of_elements < maximum_number_of_elements;
+	     number_of_elements++ )
+	{
+		read_ahead_element_index       += 1;
+		read_ahead_element_data_offset += internal_vector->element_data_size;
+
+		if( internal_vector->calculate_cache_entry_index == NULL )
+		{
+			read_ahead_cache_entry_index = read_ahead_element_index % number_of_cache_entries;
+		}
+		else
+		{
+			read_ahead_cache_entry_index = internal_vector->calculate_cache_entry_index(
+			                                read_ahead_element_index,
+			                                segment_data_range->file_index,
+			                                read_ahead_element_data_offset,
+			                                internal_vector->element_data_size,
+			                                segment_data_range->flags,
+			                                number_of_cache_entries );
+		}
+		if( read_ahead_cache_entry_index == cache_entry_index )
+		{
+			break;
+		}
+		if( libfcache_cache_get_value_by_index(
+		     cache,
+		     read_ahead_cache_entry_index,
+		     &cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache entry: %d from cache.",
+			 function,
+			 read_ahead_cache_entry_index );
+
+			return( -1 );
+		}
+		cache_value_file_index = -1;
+		cache_value_offset     = (off64_t) -1;
+		cache_value_timestamp  = 0;
+
+		if( cache_value != NULL )
+		{
+			if( libfcache_cache_value_get_identifier(
+			     cache_value,
+			     &cache_value_file_index,
+			     &cache_value_offset,
+			     &cache_value_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve cache value identifier.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( ( segment_data_range->file_index == cache_value_file_index )
+		 && ( read_ahead_element_data_offset == cache_value_offset )
+		 && ( internal_vector->timestamp == cache_value_timestamp ) )
+		{
+			break;
+		}
+	}
+	if( number_of_elements <= 1 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading elements: %d to %d data at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 element_index,
+		 element_index + number_of_elements - 1,
+		 element_data_offset,
+		 element_data_offset );
+	}
+#endif
+	/* The following elements are read speculatively, hence a read error
+	 * falls back to reading the element on its own
+	 */
+	if( internal_vector->read_elements_data(
+	     internal_vector->data_handle,
+	     file_io_handle,
+	     (libfdata_vector_t *) internal_vector,
+	     cache,
+	     element_index,
+	     number_of_elements,
+	     segment_data_range->file_index,
+	     element_data_offset,
+	     (size64_t) number_of_elements * internal_vector->element_data_size,
+	     segment_data_range->flags,
+	     read_flags,
+	     NULL ) != 1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the value of a specific element
+ * The number of sequential accesses is the number of elements that were retrieved
+ * in ascending order directly before the element, the elements that follow
+ * are read ahead if this exceeds the read ahead threshold and a read elements
+ * data function was set. The elements that are read ahead do not exceed
+ * the maximum element index, if not -1
  * Returns 1 if successful or -1 on error
  */
-int libfdata_vector_get_element_value_by_index(
+int libfdata_vector_read_element_value(
      libfdata_vector_t *vector,
      intptr_t *file_io_handle,
      libfcache_cache_t *cache,
      int element_index,
+     int maximum_element_index,
      intptr_t **element_value,
+     int number_of_sequential_accesses,
      uint8_t read_flags,
      libcerror_error_t **error )
 {
 	libfcache_cache_value_t *cache_value        = NULL;
 	libfdata_internal_vector_t *internal_vector = NULL;
 	libfdata_range_t *segment_data_range        = NULL;
-	static char *function                       = "libfdata_vector_get_element_value_by_index";
+	static char *function                       = "libfdata_vector_read_element_value";
 	off64_t cache_value_offset                  = (off64_t) -1;
 	off64_t element_data_offset                 = 0;
 	time_t cache_value_timestamp                = 0;
@@ -1516,22 +1820,24 @@ int libfdata_vector_get_element_value_by_index(
 
 		return( -1 );
 	}
+	/* The cache entry index is calculated once and reused after the element data was read
+	 */
+	if( internal_vector->calculate_cache_entry_index == NULL )
+	{
+		cache_entry_index = element_index % number_of_cache_entries;
+	}
+	else
+	{
+		cache_entry_index = internal_vector->calculate_cache_entry_index(
+		                     element_index,
+		                     element_data_file_index,
+		                     element_data_offset,
+		                     internal_vector->element_data_size,
+		                     element_data_flags,
+		                     number_of_cache_entries );
+	}
 	if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
 	{
-		if( internal_vector->calculate_cache_entry_index == NULL )
-		{
-			cache_entry_index = element_index % number_of_cache_entries;
-		}
-		else
-		{
-			cache_entry_index = internal_vector->calculate_cache_entry_index(
-			                     element_index,
-			                     element_data_file_index,
-			                     element_data_offset,
-			                     internal_vector->element_data_size,
-			                     element_data_flags,
-			                     number_of_cache_entries );
-		}
 		if( libfcache_cache_get_value_by_index(
 		     cache,
 		     cache_entry_index,
@@ -1610,42 +1916,60 @@ int libfdata_vector_get_element_value_by_index(
 			 internal_vector->element_data_size );
 		}
 #endif
-		if( internal_vector->read_element_data(
-		     internal_vector->data_handle,
-		     file_io_handle,
-		     vector,
-		     cache,
-		     element_index,
-		     element_data_file_index,
-		     element_data_offset,
-		     internal_vector->element_data_size,
-		     element_data_flags,
-		     read_flags,
-		     error ) != 1 )
+		if( ( ( read_flags & ( LIBFDATA_READ_FLAG_IGNORE_CACHE | LIBFDATA_READ_FLAG_NO_READ_AHEAD ) ) == 0 )
+		 && ( number_of_sequential_accesses >= LIBFDATA_VECTOR_READ_AHEAD_SEQUENTIAL_ACCESS_THRESHOLD ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read element data at offset: 0x%08" PRIx64 ".",
-			 function,
-			 element_data_offset );
+			result = libfdata_vector_read_ahead_element_values(
+			          internal_vector,
+			          file_io_handle,
+			          cache,
+			          element_index,
+			          maximum_element_index,
+			          segment_data_range,
+			          element_data_offset,
+			          cache_entry_index,
+			          number_of_cache_entries,
+			          read_flags,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read ahead element values from element: %d.",
+				 function,
+				 element_index );
 
-			return( -1 );
-		}
-		if( internal_vector->calculate_cache_entry_index == NULL )
-		{
-			cache_entry_index = element_index % number_of_cache_entries;
+				return( -1 );
+			}
 		}
-		else
+		if( result == 0 )
 		{
-			cache_entry_index = internal_vector->calculate_cache_entry_index(
-			                     element_index,
-			                     element_data_file_index,
-			                     element_data_offset,
-			                     internal_vector->element_data_size,
-			                     element_data_flags,
-			                     number_of_cache_entries );
+			if( internal_vector->read_element_data(
+			     internal_vector->data_handle,
+			     file_io_handle,
+			     vector,
+			     cache,
+			     element_index,
+			     element_data_file_index,
+			     element_data_offset,
+			     internal_vector->element_data_size,
+			     element_data_flags,
+			     read_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read element data at offset: 0x%08" PRIx64 ".",
+				 function,
+				 element_data_offset );
+
+				return( -1 );
+			}
 		}
 		if( libfcache_cache_get_value_by_index(
 		     cache,
@@ -1713,37 +2037,102 @@ int libfdata_vector_get_element_value_by_index(
 	return( 1 );
 }
 
-/* Retrieves the value an element at a specific offset
+/* Retrieves the value of a specific element
  * Returns 1 if successful or -1 on error
  */
-int libfdata_vector_get_element_value_at_offset(
+int libfdata_vector_get_element_value_by_index(
      libfdata_vector_t *vector,
      intptr_t *file_io_handle,
      libfcache_cache_t *cache,
-     off64_t element_value_offset,
-     off64_t *element_data_offset,
+     int element_index,
      intptr_t **element_value,
      uint8_t read_flags,
      libcerror_error_t **error )
 {
-	static char *function = "libfdata_vector_get_element_value_at_offset";
-	int element_index     = 0;
+	libfdata_internal_vector_t *internal_vector = NULL;
+	static char *function                       = "libfdata_vector_get_element_value_by_index";
 
-	if( libfdata_vector_get_element_index_at_offset(
-	     vector,
-	     element_value_offset,
-	     &element_index,
-	     element_data_offset,
-	     error ) != 1 )
+	if( vector == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element index at offset: 0x%08" PRIx64 ".",
-		 function,
-		 element_value_offset );
-
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid vector.",
+		 function );
+
+		return( -1 );
+	}
+	internal_vector = (libfdata_internal_vector_t *) vector;
+
+	if( element_index == ( internal_vector->last_element_index + 1 ) )
+	{
+		if( internal_vector->number_of_sequential_accesses < INT_MAX )
+		{
+			internal_vector->number_of_sequential_accesses += 1;
+		}
+	}
+	else if( element_index != internal_vector->last_element_index )
+	{
+		internal_vector->number_of_sequential_accesses = 0;
+	}
+	internal_vector->last_element_index = element_index;
+
+	if( libfdata_vector_read_element_value(
+	     vector,
+	     file_io_handle,
+	     cache,
+	     element_index,
+	     -1,
+	     element_value,
+	     internal_vector->number_of_sequential_accesses,
+	     read_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element: %d value.",
+		 function,
+		 element_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the value an element at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_vector_get_element_value_at_offset(
+     libfdata_vector_t *vector,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     off64_t element_value_offset,
+     off64_t *element_data_offset,
+     intptr_t **element_value,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_vector_get_element_value_at_offset";
+	int element_index     = 0;
+
+	if( libfdata_vector_get_element_index_at_offset(
+	     vector,
+	     element_value_offset,
+	     &element_index,
+	     element_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element index at offset: 0x%08" PRIx64 ".",
+		 function,
+		 element_value_offset );
+
 		return( -1 );
 	}
 	if( libfdata_vector_get_element_value_by_index(
@@ -1954,6 +2343,699 @@ int libfdata_vector_set_element_value_by_index(
 	return( 1 );
 }
 
+/* Determines the chunks in which the elements are processed by libfdata_vector_parallel_for_each
+ * A chunk only contains the elements that start in a single segment, this allows
+ * the elements of a chunk to be read sequentially. The segments are split
+ * into multiple chunks per thread, so that threads that finish early can
+ * take over the remaining chunks.
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_vector_get_for_each_chunks(
+     libfdata_internal_vector_t *internal_vector,
+     int maximum_number_of_threads,
+     libfdata_vector_for_each_chunk_t **chunks,
+     int *number_of_chunks,
+     libcerror_error_t **error )
+{
+	libfdata_range_t *segment_data_range = NULL;
+	static char *function                = "libfdata_vector_get_for_each_chunks";
+	size64_t segment_end_offset          = 0;
+	size64_t segment_start_offset        = 0;
+	int chunk_index                      = 0;
+	int element_index                    = 0;
+	int end_element_index                = 0;
+	int maximum_chunk_size               = 0;
+	int number_of_elements               = 0;
+	int number_of_segments               = 0;
+	int pass                             = 0;
+	int segment_index                    = 0;
+
+	if( internal_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunks != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunks value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_vector_get_number_of_elements(
+	     (libfdata_vector_t *) internal_vector,
+	     &number_of_elements,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_vector->segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_threads < 1 )
+	{
+		maximum_number_of_threads = 1;
+	}
+	maximum_chunk_size = number_of_elements / ( maximum_number_of_threads * LIBFDATA_VECTOR_FOR_EACH_NUMBER_OF_CHUNKS_PER_THREAD );
+
+	if( maximum_chunk_size < LIBFDATA_VECTOR_FOR_EACH_MINIMUM_CHUNK_SIZE )
+	{
+		maximum_chunk_size = LIBFDATA_VECTOR_FOR_EACH_MINIMUM_CHUNK_SIZE;
+	}
+	/* The first pass determines the number of chunks
+	 * the second pass fills the chunks
+	 */
+	for( pass = 0;
+	     pass < 2;
+	     pass++ )
+	{
+		chunk_index          = 0;
+		segment_start_offset = 0;
+
+		for( segment_index = 0;
+		     segment_index < number_of_segments;
+		     segment_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_vector->segments_array,
+			     segment_index,
+			     (intptr_t **) &segment_data_range,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment data range: %d from array.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+			if( segment_data_range == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing segment data range: %d.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+			segment_end_offset = segment_start_offset + segment_data_range->size;
+
+			/* The chunk of an element is determined by the segment that contains its first byte
+			 */
+			element_index = (int) ( ( segment_start_offset + internal_vector->element_data_size - 1 ) / internal_vector->element_data_size );
+
+			if( ( ( segment_end_offset + internal_vector->element_data_size - 1 ) / internal_vector->element_data_size ) < (size64_t) number_of_elements )
+			{
+				end_element_index = (int) ( ( segment_end_offset + internal_vector->element_data_size - 1 ) / internal_vector->element_data_size );
+			}
+			else
+			{
+				end_element_index = number_of_elements;
+			}
+			while( element_index < end_element_index )
+			{
+				if( pass != 0 )
+				{
+					( *chunks )[ chunk_index ].first_element_index = element_index;
+					( *chunks )[ chunk_index ].number_of_elements  = end_element_index - element_index;
+
+					if( ( *chunks )[ chunk_index ].number_of_elements > maximum_chunk_size )
+					{
+						( *chunks )[ chunk_index ].number_of_elements = maximum_chunk_size;
+					}
+				}
+				chunk_index++;
+
+				if( ( end_element_index - element_index ) <= maximum_chunk_size )
+				{
+					break;
+				}
+				element_index += maximum_chunk_size;
+			}
+			segment_start_offset = segment_end_offset;
+		}
+		if( ( pass != 0 )
+		 || ( chunk_index == 0 ) )
+		{
+			break;
+		}
+		*chunks = (libfdata_vector_for_each_chunk_t *) memory_allocate(
+		                                                sizeof( libfdata_vector_for_each_chunk_t ) * (size_t) chunk_index );
+
+		if( *chunks == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create chunks.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	*number_of_chunks = chunk_index;
+
+	return( 1 );
+
+on_error:
+	if( *chunks != NULL )
+	{
+		memory_free(
+		 *chunks );
+
+		*chunks = NULL;
+	}
+	return( -1 );
+}
+
+/* Retrieves the values of the elements of a chunk and passes them to the visit element value function
+ * The chunk is read with its own cache, so that chunks can be processed
+ * on multiple threads without sharing a cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_vector_visit_chunk(
+     libfdata_vector_for_each_arguments_t *arguments,
+     libfdata_vector_for_each_chunk_t *chunk,
+     libcerror_error_t **error )
+{
+	libfcache_cache_t *cache = NULL;
+	intptr_t *element_value  = NULL;
+	static char *function    = "libfdata_vector_visit_chunk";
+	int element_index        = 0;
+	int last_element_index   = 0;
+
+	if( arguments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arguments.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_initialize(
+	     &cache,
+	     arguments->number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	last_element_index = chunk->first_element_index + chunk->number_of_elements;
+
+	for( element_index = chunk->first_element_index;
+	     element_index < last_element_index;
+	     element_index++ )
+	{
+		/* The elements of a chunk are retrieved in ascending order, hence the number
+		 * of sequential accesses is tracked per chunk instead of by the vector
+		 */
+		if( libfdata_vector_read_element_value(
+		     arguments->vector,
+		     arguments->file_io_handle,
+		     cache,
+		     element_index,
+		     chunk->first_element_index + chunk->number_of_elements - 1,
+		     &element_value,
+		     element_index - chunk->first_element_index,
+		     arguments->read_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d value.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		if( arguments->visit_element_value(
+		     element_value,
+		     element_index,
+		     arguments->visitor_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to visit element: %d value.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	if( libfcache_cache_free(
+	     &cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( cache != NULL )
+	{
+		libfcache_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+
+/* Processes a chunk on a worker thread
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_vector_parallel_for_each_callback(
+     libfdata_vector_for_each_chunk_t *chunk,
+     libfdata_vector_for_each_arguments_t *arguments )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_failed     = 0;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	/* Remaining chunks are skipped once a chunk could not be processed
+	 */
+	if( libcthreads_mutex_grab(
+	     arguments->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	number_of_failed = arguments->number_of_failed_chunks;
+
+	libcthreads_mutex_release(
+	 arguments->mutex,
+	 NULL );
+
+	if( number_of_failed != 0 )
+	{
+		return( 1 );
+	}
+	if( libfdata_vector_visit_chunk(
+	     arguments,
+	     chunk,
+	     &error ) == 1 )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_grab(
+	     arguments->mutex,
+	     NULL ) == 1 )
+	{
+		arguments->number_of_failed_chunks += 1;
+
+		libcthreads_mutex_release(
+		 arguments->mutex,
+		 NULL );
+	}
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT ) */
+
+/* Retrieves the value of every element and passes it to the visit element value function
+ * The elements are split into chunks that do not cross segment boundaries.
+ * If the maximum number of threads is more than 1 and multi-thread support
+ * is available the chunks are distributed over a pool of worker threads,
+ * otherwise they are processed on the calling thread.
+ *
+ * Every chunk is read with its own cache of number of cache entries,
+ * the caches are freed when the chunk has been processed. The element value
+ * passed to the visit element value function is only valid during the call.
+ *
+ * When the chunks are processed on multiple threads, the visit element value
+ * function is called concurrently and the read element data function of
+ * the vector and the file IO handle must be safe to use from multiple threads.
+ * The elements are visited in ascending order within a chunk, but the order
+ * between chunks is undefined.
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_vector_parallel_for_each(
+     libfdata_vector_t *vector,
+     intptr_t *file_io_handle,
+     int number_of_cache_entries,
+     int maximum_number_of_threads,
+     int (*visit_element_value)(
+            intptr_t *element_value,
+            int element_index,
+            intptr_t *visitor_data,
+            libcerror_error_t **error ),
+     intptr_t *visitor_data,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfdata_vector_for_each_arguments_t arguments;
+
+	libfdata_internal_vector_t *internal_vector = NULL;
+	libfdata_vector_for_each_chunk_t *chunks    = NULL;
+	static char *function                       = "libfdata_vector_parallel_for_each";
+	int chunk_index                             = 0;
+	int number_of_chunks                        = 0;
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool      = NULL;
+	int number_of_threads                       = 0;
+#endif
+
+	if( vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid vector.",
+		 function );
+
+		return( -1 );
+	}
+	internal_vector = (libfdata_internal_vector_t *) vector;
+
+	if( internal_vector->read_element_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid vector - missing read element data function.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of cache entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_threads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of threads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( visit_element_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid visit element value function.",
+		 function );
+
+		return( -1 );
+	}
+	arguments.vector                  = vector;
+	arguments.file_io_handle          = file_io_handle;
+	arguments.number_of_cache_entries = number_of_cache_entries;
+	arguments.visit_element_value     = visit_element_value;
+	arguments.visitor_data            = visitor_data;
+	arguments.read_flags              = read_flags;
+	arguments.number_of_failed_chunks = 0;
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	arguments.mutex                   = NULL;
+#endif
+
+	if( libfdata_vector_get_for_each_chunks(
+	     internal_vector,
+	     maximum_number_of_threads,
+	     &chunks,
+	     &number_of_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine chunks.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	/* Only use a thread pool if there are multiple chunks to process
+	 */
+	if( ( maximum_number_of_threads > 1 )
+	 && ( number_of_chunks > 1 ) )
+	{
+		number_of_threads = maximum_number_of_threads;
+
+		if( number_of_threads > number_of_chunks )
+		{
+			number_of_threads = number_of_chunks;
+		}
+		if( libcthreads_mutex_initialize(
+		     &( arguments.mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     number_of_threads,
+		     number_of_chunks,
+		     (int (*)(intptr_t *, void *)) &libfdata_vector_parallel_for_each_callback,
+		     (void *) &arguments,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		for( chunk_index = 0;
+		     chunk_index < number_of_chunks;
+		     chunk_index++ )
+		{
+			if( libcthreads_thread_pool_push(
+			     thread_pool,
+			     (intptr_t *) &( chunks[ chunk_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push chunk: %d onto thread pool.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_mutex_free(
+		     &( arguments.mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( arguments.number_of_failed_chunks != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to process %d chunks.",
+			 function,
+			 arguments.number_of_failed_chunks );
+
+			goto on_error;
+		}
+	}
+	else
+#endif /* defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT ) */
+	{
+		for( chunk_index = 0;
+		     chunk_index < number_of_chunks;
+		     chunk_index++ )
+		{
+			if( libfdata_vector_visit_chunk(
+			     &arguments,
+			     &( chunks[ chunk_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to process chunk: %d.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+	}
+	if( chunks != NULL )
+	{
+		memory_free(
+		 chunks );
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	if( arguments.mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( arguments.mutex ),
+		 NULL );
+	}
+#endif
+	if( chunks != NULL )
+	{
+		memory_free(
+		 chunks );
+	}
+	return( -1 );
+}
+
 /* Retrieves the size
  * Returns 1 if successful or -1 on error
  */
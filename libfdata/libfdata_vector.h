@@ -28,7 +28,9 @@
 #include "libfdata_extern.h"
 #include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
+#include "libfdata_libcthreads.h"
 #include "libfdata_libfcache.h"
+#include "libfdata_range.h"
 #include "libfdata_types.h"
 
 #if defined( __cplusplus )
@@ -63,6 +65,14 @@ struct libfdata_internal_vector
 	 */
 	uint8_t flags;
 
+	/* The index of the most recently retrieved element
+	 */
+	int last_element_index;
+
+	/* The number of consecutive sequential element retrievals
+	 */
+	int number_of_sequential_accesses;
+
 	/* The calculate cache entry index value
 	 */
 	int (*calculate_cache_entry_index)(
@@ -105,6 +115,22 @@ struct libfdata_internal_vector
 	       uint8_t read_flags,
 	       libcerror_error_t **error );
 
+	/* The read elements data function
+	 */
+	int (*read_elements_data)(
+	       intptr_t *data_handle,
+	       intptr_t *file_io_handle,
+	       libfdata_vector_t *vector,
+	       libfcache_cache_t *cache,
+	       int first_element_index,
+	       int number_of_elements,
+	       int elements_data_file_index,
+	       off64_t elements_data_offset,
+	       size64_t elements_data_size,
+	       uint32_t elements_data_flags,
+	       uint8_t read_flags,
+	       libcerror_error_t **error );
+
 	/* The write element data function
 	 */
 	int (*write_element_data)(
@@ -121,6 +147,62 @@ struct libfdata_internal_vector
 	       libcerror_error_t **error );
 };
 
+typedef struct libfdata_vector_for_each_chunk libfdata_vector_for_each_chunk_t;
+
+struct libfdata_vector_for_each_chunk
+{
+	/* The index of the first element of the chunk
+	 */
+	int first_element_index;
+
+	/* The number of elements of the chunk
+	 */
+	int number_of_elements;
+};
+
+typedef struct libfdata_vector_for_each_arguments libfdata_vector_for_each_arguments_t;
+
+struct libfdata_vector_for_each_arguments
+{
+	/* The vector
+	 */
+	libfdata_vector_t *vector;
+
+	/* The file IO handle
+	 */
+	intptr_t *file_io_handle;
+
+	/* The number of cache entries of the cache used to read a chunk
+	 */
+	int number_of_cache_entries;
+
+	/* The visit element value function
+	 */
+	int (*visit_element_value)(
+	       intptr_t *element_value,
+	       int element_index,
+	       intptr_t *visitor_data,
+	       libcerror_error_t **error );
+
+	/* The visitor data
+	 */
+	intptr_t *visitor_data;
+
+	/* The read flags
+	 */
+	uint8_t read_flags;
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+	/* The mutex that protects the number of failed chunks
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+
+	/* The number of chunks that could not be processed
+	 */
+	int number_of_failed_chunks;
+};
+
 LIBFDATA_EXTERN \
 int libfdata_vector_initialize(
      libfdata_vector_t **vector,
@@ -171,6 +253,24 @@ int libfdata_vector_clone(
      libfdata_vector_t *source_vector,
      libcerror_error_t **error );
 
+LIBFDATA_EXTERN \
+int libfdata_vector_set_read_elements_data_function(
+     libfdata_vector_t *vector,
+     int (*read_elements_data)(
+            intptr_t *data_handle,
+            intptr_t *file_io_handle,
+            libfdata_vector_t *vector,
+            libfcache_cache_t *cache,
+            int first_element_index,
+            int number_of_elements,
+            int elements_data_file_index,
+            off64_t elements_data_offset,
+            size64_t elements_data_size,
+            uint32_t elements_data_flags,
+            uint8_t read_flags,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
 /* Segment functions
  */
 LIBFDATA_EXTERN \
@@ -255,6 +355,30 @@ int libfdata_vector_get_element_index_at_offset(
 
 /* Vector element value functions
  */
+int libfdata_vector_read_ahead_element_values(
+     libfdata_internal_vector_t *internal_vector,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     int element_index,
+     int maximum_element_index,
+     libfdata_range_t *segment_data_range,
+     off64_t element_data_offset,
+     int cache_entry_index,
+     int number_of_cache_entries,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
+int libfdata_vector_read_element_value(
+     libfdata_vector_t *vector,
+     intptr_t *file_io_handle,
+     libfcache_cache_t *cache,
+     int element_index,
+     int maximum_element_index,
+     intptr_t **element_value,
+     int number_of_sequential_accesses,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
 LIBFDATA_EXTERN \
 int libfdata_vector_get_element_value_by_index(
      libfdata_vector_t *vector,
@@ -289,6 +413,41 @@ int libfdata_vector_set_element_value_by_index(
      uint8_t write_flags,
      libcerror_error_t **error );
 
+int libfdata_vector_get_for_each_chunks(
+     libfdata_internal_vector_t *internal_vector,
+     int maximum_number_of_threads,
+     libfdata_vector_for_each_chunk_t **chunks,
+     int *number_of_chunks,
+     libcerror_error_t **error );
+
+int libfdata_vector_visit_chunk(
+     libfdata_vector_for_each_arguments_t *arguments,
+     libfdata_vector_for_each_chunk_t *chunk,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT )
+
+int libfdata_vector_parallel_for_each_callback(
+     libfdata_vector_for_each_chunk_t *chunk,
+     libfdata_vector_for_each_arguments_t *arguments );
+
+#endif /* defined( HAVE_LIBFDATA_MULTI_THREAD_SUPPORT ) */
+
+LIBFDATA_EXTERN \
+int libfdata_vector_parallel_for_each(
+     libfdata_vector_t *vector,
+     intptr_t *file_io_handle,
+     int number_of_cache_entries,
+     int maximum_number_of_threads,
+     int (*visit_element_value)(
+            intptr_t *element_value,
+            int element_index,
+            intptr_t *visitor_data,
+            libcerror_error_t **error ),
+     intptr_t *visitor_data,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
 /* IO functions
  */
 LIBFDATA_EXTERN \
@@ -38,6 +38,7 @@
 #define MAXIMUM_NUMBER_OF_LEAF_VALUES		8
 #define MAXIMUM_NUMBER_OF_NODE_LEVELS		3
 #define MAXIMUM_NUMBER_OF_SUB_NODES		8
+#define NUMBER_OF_WIDE_ENTRIES			40
 
 /* Tests initializing the btree
  * Make sure the value btree is referencing, is set to NULL
@@ -252,6 +253,52 @@ int fdata_test_key_value_compare(
 	return( LIBFDATA_COMPARE_EQUAL );
 }
 
+/* Key value hash function
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_key_value_hash(
+     uint8_t *key_value,
+     uint32_t *key_value_hash,
+     libcerror_error_t **error )
+{
+	static char *function   = "fdata_test_key_value_hash";
+	ssize_t key_value_index = 0;
+	uint32_t hash           = 0x811c9dc5UL;
+
+	if( key_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key value.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_value_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key value hash.",
+		 function );
+
+		return( -1 );
+	}
+	for( key_value_index = 1;
+	     key_value_index < (ssize_t) ( key_value[ 0 ] + 1 );
+	     key_value_index++ )
+	{
+		hash ^= key_value[ key_value_index ];
+		hash *= 0x01000193UL;
+	}
+	*key_value_hash = hash;
+
+	return( 1 );
+}
+
 /* Frees the leaf value data
  * Returns 1 if successful or -1 on error
  */
@@ -587,11 +634,123 @@ on_error:
 	return( -1 );
 }
 
+/* Reads a node of a btree with wide nodes
+ * The root node contains NUMBER_OF_WIDE_ENTRIES leaf nodes
+ * of NUMBER_OF_WIDE_ENTRIES leaf values each
+ * Callback function for the btree
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_btree_read_wide_node(
+     intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     libfdata_btree_node_t *node,
+     int node_data_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t node_data_offset,
+     size64_t node_data_size FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint32_t node_data_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t *key_value FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	static char *function  = "fdata_test_btree_read_wide_node";
+	off64_t element_offset = 0;
+	int element_index      = 0;
+	int entry_index        = 0;
+	int level              = 0;
+	int result             = 0;
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle );
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle );
+	FDATA_TEST_UNREFERENCED_PARAMETER( node_data_file_index );
+	FDATA_TEST_UNREFERENCED_PARAMETER( node_data_size );
+	FDATA_TEST_UNREFERENCED_PARAMETER( node_data_flags );
+	FDATA_TEST_UNREFERENCED_PARAMETER( key_value );
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags );
+
+	if( libfdata_btree_node_get_level(
+	     node,
+	     &level,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve level from node.",
+		 function );
+
+		return( -1 );
+	}
+	if( level == 0 )
+	{
+		element_offset = NODE_DATA_SIZE;
+	}
+	else
+	{
+		element_offset = ( ( node_data_offset / NODE_DATA_SIZE ) - 1 ) * NUMBER_OF_WIDE_ENTRIES * LEAF_VALUE_DATA_SIZE;
+	}
+	for( entry_index = 0;
+	     entry_index < NUMBER_OF_WIDE_ENTRIES;
+	     entry_index++ )
+	{
+		if( level == 0 )
+		{
+			result = libfdata_btree_node_append_sub_node(
+			          node,
+			          &element_index,
+			          0,
+			          element_offset,
+			          NODE_DATA_SIZE,
+			          0,
+			          NULL,
+			          NULL,
+			          0,
+			          error );
+
+			element_offset += NODE_DATA_SIZE;
+		}
+		else
+		{
+			result = libfdata_btree_node_append_leaf_value(
+			          node,
+			          &element_index,
+			          0,
+			          element_offset,
+			          LEAF_VALUE_DATA_SIZE,
+			          0,
+			          NULL,
+			          NULL,
+			          0,
+			          error );
+
+			element_offset += LEAF_VALUE_DATA_SIZE;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
 /* Tests reading the btree
+ * The key value index mode is 0 to not use a key value index, 1 to fill it
+ * while the leaf nodes are read or 2 to build it before the leaf values are read
+ * A small number of cache entries makes the nodes on the path evict each other
  * Returns 1 if successful, 0 if not or -1 on error
  */
 int fdata_test_btree_read(
-    void )
+    int maximum_number_of_threads,
+    int key_value_index_mode,
+    int number_of_cache_entries )
 {
 	uint8_t key_value[ 8 ];
 
@@ -626,6 +785,34 @@ int fdata_test_btree_read(
 
 		goto on_error;
 	}
+	if( libfdata_btree_set_maximum_number_of_threads(
+	     btree,
+	     maximum_number_of_threads,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of threads in btree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_btree_set_key_value_hash_function(
+	     btree,
+	     (int (*)(intptr_t *, uint32_t *, libcerror_error_t **)) &fdata_test_key_value_hash,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key value hash function in btree.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfdata_btree_set_root_node(
 	     btree,
 	     0,
@@ -645,7 +832,7 @@ int fdata_test_btree_read(
 	}
 	if( libfdata_cache_initialize(
 	     &cache,
-	     128,
+	     number_of_cache_entries,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
@@ -657,6 +844,41 @@ int fdata_test_btree_read(
 
 		goto on_error;
 	}
+	if( key_value_index_mode == 1 )
+	{
+		if( libfdata_btree_enable_key_value_index(
+		     btree,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to enable key value index in btree.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else if( key_value_index_mode == 2 )
+	{
+		if( libfdata_btree_build_key_value_index(
+		     btree,
+		     NULL,
+		     cache,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to build key value index in btree.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libfdata_btree_get_number_of_leaf_values(
 	     btree,
 	     NULL,
@@ -776,6 +998,69 @@ int fdata_test_btree_read(
 		 "\n" );
 	}
 	if( result != 0 )
+	{
+		for( leaf_value_index = number_of_leaf_values - 1;
+		     leaf_value_index >= 0;
+		     leaf_value_index-- )
+		{
+			if( libfdata_btree_get_leaf_value_by_index(
+			     btree,
+			     NULL,
+			     cache,
+			     leaf_value_index,
+			     (intptr_t **) &leaf_value_data,
+			     0,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to retrieve leaf value: %d.",
+				 function,
+				 leaf_value_index );
+
+				goto on_error;
+			}
+			result = 0;
+
+			if( leaf_value_data != NULL )
+			{
+				byte_stream_copy_to_uint32_little_endian(
+				 leaf_value_data,
+				 test_leaf_value_index );
+
+				if( test_leaf_value_index == (uint32_t) leaf_value_index )
+				{
+					result = 1;
+				}
+			}
+			if( result == 0 )
+			{
+				break;
+			}
+		}
+		fprintf(
+		 stdout,
+		 "Testing get_leaf_value_by_index in reverse order\t" );
+
+		if( result == 0 )
+		{
+			fprintf(
+			 stdout,
+			 "(FAIL)" );
+		}
+		else
+		{
+			fprintf(
+			 stdout,
+			 "(PASS)" );
+		}
+		fprintf(
+		 stdout,
+		 "\n" );
+	}
+	if( result != 0 )
 	{
 /* TODO add support for different maximum number of node levels
  */
@@ -910,6 +1195,51 @@ int fdata_test_btree_read(
 				result = 1;
 			}
 		}
+		if( result != 0 )
+		{
+			/* See if the function fails gracefully with a non existing key
+			 * when the neighbouring leaf nodes are scanned
+			 */
+			key_value[ 0 ] = 0x03;
+			key_value[ 1 ] = 0x04;
+			key_value[ 2 ] = 0x07;
+			key_value[ 3 ] = 0x09;
+			key_value[ 4 ] = 0x00;
+			key_value[ 5 ] = 0x00;
+			key_value[ 6 ] = 0x00;
+			key_value[ 7 ] = 0x00;
+
+			result = libfdata_btree_get_leaf_value_by_key(
+			          btree,
+			          NULL,
+			          cache,
+			          (intptr_t *) key_value,
+			          (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &fdata_test_key_value_compare,
+			          LIBFDATA_BTREE_SEARCH_FLAG_SCAN_PREVIOUS_NODE | LIBFDATA_BTREE_SEARCH_FLAG_SCAN_NEXT_NODE,
+			          (intptr_t **) &leaf_value_data,
+			          0,
+			          &error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to retrieve leaf value by key.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				result = 0;
+			}
+			else
+			{
+				result = 1;
+			}
+		}
 		fprintf(
 		 stdout,
 		 "Testing get_leaf_value_by_key\t" );
@@ -983,6 +1313,204 @@ on_error:
 	return( -1 );
 }
 
+/* Tests reading a btree with nodes that have more entries than initially allocated
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_btree_read_wide(
+    void )
+{
+	libcerror_error_t *error       = NULL;
+	libfdata_btree_t *btree        = NULL;
+	libfdata_cache_t *cache        = NULL;
+	uint8_t *leaf_value_data       = NULL;
+	static char *function          = "fdata_test_btree_read_wide";
+	uint32_t test_leaf_value_index = 0;
+	int leaf_value_index           = 0;
+	int number_of_leaf_values      = 0;
+	int result                     = 1;
+
+	if( libfdata_btree_initialize(
+	     &btree,
+	     NULL,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_btree_node_t *, int, off64_t, size64_t, uint32_t, intptr_t *, uint8_t, libcerror_error_t **)) &fdata_test_btree_read_wide_node,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_btree_t *, libfdata_cache_t *, int, int, off64_t, size64_t, uint32_t, intptr_t *, uint8_t, libcerror_error_t **)) &fdata_test_btree_read_leaf_value,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create btree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_btree_set_root_node(
+	     btree,
+	     0,
+	     0,
+	     NODE_DATA_SIZE,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set root node in btree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_cache_initialize(
+	     &cache,
+	     128,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_btree_get_number_of_leaf_values(
+	     btree,
+	     NULL,
+	     cache,
+	     &number_of_leaf_values,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of leaf values in btree.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_leaf_values != ( NUMBER_OF_WIDE_ENTRIES * NUMBER_OF_WIDE_ENTRIES ) )
+	{
+		result = 0;
+	}
+	for( leaf_value_index = 0;
+	     ( result != 0 )
+	  && ( leaf_value_index < number_of_leaf_values );
+	     leaf_value_index++ )
+	{
+		if( libfdata_btree_get_leaf_value_by_index(
+		     btree,
+		     NULL,
+		     cache,
+		     leaf_value_index,
+		     (intptr_t **) &leaf_value_data,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve leaf value: %d.",
+			 function,
+			 leaf_value_index );
+
+			goto on_error;
+		}
+		result = 0;
+
+		if( leaf_value_data != NULL )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 leaf_value_data,
+			 test_leaf_value_index );
+
+			if( test_leaf_value_index == (uint32_t) leaf_value_index )
+			{
+				result = 1;
+			}
+		}
+	}
+	fprintf(
+	 stdout,
+	 "Testing read wide nodes\t" );
+
+	if( result == 0 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( libfdata_cache_free(
+	     &cache,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_btree_free(
+	     &btree,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free btree.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( btree != NULL )
+	{
+		libfdata_btree_free(
+		 &btree,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -1037,7 +1565,10 @@ int main( int argc, char * const argv[] )
 	}
 	/* Test: read nodes
 	 */
-	if( fdata_test_btree_read() != 1 )
+	if( fdata_test_btree_read(
+	     0,
+	     0,
+	     128 ) != 1 )
 	{
 		fprintf(
 		 stderr,
@@ -1045,6 +1576,68 @@ int main( int argc, char * const argv[] )
 
 		return( EXIT_FAILURE );
 	}
+	/* Test: read nodes using multiple threads
+	 */
+	if( fdata_test_btree_read(
+	     4,
+	     0,
+	     128 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read using multiple threads.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: read nodes using a key value index
+	 */
+	if( fdata_test_btree_read(
+	     0,
+	     1,
+	     128 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read using a key value index.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: read nodes using a prebuilt key value index
+	 */
+	if( fdata_test_btree_read(
+	     0,
+	     2,
+	     128 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read using a prebuilt key value index.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: read nodes using a cache in which the nodes on the path evict each other
+	 */
+	if( fdata_test_btree_read(
+	     0,
+	     0,
+	     1 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read using a single cache entry.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: read nodes with more entries than initially allocated
+	 */
+	if( fdata_test_btree_read_wide() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read wide nodes.\n" );
+
+		return( EXIT_FAILURE );
+	}
 	return( EXIT_SUCCESS );
 }
 
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -270,6 +271,181 @@ on_error:
 	return( 0 );
 }
 
+/* The number of times a key value was freed
+ */
+int fdata_test_btree_range_number_of_key_value_frees = 0;
+
+/* Frees a key value
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_btree_range_key_value_free(
+     uint8_t **key_value,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_test_btree_range_key_value_free";
+
+	if( key_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key value.",
+		 function );
+
+		return( -1 );
+	}
+	if( *key_value != NULL )
+	{
+		memory_free(
+		 *key_value );
+
+		*key_value = NULL;
+
+		fdata_test_btree_range_number_of_key_value_frees++;
+	}
+	return( 1 );
+}
+
+/* Tests the libfdata_btree_range_clear function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_btree_range_clear(
+     void )
+{
+	libfdata_btree_range_t btree_range;
+
+	libcerror_error_t *error = NULL;
+	uint8_t *key_value       = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = ( memory_set(
+	            &btree_range,
+	            0,
+	            sizeof( libfdata_btree_range_t ) ) != NULL );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	key_value = (uint8_t *) memory_allocate(
+	                         sizeof( uint8_t ) * 4 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "key_value",
+	 key_value );
+
+	result = libfdata_btree_range_set(
+	          &btree_range,
+	          0,
+	          512,
+	          512,
+	          0,
+	          (intptr_t *) key_value,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &fdata_test_btree_range_key_value_free,
+	          LIBFDATA_KEY_VALUE_FLAG_MANAGED,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        FDATA_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* The key value is now managed by the range
+	 */
+	key_value = NULL;
+
+	fdata_test_btree_range_number_of_key_value_frees = 0;
+
+	/* Test regular cases
+	 */
+	result = libfdata_btree_range_clear(
+	          &btree_range,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        FDATA_TEST_ASSERT_IS_NULL(
+         "btree_range.key_value",
+         btree_range.key_value );
+
+        FDATA_TEST_ASSERT_IS_NULL(
+         "btree_range.key_value_filter",
+         btree_range.key_value_filter );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_btree_range_number_of_key_value_frees",
+	 fdata_test_btree_range_number_of_key_value_frees,
+	 1 );
+
+        FDATA_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Clearing a cleared range does not free the key value again
+	 */
+	result = libfdata_btree_range_clear(
+	          &btree_range,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_btree_range_number_of_key_value_frees",
+	 fdata_test_btree_range_number_of_key_value_frees,
+	 1 );
+
+        FDATA_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libfdata_btree_range_clear(
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        FDATA_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( key_value != NULL )
+	{
+		memory_free(
+		 key_value );
+	}
+	return( 0 );
+}
+
 /* Tests the libfdata_btree_range_clone function
  * Returns 1 if successful or 0 if not
  */
@@ -443,6 +619,10 @@ int main(
 	 "libfdata_btree_range_free",
 	 fdata_test_btree_range_free );
 
+	FDATA_TEST_RUN(
+	 "libfdata_btree_range_clear",
+	 fdata_test_btree_range_clear );
+
 	FDATA_TEST_RUN(
 	 "libfdata_btree_range_clone",
 	 fdata_test_btree_range_clone );
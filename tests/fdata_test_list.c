@@ -439,6 +439,2028 @@ on_error:
 	return( -1 );
 }
 
+/* Tests retrieving element indexes at offsets in a list of variable sized elements
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_list_get_element_index_at_offset(
+    void )
+{
+	libcerror_error_t *error         = NULL;
+	libfdata_list_t *list            = NULL;
+	static char *function            = "fdata_test_list_get_element_index_at_offset";
+	off64_t element_data_offset      = 0;
+	off64_t element_offsets[ MAXIMUM_NUMBER_OF_ELEMENTS ];
+	off64_t result_element_offset    = 0;
+	size64_t element_size            = 0;
+	int element_index                = 0;
+	int iterator                     = 0;
+	int result                       = 1;
+	int result_element_index         = 0;
+
+	if( libfdata_list_initialize(
+	     &list,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list.",
+		 function );
+
+		goto on_error;
+	}
+	/* Mix small elements with large ones
+	 */
+	for( element_index = 0;
+	     element_index < MAXIMUM_NUMBER_OF_ELEMENTS;
+	     element_index++ )
+	{
+		if( ( element_index % 64 ) == 0 )
+		{
+			element_size = 1024 * 1024;
+		}
+		else
+		{
+			element_size = 1 + ( element_index % 5 );
+		}
+		element_offsets[ element_index ] = element_data_offset;
+
+		if( libfdata_list_append_element(
+		     list,
+		     &result_element_index,
+		     0,
+		     element_data_offset,
+		     element_size,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element: %d to list.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		element_data_offset += element_size;
+	}
+	fprintf(
+	 stdout,
+	 "Testing get_element_index_at_offset\t" );
+
+	/* Look up the last byte of every element both in sequential
+	 * and in an alternating (non sequential) order
+	 */
+	for( iterator = 0;
+	     iterator < ( 2 * MAXIMUM_NUMBER_OF_ELEMENTS );
+	     iterator++ )
+	{
+		if( iterator < MAXIMUM_NUMBER_OF_ELEMENTS )
+		{
+			element_index = iterator;
+		}
+		else if( ( iterator % 2 ) == 0 )
+		{
+			element_index = ( iterator - MAXIMUM_NUMBER_OF_ELEMENTS ) / 2;
+		}
+		else
+		{
+			element_index = MAXIMUM_NUMBER_OF_ELEMENTS - 1 - ( ( iterator - MAXIMUM_NUMBER_OF_ELEMENTS ) / 2 );
+		}
+		if( element_index < ( MAXIMUM_NUMBER_OF_ELEMENTS - 1 ) )
+		{
+			element_size = (size64_t) ( element_offsets[ element_index + 1 ] - element_offsets[ element_index ] );
+		}
+		else
+		{
+			element_size = (size64_t) ( element_data_offset - element_offsets[ element_index ] );
+		}
+		if( libfdata_list_get_element_index_at_offset(
+		     list,
+		     element_offsets[ element_index ] + (off64_t) element_size - 1,
+		     &result_element_index,
+		     &result_element_offset,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element index at offset.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( result_element_index != element_index )
+		 || ( result_element_offset != (off64_t) element_size - 1 ) )
+		{
+			result = 0;
+
+			break;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libfdata_list_get_element_index_at_offset(
+		     list,
+		     element_data_offset,
+		     &result_element_index,
+		     &result_element_offset,
+		     &error ) != 0 )
+		{
+			result = 0;
+		}
+	}
+	if( result == 0 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( libfdata_list_free(
+	     &list,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free list.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( list != NULL )
+	{
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the data range of an element
+ * Callback function for the lazy list
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_list_get_element_range(
+     intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     int element_index,
+     int *element_file_index,
+     off64_t *element_offset,
+     size64_t *element_size,
+     uint32_t *element_flags,
+     size64_t *mapped_size,
+     libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle );
+	FDATA_TEST_UNREFERENCED_PARAMETER( error );
+
+	*element_file_index = 0;
+	*element_offset     = (off64_t) element_index * ELEMENT_DATA_SIZE;
+	*element_size       = ELEMENT_DATA_SIZE;
+	*element_flags      = 0;
+	*mapped_size        = ELEMENT_DATA_SIZE;
+
+	return( 1 );
+}
+
+/* Tests reading a lazy list
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_list_read_lazy(
+    void )
+{
+	libcerror_error_t *error              = NULL;
+	libfdata_cache_t *cache               = NULL;
+	libfdata_list_t *list                 = NULL;
+	libfdata_list_element_t *list_element = NULL;
+	uint8_t *element_data                 = NULL;
+	static char *function                 = "fdata_test_list_read_lazy";
+	off64_t result_element_offset         = 0;
+	uint32_t test_element_index           = 0;
+	int element_index                     = 0;
+	int result                            = 1;
+	int result_element_index              = 0;
+
+	if( libfdata_list_initialize(
+	     &list,
+	     NULL,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_list_read_element_data,
+	     NULL,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_set_element_range_function(
+	     list,
+	     MAXIMUM_NUMBER_OF_ELEMENTS,
+	     &fdata_test_list_get_element_range,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set get element range function.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_cache_initialize(
+	     &cache,
+	     4,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Testing lazy get_element_value_by_index\t" );
+
+	/* Read a sparse set of elements
+	 */
+	for( element_index = MAXIMUM_NUMBER_OF_ELEMENTS - 1;
+	     element_index >= 0;
+	     element_index -= 97 )
+	{
+		if( libfdata_list_get_element_value_by_index(
+		     list,
+		     NULL,
+		     cache,
+		     element_index,
+		     (intptr_t **) &element_data,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d value.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		result = 0;
+
+		if( element_data != NULL )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 element_data,
+			 test_element_index );
+
+			if( test_element_index == (uint32_t) element_index )
+			{
+				result = 1;
+			}
+		}
+		if( result == 0 )
+		{
+			break;
+		}
+	}
+	/* Retrieving an element at an offset resolves all the elements
+	 * the list element retrieved before must remain valid
+	 */
+	if( result == 1 )
+	{
+		if( libfdata_list_get_list_element_by_index(
+		     list,
+		     7,
+		     &list_element,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve list element: 7.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfdata_list_get_element_index_at_offset(
+		     list,
+		     ( 300 * ELEMENT_DATA_SIZE ) + 5,
+		     &result_element_index,
+		     &result_element_offset,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element index at offset.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( result_element_index != 300 )
+		 || ( result_element_offset != 5 ) )
+		{
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libfdata_list_element_get_element_value(
+		     list_element,
+		     NULL,
+		     cache,
+		     (intptr_t **) &element_data,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve list element: 7 value.",
+			 function );
+
+			goto on_error;
+		}
+		result = 0;
+
+		if( element_data != NULL )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 element_data,
+			 test_element_index );
+
+			if( test_element_index == 7 )
+			{
+				result = 1;
+			}
+		}
+	}
+	/* Reversing a lazy list of which list elements were created before
+	 * the list was emptied
+	 */
+	if( result == 1 )
+	{
+		if( libfdata_list_empty(
+		     list,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to empty list.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfdata_list_set_element_range_function(
+		     list,
+		     MAXIMUM_NUMBER_OF_ELEMENTS,
+		     &fdata_test_list_get_element_range,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set get element range function.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfdata_list_reverse(
+		     list,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reverse list.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfdata_list_get_element_value_by_index(
+		     list,
+		     NULL,
+		     cache,
+		     0,
+		     (intptr_t **) &element_data,
+		     LIBFDATA_READ_FLAG_IGNORE_CACHE,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: 0 value.",
+			 function );
+
+			goto on_error;
+		}
+		result = 0;
+
+		if( element_data != NULL )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 element_data,
+			 test_element_index );
+
+			if( test_element_index == (uint32_t) ( MAXIMUM_NUMBER_OF_ELEMENTS - 1 ) )
+			{
+				result = 1;
+			}
+		}
+	}
+	if( result == 0 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( libfdata_cache_free(
+	     &cache,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_free(
+	     &list,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free list.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( list != NULL )
+	{
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	return( -1 );
+}
+
+static int fdata_test_list_number_of_reads           = 0;
+static int fdata_test_list_number_of_unordered_reads = 0;
+static off64_t fdata_test_list_last_read_offset      = -1;
+
+/* Reads element data and keeps track of the order of the reads
+ * Callback function for the list
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_list_read_element_data_ordered(
+     intptr_t *data_handle,
+     intptr_t *file_io_handle,
+     libfdata_list_element_t *list_element,
+     libfdata_cache_t *cache,
+     int element_data_file_index,
+     off64_t element_data_offset,
+     size64_t element_data_size,
+     uint32_t element_data_flags,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	if( element_data_offset < fdata_test_list_last_read_offset )
+	{
+		fdata_test_list_number_of_unordered_reads++;
+	}
+	fdata_test_list_last_read_offset = element_data_offset;
+
+	fdata_test_list_number_of_reads++;
+
+	return( fdata_test_list_read_element_data(
+	         data_handle,
+	         file_io_handle,
+	         list_element,
+	         cache,
+	         element_data_file_index,
+	         element_data_offset,
+	         element_data_size,
+	         element_data_flags,
+	         read_flags,
+	         error ) );
+}
+
+/* Tests prefetching element values of the list
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_list_prefetch_element_values(
+    void )
+{
+	libcerror_error_t *error    = NULL;
+	libfdata_cache_t *cache     = NULL;
+	libfdata_list_t *list       = NULL;
+	uint8_t *element_data       = NULL;
+	static char *function       = "fdata_test_list_prefetch_element_values";
+	uint32_t test_element_index = 0;
+	int element_index           = 0;
+	int result                  = 1;
+	int result_element_index    = 0;
+
+	if( libfdata_list_initialize(
+	     &list,
+	     NULL,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_list_read_element_data_ordered,
+	     NULL,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list.",
+		 function );
+
+		goto on_error;
+	}
+	/* Store the elements in reverse order
+	 */
+	for( element_index = 0;
+	     element_index < 64;
+	     element_index++ )
+	{
+		if( libfdata_list_append_element(
+		     list,
+		     &result_element_index,
+		     0,
+		     (off64_t) ( 63 - element_index ) * ELEMENT_DATA_SIZE,
+		     ELEMENT_DATA_SIZE,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element: %d to list.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	if( libfdata_cache_initialize(
+	     &cache,
+	     64,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Testing prefetch_element_values\t" );
+
+	if( libfdata_list_prefetch_element_values(
+	     list,
+	     NULL,
+	     cache,
+	     0,
+	     64,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to prefetch element values.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( fdata_test_list_number_of_reads != 64 )
+	 || ( fdata_test_list_number_of_unordered_reads != 0 ) )
+	{
+		result = 0;
+	}
+	/* The values should now be read from the cache
+	 */
+	for( element_index = 0;
+	     element_index < 64;
+	     element_index++ )
+	{
+		if( result == 0 )
+		{
+			break;
+		}
+		if( libfdata_list_get_element_value_by_index(
+		     list,
+		     NULL,
+		     cache,
+		     element_index,
+		     (intptr_t **) &element_data,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d value.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		result = 0;
+
+		if( element_data != NULL )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 element_data,
+			 test_element_index );
+
+			if( test_element_index == (uint32_t) ( 63 - element_index ) )
+			{
+				result = 1;
+			}
+		}
+	}
+	if( fdata_test_list_number_of_reads != 64 )
+	{
+		result = 0;
+	}
+	if( result == 0 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( libfdata_cache_free(
+	     &cache,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_free(
+	     &list,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free list.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( list != NULL )
+	{
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	return( -1 );
+}
+
+static int fdata_test_list_number_of_batched_reads  = 0;
+static int fdata_test_list_number_of_batch_elements  = 0;
+
+/* Reads the data of consecutive elements and keeps track of the number of reads
+ * Callback function for the list
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_list_read_elements_data_counted(
+     intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     intptr_t *file_io_handle,
+     libfdata_list_t *list,
+     libfdata_cache_t *cache,
+     int first_element_index,
+     int number_of_elements,
+     int elements_data_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t elements_data_offset,
+     size64_t elements_data_size,
+     uint32_t elements_data_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	uint8_t *element_data = NULL;
+	static char *function = "fdata_test_list_read_elements_data_counted";
+	int element_index     = 0;
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle );
+	FDATA_TEST_UNREFERENCED_PARAMETER( elements_data_file_index );
+	FDATA_TEST_UNREFERENCED_PARAMETER( elements_data_flags );
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags );
+
+	if( elements_data_size != (size64_t) number_of_elements * ELEMENT_DATA_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid elements data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	fdata_test_list_number_of_batched_reads++;
+
+	for( element_index = 0;
+	     element_index < number_of_elements;
+	     element_index++ )
+	{
+		element_data = (uint8_t *) memory_allocate(
+		                            sizeof( uint8_t ) * ELEMENT_DATA_SIZE );
+
+		if( element_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create element data.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     element_data,
+		     0,
+		     sizeof( uint8_t ) * ELEMENT_DATA_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear element data.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_from_uint32_little_endian(
+		 element_data,
+		 (uint32_t) ( elements_data_offset / ELEMENT_DATA_SIZE ) + element_index );
+
+		if( libfdata_list_set_element_value_by_index(
+		     list,
+		     file_io_handle,
+		     cache,
+		     first_element_index + element_index,
+		     (intptr_t *) element_data,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &fdata_test_list_element_data_free,
+		     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set element: %d value.",
+			 function,
+			 first_element_index + element_index );
+
+			goto on_error;
+		}
+		element_data = NULL;
+
+		fdata_test_list_number_of_batch_elements++;
+	}
+	return( 1 );
+
+on_error:
+	if( element_data != NULL )
+	{
+		memory_free(
+		 element_data );
+	}
+	return( -1 );
+}
+
+/* Tests prefetching element values of the list with a read elements data function
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_list_prefetch_element_values_batched(
+    void )
+{
+	libcerror_error_t *error    = NULL;
+	libfdata_cache_t *cache     = NULL;
+	libfdata_list_t *list       = NULL;
+	uint8_t *element_data       = NULL;
+	static char *function       = "fdata_test_list_prefetch_element_values_batched";
+	off64_t element_offset      = 0;
+	uint32_t test_element_index = 0;
+	int element_index           = 0;
+	int result                  = 1;
+	int result_element_index    = 0;
+
+	fdata_test_list_number_of_reads           = 0;
+	fdata_test_list_number_of_unordered_reads = 0;
+	fdata_test_list_last_read_offset          = -1;
+	fdata_test_list_number_of_batched_reads   = 0;
+	fdata_test_list_number_of_batch_elements  = 0;
+
+	if( libfdata_list_initialize(
+	     &list,
+	     NULL,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_list_read_element_data_ordered,
+	     NULL,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_set_read_elements_data_function(
+	     list,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_list_t *, libfdata_cache_t *, int, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_list_read_elements_data_counted,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read elements data function.",
+		 function );
+
+		goto on_error;
+	}
+	/* Store the elements contiguously with a gap between element 31 and 32
+	 */
+	for( element_index = 0;
+	     element_index < 64;
+	     element_index++ )
+	{
+		element_offset = (off64_t) element_index * ELEMENT_DATA_SIZE;
+
+		if( element_index >= 32 )
+		{
+			element_offset += ELEMENT_DATA_SIZE;
+		}
+		if( libfdata_list_append_element(
+		     list,
+		     &result_element_index,
+		     0,
+		     element_offset,
+		     ELEMENT_DATA_SIZE,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element: %d to list.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	if( libfdata_cache_initialize(
+	     &cache,
+	     64,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Testing prefetch_element_values batched\t" );
+
+	/* Cache element 10 so that it is not read again
+	 */
+	if( libfdata_list_get_element_value_by_index(
+	     list,
+	     NULL,
+	     cache,
+	     10,
+	     (intptr_t **) &element_data,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element: 10 value.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_prefetch_element_values(
+	     list,
+	     NULL,
+	     cache,
+	     0,
+	     64,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to prefetch element values.",
+		 function );
+
+		goto on_error;
+	}
+	/* The elements 0 to 9, 11 to 31 and 32 to 63 are read with a single call each
+	 */
+	if( ( fdata_test_list_number_of_reads != 1 )
+	 || ( fdata_test_list_number_of_batched_reads != 3 )
+	 || ( fdata_test_list_number_of_batch_elements != 63 ) )
+	{
+		result = 0;
+	}
+	/* The values should now be read from the cache
+	 */
+	for( element_index = 0;
+	     element_index < 64;
+	     element_index++ )
+	{
+		if( result == 0 )
+		{
+			break;
+		}
+		if( libfdata_list_get_element_value_by_index(
+		     list,
+		     NULL,
+		     cache,
+		     element_index,
+		     (intptr_t **) &element_data,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d value.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		result = 0;
+
+		if( element_data != NULL )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 element_data,
+			 test_element_index );
+
+			if( ( ( element_index < 32 )
+			  &&  ( test_element_index == (uint32_t) element_index ) )
+			 || ( ( element_index >= 32 )
+			  &&  ( test_element_index == (uint32_t) ( element_index + 1 ) ) ) )
+			{
+				result = 1;
+			}
+		}
+	}
+	if( ( fdata_test_list_number_of_reads != 1 )
+	 || ( fdata_test_list_number_of_batched_reads != 3 ) )
+	{
+		result = 0;
+	}
+	if( result == 0 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( libfdata_cache_free(
+	     &cache,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_free(
+	     &list,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free list.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( list != NULL )
+	{
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Values to count the element data reads
+ */
+static int fdata_test_list_number_of_element_reads = 0;
+
+/* Reads element data and counts the reads
+ * Callback function for the list
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_list_read_element_data_counted(
+     intptr_t *data_handle,
+     intptr_t *file_io_handle,
+     libfdata_list_element_t *list_element,
+     libfdata_cache_t *cache,
+     int element_data_file_index,
+     off64_t element_data_offset,
+     size64_t element_data_size,
+     uint32_t element_data_flags,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	fdata_test_list_number_of_element_reads++;
+
+	return( fdata_test_list_read_element_data(
+	         data_handle,
+	         file_io_handle,
+	         list_element,
+	         cache,
+	         element_data_file_index,
+	         element_data_offset,
+	         element_data_size,
+	         element_data_flags,
+	         read_flags,
+	         error ) );
+}
+
+/* Tests that replacing the data range of an element does not return a stale cached element value
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_list_set_element_cached_value(
+    void )
+{
+	libcerror_error_t *error    = NULL;
+	libfdata_cache_t *cache     = NULL;
+	libfdata_list_t *list       = NULL;
+	uint8_t *element_data       = NULL;
+	static char *function       = "fdata_test_list_set_element_cached_value";
+	uint32_t test_element_index = 0;
+	int element_index           = 0;
+	int result                  = 1;
+	int result_element_index    = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing set element cached value\t" );
+
+	if( libfdata_list_initialize(
+	     &list,
+	     NULL,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_list_read_element_data_counted,
+	     NULL,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list.",
+		 function );
+
+		goto on_error;
+	}
+	for( element_index = 0;
+	     element_index < 4;
+	     element_index++ )
+	{
+		if( libfdata_list_append_element(
+		     list,
+		     &result_element_index,
+		     0,
+		     (off64_t) element_index * ELEMENT_DATA_SIZE,
+		     ELEMENT_DATA_SIZE,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element: %d to list.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	if( libfdata_cache_initialize(
+	     &cache,
+	     4,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	fdata_test_list_number_of_element_reads = 0;
+
+	/* The second retrieval of the element value should be a cache hit
+	 */
+	for( element_index = 0;
+	     element_index < 2;
+	     element_index++ )
+	{
+		if( libfdata_list_get_element_value_by_index(
+		     list,
+		     NULL,
+		     cache,
+		     1,
+		     (intptr_t **) &element_data,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: 1 value.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( fdata_test_list_number_of_element_reads != 1 )
+	{
+		result = 0;
+	}
+	/* Replacing the data range with the same file index and offset
+	 * should not return the cached element value of the previous data range
+	 */
+	if( libfdata_list_set_element_by_index(
+	     list,
+	     1,
+	     0,
+	     (off64_t) ELEMENT_DATA_SIZE,
+	     ELEMENT_DATA_SIZE / 2,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set element: 1.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_get_element_value_by_index(
+	     list,
+	     NULL,
+	     cache,
+	     1,
+	     (intptr_t **) &element_data,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element: 1 value.",
+		 function );
+
+		goto on_error;
+	}
+	if( fdata_test_list_number_of_element_reads != 2 )
+	{
+		result = 0;
+	}
+	/* Replacing the data range with a different offset should return
+	 * the element value of the new data range
+	 */
+	if( libfdata_list_set_element_by_index(
+	     list,
+	     1,
+	     0,
+	     (off64_t) 3 * ELEMENT_DATA_SIZE,
+	     ELEMENT_DATA_SIZE,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set element: 1.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_get_element_value_by_index(
+	     list,
+	     NULL,
+	     cache,
+	     1,
+	     (intptr_t **) &element_data,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element: 1 value.",
+		 function );
+
+		goto on_error;
+	}
+	if( element_data == NULL )
+	{
+		result = 0;
+	}
+	else
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 element_data,
+		 test_element_index );
+
+		if( test_element_index != 3 )
+		{
+			result = 0;
+		}
+	}
+	if( fdata_test_list_number_of_element_reads != 3 )
+	{
+		result = 0;
+	}
+	if( result == 0 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( libfdata_cache_free(
+	     &cache,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_free(
+	     &list,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free list.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( list != NULL )
+	{
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests appending lists
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_list_append_list(
+    void )
+{
+	libfdata_list_t *source_lists[ 2 ]    = { NULL, NULL };
+
+	libcerror_error_t *error              = NULL;
+	libfdata_list_element_t *list_element = NULL;
+	libfdata_list_t *list                 = NULL;
+	static char *function                 = "fdata_test_list_append_list";
+	off64_t result_element_offset         = 0;
+	size64_t mapped_size                  = 0;
+	int element_index                     = 0;
+	int list_index                        = 0;
+	int number_of_elements                = 0;
+	int result                            = 1;
+	int result_element_index              = 0;
+
+	if( libfdata_list_initialize(
+	     &list,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list.",
+		 function );
+
+		goto on_error;
+	}
+	for( list_index = 0;
+	     list_index < 2;
+	     list_index++ )
+	{
+		if( libfdata_list_initialize(
+		     &( source_lists[ list_index ] ),
+		     NULL,
+		     NULL,
+		     NULL,
+		     NULL,
+		     NULL,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create source list: %d.",
+			 function,
+			 list_index );
+
+			goto on_error;
+		}
+		for( element_index = 0;
+		     element_index < 100;
+		     element_index++ )
+		{
+			if( libfdata_list_append_element(
+			     source_lists[ list_index ],
+			     &result_element_index,
+			     0,
+			     (off64_t) ( ( list_index * 100 ) + element_index ) * ELEMENT_DATA_SIZE,
+			     ELEMENT_DATA_SIZE,
+			     0,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append element: %d to source list: %d.",
+				 function,
+				 element_index,
+				 list_index );
+
+				goto on_error;
+			}
+		}
+	}
+	/* Retrieve a list element of the second source list that is taken over by the list
+	 */
+	if( libfdata_list_get_list_element_by_index(
+	     source_lists[ 1 ],
+	     10,
+	     &list_element,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve list element: 10.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Testing append_list\t" );
+
+	for( list_index = 0;
+	     list_index < 2;
+	     list_index++ )
+	{
+		if( libfdata_list_append_list(
+		     list,
+		     source_lists[ list_index ],
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append source list: %d.",
+			 function,
+			 list_index );
+
+			goto on_error;
+		}
+		if( libfdata_list_get_number_of_elements(
+		     source_lists[ list_index ],
+		     &number_of_elements,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of elements of source list: %d.",
+			 function,
+			 list_index );
+
+			goto on_error;
+		}
+		if( number_of_elements != 0 )
+		{
+			result = 0;
+		}
+	}
+	if( libfdata_list_get_number_of_elements(
+	     list,
+	     &number_of_elements,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_elements != 200 )
+	{
+		result = 0;
+	}
+	if( libfdata_list_get_element_index_at_offset(
+	     list,
+	     ( 150 * ELEMENT_DATA_SIZE ) + 1,
+	     &result_element_index,
+	     &result_element_offset,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element index at offset.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( result_element_index != 150 )
+	 || ( result_element_offset != 1 ) )
+	{
+		result = 0;
+	}
+	/* The list element taken over from the source list should refer to element 110 of the list
+	 */
+	if( libfdata_list_element_set_mapped_size(
+	     list_element,
+	     ELEMENT_DATA_SIZE,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set mapped size of list element.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_get_mapped_size_by_index(
+	     list,
+	     110,
+	     &mapped_size,
+	     &error ) != 1 )
+	{
+		result = 0;
+	}
+	if( result == 0 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	for( list_index = 0;
+	     list_index < 2;
+	     list_index++ )
+	{
+		if( libfdata_list_free(
+		     &( source_lists[ list_index ] ),
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free source list: %d.",
+			 function,
+			 list_index );
+
+			goto on_error;
+		}
+	}
+	if( libfdata_list_free(
+	     &list,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free list.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	for( list_index = 0;
+	     list_index < 2;
+	     list_index++ )
+	{
+		if( source_lists[ list_index ] != NULL )
+		{
+			libfdata_list_free(
+			 &( source_lists[ list_index ] ),
+			 NULL );
+		}
+	}
+	if( list != NULL )
+	{
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Checks the value of an element
+ * Callback function for libfdata_list_parallel_for_each
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_list_visit_element_value(
+     intptr_t *element_value,
+     int element_index,
+     intptr_t *visitor_data,
+     libcerror_error_t **error )
+{
+	int *number_of_visits       = NULL;
+	static char *function       = "fdata_test_list_visit_element_value";
+	uint32_t test_element_index = 0;
+
+	if( element_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element value.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( element_index < 0 )
+	 || ( element_index >= MAXIMUM_NUMBER_OF_ELEMENTS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 (uint8_t *) element_value,
+	 test_element_index );
+
+	if( test_element_index != (uint32_t) element_index )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element: %d value.",
+		 function,
+		 element_index );
+
+		return( -1 );
+	}
+	/* Every element is visited by a single thread
+	 */
+	number_of_visits = (int *) visitor_data;
+
+	number_of_visits[ element_index ] += 1;
+
+	return( 1 );
+}
+
+/* Tests visiting the list elements in parallel
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_list_parallel_for_each(
+    void )
+{
+	int number_of_visits[ MAXIMUM_NUMBER_OF_ELEMENTS ];
+
+	libcerror_error_t *error = NULL;
+	libfdata_list_t *list    = NULL;
+	static char *function    = "fdata_test_list_parallel_for_each";
+	int element_index        = 0;
+	int number_of_threads    = 0;
+	int result               = 1;
+	int result_element_index = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing parallel_for_each\t" );
+
+	if( libfdata_list_initialize(
+	     &list,
+	     NULL,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_list_read_element_data,
+	     NULL,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list.",
+		 function );
+
+		goto on_error;
+	}
+	/* Store the elements in 2 files, so that the chunks are split on the file boundary
+	 */
+	for( element_index = 0;
+	     element_index < MAXIMUM_NUMBER_OF_ELEMENTS;
+	     element_index++ )
+	{
+		if( libfdata_list_append_element(
+		     list,
+		     &result_element_index,
+		     ( element_index < 100 ) ? 0 : 1,
+		     (off64_t) element_index * ELEMENT_DATA_SIZE,
+		     ELEMENT_DATA_SIZE,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element: %d to list.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	for( number_of_threads = 1;
+	     number_of_threads <= 4;
+	     number_of_threads += 3 )
+	{
+		for( element_index = 0;
+		     element_index < MAXIMUM_NUMBER_OF_ELEMENTS;
+		     element_index++ )
+		{
+			number_of_visits[ element_index ] = 0;
+		}
+		if( libfdata_list_parallel_for_each(
+		     list,
+		     NULL,
+		     8,
+		     number_of_threads,
+		     &fdata_test_list_visit_element_value,
+		     (intptr_t *) number_of_visits,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to visit elements using %d threads.",
+			 function,
+			 number_of_threads );
+
+			goto on_error;
+		}
+		for( element_index = 0;
+		     element_index < MAXIMUM_NUMBER_OF_ELEMENTS;
+		     element_index++ )
+		{
+			if( number_of_visits[ element_index ] != 1 )
+			{
+				result = 0;
+			}
+		}
+	}
+	if( result == 0 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( libfdata_list_free(
+	     &list,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free list.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	fprintf(
+	 stdout,
+	 "(FAIL)\n" );
+
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( list != NULL )
+	{
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	return( -1 );
+}
 
 /* The main program
  */
@@ -502,6 +2524,76 @@ int main( int argc, char * const argv[] )
 
 		return( EXIT_FAILURE );
 	}
+	/* Test: retrieve element indexes at offsets
+	 */
+	if( fdata_test_list_get_element_index_at_offset() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test get element index at offset.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: read elements of a lazy list
+	 */
+	if( fdata_test_list_read_lazy() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read lazy.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: prefetch element values
+	 */
+	if( fdata_test_list_prefetch_element_values() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test prefetch element values.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: prefetch element values with a read elements data function
+	 */
+	if( fdata_test_list_prefetch_element_values_batched() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test prefetch element values batched.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: replace the data range of an element of which the value is cached
+	 */
+	if( fdata_test_list_set_element_cached_value() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test set element cached value.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: append lists
+	 */
+	if( fdata_test_list_append_list() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test append list.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: visit elements in parallel
+	 */
+	if( fdata_test_list_parallel_for_each() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test parallel for each.\n" );
+
+		return( EXIT_FAILURE );
+	}
 	return( EXIT_SUCCESS );
 }
 
@@ -120,6 +120,483 @@ int fdata_test_range_list_initialize(
 	return( 1 );
 }
 
+/* Tests inserting elements in the range list
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_range_list_insert_element(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libfdata_range_list_t *range_list = NULL;
+	static char *function             = "fdata_test_range_list_insert_element";
+	size64_t element_size             = 0;
+	off64_t element_data_offset       = 0;
+	off64_t element_offset            = 0;
+	uint32_t element_flags            = 0;
+	int element_file_index            = 0;
+	int result                        = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing insert element\t" );
+
+	if( libfdata_range_list_initialize(
+	     &range_list,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create range list.",
+		 function );
+
+		goto on_error;
+	}
+	/* Insert the ranges out of order, the range at 512 is adjacent
+	 * to the range at 0 and is merged with it
+	 */
+	if( libfdata_range_list_insert_element(
+	     range_list,
+	     2048,
+	     512,
+	     0,
+	     8192,
+	     512,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert element.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_range_list_insert_element(
+	     range_list,
+	     0,
+	     512,
+	     0,
+	     4096,
+	     512,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert element.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_range_list_insert_element(
+	     range_list,
+	     1024,
+	     512,
+	     0,
+	     6144,
+	     512,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert element.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_range_list_insert_element(
+	     range_list,
+	     512,
+	     512,
+	     0,
+	     5120,
+	     512,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert element.",
+		 function );
+
+		goto on_error;
+	}
+	/* Overlapping ranges are not allowed
+	 */
+	if( libfdata_range_list_insert_element(
+	     range_list,
+	     1280,
+	     512,
+	     0,
+	     7168,
+	     512,
+	     0,
+	     &error ) != -1 )
+	{
+		goto on_error;
+	}
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_range_list_get_element_at_offset(
+	          range_list,
+	          600,
+	          &element_data_offset,
+	          &element_file_index,
+	          &element_offset,
+	          &element_size,
+	          &element_flags,
+	          &error );
+
+	if( ( result != 1 )
+	 || ( element_offset != 5120 )
+	 || ( element_data_offset != 88 ) )
+	{
+		goto on_error;
+	}
+	result = libfdata_range_list_get_element_at_offset(
+	          range_list,
+	          2559,
+	          &element_data_offset,
+	          &element_file_index,
+	          &element_offset,
+	          &element_size,
+	          &element_flags,
+	          &error );
+
+	if( ( result != 1 )
+	 || ( element_offset != 8192 )
+	 || ( element_data_offset != 511 ) )
+	{
+		goto on_error;
+	}
+	result = libfdata_range_list_get_element_at_offset(
+	          range_list,
+	          1536,
+	          &element_data_offset,
+	          &element_file_index,
+	          &element_offset,
+	          &element_size,
+	          &element_flags,
+	          &error );
+
+	if( result != 0 )
+	{
+		goto on_error;
+	}
+	if( libfdata_range_list_free(
+	     &range_list,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free range list.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "(PASS)\n" );
+
+	return( 1 );
+
+on_error:
+	fprintf(
+	 stdout,
+	 "(FAIL)\n" );
+
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( range_list != NULL )
+	{
+		libfdata_range_list_free(
+		 &range_list,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests bulk inserting elements and retrieving the elements in a range
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_range_list_get_elements_in_range(
+     void )
+{
+	libfdata_list_element_t *elements[ 8 ];
+
+	libcerror_error_t *error          = NULL;
+	libfdata_range_list_t *range_list = NULL;
+	static char *function             = "fdata_test_range_list_get_elements_in_range";
+	size64_t element_sizes[ 5 ]       = { 512, 512, 512, 512, 512 };
+	size64_t element_size             = 0;
+	size64_t sizes[ 5 ]               = { 512, 512, 512, 512, 512 };
+	off64_t element_offsets[ 5 ]      = { 4096, 4608, 8192, 12288, 12800 };
+	off64_t element_offset            = 0;
+	off64_t offsets[ 5 ]              = { 0, 512, 2048, 4096, 4608 };
+	uint32_t element_flags[ 5 ]       = { 0, 0, 0, 0, 0 };
+	uint32_t flags                    = 0;
+	int element_file_indexes[ 5 ]     = { 0, 0, 0, 0, 0 };
+	int element_file_index            = 0;
+	int number_of_elements            = 0;
+	int result                        = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing get elements in range\t" );
+
+	if( libfdata_range_list_initialize(
+	     &range_list,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create range list.",
+		 function );
+
+		goto on_error;
+	}
+	/* An element in between the bulk loaded elements
+	 */
+	if( libfdata_range_list_insert_element(
+	     range_list,
+	     1024,
+	     512,
+	     0,
+	     16384,
+	     512,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert element.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_range_list_insert_elements(
+	     range_list,
+	     5,
+	     offsets,
+	     sizes,
+	     element_file_indexes,
+	     element_offsets,
+	     element_sizes,
+	     element_flags,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert elements.",
+		 function );
+
+		goto on_error;
+	}
+	/* Unsorted mapped ranges are not allowed
+	 */
+	offsets[ 1 ] = 256;
+
+	if( libfdata_range_list_insert_elements(
+	     range_list,
+	     5,
+	     offsets,
+	     sizes,
+	     element_file_indexes,
+	     element_offsets,
+	     element_sizes,
+	     element_flags,
+	     &error ) != -1 )
+	{
+		goto on_error;
+	}
+	libcerror_error_free(
+	 &error );
+
+	/* The range 256 - 4352 overlaps with the elements at 0, 512, 1024, 2048 and 4096
+	 */
+	result = libfdata_range_list_get_elements_in_range(
+	          range_list,
+	          256,
+	          4096,
+	          NULL,
+	          0,
+	          &number_of_elements,
+	          &error );
+
+	if( ( result != 1 )
+	 || ( number_of_elements != 5 ) )
+	{
+		goto on_error;
+	}
+	result = libfdata_range_list_get_elements_in_range(
+	          range_list,
+	          256,
+	          4096,
+	          elements,
+	          8,
+	          &number_of_elements,
+	          &error );
+
+	if( ( result != 1 )
+	 || ( number_of_elements != 5 ) )
+	{
+		goto on_error;
+	}
+	if( libfdata_list_element_get_data_range(
+	     elements[ 3 ],
+	     &element_file_index,
+	     &element_offset,
+	     &element_size,
+	     &flags,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data range.",
+		 function );
+
+		goto on_error;
+	}
+	if( element_offset != 8192 )
+	{
+		goto on_error;
+	}
+	if( libfdata_list_element_get_data_range(
+	     elements[ 4 ],
+	     &element_file_index,
+	     &element_offset,
+	     &element_size,
+	     &flags,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data range.",
+		 function );
+
+		goto on_error;
+	}
+	if( element_offset != 12288 )
+	{
+		goto on_error;
+	}
+	/* The range 4352 - 8448 overlaps with the elements at 4096 and 4608
+	 */
+	result = libfdata_range_list_get_elements_in_range(
+	          range_list,
+	          4352,
+	          4096,
+	          elements,
+	          1,
+	          &number_of_elements,
+	          &error );
+
+	if( ( result != 1 )
+	 || ( number_of_elements != 2 ) )
+	{
+		goto on_error;
+	}
+	/* The range 1536 - 2048 does not overlap with any element
+	 */
+	result = libfdata_range_list_get_elements_in_range(
+	          range_list,
+	          1536,
+	          512,
+	          elements,
+	          8,
+	          &number_of_elements,
+	          &error );
+
+	if( ( result != 0 )
+	 || ( number_of_elements != 0 ) )
+	{
+		goto on_error;
+	}
+	if( libfdata_range_list_free(
+	     &range_list,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free range list.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "(PASS)\n" );
+
+	return( 1 );
+
+on_error:
+	fprintf(
+	 stdout,
+	 "(FAIL)\n" );
+
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( range_list != NULL )
+	{
+		libfdata_range_list_free(
+		 &range_list,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -172,6 +649,22 @@ int main( int argc, char * const argv[] )
 
 		return( EXIT_FAILURE );
 	}
+	if( fdata_test_range_list_insert_element() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test insert element.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( fdata_test_range_list_get_elements_in_range() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test get elements in range.\n" );
+
+		return( EXIT_FAILURE );
+	}
 	return( EXIT_SUCCESS );
 }
 
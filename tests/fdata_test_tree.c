@@ -0,0 +1,3892 @@
+/*
+ * Library tree type testing program
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fdata_test_libcerror.h"
+#include "fdata_test_libfdata.h"
+#include "fdata_test_unused.h"
+
+#define NODE_DATA_SIZE				512
+#define MAXIMUM_NUMBER_OF_NODE_LEVELS		3
+#define MAXIMUM_NUMBER_OF_SUB_NODES		8
+#define DELETED_LEAF_NODE_INTERVAL		4
+#define NUMBER_OF_WIDE_SUB_NODES		1000
+#define NUMBER_OF_WIDE_SPLITS			8
+#define NUMBER_OF_SPLIT_SUB_NODES		24
+
+/* The node value
+ */
+uint8_t fdata_test_tree_node_value = 0;
+
+/* Values to check the order in which the node and sub nodes data is read
+ */
+uint8_t fdata_test_tree_check_read_order      = 0;
+off64_t fdata_test_tree_last_node_offset      = 0;
+off64_t fdata_test_tree_last_sub_nodes_offset = 0;
+int fdata_test_tree_number_of_unordered_reads = 0;
+
+/* The index of the branch node on the first sub node level that is deleted
+ * -1 if no branch node is deleted
+ */
+int fdata_test_tree_deleted_branch_node_index = -1;
+
+/* Values to check the cloned tree
+ */
+libfdata_tree_t *fdata_test_tree_cloned_tree  = NULL;
+int fdata_test_tree_number_of_sub_nodes_reads = 0;
+
+/* Reads a node
+ * Callback function for the tree
+ * The data handle contains a reference to the tree
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_tree_read_node(
+     libfdata_tree_t **tree,
+     intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     libfdata_tree_node_t *node,
+     libfdata_cache_t *cache,
+     int node_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t node_offset,
+     size64_t node_size FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint32_t node_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_test_tree_read_node";
+	off64_t node_index    = 0;
+	int level             = 0;
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle );
+	FDATA_TEST_UNREFERENCED_PARAMETER( node_file_index );
+	FDATA_TEST_UNREFERENCED_PARAMETER( node_size );
+	FDATA_TEST_UNREFERENCED_PARAMETER( node_flags );
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags );
+
+	if( tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	/* The upper 32-bit of the offset contain the level
+	 * the lower 32-bit the index of the node within the level
+	 */
+	level      = (int) ( node_offset >> 32 );
+	node_index = node_offset & 0xffffffffUL;
+
+	if( fdata_test_tree_check_read_order != 0 )
+	{
+		if( node_offset < fdata_test_tree_last_node_offset )
+		{
+			fdata_test_tree_number_of_unordered_reads++;
+		}
+		fdata_test_tree_last_node_offset = node_offset;
+	}
+
+	if( ( level + 1 ) < MAXIMUM_NUMBER_OF_NODE_LEVELS )
+	{
+		if( libfdata_tree_node_set_sub_nodes_data_range(
+		     node,
+		     0,
+		     node_offset,
+		     NODE_DATA_SIZE,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set sub nodes data range.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( level == 1 )
+		 && ( node_index == (off64_t) fdata_test_tree_deleted_branch_node_index ) )
+		{
+			if( libfdata_tree_node_set_deleted(
+			     node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set deleted.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	else
+	{
+		if( libfdata_tree_node_set_leaf(
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set leaf.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( node_index % DELETED_LEAF_NODE_INTERVAL ) == ( DELETED_LEAF_NODE_INTERVAL - 1 ) )
+		{
+			if( libfdata_tree_node_set_deleted(
+			     node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set deleted.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	if( libfdata_tree_set_node_value(
+	     *tree,
+	     cache,
+	     node,
+	     (intptr_t *) &fdata_test_tree_node_value,
+	     NULL,
+	     LIBFDATA_TREE_NODE_VALUE_FLAG_NON_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set node value.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the sub nodes
+ * Callback function for the tree
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_tree_read_sub_nodes(
+     libfdata_tree_t **tree FDATA_TEST_ATTRIBUTE_UNUSED,
+     intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     libfdata_tree_node_t *node,
+     libfdata_cache_t *cache FDATA_TEST_ATTRIBUTE_UNUSED,
+     int sub_nodes_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t sub_nodes_offset,
+     size64_t sub_nodes_size FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint32_t sub_nodes_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	static char *function  = "fdata_test_tree_read_sub_nodes";
+	off64_t element_offset = 0;
+	int element_index      = 0;
+	int level              = 0;
+	int sub_node_index     = 0;
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( tree );
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle );
+	FDATA_TEST_UNREFERENCED_PARAMETER( cache );
+	FDATA_TEST_UNREFERENCED_PARAMETER( sub_nodes_file_index );
+	FDATA_TEST_UNREFERENCED_PARAMETER( sub_nodes_size );
+	FDATA_TEST_UNREFERENCED_PARAMETER( sub_nodes_flags );
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags );
+
+	fdata_test_tree_number_of_sub_nodes_reads++;
+
+	if( fdata_test_tree_check_read_order != 0 )
+	{
+		if( sub_nodes_offset < fdata_test_tree_last_sub_nodes_offset )
+		{
+			fdata_test_tree_number_of_unordered_reads++;
+		}
+		fdata_test_tree_last_sub_nodes_offset = sub_nodes_offset;
+	}
+	level = (int) ( sub_nodes_offset >> 32 );
+
+	element_offset  = sub_nodes_offset & 0xffffffffUL;
+	element_offset *= MAXIMUM_NUMBER_OF_SUB_NODES;
+	element_offset += (off64_t) ( level + 1 ) << 32;
+
+	for( sub_node_index = 0;
+	     sub_node_index < MAXIMUM_NUMBER_OF_SUB_NODES;
+	     sub_node_index++ )
+	{
+		if( libfdata_tree_node_append_sub_node(
+		     node,
+		     &element_index,
+		     0,
+		     element_offset,
+		     NODE_DATA_SIZE,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append sub node.",
+			 function );
+
+			return( -1 );
+		}
+		element_offset += 1;
+	}
+	return( 1 );
+}
+
+/* Frees the data handle
+ * Callback function for the tree
+ * The data handle only references a tree and is not freed
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_tree_free_data_handle(
+     intptr_t **data_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_test_tree_free_data_handle";
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	*data_handle = NULL;
+
+	return( 1 );
+}
+
+/* Clones the data handle
+ * Callback function for the tree
+ * The destination data handle references the cloned tree
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_tree_clone_data_handle(
+     intptr_t **destination_data_handle,
+     intptr_t *source_data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_test_tree_clone_data_handle";
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( source_data_handle );
+
+	if( destination_data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination data handle.",
+		 function );
+
+		return( -1 );
+	}
+	*destination_data_handle = (intptr_t *) &fdata_test_tree_cloned_tree;
+
+	return( 1 );
+}
+
+/* Reads a node of a tree with a wide root node
+ * Callback function for the tree
+ * The data handle contains a reference to the tree
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_tree_read_wide_node(
+     libfdata_tree_t **tree,
+     intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     libfdata_tree_node_t *node,
+     libfdata_cache_t *cache,
+     int node_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t node_offset,
+     size64_t node_size FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint32_t node_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_test_tree_read_wide_node";
+	int result            = 0;
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle );
+	FDATA_TEST_UNREFERENCED_PARAMETER( node_file_index );
+	FDATA_TEST_UNREFERENCED_PARAMETER( node_size );
+	FDATA_TEST_UNREFERENCED_PARAMETER( node_flags );
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags );
+
+	if( tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree.",
+		 function );
+
+		return( -1 );
+	}
+	/* The root node is the only branch node
+	 */
+	if( node_offset == 0 )
+	{
+		result = libfdata_tree_node_set_sub_nodes_data_range(
+		          node,
+		          0,
+		          0,
+		          NODE_DATA_SIZE,
+		          0,
+		          error );
+	}
+	else
+	{
+		result = libfdata_tree_node_set_leaf(
+		          node,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set node values.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_tree_set_node_value(
+	     *tree,
+	     cache,
+	     node,
+	     (intptr_t *) &fdata_test_tree_node_value,
+	     NULL,
+	     LIBFDATA_TREE_NODE_VALUE_FLAG_NON_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set node value.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the sub nodes of the wide root node and splits them lazily
+ * Callback function for the tree
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_tree_read_wide_sub_nodes(
+     libfdata_tree_t **tree FDATA_TEST_ATTRIBUTE_UNUSED,
+     intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     libfdata_tree_node_t *node,
+     libfdata_cache_t *cache FDATA_TEST_ATTRIBUTE_UNUSED,
+     int sub_nodes_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t sub_nodes_offset FDATA_TEST_ATTRIBUTE_UNUSED,
+     size64_t sub_nodes_size FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint32_t sub_nodes_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_test_tree_read_wide_sub_nodes";
+	int element_index     = 0;
+	int sub_node_index    = 0;
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( tree );
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle );
+	FDATA_TEST_UNREFERENCED_PARAMETER( cache );
+	FDATA_TEST_UNREFERENCED_PARAMETER( sub_nodes_file_index );
+	FDATA_TEST_UNREFERENCED_PARAMETER( sub_nodes_offset );
+	FDATA_TEST_UNREFERENCED_PARAMETER( sub_nodes_size );
+	FDATA_TEST_UNREFERENCED_PARAMETER( sub_nodes_flags );
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags );
+
+	for( sub_node_index = 0;
+	     sub_node_index < NUMBER_OF_WIDE_SUB_NODES;
+	     sub_node_index++ )
+	{
+		if( libfdata_tree_node_append_sub_node(
+		     node,
+		     &element_index,
+		     0,
+		     (off64_t) sub_node_index + 1,
+		     NODE_DATA_SIZE,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append sub node.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libfdata_tree_node_split_sub_nodes_lazy(
+	     node,
+	     NUMBER_OF_WIDE_SPLITS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to split sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the sub nodes of the root node without splitting them
+ * Callback function for the tree
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_tree_read_split_sub_nodes(
+     libfdata_tree_t **tree FDATA_TEST_ATTRIBUTE_UNUSED,
+     intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     libfdata_tree_node_t *node,
+     libfdata_cache_t *cache FDATA_TEST_ATTRIBUTE_UNUSED,
+     int sub_nodes_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t sub_nodes_offset FDATA_TEST_ATTRIBUTE_UNUSED,
+     size64_t sub_nodes_size FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint32_t sub_nodes_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_test_tree_read_split_sub_nodes";
+	int element_index     = 0;
+	int sub_node_index    = 0;
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( tree );
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle );
+	FDATA_TEST_UNREFERENCED_PARAMETER( cache );
+	FDATA_TEST_UNREFERENCED_PARAMETER( sub_nodes_file_index );
+	FDATA_TEST_UNREFERENCED_PARAMETER( sub_nodes_offset );
+	FDATA_TEST_UNREFERENCED_PARAMETER( sub_nodes_size );
+	FDATA_TEST_UNREFERENCED_PARAMETER( sub_nodes_flags );
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags );
+
+	for( sub_node_index = 0;
+	     sub_node_index < NUMBER_OF_SPLIT_SUB_NODES;
+	     sub_node_index++ )
+	{
+		if( libfdata_tree_node_append_sub_node(
+		     node,
+		     &element_index,
+		     0,
+		     (off64_t) sub_node_index + 1,
+		     NODE_DATA_SIZE,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append sub node.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Tests initializing the tree
+ * Make sure the value tree is referencing, is set to NULL
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_tree_initialize(
+     libfdata_tree_t **tree,
+     int expected_result )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "fdata_test_tree_initialize";
+	int result               = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing initialize\t" );
+
+	result = libfdata_tree_initialize(
+	          tree,
+	          NULL,
+	          NULL,
+	          NULL,
+	          (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_node,
+	          (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_sub_nodes,
+	          0,
+	          &error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create tree.",
+		 function );
+	}
+	if( result != expected_result )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( result == -1 )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( result == 1 )
+	{
+		if( libfdata_tree_free(
+		     tree,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free tree.",
+			 function );
+
+			libcerror_error_backtrace_fprint(
+			 error,
+			 stdout );
+
+			libcerror_error_free(
+			 &error );
+
+			return( -1 );
+		}
+	}
+	if( result != expected_result )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Tests retrieving a (deleted) leaf node by index
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_tree_get_leaf_node(
+     libfdata_tree_t *tree,
+     libfdata_cache_t *cache,
+     int leaf_node_index,
+     uint8_t is_deleted,
+     libcerror_error_t **error )
+{
+	libfdata_tree_node_t *leaf_node = NULL;
+	static char *function           = "fdata_test_tree_get_leaf_node";
+	off64_t expected_node_offset    = 0;
+	off64_t node_offset             = 0;
+	size64_t node_size              = 0;
+	uint32_t node_flags             = 0;
+	int node_file_index             = 0;
+	int result                      = 0;
+
+	if( is_deleted == 0 )
+	{
+		result = libfdata_tree_get_leaf_node_by_index(
+		          tree,
+		          NULL,
+		          cache,
+		          leaf_node_index,
+		          &leaf_node,
+		          0,
+		          error );
+
+		expected_node_offset = ( leaf_node_index / ( DELETED_LEAF_NODE_INTERVAL - 1 ) ) * DELETED_LEAF_NODE_INTERVAL
+		                     + ( leaf_node_index % ( DELETED_LEAF_NODE_INTERVAL - 1 ) );
+	}
+	else
+	{
+		result = libfdata_tree_get_deleted_leaf_node_by_index(
+		          tree,
+		          NULL,
+		          cache,
+		          leaf_node_index,
+		          &leaf_node,
+		          0,
+		          error );
+
+		expected_node_offset = ( leaf_node_index * DELETED_LEAF_NODE_INTERVAL )
+		                     + ( DELETED_LEAF_NODE_INTERVAL - 1 );
+	}
+	expected_node_offset += (off64_t) ( MAXIMUM_NUMBER_OF_NODE_LEVELS - 1 ) << 32;
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve leaf node: %d.",
+		 function,
+		 leaf_node_index );
+
+		return( -1 );
+	}
+	if( libfdata_tree_node_get_data_range(
+	     leaf_node,
+	     &node_file_index,
+	     &node_offset,
+	     &node_size,
+	     &node_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data range of leaf node: %d.",
+		 function,
+		 leaf_node_index );
+
+		return( -1 );
+	}
+	if( node_offset != expected_node_offset )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Tests reading the tree
+ * If count_first is set the leaf nodes are counted before they are retrieved
+ * otherwise they are retrieved in reverse order while the leaf nodes are counted
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_tree_read(
+     int count_first,
+     int maximum_number_of_nodes,
+     int maximum_number_of_threads )
+{
+	libcerror_error_t *error          = NULL;
+	libfdata_cache_t *cache           = NULL;
+	libfdata_tree_t *tree             = NULL;
+	static char *function             = "fdata_test_tree_read";
+	int expected_number_of_leaf_nodes = 0;
+	int leaf_node_index               = 0;
+	int level                         = 0;
+	int number_of_deleted_leaf_nodes  = 0;
+	int number_of_leaf_nodes          = 0;
+	int number_of_nodes               = 0;
+	int result                        = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing read (count first: %d, maximum number of nodes: %d, maximum number of threads: %d)\t",
+	 count_first,
+	 maximum_number_of_nodes,
+	 maximum_number_of_threads );
+
+	if( libfdata_tree_initialize(
+	     &tree,
+	     (intptr_t *) &tree,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_node,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_sub_nodes,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_set_root_node(
+	     tree,
+	     0,
+	     0,
+	     NODE_DATA_SIZE,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set root node in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_set_maximum_number_of_nodes(
+	     tree,
+	     maximum_number_of_nodes,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of nodes in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_set_maximum_number_of_threads(
+	     tree,
+	     maximum_number_of_threads,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of threads in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_cache_initialize(
+	     &cache,
+	     128,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	expected_number_of_leaf_nodes = 1;
+
+	for( level = 1;
+	     level < MAXIMUM_NUMBER_OF_NODE_LEVELS;
+	     level++ )
+	{
+		expected_number_of_leaf_nodes *= MAXIMUM_NUMBER_OF_SUB_NODES;
+	}
+	if( count_first != 0 )
+	{
+		if( libfdata_tree_get_number_of_leaf_nodes(
+		     tree,
+		     NULL,
+		     cache,
+		     &number_of_leaf_nodes,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of leaf nodes in tree.",
+			 function );
+
+			goto on_error;
+		}
+		if( number_of_leaf_nodes != ( expected_number_of_leaf_nodes / DELETED_LEAF_NODE_INTERVAL ) * ( DELETED_LEAF_NODE_INTERVAL - 1 ) )
+		{
+			result = 0;
+		}
+		for( leaf_node_index = 0;
+		     leaf_node_index < number_of_leaf_nodes;
+		     leaf_node_index++ )
+		{
+			if( result != 1 )
+			{
+				break;
+			}
+			result = fdata_test_tree_get_leaf_node(
+			          tree,
+			          cache,
+			          leaf_node_index,
+			          0,
+			          &error );
+		}
+	}
+	else
+	{
+		/* Retrieve the leaf nodes in reverse order before they are counted
+		 */
+		number_of_leaf_nodes = ( expected_number_of_leaf_nodes / DELETED_LEAF_NODE_INTERVAL ) * ( DELETED_LEAF_NODE_INTERVAL - 1 );
+
+		for( leaf_node_index = number_of_leaf_nodes - 1;
+		     leaf_node_index >= 0;
+		     leaf_node_index-- )
+		{
+			if( result != 1 )
+			{
+				break;
+			}
+			result = fdata_test_tree_get_leaf_node(
+			          tree,
+			          cache,
+			          leaf_node_index,
+			          0,
+			          &error );
+		}
+		/* Retrieve the first deleted leaf node before the deleted leaf nodes are counted
+		 */
+		if( result == 1 )
+		{
+			result = fdata_test_tree_get_leaf_node(
+			          tree,
+			          cache,
+			          0,
+			          1,
+			          &error );
+		}
+	}
+	if( result == 1 )
+	{
+		if( libfdata_tree_get_number_of_deleted_leaf_nodes(
+		     tree,
+		     NULL,
+		     cache,
+		     &number_of_deleted_leaf_nodes,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of deleted leaf nodes in tree.",
+			 function );
+
+			goto on_error;
+		}
+		if( number_of_deleted_leaf_nodes != ( expected_number_of_leaf_nodes / DELETED_LEAF_NODE_INTERVAL ) )
+		{
+			result = 0;
+		}
+	}
+	for( leaf_node_index = 0;
+	     leaf_node_index < number_of_deleted_leaf_nodes;
+	     leaf_node_index++ )
+	{
+		if( result != 1 )
+		{
+			break;
+		}
+		result = fdata_test_tree_get_leaf_node(
+		          tree,
+		          cache,
+		          leaf_node_index,
+		          1,
+		          &error );
+	}
+	if( result == 1 )
+	{
+		/* Retrieving a leaf node out of bounds should fail
+		 */
+		if( fdata_test_tree_get_leaf_node(
+		     tree,
+		     cache,
+		     number_of_leaf_nodes,
+		     0,
+		     &error ) != -1 )
+		{
+			result = 0;
+		}
+		libcerror_error_free(
+		 &error );
+	}
+	if( ( result == 1 )
+	 && ( maximum_number_of_nodes > 0 ) )
+	{
+		if( libfdata_tree_get_number_of_nodes(
+		     tree,
+		     &number_of_nodes,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of nodes in tree.",
+			 function );
+
+			goto on_error;
+		}
+		if( number_of_nodes > maximum_number_of_nodes )
+		{
+			result = 0;
+		}
+	}
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( libfdata_cache_free(
+	     &cache,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_free(
+	     &tree,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free tree.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( tree != NULL )
+	{
+		libfdata_tree_free(
+		 &tree,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests retrieving the leaf nodes in a non sequential order
+ * The leaf nodes are retrieved with a stride that is co-prime with the number
+ * of leaf nodes, so that every leaf node is looked up without a preceding one
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_tree_get_leaf_node_strided(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libfdata_cache_t *cache          = NULL;
+	libfdata_tree_t *tree            = NULL;
+	static char *function            = "fdata_test_tree_get_leaf_node_strided";
+	int iteration                    = 0;
+	int number_of_deleted_leaf_nodes = 0;
+	int number_of_leaf_nodes         = 0;
+	int result                       = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing get leaf node strided\t" );
+
+	if( libfdata_tree_initialize(
+	     &tree,
+	     (intptr_t *) &tree,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_node,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_sub_nodes,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_set_root_node(
+	     tree,
+	     0,
+	     0,
+	     NODE_DATA_SIZE,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set root node in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_cache_initialize(
+	     &cache,
+	     128,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_get_number_of_leaf_nodes(
+	     tree,
+	     NULL,
+	     cache,
+	     &number_of_leaf_nodes,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of leaf nodes in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_get_number_of_deleted_leaf_nodes(
+	     tree,
+	     NULL,
+	     cache,
+	     &number_of_deleted_leaf_nodes,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of deleted leaf nodes in tree.",
+		 function );
+
+		goto on_error;
+	}
+	/* The strides are co-prime with 48 leaf nodes and 16 deleted leaf nodes
+	 */
+	if( ( number_of_leaf_nodes != 48 )
+	 || ( number_of_deleted_leaf_nodes != 16 ) )
+	{
+		result = 0;
+	}
+	for( iteration = 0;
+	     ( result == 1 )
+	  && ( iteration < number_of_leaf_nodes );
+	     iteration++ )
+	{
+		result = fdata_test_tree_get_leaf_node(
+		          tree,
+		          cache,
+		          ( iteration * 37 ) % number_of_leaf_nodes,
+		          0,
+		          &error );
+	}
+	for( iteration = 0;
+	     ( result == 1 )
+	  && ( iteration < number_of_deleted_leaf_nodes );
+	     iteration++ )
+	{
+		result = fdata_test_tree_get_leaf_node(
+		          tree,
+		          cache,
+		          ( iteration * 5 ) % number_of_deleted_leaf_nodes,
+		          1,
+		          &error );
+	}
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( libfdata_cache_free(
+	     &cache,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_free(
+	     &tree,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free tree.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( tree != NULL )
+	{
+		libfdata_tree_free(
+		 &tree,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests retrieving the (deleted) leaf nodes of a tree with a deleted branch node
+ * The leaf nodes of the deleted branch node are deleted leaf nodes
+ * If count_first is not set the deleted leaf nodes are retrieved in reverse order
+ * before the leaf nodes are counted
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_tree_deleted_branch_node(
+     int count_first )
+{
+	off64_t expected_deleted_leaf_node_offsets[ MAXIMUM_NUMBER_OF_SUB_NODES * MAXIMUM_NUMBER_OF_SUB_NODES ];
+	off64_t expected_leaf_node_offsets[ MAXIMUM_NUMBER_OF_SUB_NODES * MAXIMUM_NUMBER_OF_SUB_NODES ];
+
+	libcerror_error_t *error                  = NULL;
+	libfdata_cache_t *cache                   = NULL;
+	libfdata_tree_node_t *leaf_node           = NULL;
+	libfdata_tree_t *tree                     = NULL;
+	static char *function                     = "fdata_test_tree_deleted_branch_node";
+	off64_t leaf_node_offset                  = 0;
+	off64_t node_offset                       = 0;
+	size64_t node_size                        = 0;
+	uint32_t node_flags                       = 0;
+	uint8_t is_deleted                        = 0;
+	int branch_node_index                     = 0;
+	int expected_number_of_deleted_leaf_nodes = 0;
+	int expected_number_of_leaf_nodes         = 0;
+	int leaf_node_index                       = 0;
+	int node_file_index                       = 0;
+	int number_of_deleted_leaf_nodes          = 0;
+	int number_of_leaf_nodes                  = 0;
+	int result                                = 1;
+	int sub_node_index                        = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing deleted branch node (count first: %d)\t",
+	 count_first );
+
+	/* The expected leaf nodes assume a tree with 2 sub node levels
+	 * the leaf nodes of the deleted branch node are followed by its deleted leaf nodes
+	 */
+	fdata_test_tree_deleted_branch_node_index = 2;
+
+	for( branch_node_index = 0;
+	     branch_node_index < MAXIMUM_NUMBER_OF_SUB_NODES;
+	     branch_node_index++ )
+	{
+		for( is_deleted = 0;
+		     is_deleted <= 1;
+		     is_deleted++ )
+		{
+			for( sub_node_index = 0;
+			     sub_node_index < MAXIMUM_NUMBER_OF_SUB_NODES;
+			     sub_node_index++ )
+			{
+				leaf_node_index = ( branch_node_index * MAXIMUM_NUMBER_OF_SUB_NODES ) + sub_node_index;
+
+				if( ( ( leaf_node_index % DELETED_LEAF_NODE_INTERVAL ) == ( DELETED_LEAF_NODE_INTERVAL - 1 ) ) != is_deleted )
+				{
+					continue;
+				}
+				leaf_node_offset = ( (off64_t) ( MAXIMUM_NUMBER_OF_NODE_LEVELS - 1 ) << 32 ) + leaf_node_index;
+
+				if( ( is_deleted == 0 )
+				 && ( branch_node_index != fdata_test_tree_deleted_branch_node_index ) )
+				{
+					expected_leaf_node_offsets[ expected_number_of_leaf_nodes++ ] = leaf_node_offset;
+				}
+				else
+				{
+					expected_deleted_leaf_node_offsets[ expected_number_of_deleted_leaf_nodes++ ] = leaf_node_offset;
+				}
+			}
+		}
+	}
+	if( libfdata_tree_initialize(
+	     &tree,
+	     (intptr_t *) &tree,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_node,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_sub_nodes,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_set_root_node(
+	     tree,
+	     0,
+	     0,
+	     NODE_DATA_SIZE,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set root node in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_cache_initialize(
+	     &cache,
+	     128,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( count_first == 0 )
+	{
+		/* Retrieve the deleted leaf nodes in reverse order before they are counted
+		 */
+		for( leaf_node_index = expected_number_of_deleted_leaf_nodes - 1;
+		     leaf_node_index >= 0;
+		     leaf_node_index-- )
+		{
+			if( libfdata_tree_get_deleted_leaf_node_by_index(
+			     tree,
+			     NULL,
+			     cache,
+			     leaf_node_index,
+			     &leaf_node,
+			     0,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve deleted leaf node: %d.",
+				 function,
+				 leaf_node_index );
+
+				goto on_error;
+			}
+			if( libfdata_tree_node_get_data_range(
+			     leaf_node,
+			     &node_file_index,
+			     &node_offset,
+			     &node_size,
+			     &node_flags,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve data range of deleted leaf node: %d.",
+				 function,
+				 leaf_node_index );
+
+				goto on_error;
+			}
+			if( node_offset != expected_deleted_leaf_node_offsets[ leaf_node_index ] )
+			{
+				result = 0;
+
+				break;
+			}
+		}
+	}
+	if( libfdata_tree_get_number_of_leaf_nodes(
+	     tree,
+	     NULL,
+	     cache,
+	     &number_of_leaf_nodes,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of leaf nodes in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_get_number_of_deleted_leaf_nodes(
+	     tree,
+	     NULL,
+	     cache,
+	     &number_of_deleted_leaf_nodes,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of deleted leaf nodes in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( number_of_leaf_nodes != expected_number_of_leaf_nodes )
+	 || ( number_of_deleted_leaf_nodes != expected_number_of_deleted_leaf_nodes ) )
+	{
+		result = 0;
+	}
+	for( is_deleted = 0;
+	     is_deleted <= 1;
+	     is_deleted++ )
+	{
+		if( is_deleted == 0 )
+		{
+			expected_number_of_leaf_nodes = number_of_leaf_nodes;
+		}
+		else
+		{
+			expected_number_of_leaf_nodes = number_of_deleted_leaf_nodes;
+		}
+		for( leaf_node_index = 0;
+		     leaf_node_index < expected_number_of_leaf_nodes;
+		     leaf_node_index++ )
+		{
+			if( result != 1 )
+			{
+				break;
+			}
+			if( is_deleted == 0 )
+			{
+				result = libfdata_tree_get_leaf_node_by_index(
+				          tree,
+				          NULL,
+				          cache,
+				          leaf_node_index,
+				          &leaf_node,
+				          0,
+				          &error );
+			}
+			else
+			{
+				result = libfdata_tree_get_deleted_leaf_node_by_index(
+				          tree,
+				          NULL,
+				          cache,
+				          leaf_node_index,
+				          &leaf_node,
+				          0,
+				          &error );
+			}
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve leaf node: %d.",
+				 function,
+				 leaf_node_index );
+
+				goto on_error;
+			}
+			if( libfdata_tree_node_get_data_range(
+			     leaf_node,
+			     &node_file_index,
+			     &node_offset,
+			     &node_size,
+			     &node_flags,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve data range of leaf node: %d.",
+				 function,
+				 leaf_node_index );
+
+				goto on_error;
+			}
+			if( is_deleted == 0 )
+			{
+				leaf_node_offset = expected_leaf_node_offsets[ leaf_node_index ];
+			}
+			else
+			{
+				leaf_node_offset = expected_deleted_leaf_node_offsets[ leaf_node_index ];
+			}
+			if( node_offset != leaf_node_offset )
+			{
+				result = 0;
+			}
+		}
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	fdata_test_tree_deleted_branch_node_index = -1;
+
+	if( libfdata_cache_free(
+	     &cache,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_free(
+	     &tree,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free tree.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	fdata_test_tree_deleted_branch_node_index = -1;
+
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( tree != NULL )
+	{
+		libfdata_tree_free(
+		 &tree,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests reading all the sub nodes of the tree in level order
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_tree_read_all_sub_nodes(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libfdata_cache_t *cache           = NULL;
+	libfdata_tree_t *tree             = NULL;
+	static char *function             = "fdata_test_tree_read_all_sub_nodes";
+	int expected_number_of_leaf_nodes = 0;
+	int level                         = 0;
+	int number_of_leaf_nodes          = 0;
+	int result                        = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing read all sub nodes\t" );
+
+	if( libfdata_tree_initialize(
+	     &tree,
+	     (intptr_t *) &tree,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_node,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_sub_nodes,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_set_root_node(
+	     tree,
+	     0,
+	     0,
+	     NODE_DATA_SIZE,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set root node in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_cache_initialize(
+	     &cache,
+	     128,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	fdata_test_tree_check_read_order          = 1;
+	fdata_test_tree_last_node_offset          = 0;
+	fdata_test_tree_last_sub_nodes_offset     = 0;
+	fdata_test_tree_number_of_unordered_reads = 0;
+
+	if( libfdata_tree_read_all_sub_nodes(
+	     tree,
+	     NULL,
+	     cache,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read all sub nodes of tree.",
+		 function );
+
+		goto on_error;
+	}
+	fdata_test_tree_check_read_order = 0;
+
+	/* The node and sub nodes data of a level should be read in order of offset
+	 */
+	if( fdata_test_tree_number_of_unordered_reads != 0 )
+	{
+		result = 0;
+	}
+	if( fdata_test_tree_last_node_offset != ( ( (off64_t) ( MAXIMUM_NUMBER_OF_NODE_LEVELS - 1 ) << 32 ) + ( MAXIMUM_NUMBER_OF_SUB_NODES * MAXIMUM_NUMBER_OF_SUB_NODES ) - 1 ) )
+	{
+		result = 0;
+	}
+	if( libfdata_tree_get_number_of_leaf_nodes(
+	     tree,
+	     NULL,
+	     cache,
+	     &number_of_leaf_nodes,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of leaf nodes in tree.",
+		 function );
+
+		goto on_error;
+	}
+	expected_number_of_leaf_nodes = 1;
+
+	for( level = 1;
+	     level < MAXIMUM_NUMBER_OF_NODE_LEVELS;
+	     level++ )
+	{
+		expected_number_of_leaf_nodes *= MAXIMUM_NUMBER_OF_SUB_NODES;
+	}
+	if( number_of_leaf_nodes != ( expected_number_of_leaf_nodes / DELETED_LEAF_NODE_INTERVAL ) * ( DELETED_LEAF_NODE_INTERVAL - 1 ) )
+	{
+		result = 0;
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( libfdata_cache_free(
+	     &cache,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_free(
+	     &tree,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free tree.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	fdata_test_tree_check_read_order = 0;
+
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( tree != NULL )
+	{
+		libfdata_tree_free(
+		 &tree,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Values to check the batched reading of the node data
+ */
+int fdata_test_tree_number_of_node_reads         = 0;
+int fdata_test_tree_number_of_batched_node_reads = 0;
+int fdata_test_tree_number_of_batch_nodes        = 0;
+int fdata_test_tree_last_node_file_index         = -1;
+int fdata_test_tree_last_node_level              = -1;
+
+/* Checks if the node data is read in order of file index and offset within a level
+ */
+void fdata_test_tree_check_node_read_order(
+      int node_file_index,
+      off64_t node_offset )
+{
+	int level = (int) ( node_offset >> 32 );
+
+	if( level == fdata_test_tree_last_node_level )
+	{
+		if( ( node_file_index < fdata_test_tree_last_node_file_index )
+		 || ( ( node_file_index == fdata_test_tree_last_node_file_index )
+		  &&  ( node_offset < fdata_test_tree_last_node_offset ) ) )
+		{
+			fdata_test_tree_number_of_unordered_reads++;
+		}
+	}
+	fdata_test_tree_last_node_level      = level;
+	fdata_test_tree_last_node_file_index = node_file_index;
+	fdata_test_tree_last_node_offset     = node_offset;
+}
+
+/* Reads a node and keeps track of the number of reads
+ * Callback function for the tree
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_tree_read_node_counted(
+     libfdata_tree_t **tree,
+     intptr_t *file_io_handle,
+     libfdata_tree_node_t *node,
+     libfdata_cache_t *cache,
+     int node_file_index,
+     off64_t node_offset,
+     size64_t node_size,
+     uint32_t node_flags,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	fdata_test_tree_number_of_node_reads++;
+
+	fdata_test_tree_check_node_read_order(
+	 node_file_index,
+	 node_offset );
+
+	return( fdata_test_tree_read_node(
+	         tree,
+	         file_io_handle,
+	         node,
+	         cache,
+	         node_file_index,
+	         node_offset,
+	         node_size,
+	         node_flags,
+	         read_flags,
+	         error ) );
+}
+
+/* Reads the node data of contiguous nodes
+ * Callback function for the tree
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_tree_read_nodes(
+     libfdata_tree_t **tree,
+     intptr_t *file_io_handle,
+     libfdata_tree_node_t **nodes,
+     int number_of_nodes,
+     libfdata_cache_t *cache,
+     int nodes_file_index,
+     off64_t nodes_offset,
+     size64_t nodes_size,
+     uint32_t nodes_flags,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_test_tree_read_nodes";
+	off64_t node_offset   = 0;
+	size64_t node_size    = 0;
+	uint32_t node_flags   = 0;
+	int node_file_index   = 0;
+	int node_index        = 0;
+
+	fdata_test_tree_number_of_batched_node_reads++;
+
+	for( node_index = 0;
+	     node_index < number_of_nodes;
+	     node_index++ )
+	{
+		if( libfdata_tree_node_get_data_range(
+		     nodes[ node_index ],
+		     &node_file_index,
+		     &node_offset,
+		     &node_size,
+		     &node_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data range from tree node.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( node_file_index != nodes_file_index )
+		 || ( node_offset != nodes_offset )
+		 || ( node_size > nodes_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid node: %d data range value out of bounds.",
+			 function,
+			 node_index );
+
+			return( -1 );
+		}
+		fdata_test_tree_check_node_read_order(
+		 node_file_index,
+		 node_offset );
+
+		if( fdata_test_tree_read_node(
+		     tree,
+		     file_io_handle,
+		     nodes[ node_index ],
+		     cache,
+		     node_file_index,
+		     node_offset,
+		     node_size,
+		     nodes_flags,
+		     read_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read node: %d.",
+			 function,
+			 node_index );
+
+			return( -1 );
+		}
+		nodes_offset += node_size;
+		nodes_size   -= node_size;
+
+		fdata_test_tree_number_of_batch_nodes++;
+	}
+	return( 1 );
+}
+
+/* Reads the sub nodes in reverse order of their offsets
+ * The sub nodes of the nodes with an odd index within the level are stored in file 1,
+ * the others in file 0. The node data of the sub nodes of a node is stored contiguously
+ * Callback function for the tree
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_tree_read_sub_nodes_reversed(
+     libfdata_tree_t **tree FDATA_TEST_ATTRIBUTE_UNUSED,
+     intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     libfdata_tree_node_t *node,
+     libfdata_cache_t *cache FDATA_TEST_ATTRIBUTE_UNUSED,
+     int sub_nodes_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t sub_nodes_offset,
+     size64_t sub_nodes_size FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint32_t sub_nodes_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	static char *function  = "fdata_test_tree_read_sub_nodes_reversed";
+	off64_t element_offset = 0;
+	off64_t node_index     = 0;
+	int element_index      = 0;
+	int level              = 0;
+	int sub_node_index     = 0;
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( tree );
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle );
+	FDATA_TEST_UNREFERENCED_PARAMETER( cache );
+	FDATA_TEST_UNREFERENCED_PARAMETER( sub_nodes_file_index );
+	FDATA_TEST_UNREFERENCED_PARAMETER( sub_nodes_size );
+	FDATA_TEST_UNREFERENCED_PARAMETER( sub_nodes_flags );
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags );
+
+	level      = (int) ( sub_nodes_offset >> 32 );
+	node_index = sub_nodes_offset & 0xffffffffUL;
+
+	element_offset  = node_index * MAXIMUM_NUMBER_OF_SUB_NODES;
+	element_offset += (off64_t) ( level + 1 ) << 32;
+
+	for( sub_node_index = MAXIMUM_NUMBER_OF_SUB_NODES - 1;
+	     sub_node_index >= 0;
+	     sub_node_index-- )
+	{
+		if( libfdata_tree_node_append_sub_node(
+		     node,
+		     &element_index,
+		     (int) ( node_index % 2 ),
+		     element_offset + sub_node_index,
+		     1,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append sub node.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Tests reading all the sub nodes of the tree in level order with a read nodes function
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_tree_read_all_sub_nodes_batched(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libfdata_cache_t *cache  = NULL;
+	libfdata_tree_t *tree    = NULL;
+	static char *function    = "fdata_test_tree_read_all_sub_nodes_batched";
+	int result               = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing read all sub nodes batched\t" );
+
+	if( libfdata_tree_initialize(
+	     &tree,
+	     (intptr_t *) &tree,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_node_counted,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_sub_nodes_reversed,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_set_read_nodes_function(
+	     tree,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t **, int, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_nodes,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read nodes function.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_set_root_node(
+	     tree,
+	     0,
+	     0,
+	     1,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set root node in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_cache_initialize(
+	     &cache,
+	     128,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	fdata_test_tree_number_of_unordered_reads    = 0;
+	fdata_test_tree_number_of_node_reads         = 0;
+	fdata_test_tree_number_of_batched_node_reads = 0;
+	fdata_test_tree_number_of_batch_nodes        = 0;
+	fdata_test_tree_last_node_file_index         = -1;
+	fdata_test_tree_last_node_level              = -1;
+	fdata_test_tree_last_node_offset             = 0;
+
+	if( libfdata_tree_read_all_sub_nodes(
+	     tree,
+	     NULL,
+	     cache,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read all sub nodes of tree.",
+		 function );
+
+		goto on_error;
+	}
+	/* The node data of a level should be read in order of file index and offset
+	 * although the sub nodes are stored in reverse order
+	 */
+	if( fdata_test_tree_number_of_unordered_reads != 0 )
+	{
+		result = 0;
+	}
+	/* The root node is read on its own, the sub nodes of every node are contiguous
+	 * and are read with a single call, the sub nodes of the second level are spread
+	 * over 2 files, hence the nodes of different parents are not contiguous
+	 */
+	if( ( fdata_test_tree_number_of_node_reads != 1 )
+	 || ( fdata_test_tree_number_of_batched_node_reads != 1 + MAXIMUM_NUMBER_OF_SUB_NODES )
+	 || ( fdata_test_tree_number_of_batch_nodes != MAXIMUM_NUMBER_OF_SUB_NODES + ( MAXIMUM_NUMBER_OF_SUB_NODES * MAXIMUM_NUMBER_OF_SUB_NODES ) ) )
+	{
+		result = 0;
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( libfdata_cache_free(
+	     &cache,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_free(
+	     &tree,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free tree.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( tree != NULL )
+	{
+		libfdata_tree_free(
+		 &tree,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests iterating the nodes of the tree
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_tree_iterate(
+     uint8_t iterator_flags )
+{
+	int level_node_indexes[ MAXIMUM_NUMBER_OF_NODE_LEVELS ];
+
+	libcerror_error_t *error             = NULL;
+	libfdata_cache_t *cache              = NULL;
+	libfdata_tree_t *tree                = NULL;
+	libfdata_tree_iterator_t *iterator   = NULL;
+	libfdata_tree_node_t *node           = NULL;
+	static char *function                = "fdata_test_tree_iterate";
+	off64_t node_index                   = 0;
+	off64_t node_offset                  = 0;
+	off64_t parent_node_index            = 0;
+	size64_t node_size                   = 0;
+	uint32_t node_flags                  = 0;
+	int expected_number_of_visited_nodes = 0;
+	int get_result                       = 0;
+	int level                            = 0;
+	int maximum_number_of_nodes          = 0;
+	int node_file_index                  = 0;
+	int number_of_level_nodes            = 0;
+	int number_of_nodes                  = 0;
+	int number_of_visited_nodes          = 0;
+	int result                           = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing iterate %s-order\t",
+	 ( ( iterator_flags & LIBFDATA_TREE_ITERATOR_FLAG_POST_ORDER ) != 0 ) ? "post" : "pre" );
+
+	if( libfdata_tree_initialize(
+	     &tree,
+	     (intptr_t *) &tree,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_node,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_sub_nodes,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_set_root_node(
+	     tree,
+	     0,
+	     0,
+	     NODE_DATA_SIZE,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set root node in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_cache_initialize(
+	     &cache,
+	     128,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_iterator_initialize(
+	     &iterator,
+	     tree,
+	     iterator_flags,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create iterator.",
+		 function );
+
+		goto on_error;
+	}
+	for( level = 0;
+	     level < MAXIMUM_NUMBER_OF_NODE_LEVELS;
+	     level++ )
+	{
+		level_node_indexes[ level ] = 0;
+	}
+	/* Only the nodes on the path to the current node and their sub nodes
+	 * should be kept in memory
+	 */
+	maximum_number_of_nodes = 1 + ( ( MAXIMUM_NUMBER_OF_NODE_LEVELS - 1 ) * MAXIMUM_NUMBER_OF_SUB_NODES );
+
+	do
+	{
+		get_result = libfdata_tree_iterator_get_next_node(
+		              iterator,
+		              NULL,
+		              cache,
+		              &node,
+		              0,
+		              &error );
+
+		if( get_result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next node.",
+			 function );
+
+			goto on_error;
+		}
+		else if( get_result == 0 )
+		{
+			break;
+		}
+		if( libfdata_tree_node_get_data_range(
+		     node,
+		     &node_file_index,
+		     &node_offset,
+		     &node_size,
+		     &node_flags,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve node data range.",
+			 function );
+
+			goto on_error;
+		}
+		level      = (int) ( node_offset >> 32 );
+		node_index = node_offset & 0xffffffffUL;
+
+		/* The nodes of a level are visited in order and a node is visited
+		 * after its parent in pre-order and before its parent in post-order
+		 */
+		if( ( level >= MAXIMUM_NUMBER_OF_NODE_LEVELS )
+		 || ( node_index != level_node_indexes[ level ] ) )
+		{
+			result = 0;
+
+			break;
+		}
+		if( level > 0 )
+		{
+			parent_node_index = level_node_indexes[ level - 1 ];
+
+			if( ( iterator_flags & LIBFDATA_TREE_ITERATOR_FLAG_POST_ORDER ) == 0 )
+			{
+				parent_node_index -= 1;
+			}
+			if( ( node_index / MAXIMUM_NUMBER_OF_SUB_NODES ) != parent_node_index )
+			{
+				result = 0;
+			}
+		}
+		level_node_indexes[ level ] += 1;
+
+		number_of_visited_nodes++;
+
+		if( libfdata_tree_get_number_of_nodes(
+		     tree,
+		     &number_of_nodes,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of nodes in tree.",
+			 function );
+
+			goto on_error;
+		}
+		if( number_of_nodes > maximum_number_of_nodes )
+		{
+			result = 0;
+		}
+	}
+	while( result == 1 );
+
+	expected_number_of_visited_nodes = 0;
+	number_of_level_nodes            = 1;
+
+	for( level = 0;
+	     level < MAXIMUM_NUMBER_OF_NODE_LEVELS;
+	     level++ )
+	{
+		expected_number_of_visited_nodes += number_of_level_nodes;
+		number_of_level_nodes            *= MAXIMUM_NUMBER_OF_SUB_NODES;
+	}
+	if( number_of_visited_nodes != expected_number_of_visited_nodes )
+	{
+		result = 0;
+	}
+	/* After the iteration only the root node should remain
+	 */
+	if( result == 1 )
+	{
+		if( libfdata_tree_get_number_of_nodes(
+		     tree,
+		     &number_of_nodes,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of nodes in tree.",
+			 function );
+
+			goto on_error;
+		}
+		if( number_of_nodes != 1 )
+		{
+			result = 0;
+		}
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( libfdata_tree_iterator_free(
+	     &iterator,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free iterator.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_cache_free(
+	     &cache,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_free(
+	     &tree,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free tree.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( iterator != NULL )
+	{
+		libfdata_tree_iterator_free(
+		 &iterator,
+		 NULL );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( tree != NULL )
+	{
+		libfdata_tree_free(
+		 &tree,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests splitting the sub nodes into virtual sub nodes
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_tree_split_sub_nodes(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libfdata_cache_t *cache         = NULL;
+	libfdata_tree_t *tree           = NULL;
+	libfdata_tree_node_t *node      = NULL;
+	libfdata_tree_node_t *root_node = NULL;
+	libfdata_tree_node_t *sub_node  = NULL;
+	static char *function           = "fdata_test_tree_split_sub_nodes";
+	off64_t node_offset             = 0;
+	size64_t node_size              = 0;
+	uint32_t node_flags             = 0;
+	int element_index               = 0;
+	int leaf_node_index             = 0;
+	int node_file_index             = 0;
+	int number_of_leaf_nodes        = 0;
+	int number_of_sub_nodes         = 0;
+	int result                      = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing split sub nodes\t" );
+
+	if( libfdata_tree_initialize(
+	     &tree,
+	     (intptr_t *) &tree,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_wide_node,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_split_sub_nodes,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_set_root_node(
+	     tree,
+	     0,
+	     0,
+	     NODE_DATA_SIZE,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set root node in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_cache_initialize(
+	     &cache,
+	     128,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_get_root_node(
+	     tree,
+	     &root_node,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve root node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_node_get_number_of_sub_nodes(
+	     root_node,
+	     NULL,
+	     cache,
+	     &number_of_sub_nodes,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_sub_nodes != NUMBER_OF_SPLIT_SUB_NODES )
+	{
+		result = 0;
+	}
+	/* The number of splits is the number of virtual sub nodes
+	 */
+	if( libfdata_tree_node_split_sub_nodes(
+	     root_node,
+	     4,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to split sub nodes of root node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_node_get_number_of_sub_nodes(
+	     root_node,
+	     NULL,
+	     cache,
+	     &number_of_sub_nodes,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_sub_nodes != 4 )
+	{
+		result = 0;
+	}
+	/* The sub nodes of a virtual sub node can be split again
+	 */
+	if( libfdata_tree_node_get_sub_node_by_index(
+	     root_node,
+	     NULL,
+	     cache,
+	     0,
+	     &sub_node,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub node: 0.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_node_get_number_of_sub_nodes(
+	     sub_node,
+	     NULL,
+	     cache,
+	     &number_of_sub_nodes,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes of virtual sub node.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_sub_nodes != ( NUMBER_OF_SPLIT_SUB_NODES / 4 ) )
+	{
+		result = 0;
+	}
+	if( libfdata_tree_node_split_sub_nodes(
+	     sub_node,
+	     3,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to split sub nodes of virtual sub node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_node_get_number_of_sub_nodes(
+	     sub_node,
+	     NULL,
+	     cache,
+	     &number_of_sub_nodes,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes of virtual sub node.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_sub_nodes != 3 )
+	{
+		result = 0;
+	}
+	/* The sub nodes of a node can be split more than once
+	 */
+	if( libfdata_tree_node_split_sub_nodes(
+	     root_node,
+	     2,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to split sub nodes of root node again.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_node_get_number_of_sub_nodes(
+	     root_node,
+	     NULL,
+	     cache,
+	     &number_of_sub_nodes,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_sub_nodes != 2 )
+	{
+		result = 0;
+	}
+	/* Sub nodes can be appended to a node of which the sub nodes were split
+	 */
+	if( libfdata_tree_node_append_sub_node(
+	     root_node,
+	     &element_index,
+	     0,
+	     (off64_t) NUMBER_OF_SPLIT_SUB_NODES + 1,
+	     NODE_DATA_SIZE,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append sub node to root node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_node_get_number_of_sub_nodes(
+	     root_node,
+	     NULL,
+	     cache,
+	     &number_of_sub_nodes,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_sub_nodes != 3 )
+	{
+		result = 0;
+	}
+	/* The leaf nodes should be retrievable by index via the virtual sub nodes
+	 */
+	if( libfdata_tree_get_number_of_leaf_nodes(
+	     tree,
+	     NULL,
+	     cache,
+	     &number_of_leaf_nodes,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of leaf nodes in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_leaf_nodes != ( NUMBER_OF_SPLIT_SUB_NODES + 1 ) )
+	{
+		result = 0;
+	}
+	for( leaf_node_index = 0;
+	     leaf_node_index < number_of_leaf_nodes;
+	     leaf_node_index++ )
+	{
+		if( libfdata_tree_get_leaf_node_by_index(
+		     tree,
+		     NULL,
+		     cache,
+		     leaf_node_index,
+		     &node,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve leaf node: %d.",
+			 function,
+			 leaf_node_index );
+
+			goto on_error;
+		}
+		if( libfdata_tree_node_get_data_range(
+		     node,
+		     &node_file_index,
+		     &node_offset,
+		     &node_size,
+		     &node_flags,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data range of leaf node: %d.",
+			 function,
+			 leaf_node_index );
+
+			goto on_error;
+		}
+		if( node_offset != ( (off64_t) leaf_node_index + 1 ) )
+		{
+			result = 0;
+
+			break;
+		}
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( libfdata_cache_free(
+	     &cache,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_free(
+	     &tree,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free tree.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( tree != NULL )
+	{
+		libfdata_tree_free(
+		 &tree,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests splitting the sub nodes of a wide node lazily
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_tree_split_sub_nodes_lazy(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libfdata_cache_t *cache          = NULL;
+	libfdata_tree_t *tree            = NULL;
+	libfdata_tree_node_t *node       = NULL;
+	libfdata_tree_node_t *sub_node   = NULL;
+	static char *function            = "fdata_test_tree_split_sub_nodes_lazy";
+	off64_t node_offset              = 0;
+	size64_t node_size               = 0;
+	uint32_t node_flags              = 0;
+	int depth                        = 0;
+	int leaf_node_index              = 0;
+	int maximum_depth                = 0;
+	int maximum_number_of_leaf_nodes = 0;
+	int node_file_index              = 0;
+	int number_of_leaf_nodes         = 0;
+	int number_of_nodes              = 0;
+	int number_of_sub_nodes          = 0;
+	int result                       = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing split sub nodes lazy\t" );
+
+	if( libfdata_tree_initialize(
+	     &tree,
+	     (intptr_t *) &tree,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_wide_node,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_wide_sub_nodes,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_set_root_node(
+	     tree,
+	     0,
+	     0,
+	     NODE_DATA_SIZE,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set root node in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_cache_initialize(
+	     &cache,
+	     128,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_get_root_node(
+	     tree,
+	     &node,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve root node.",
+		 function );
+
+		goto on_error;
+	}
+	/* The virtual sub nodes of the split sub nodes should be created on demand
+	 */
+	if( libfdata_tree_node_get_number_of_sub_nodes(
+	     node,
+	     NULL,
+	     cache,
+	     &number_of_sub_nodes,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_sub_nodes != NUMBER_OF_WIDE_SPLITS )
+	{
+		result = 0;
+	}
+	if( libfdata_tree_get_number_of_nodes(
+	     tree,
+	     &number_of_nodes,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of nodes in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_nodes != ( 1 + NUMBER_OF_WIDE_SUB_NODES + NUMBER_OF_WIDE_SPLITS ) )
+	{
+		result = 0;
+	}
+	/* The depth of the virtual sub nodes should be logarithmic
+	 */
+	maximum_number_of_leaf_nodes = 1;
+
+	while( maximum_number_of_leaf_nodes < NUMBER_OF_WIDE_SUB_NODES )
+	{
+		maximum_number_of_leaf_nodes *= NUMBER_OF_WIDE_SPLITS;
+		maximum_depth                += 1;
+	}
+	while( number_of_sub_nodes > 0 )
+	{
+		if( ( number_of_sub_nodes > NUMBER_OF_WIDE_SPLITS )
+		 || ( depth >= maximum_depth ) )
+		{
+			result = 0;
+
+			break;
+		}
+		if( libfdata_tree_node_get_sub_node_by_index(
+		     node,
+		     NULL,
+		     cache,
+		     number_of_sub_nodes - 1,
+		     &sub_node,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub node: %d.",
+			 function,
+			 number_of_sub_nodes - 1 );
+
+			goto on_error;
+		}
+		node   = sub_node;
+		depth += 1;
+
+		if( libfdata_tree_node_get_number_of_sub_nodes(
+		     node,
+		     NULL,
+		     cache,
+		     &number_of_sub_nodes,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of sub nodes.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfdata_tree_node_get_data_range(
+	     node,
+	     &node_file_index,
+	     &node_offset,
+	     &node_size,
+	     &node_flags,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve node data range.",
+		 function );
+
+		goto on_error;
+	}
+	if( node_offset != NUMBER_OF_WIDE_SUB_NODES )
+	{
+		result = 0;
+	}
+	/* The leaf nodes should be retrievable by index via the virtual sub nodes
+	 */
+	if( libfdata_tree_get_number_of_leaf_nodes(
+	     tree,
+	     NULL,
+	     cache,
+	     &number_of_leaf_nodes,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of leaf nodes in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_leaf_nodes != NUMBER_OF_WIDE_SUB_NODES )
+	{
+		result = 0;
+	}
+	for( leaf_node_index = 0;
+	     leaf_node_index < number_of_leaf_nodes;
+	     leaf_node_index++ )
+	{
+		if( libfdata_tree_get_leaf_node_by_index(
+		     tree,
+		     NULL,
+		     cache,
+		     leaf_node_index,
+		     &node,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve leaf node: %d.",
+			 function,
+			 leaf_node_index );
+
+			goto on_error;
+		}
+		if( libfdata_tree_node_get_data_range(
+		     node,
+		     &node_file_index,
+		     &node_offset,
+		     &node_size,
+		     &node_flags,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data range of leaf node: %d.",
+			 function,
+			 leaf_node_index );
+
+			goto on_error;
+		}
+		if( node_offset != ( (off64_t) leaf_node_index + 1 ) )
+		{
+			result = 0;
+
+			break;
+		}
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( libfdata_cache_free(
+	     &cache,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_free(
+	     &tree,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free tree.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( tree != NULL )
+	{
+		libfdata_tree_free(
+		 &tree,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests cloning a tree of which the nodes have been read
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_tree_clone(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libfdata_cache_t *cache           = NULL;
+	libfdata_tree_t *tree             = NULL;
+	static char *function             = "fdata_test_tree_clone";
+	int expected_number_of_leaf_nodes = 0;
+	int leaf_node_index               = 0;
+	int level                         = 0;
+	int number_of_cloned_nodes        = 0;
+	int number_of_leaf_nodes          = 0;
+	int number_of_nodes               = 0;
+	int number_of_sub_nodes_reads     = 0;
+	int result                        = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing clone\t" );
+
+	if( libfdata_tree_initialize(
+	     &tree,
+	     (intptr_t *) &tree,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &fdata_test_tree_free_data_handle,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &fdata_test_tree_clone_data_handle,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_node,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_tree_node_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_tree_read_sub_nodes,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_set_root_node(
+	     tree,
+	     0,
+	     0,
+	     NODE_DATA_SIZE,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set root node in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_cache_initialize(
+	     &cache,
+	     128,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	expected_number_of_leaf_nodes = 1;
+
+	for( level = 1;
+	     level < MAXIMUM_NUMBER_OF_NODE_LEVELS;
+	     level++ )
+	{
+		expected_number_of_leaf_nodes *= MAXIMUM_NUMBER_OF_SUB_NODES;
+	}
+	expected_number_of_leaf_nodes = ( expected_number_of_leaf_nodes / DELETED_LEAF_NODE_INTERVAL ) * ( DELETED_LEAF_NODE_INTERVAL - 1 );
+
+	/* Counting the leaf nodes reads all the nodes of the source tree
+	 */
+	if( libfdata_tree_get_number_of_leaf_nodes(
+	     tree,
+	     NULL,
+	     cache,
+	     &number_of_leaf_nodes,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of leaf nodes in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_get_number_of_nodes(
+	     tree,
+	     &number_of_nodes,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of nodes in tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_clone(
+	     &fdata_test_tree_cloned_tree,
+	     tree,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to clone tree.",
+		 function );
+
+		goto on_error;
+	}
+	/* The cloned tree should not depend on the source tree
+	 */
+	if( libfdata_tree_free(
+	     &tree,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_get_number_of_nodes(
+	     fdata_test_tree_cloned_tree,
+	     &number_of_cloned_nodes,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of nodes in cloned tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_cloned_nodes != number_of_nodes )
+	{
+		result = 0;
+	}
+	number_of_sub_nodes_reads = fdata_test_tree_number_of_sub_nodes_reads;
+
+	if( result == 1 )
+	{
+		if( libfdata_tree_get_number_of_leaf_nodes(
+		     fdata_test_tree_cloned_tree,
+		     NULL,
+		     cache,
+		     &number_of_leaf_nodes,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of leaf nodes in cloned tree.",
+			 function );
+
+			goto on_error;
+		}
+		if( number_of_leaf_nodes != expected_number_of_leaf_nodes )
+		{
+			result = 0;
+		}
+	}
+	for( leaf_node_index = 0;
+	     leaf_node_index < number_of_leaf_nodes;
+	     leaf_node_index++ )
+	{
+		if( result != 1 )
+		{
+			break;
+		}
+		result = fdata_test_tree_get_leaf_node(
+		          fdata_test_tree_cloned_tree,
+		          cache,
+		          leaf_node_index,
+		          0,
+		          &error );
+	}
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	/* The sub nodes of the cloned tree should not have been read again
+	 */
+	if( fdata_test_tree_number_of_sub_nodes_reads != number_of_sub_nodes_reads )
+	{
+		result = 0;
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( libfdata_cache_free(
+	     &cache,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_tree_free(
+	     &fdata_test_tree_cloned_tree,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cloned tree.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( fdata_test_tree_cloned_tree != NULL )
+	{
+		libfdata_tree_free(
+		 &fdata_test_tree_cloned_tree,
+		 NULL );
+	}
+	if( tree != NULL )
+	{
+		libfdata_tree_free(
+		 &tree,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libfdata_tree_t *tree = NULL;
+
+	if( argc != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported number of arguments.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	tree = NULL;
+
+	if( fdata_test_tree_initialize(
+	     &tree,
+	     1 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test initialize.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	tree = (libfdata_tree_t *) 0x12345678UL;
+
+	if( fdata_test_tree_initialize(
+	     &tree,
+	     -1 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test initialize.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( fdata_test_tree_initialize(
+	     NULL,
+	     -1 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test initialize.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: read nodes and count the leaf nodes first
+	 */
+	if( fdata_test_tree_read(
+	     1,
+	     0,
+	     0 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: read nodes while the leaf nodes are counted
+	 */
+	if( fdata_test_tree_read(
+	     0,
+	     0,
+	     0 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read while counting leaf nodes.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: read nodes with a maximum number of nodes
+	 */
+	if( fdata_test_tree_read(
+	     1,
+	     2 * ( MAXIMUM_NUMBER_OF_SUB_NODES + 1 ),
+	     0 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read with a maximum number of nodes.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( fdata_test_tree_read(
+	     0,
+	     2 * ( MAXIMUM_NUMBER_OF_SUB_NODES + 1 ),
+	     0 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read while counting leaf nodes with a maximum number of nodes.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: read nodes with multiple threads
+	 */
+	if( fdata_test_tree_read(
+	     1,
+	     0,
+	     4 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read with multiple threads.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: retrieve the (deleted) leaf nodes in a non sequential order
+	 */
+	if( fdata_test_tree_get_leaf_node_strided() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test get leaf node strided.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: read the leaf nodes of a deleted branch node as deleted leaf nodes
+	 */
+	if( fdata_test_tree_deleted_branch_node(
+	     1 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test deleted branch node.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( fdata_test_tree_deleted_branch_node(
+	     0 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test deleted branch node while counting leaf nodes.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: read all sub nodes in level order
+	 */
+	if( fdata_test_tree_read_all_sub_nodes() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read all sub nodes.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: read all sub nodes in level order with a read nodes function
+	 */
+	if( fdata_test_tree_read_all_sub_nodes_batched() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read all sub nodes batched.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: iterate the nodes in pre-order and post-order
+	 */
+	if( fdata_test_tree_iterate(
+	     LIBFDATA_TREE_ITERATOR_FLAG_PRE_ORDER ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test iterate in pre-order.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( fdata_test_tree_iterate(
+	     LIBFDATA_TREE_ITERATOR_FLAG_POST_ORDER ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test iterate in post-order.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: split the sub nodes into virtual sub nodes
+	 */
+	if( fdata_test_tree_split_sub_nodes() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test split sub nodes.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: split the sub nodes of a wide node lazily
+	 */
+	if( fdata_test_tree_split_sub_nodes_lazy() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test split sub nodes lazy.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: clone a tree of which the nodes have been read
+	 */
+	if( fdata_test_tree_clone() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test clone.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+}
+
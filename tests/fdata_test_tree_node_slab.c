@@ -0,0 +1,764 @@
+/*
+ * Library tree_node_slab type testing program
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fdata_test_libcerror.h"
+#include "fdata_test_libfdata.h"
+#include "fdata_test_macros.h"
+#include "fdata_test_memory.h"
+#include "fdata_test_unused.h"
+
+#include "../libfdata/libfdata_tree_node_slab.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libfdata_tree_node_slab_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_tree_node_slab_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libfdata_tree_node_slab_t *slab = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_FDATA_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfdata_tree_node_slab_initialize(
+	          &slab,
+	          sizeof( uint8_t ),
+	          4,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "slab",
+	 slab );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The element size is at least the size of a free element reference
+	 */
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "slab->element_size",
+	 (int) ( slab->element_size >= sizeof( uint8_t * ) ),
+	 1 );
+
+	result = libfdata_tree_node_slab_free(
+	          &slab,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "slab",
+	 slab );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_tree_node_slab_initialize(
+	          NULL,
+	          64,
+	          4,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	slab = (libfdata_tree_node_slab_t *) 0x12345678UL;
+
+	result = libfdata_tree_node_slab_initialize(
+	          &slab,
+	          64,
+	          4,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	slab = NULL;
+
+	result = libfdata_tree_node_slab_initialize(
+	          &slab,
+	          0,
+	          4,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "slab",
+	 slab );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_tree_node_slab_initialize(
+	          &slab,
+	          64,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "slab",
+	 slab );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FDATA_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfdata_tree_node_slab_initialize with malloc failing
+		 */
+		fdata_test_malloc_attempts_before_fail = test_number;
+
+		result = libfdata_tree_node_slab_initialize(
+		          &slab,
+		          64,
+		          4,
+		          &error );
+
+		if( fdata_test_malloc_attempts_before_fail != -1 )
+		{
+			fdata_test_malloc_attempts_before_fail = -1;
+
+			if( slab != NULL )
+			{
+				libfdata_tree_node_slab_free(
+				 &slab,
+				 NULL );
+			}
+		}
+		else
+		{
+			FDATA_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FDATA_TEST_ASSERT_IS_NULL(
+			 "slab",
+			 slab );
+
+			FDATA_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfdata_tree_node_slab_initialize with memset failing
+		 */
+		fdata_test_memset_attempts_before_fail = test_number;
+
+		result = libfdata_tree_node_slab_initialize(
+		          &slab,
+		          64,
+		          4,
+		          &error );
+
+		if( fdata_test_memset_attempts_before_fail != -1 )
+		{
+			fdata_test_memset_attempts_before_fail = -1;
+
+			if( slab != NULL )
+			{
+				libfdata_tree_node_slab_free(
+				 &slab,
+				 NULL );
+			}
+		}
+		else
+		{
+			FDATA_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FDATA_TEST_ASSERT_IS_NULL(
+			 "slab",
+			 slab );
+
+			FDATA_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FDATA_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( slab != NULL )
+	{
+		libfdata_tree_node_slab_free(
+		 &slab,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_tree_node_slab_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_tree_node_slab_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfdata_tree_node_slab_free(
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_tree_node_slab_allocate_element function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_tree_node_slab_allocate_element(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libfdata_tree_node_slab_t *slab = NULL;
+	intptr_t *elements[ 3 ]         = { NULL, NULL, NULL };
+	int element_index               = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_tree_node_slab_initialize(
+	          &slab,
+	          64,
+	          2,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "slab",
+	 slab );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * the third element does not fit in the first block
+	 */
+	for( element_index = 0;
+	     element_index < 3;
+	     element_index++ )
+	{
+		result = libfdata_tree_node_slab_allocate_element(
+		          slab,
+		          &( elements[ element_index ] ),
+		          &error );
+
+		FDATA_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FDATA_TEST_ASSERT_IS_NOT_NULL(
+		 "element",
+		 elements[ element_index ] );
+
+		FDATA_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The element is cleared and can be written
+		 */
+		FDATA_TEST_ASSERT_EQUAL_INT(
+		 "element[ 63 ]",
+		 (int) ( (uint8_t *) elements[ element_index ] )[ 63 ],
+		 0 );
+
+		memory_set(
+		 elements[ element_index ],
+		 0xff,
+		 64 );
+	}
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "slab->number_of_allocated_elements",
+	 slab->number_of_allocated_elements,
+	 3 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "slab->blocks",
+	 slab->blocks );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "slab->blocks->next_block",
+	 slab->blocks->next_block );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "slab->blocks->next_block->next_block",
+	 slab->blocks->next_block->next_block );
+
+	FDATA_TEST_ASSERT_NOT_EQUAL_INT(
+	 "element 1",
+	 (int) ( elements[ 0 ] == elements[ 1 ] ),
+	 1 );
+
+	FDATA_TEST_ASSERT_NOT_EQUAL_INT(
+	 "element 2",
+	 (int) ( elements[ 1 ] == elements[ 2 ] ),
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libfdata_tree_node_slab_allocate_element(
+	          NULL,
+	          &( elements[ 0 ] ),
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_tree_node_slab_allocate_element(
+	          slab,
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 * freeing the slab frees the elements that were not freed individually
+	 */
+	result = libfdata_tree_node_slab_free(
+	          &slab,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "slab",
+	 slab );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( slab != NULL )
+	{
+		libfdata_tree_node_slab_free(
+		 &slab,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_tree_node_slab_free_element function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_tree_node_slab_free_element(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libfdata_tree_node_slab_t *slab = NULL;
+	intptr_t *element               = NULL;
+	intptr_t *reused_element        = NULL;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_tree_node_slab_initialize(
+	          &slab,
+	          64,
+	          4,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "slab",
+	 slab );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_tree_node_slab_allocate_element(
+	          slab,
+	          &element,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "element",
+	 element );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 element,
+	 0xff,
+	 64 );
+
+	/* Test regular cases
+	 */
+	result = libfdata_tree_node_slab_free_element(
+	          slab,
+	          element,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "slab->number_of_allocated_elements",
+	 slab->number_of_allocated_elements,
+	 0 );
+
+	/* The freed element is reused and cleared
+	 */
+	result = libfdata_tree_node_slab_allocate_element(
+	          slab,
+	          &reused_element,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "reused_element",
+	 (int) ( reused_element == element ),
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "reused_element[ 0 ]",
+	 (int) ( (uint8_t *) reused_element )[ 0 ],
+	 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "reused_element[ 63 ]",
+	 (int) ( (uint8_t *) reused_element )[ 63 ],
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "slab->blocks->next_block",
+	 slab->blocks->next_block );
+
+	result = libfdata_tree_node_slab_free_element(
+	          slab,
+	          reused_element,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_tree_node_slab_free_element(
+	          NULL,
+	          element,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_tree_node_slab_free_element(
+	          slab,
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Freeing more elements than were allocated fails
+	 */
+	result = libfdata_tree_node_slab_free_element(
+	          slab,
+	          element,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_tree_node_slab_free(
+	          &slab,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "slab",
+	 slab );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( slab != NULL )
+	{
+		libfdata_tree_node_slab_free(
+		 &slab,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FDATA_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FDATA_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FDATA_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FDATA_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( argc )
+	FDATA_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	FDATA_TEST_RUN(
+	 "libfdata_tree_node_slab_initialize",
+	 fdata_test_tree_node_slab_initialize );
+
+	FDATA_TEST_RUN(
+	 "libfdata_tree_node_slab_free",
+	 fdata_test_tree_node_slab_free );
+
+	FDATA_TEST_RUN(
+	 "libfdata_tree_node_slab_allocate_element",
+	 fdata_test_tree_node_slab_allocate_element );
+
+	FDATA_TEST_RUN(
+	 "libfdata_tree_node_slab_free_element",
+	 fdata_test_tree_node_slab_free_element );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -436,6 +436,689 @@ on_error:
 	return( -1 );
 }
 
+static int fdata_test_vector_number_of_reads          = 0;
+static int fdata_test_vector_number_of_batched_reads  = 0;
+static int fdata_test_vector_number_of_batch_elements = 0;
+
+/* Reads element data and keeps track of the number of reads
+ * Callback function for the vector
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_vector_read_element_data_counted(
+     intptr_t *data_handle,
+     intptr_t *file_io_handle,
+     libfdata_vector_t *vector,
+     libfdata_cache_t *cache,
+     int element_index,
+     int element_data_file_index,
+     off64_t element_data_offset,
+     size64_t element_data_size,
+     uint32_t element_data_flags,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	fdata_test_vector_number_of_reads++;
+
+	return( fdata_test_vector_read_element_data(
+	         data_handle,
+	         file_io_handle,
+	         vector,
+	         cache,
+	         element_index,
+	         element_data_file_index,
+	         element_data_offset,
+	         element_data_size,
+	         element_data_flags,
+	         read_flags,
+	         error ) );
+}
+
+/* Reads the data of consecutive elements and keeps track of the number of reads
+ * Callback function for the vector
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_vector_read_elements_data_counted(
+     intptr_t *data_handle,
+     intptr_t *file_io_handle,
+     libfdata_vector_t *vector,
+     libfdata_cache_t *cache,
+     int first_element_index,
+     int number_of_elements,
+     int elements_data_file_index,
+     off64_t elements_data_offset,
+     size64_t elements_data_size,
+     uint32_t elements_data_flags,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_test_vector_read_elements_data_counted";
+	int element_index     = 0;
+
+	if( elements_data_size != ( (size64_t) number_of_elements * ELEMENT_DATA_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid elements data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	fdata_test_vector_number_of_batched_reads++;
+
+	fdata_test_vector_number_of_batch_elements += number_of_elements;
+
+	for( element_index = 0;
+	     element_index < number_of_elements;
+	     element_index++ )
+	{
+		if( fdata_test_vector_read_element_data(
+		     data_handle,
+		     file_io_handle,
+		     vector,
+		     cache,
+		     first_element_index + element_index,
+		     elements_data_file_index,
+		     elements_data_offset + ( element_index * ELEMENT_DATA_SIZE ),
+		     ELEMENT_DATA_SIZE,
+		     elements_data_flags,
+		     read_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read element: %d data.",
+			 function,
+			 first_element_index + element_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Tests reading ahead the vector elements on sequential access
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_vector_read_ahead(
+    void )
+{
+	/* The read flags and if the read elements data function is set
+	 */
+	uint8_t test_values[ 3 ][ 2 ] = {
+		{ 0, 1 },
+		{ LIBFDATA_READ_FLAG_NO_READ_AHEAD, 1 },
+		{ 0, 0 } };
+
+	libcerror_error_t *error      = NULL;
+	libfdata_cache_t *cache       = NULL;
+	libfdata_vector_t *vector     = NULL;
+	uint8_t *element_data         = NULL;
+	static char *function         = "fdata_test_vector_read_ahead";
+	uint32_t test_element_index   = 0;
+	int element_index             = 0;
+	int expected_number_of_reads  = 0;
+	int result                    = 1;
+	int segment_index             = 0;
+	int test_index                = 0;
+
+	for( test_index = 0;
+	     test_index < 3;
+	     test_index++ )
+	{
+		if( libfdata_vector_initialize(
+		     &vector,
+		     ELEMENT_DATA_SIZE,
+		     NULL,
+		     NULL,
+		     NULL,
+		     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfdata_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_vector_read_element_data_counted,
+		     NULL,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create vector.",
+			 function );
+
+			goto on_error;
+		}
+		if( test_values[ test_index ][ 1 ] != 0 )
+		{
+			if( libfdata_vector_set_read_elements_data_function(
+			     vector,
+			     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfdata_cache_t *, int, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_vector_read_elements_data_counted,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set read elements data function.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libfdata_vector_append_segment(
+		     vector,
+		     &segment_index,
+		     0,
+		     0,
+		     MAXIMUM_NUMBER_OF_ELEMENTS * ELEMENT_DATA_SIZE,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment to vector.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfdata_cache_initialize(
+		     &cache,
+		     16,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create cache.",
+			 function );
+
+			goto on_error;
+		}
+		fdata_test_vector_number_of_reads          = 0;
+		fdata_test_vector_number_of_batched_reads  = 0;
+		fdata_test_vector_number_of_batch_elements = 0;
+
+		/* Retrieve the first elements sequentially and then an element further on
+		 */
+		for( element_index = 0;
+		     element_index < 5;
+		     element_index++ )
+		{
+			if( libfdata_vector_get_element_value_by_index(
+			     vector,
+			     NULL,
+			     cache,
+			     ( element_index < 4 ) ? element_index : 10,
+			     (intptr_t **) &element_data,
+			     test_values[ test_index ][ 0 ],
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve element: %d value.",
+				 function,
+				 element_index );
+
+				goto on_error;
+			}
+			test_element_index = 0;
+
+			if( element_data != NULL )
+			{
+				byte_stream_copy_to_uint32_little_endian(
+				 element_data,
+				 test_element_index );
+			}
+			if( test_element_index != (uint32_t) ( ( element_index < 4 ) ? element_index : 10 ) )
+			{
+				result = 0;
+			}
+		}
+		/* With read ahead element 1 is read together with the elements following it
+		 * in a single batched read, hence elements 2, 3 and 10 are retrieved from the cache.
+		 * Without read ahead or a read elements data function every retrieved element
+		 * is read on its own
+		 */
+		if( test_index == 0 )
+		{
+			expected_number_of_reads = 1;
+
+			if( ( fdata_test_vector_number_of_batched_reads != 1 )
+			 || ( fdata_test_vector_number_of_batch_elements != 16 ) )
+			{
+				result = 0;
+			}
+		}
+		else
+		{
+			expected_number_of_reads = 5;
+
+			if( fdata_test_vector_number_of_batched_reads != 0 )
+			{
+				result = 0;
+			}
+		}
+		if( fdata_test_vector_number_of_reads != expected_number_of_reads )
+		{
+			result = 0;
+		}
+		if( libfdata_cache_free(
+		     &cache,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free cache.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfdata_vector_free(
+		     &vector,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free vector.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	fprintf(
+	 stdout,
+	 "Testing read ahead\t" );
+
+	if( result == 0 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( vector != NULL )
+	{
+		libfdata_vector_free(
+		 &vector,
+		 NULL );
+	}
+	return( -1 );
+}
+
+static int fdata_test_vector_element_number_of_reads[ MAXIMUM_NUMBER_OF_ELEMENTS ];
+
+/* Reads element data and keeps track of the number of reads per element
+ * Callback function for the vector
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_vector_read_element_data_tracked(
+     intptr_t *data_handle,
+     intptr_t *file_io_handle,
+     libfdata_vector_t *vector,
+     libfdata_cache_t *cache,
+     int element_index,
+     int element_data_file_index,
+     off64_t element_data_offset,
+     size64_t element_data_size,
+     uint32_t element_data_flags,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	if( ( element_index >= 0 )
+	 && ( element_index < MAXIMUM_NUMBER_OF_ELEMENTS ) )
+	{
+		fdata_test_vector_element_number_of_reads[ element_index ] += 1;
+	}
+	return( fdata_test_vector_read_element_data(
+	         data_handle,
+	         file_io_handle,
+	         vector,
+	         cache,
+	         element_index,
+	         element_data_file_index,
+	         element_data_offset,
+	         element_data_size,
+	         element_data_flags,
+	         read_flags,
+	         error ) );
+}
+
+/* Reads the data of consecutive elements and keeps track of the number of reads per element
+ * Callback function for the vector
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_vector_read_elements_data_tracked(
+     intptr_t *data_handle,
+     intptr_t *file_io_handle,
+     libfdata_vector_t *vector,
+     libfdata_cache_t *cache,
+     int first_element_index,
+     int number_of_elements,
+     int elements_data_file_index,
+     off64_t elements_data_offset,
+     size64_t elements_data_size FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint32_t elements_data_flags,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	int element_index = 0;
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( elements_data_size );
+
+	for( element_index = 0;
+	     element_index < number_of_elements;
+	     element_index++ )
+	{
+		if( fdata_test_vector_read_element_data_tracked(
+		     data_handle,
+		     file_io_handle,
+		     vector,
+		     cache,
+		     first_element_index + element_index,
+		     elements_data_file_index,
+		     elements_data_offset + ( element_index * ELEMENT_DATA_SIZE ),
+		     ELEMENT_DATA_SIZE,
+		     elements_data_flags,
+		     read_flags,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Checks the value of an element
+ * Callback function for libfdata_vector_parallel_for_each
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_vector_visit_element_value(
+     intptr_t *element_value,
+     int element_index,
+     intptr_t *visitor_data,
+     libcerror_error_t **error )
+{
+	int *number_of_visits       = NULL;
+	static char *function       = "fdata_test_vector_visit_element_value";
+	uint32_t test_element_index = 0;
+
+	if( element_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element value.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( element_index < 0 )
+	 || ( element_index >= MAXIMUM_NUMBER_OF_ELEMENTS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 (uint8_t *) element_value,
+	 test_element_index );
+
+	if( test_element_index != (uint32_t) element_index )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element: %d value.",
+		 function,
+		 element_index );
+
+		return( -1 );
+	}
+	/* Every element is visited by a single thread
+	 */
+	number_of_visits = (int *) visitor_data;
+
+	number_of_visits[ element_index ] += 1;
+
+	return( 1 );
+}
+
+/* Tests visiting the vector elements in parallel
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fdata_test_vector_parallel_for_each(
+    void )
+{
+	int number_of_visits[ MAXIMUM_NUMBER_OF_ELEMENTS ];
+
+	libcerror_error_t *error  = NULL;
+	libfdata_vector_t *vector = NULL;
+	static char *function     = "fdata_test_vector_parallel_for_each";
+	int element_index         = 0;
+	int number_of_threads     = 0;
+	int result                = 1;
+	int segment_index         = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing parallel_for_each\t" );
+
+	if( libfdata_vector_initialize(
+	     &vector,
+	     ELEMENT_DATA_SIZE,
+	     NULL,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfdata_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_vector_read_element_data_tracked,
+	     NULL,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create vector.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_vector_set_read_elements_data_function(
+	     vector,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfdata_cache_t *, int, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_test_vector_read_elements_data_tracked,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read elements data function.",
+		 function );
+
+		goto on_error;
+	}
+	/* Use multiple segments of which the boundaries are not aligned with the elements
+	 */
+	if( libfdata_vector_append_segment(
+	     vector,
+	     &segment_index,
+	     0,
+	     0,
+	     ( 100 * ELEMENT_DATA_SIZE ) + 16,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append segment to vector.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_vector_append_segment(
+	     vector,
+	     &segment_index,
+	     0,
+	     ( 100 * ELEMENT_DATA_SIZE ) + 16,
+	     ( ( MAXIMUM_NUMBER_OF_ELEMENTS - 100 ) * ELEMENT_DATA_SIZE ) - 16,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append segment to vector.",
+		 function );
+
+		goto on_error;
+	}
+	for( number_of_threads = 1;
+	     number_of_threads <= 4;
+	     number_of_threads += 3 )
+	{
+		for( element_index = 0;
+		     element_index < MAXIMUM_NUMBER_OF_ELEMENTS;
+		     element_index++ )
+		{
+			number_of_visits[ element_index ] = 0;
+
+			fdata_test_vector_element_number_of_reads[ element_index ] = 0;
+		}
+		if( libfdata_vector_parallel_for_each(
+		     vector,
+		     NULL,
+		     8,
+		     number_of_threads,
+		     &fdata_test_vector_visit_element_value,
+		     (intptr_t *) number_of_visits,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to visit elements using %d threads.",
+			 function,
+			 number_of_threads );
+
+			goto on_error;
+		}
+		for( element_index = 0;
+		     element_index < MAXIMUM_NUMBER_OF_ELEMENTS;
+		     element_index++ )
+		{
+			/* The elements read ahead do not cross the chunk boundaries,
+			 * hence every element is read once
+			 */
+			if( ( number_of_visits[ element_index ] != 1 )
+			 || ( fdata_test_vector_element_number_of_reads[ element_index ] != 1 ) )
+			{
+				result = 0;
+			}
+		}
+	}
+	if( result == 0 )
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( libfdata_vector_free(
+	     &vector,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free vector.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	fprintf(
+	 stdout,
+	 "(FAIL)\n" );
+
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( vector != NULL )
+	{
+		libfdata_vector_free(
+		 &vector,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -498,6 +1181,26 @@ int main( int argc, char * const argv[] )
 
 		return( EXIT_FAILURE );
 	}
+	/* Test: read ahead elements
+	 */
+	if( fdata_test_vector_read_ahead() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read ahead.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Test: visit elements in parallel
+	 */
+	if( fdata_test_vector_parallel_for_each() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test parallel for each.\n" );
+
+		return( EXIT_FAILURE );
+	}
 	return( EXIT_SUCCESS );
 }
 
@@ -10,7 +10,7 @@ $TestPrefix = Split-Path -path ${Pwd}.Path -parent
 $TestPrefix = Split-Path -path ${TestPrefix} -leaf
 $TestPrefix = ${TestPrefix}.Substring(3)
 
-$TestTypes = "area btree btree_range cache list mapped_range range range_list stream vector"
+$TestTypes = "area btree btree_range cache list mapped_range range range_list stream tree_node_slab vector"
 $TestTypesWithInput = ""
 
 $TestToolDirectory = "..\msvscpp\Release"
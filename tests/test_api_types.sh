@@ -11,7 +11,7 @@ TEST_PREFIX=`dirname ${PWD}`;
 TEST_PREFIX=`basename ${TEST_PREFIX} | sed 's/^lib\([^-]*\).*$/\1/'`;
 
 TEST_PROFILE="lib${TEST_PREFIX}";
-TEST_TYPES="area btree btree_range cache list mapped_range range range_list stream vector";
+TEST_TYPES="area btree btree_range cache list mapped_range range range_list stream tree tree_node_slab vector";
 TEST_TYPES_WITH_INPUT="";
 OPTION_SETS="";
 